@@ -24,6 +24,8 @@ except ModuleNotFoundError:
 bskModuleOptionsBool = {
     "opNav": False,
     "vizInterface": True,
+    "mpi": False,
+    "allocationGuard": False,
     "buildProject": True
 }
 bskModuleOptionsString = {
@@ -262,6 +264,8 @@ class BasiliskConan(ConanFile):
             cmake.definitions["CONAN_LINK_RUNTIME"] = False
         cmake.definitions["BUILD_OPNAV"] = self.options.opNav
         cmake.definitions["BUILD_VIZINTERFACE"] = self.options.vizInterface
+        cmake.definitions["BUILD_MPI"] = self.options.mpi
+        cmake.definitions["BUILD_ALLOCATION_GUARD"] = self.options.allocationGuard
         cmake.definitions["EXTERNAL_MODULES_PATH"] = self.options.pathToExternalModules
         cmake.definitions["PYTHON_VERSION"] = sys.version_info.major + 0.1*sys.version_info.minor
         cmake.parallel = True
@@ -43,9 +43,9 @@ process and task list.  This is done with the commands::
     pyModulesProcess = scSim.CreateNewPythonProcess(pyProcessName, 9)
     pyModulesProcess.createPythonTask(pyTaskName, simulationTimeStep, True, -1)
 
-Note that the python processes are always evaluated after the regular C/C++ processes.  Thus, the priority number
-only controls the order of the python processes, not the python process execution relative to regular
-Basilisk processes.
+The python tasks are executed by the native Basilisk scheduler.  Thus, the process priority number
+controls the order of the python process relative to the regular C/C++ processes, just as with any
+other Basilisk process.
 
 Creating an instance of the Python module is done with the code::
 
@@ -24,6 +24,9 @@
 #include <stdint.h>
 #include <architecture/utilities/bskLogging.h>
 
+/*! C update function of a module, called with the module data, the simulation time and the module ID */
+typedef void (*SysModelUpdatePtr)(void*, uint64_t, uint64_t);
+
 /*! @brief Simulation System Model Class */
 class SysModel
 {
@@ -36,6 +39,7 @@ public:
     virtual void IntegratedInit();  //!< -- ???
     virtual void UpdateState(uint64_t CurrentSimNanos);  //!< -- What the module does each time step
     virtual void Reset(uint64_t CurrentSimNanos);  //!< -- Reset module to specified time
+    virtual SysModelUpdatePtr directUpdate(void ** /*updateData*/) {return NULL;}  //!< -- C function a task can call instead of UpdateState(), NULL if there is none
     
 public:
     std::string ModelTag;  //!< -- name for the algorithm to base off of
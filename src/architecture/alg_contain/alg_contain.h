@@ -47,6 +47,7 @@ public:
     uint64_t getSelfInitAddress() {return reinterpret_cast<uint64_t>(*AlgSelfInit);} //!< method
     uint64_t getResetAddress() {return reinterpret_cast<uint64_t>(*AlgReset);} //!< method
     uint64_t getUpdateAddress() {return reinterpret_cast<uint64_t>(*AlgUpdate);} //!< method
+    AlgUpdatePtr directUpdate(void **updateData) {*updateData = DataPtr; return AlgUpdate;} //!< lets the task call the C update function directly
     
 public:
     void *DataPtr;                              //!< class variable
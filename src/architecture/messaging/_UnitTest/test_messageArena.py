@@ -0,0 +1,164 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import time
+from contextlib import nullcontext
+
+import numpy as np
+from Basilisk.architecture import bskLogging
+from Basilisk.architecture import messaging
+from Basilisk.fswAlgorithms import attTrackingError
+from Basilisk.fswAlgorithms import inertial3D
+from Basilisk.fswAlgorithms import mrpFeedback
+from Basilisk.simulation import extForceTorque
+from Basilisk.simulation import simpleNav
+from Basilisk.simulation import spacecraft
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simIncludeGravBody
+from Basilisk.utilities import unitTestSupport
+
+
+def buildScenario(numSpacecraft, useArena):
+    """
+    build a formation of spacecraft, each with its own dynamics and attitude control modules.  The dynamics and FSW
+    modules are created in execution order, inside the message arena of their process if ``useArena`` is set.
+    """
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("dynProcess", 2)
+    fswProcess = scSim.CreateNewProcess("fswProcess", 1)
+    dynProcess.addTask(scSim.CreateNewTask("dynTask", macros.sec2nano(0.1)))
+    fswProcess.addTask(scSim.CreateNewTask("fswTask", macros.sec2nano(0.5)))
+
+    gravFactory = simIncludeGravBody.gravBodyFactory()
+    earth = gravFactory.createEarth()
+    earth.isCentralBody = True
+
+    I = [900., 0., 0., 0., 800., 0., 0., 0., 600.]
+    configData = messaging.VehicleConfigMsgPayload()
+    configData.ISCPntB_B = I
+
+    scSim.formation = []
+    for i in range(numSpacecraft):
+        with dynProcess.placeMessages() if useArena else nullcontext():
+            scObject = spacecraft.Spacecraft()
+            extFTObject = extForceTorque.ExtForceTorque()
+            sNavObject = simpleNav.SimpleNav()
+        scObject.ModelTag = "spacecraft" + str(i)
+        scObject.hub.mHub = 750.0
+        scObject.hub.IHubPntBc_B = unitTestSupport.np2EigenMatrix3d(I)
+        scObject.hub.r_CN_NInit = [[7000.0e3 + 10.0 * i], [0.0], [0.0]]
+        scObject.hub.v_CN_NInit = [[0.0], [7.5e3], [0.0]]
+        scObject.hub.sigma_BNInit = [[0.1], [0.2], [-0.3 + 0.01 * i]]
+        scObject.hub.omega_BN_BInit = [[0.001], [-0.01], [0.03]]
+        scObject.gravField.gravBodies = spacecraft.GravBodyVector(list(gravFactory.gravBodies.values()))
+        scObject.addDynamicEffector(extFTObject)
+        scSim.AddModelToTask("dynTask", scObject, None, 30)
+        scSim.AddModelToTask("dynTask", extFTObject, None, 20)
+        scSim.AddModelToTask("dynTask", sNavObject, None, 10)
+
+        with fswProcess.placeMessages() if useArena else nullcontext():
+            configDataMsg = messaging.VehicleConfigMsg().write(configData)
+            inertial3DConfig = inertial3D.inertial3DConfig()
+            attErrorConfig = attTrackingError.attTrackingErrorConfig()
+            mrpControlConfig = mrpFeedback.mrpFeedbackConfig()
+        inertial3DWrap = scSim.setModelDataWrap(inertial3DConfig)
+        attErrorWrap = scSim.setModelDataWrap(attErrorConfig)
+        mrpControlWrap = scSim.setModelDataWrap(mrpControlConfig)
+        scSim.AddModelToTask("fswTask", inertial3DWrap, inertial3DConfig, 30)
+        scSim.AddModelToTask("fswTask", attErrorWrap, attErrorConfig, 20)
+        scSim.AddModelToTask("fswTask", mrpControlWrap, mrpControlConfig, 10)
+        mrpControlConfig.K = 3.5
+        mrpControlConfig.Ki = -1
+        mrpControlConfig.P = 30.0
+
+        sNavObject.scStateInMsg.subscribeTo(scObject.scStateOutMsg)
+        attErrorConfig.attNavInMsg.subscribeTo(sNavObject.attOutMsg)
+        attErrorConfig.attRefInMsg.subscribeTo(inertial3DConfig.attRefOutMsg)
+        mrpControlConfig.guidInMsg.subscribeTo(attErrorConfig.attGuidOutMsg)
+        mrpControlConfig.vehConfigInMsg.subscribeTo(configDataMsg)
+        extFTObject.cmdTorqueInMsg.subscribeTo(mrpControlConfig.cmdTorqueOutMsg)
+
+        scSim.formation.append((scObject, extFTObject, sNavObject, configDataMsg,
+                                inertial3DConfig, attErrorConfig, mrpControlConfig))
+    return scSim, dynProcess, fswProcess
+
+
+def runFrames(scSim, simTime):
+    """
+    execute the simulation and return the average wall clock time of a dynamics frame in seconds
+    """
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(simTime))
+    start = time.perf_counter()
+    scSim.ExecuteSimulation()
+    return (time.perf_counter() - start) / (simTime / 0.1)
+
+
+def test_messageArena():
+    """
+    testing that messages placed in the arena of a process behave like the messages stored in their modules
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    attitudes = []
+    for useArena in [False, True]:
+        scSim, dynProcess, fswProcess = buildScenario(3, useArena)
+        scObject, extFTObject, sNavObject, configDataMsg = scSim.formation[0][:4]
+        assert scObject.scStateOutMsg.isPlaced() == useArena
+        assert sNavObject.attOutMsg.isPlaced() == useArena
+        assert configDataMsg.isPlaced() == useArena
+        if useArena:
+            arena = dynProcess.processData.messageArena
+            # every spacecraft writes its states and mass properties, simple nav its attitude and translation
+            assert arena.messageCount() >= 3 * 4
+            assert arena.bytesUsed() >= 3 * (scObject.scStateOutMsg.getPayloadSize()
+                                             + sNavObject.attOutMsg.getPayloadSize())
+            assert fswProcess.processData.messageArena.messageCount() == 3
+        runFrames(scSim, 20.0)
+        attitudes.append([sc[0].scStateOutMsg.read().sigma_BN for sc in scSim.formation])
+
+    np.testing.assert_array_equal(attitudes[0], attitudes[1])
+
+    # messages created outside of a placement block are not placed
+    assert not messaging.SCStatesMsg().isPlaced()
+
+
+def messageArenaBenchmark(numSpacecraft=100, simTime=60.0):
+    """
+    measure the average dynamics frame time of a formation with and without the message arenas
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    frameTimes = {}
+    for useArena in [False, True]:
+        scSim = buildScenario(numSpacecraft, useArena)[0]
+        frameTimes[useArena] = runFrames(scSim, simTime)
+        print("%d spacecraft, message arena %s: %.1f us per frame"
+              % (numSpacecraft, "on " if useArena else "off", frameTimes[useArena] * 1.0e6))
+    return frameTimes
+
+
+def test_messageArenaBenchmark():
+    """
+    smoke test of the frame time benchmark, run this file directly for a full size benchmark
+    """
+    frameTimes = messageArenaBenchmark(10, 5.0)
+    assert frameTimes[False] > 0.0 and frameTimes[True] > 0.0
+
+
+if __name__ == "__main__":
+    messageArenaBenchmark()
@@ -0,0 +1,96 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import numpy as np
+import pytest
+from Basilisk.architecture import bskLogging
+from Basilisk.architecture import messaging
+from Basilisk.moduleTemplates import cModuleTemplate
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def test_payloadView():
+    """
+    testing the zero-copy numpy views of C++ messages, C++ input messages and C-wrapped messages
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+
+    # stand-alone C++ message written through the view
+    msg = messaging.SCStatesMsg()
+    view = msg.payloadView()
+    assert view.dtype.itemsize == msg.getPayloadSize()
+    view['r_BN_N'][:] = [1., 2., 3.]
+    view['MRPSwitchCount'] = 4
+    msg.writeView(macros.sec2nano(2.), 7)
+    payload = msg.read()
+    np.testing.assert_allclose(payload.r_BN_N, [1., 2., 3.])
+    assert payload.MRPSwitchCount == 4
+    reader = msg.addSubscriber()
+    assert reader.isWritten()
+    assert reader.timeWritten() == macros.sec2nano(2.)
+    assert reader.moduleID() == 7
+
+    # writing through the regular interface is seen by an existing view
+    payload.v_BN_N = [4., 5., 6.]
+    msg.write(payload)
+    np.testing.assert_allclose(view['v_BN_N'], [4., 5., 6.])
+
+    # setup a sim where a C++ and a C module read and write messages
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("proc")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(1.)))
+
+    cppMod = cppModuleTemplate.CppModuleTemplate()
+    cppMod.ModelTag = "cppModule"
+    scSim.AddModelToTask("task", cppMod)
+
+    cMod = cModuleTemplate.cModuleTemplateConfig()
+    cModWrap = scSim.setModelDataWrap(cMod)
+    cModWrap.ModelTag = "cModule"
+    scSim.AddModelToTask("task", cModWrap, cMod)
+
+    inMsg = messaging.CModuleTemplateMsg()
+    inView = inMsg.payloadView()
+    inView['dataVector'][:] = [1., 0., 0.]
+    inMsg.writeView()
+    cppMod.dataInMsg.subscribeTo(inMsg)
+    cMod.dataInMsg.subscribeTo(cppMod.dataOutMsg)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(3.))
+    scSim.ExecuteSimulation()
+
+    # input message views share the memory of the subscribed message and are read-only
+    readView = cppMod.dataInMsg.payloadView()
+    np.testing.assert_allclose(readView['dataVector'], inView['dataVector'])
+    with pytest.raises(ValueError):
+        readView['dataVector'][0] = 3.
+
+    cppOut = cppMod.dataOutMsg.read()
+    np.testing.assert_allclose(cppMod.dataOutMsg.payloadView()['dataVector'], cppOut.dataVector)
+
+    # C-wrapped input message views point to the connected C++ output message
+    np.testing.assert_allclose(cMod.dataInMsg.payloadView()['dataVector'], cppOut.dataVector)
+    cOut = cMod.dataOutMsg.read()
+    np.testing.assert_allclose(cMod.dataOutMsg.payloadView()['dataVector'], cOut.dataVector)
+
+
+if __name__ == "__main__":
+    test_payloadView()
@@ -22,7 +22,10 @@ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
 #include <vector>
 #include "architecture/messaging/msgHeader.h"
 #include "architecture/utilities/bskLogging.h"
+#include "architecture/utilities/moduleIdGenerator/messageArena.h"
 #include <typeinfo>
+#include <type_traits>
+#include <new>
 #include <stdlib.h>
 
 /*! forward-declare sim message for use by read functor */
@@ -145,6 +148,16 @@ public:
 
     };
 
+    //! return the pointers to the connected message payload and header
+    messageType* getMsgPointers(MsgHeader **msgPtr){
+        if (!this->initialized) {
+            messageType var;
+            bskLogger.bskLog(BSK_ERROR, "In C++ read functor, you are requesting the pointers of an unconnected msg of type %s.", typeid(var).name());
+        }
+        *msgPtr = this->headerPointer;
+        return this->payloadPointer;
+    };
+
     //! Recorder method description
     Recorder<messageType> recorder(uint64_t timeDiff = 0){return Recorder<messageType>(this, timeDiff);}
 };
@@ -181,10 +194,14 @@ class Message{
 private:
     messageType payload = {};   //!< struct defining message payload, zero'd on creation
     MsgHeader header = {};      //!< struct defining the message header, zero'd on creation
-    ReadFunctor<messageType> read = ReadFunctor<messageType>(&payload, &header);  //!< read functor instance
+    messageType *payloadPointer = &payload; //!< payload in use, the one above or one placed in a message arena
+    MsgHeader *headerPointer = &header;     //!< header in use, the one above or one placed in a message arena
+    ReadFunctor<messageType> read;  //!< read functor instance
 public:
+    //! -- constructor, places the header and payload in the message arena opened on this thread if any
+    Message();
     //! write functor to this message
-    WriteFunctor<messageType> write = WriteFunctor<messageType>(&payload, &header);
+    WriteFunctor<messageType> write;
     //! -- request read rights. returns reference to class ``read`` variable
     ReadFunctor<messageType> addSubscriber();
     //! -- request write rights.
@@ -201,16 +218,40 @@ public:
     messageType zeroMsgPayload = {};    //!< zero'd copy of the message payload structure
 
     //! check if this msg has been connected to
-    bool isLinked(){return this->header.isLinked;};
+    bool isLinked(){return this->headerPointer->isLinked;};
+
+    //! check if the header and payload are placed in a message arena
+    bool isPlaced(){return this->headerPointer != &this->header;};
 
     //! Return the memory size of the payload, be careful about dynamically sized things
     uint64_t getPayloadSize() {return sizeof(messageType);};
+
+    //! check if the payload can be copied byte by byte, such as when it is read across threads
+    bool isPayloadTriviallyCopyable(){return std::is_trivially_copyable<messageType>::value;};
 };
 
 
+template<typename messageType>
+Message<messageType>::Message(){
+    MessageArena *arena = MessageArena::current();
+    // payloads owning memory, such as vectors, keep living in the message as the arena never runs destructors
+    if (arena != nullptr && std::is_trivially_copyable<messageType>::value) {
+        const size_t alignment = alignof(messageType) > alignof(MsgHeader) ? alignof(messageType) : alignof(MsgHeader);
+        const size_t payloadOffset = (sizeof(MsgHeader) + alignof(messageType) - 1) / alignof(messageType) * alignof(messageType);
+        char *record = (char *) arena->allocate(payloadOffset + sizeof(messageType), alignment);
+        if (record != nullptr) {
+            this->headerPointer = new (record) MsgHeader();
+            this->payloadPointer = new (record + payloadOffset) messageType();
+        }
+    }
+    this->read = ReadFunctor<messageType>(this->payloadPointer, this->headerPointer);
+    this->write = WriteFunctor<messageType>(this->payloadPointer, this->headerPointer);
+}
+
+
 template<typename messageType>
 ReadFunctor<messageType> Message<messageType>::addSubscriber(){
-    this->header.isLinked = 1;
+    this->headerPointer->isLinked = 1;
     return this->read;
 }
 
@@ -221,15 +262,15 @@ WriteFunctor<messageType> Message<messageType>::addAuthor(){
 
 template<typename messageType>
 messageType* Message<messageType>::subscribeRaw(MsgHeader **msgPtr){
-    *msgPtr = &this->header;
-    this->header.isLinked = 1;
-    return &this->payload;
+    *msgPtr = this->headerPointer;
+    this->headerPointer->isLinked = 1;
+    return this->payloadPointer;
 }
 
 template<typename messageType>
 messageType* Message<messageType>::getMsgPointers(MsgHeader **msgPtr){
-    *msgPtr = &this->header;
-    return &this->payload;
+    *msgPtr = this->headerPointer;
+    return this->payloadPointer;
 }
 
 /*! Keep a time history of messages accessible to users from python */
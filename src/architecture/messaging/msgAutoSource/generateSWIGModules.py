@@ -1,5 +1,78 @@
+import os
+import re
 import sys
 
+# numpy type codes of the payload member types that can be exposed through a zero-copy view
+numpyTypeMap = {
+    'double': 'f8',
+    'float': 'f4',
+    'int': 'i4',
+    'unsigned int': 'u4',
+    'int8_t': 'i1',
+    'uint8_t': 'u1',
+    'int16_t': 'i2',
+    'uint16_t': 'u2',
+    'int32_t': 'i4',
+    'uint32_t': 'u4',
+    'int64_t': 'i8',
+    'uint64_t': 'u8',
+    'bool': '?',
+    'char': 'S',
+}
+
+
+def parsePayloadFields(headerPath, payloadName):
+    """
+    Returns the (type, name, number of array dimensions) of the payload members that have a plain numeric type.
+    Members of any other type (nested structures, enums, Eigen or std types) are left out.
+    """
+    with open(headerPath, 'r') as fid:
+        text = fid.read()
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    text = re.sub(r'//.*', '', text)
+    text = re.sub(r'^\s*#.*$', '', text, flags=re.M)
+    match = re.search(r'typedef\s+struct\s*\w*\s*\{(.*?)\}\s*' + payloadName + r'\s*;', text, flags=re.S)
+    if match is None:
+        return []
+    fields = []
+    for statement in match.group(1).split(';'):
+        fieldMatch = re.match(r'\s*((?:unsigned\s+)?\w+)\s+(\w+)\s*((?:\[[^\]]+\]\s*)*)$', statement.strip())
+        if fieldMatch is None:
+            continue
+        fieldType = ' '.join(fieldMatch.group(1).split())
+        if fieldType not in numpyTypeMap:
+            continue
+        fields.append((fieldType, fieldMatch.group(2), fieldMatch.group(3).count('[')))
+    return fields
+
+
+def generatePayloadLayout(payloadName, fields):
+    """
+    Creates the C++ body of the function returning the payload memory layout string used to build the numpy
+    structured dtype.  The layout is ``size;name:offset:format:dim0,dim1;...``.  Offsets and array dimensions
+    are evaluated by the compiler.  An empty string is returned for payloads that are not standard-layout types.
+    """
+    lines = ['    if (!std::is_standard_layout<' + payloadName + '>::value) {',
+             '        return std::string();',
+             '    }',
+             '    std::string layout = std::to_string(sizeof(' + payloadName + '));']
+    for fieldType, fieldName, numDims in fields:
+        member = payloadName + '::' + fieldName
+        dims = []
+        for i in range(numDims):
+            dims.append('std::to_string(sizeof(' + member + '[0]' * i + ')/sizeof(' + member + '[0]' * (i + 1) + '))')
+        fmt = '"' + numpyTypeMap[fieldType] + '"'
+        if fieldType == 'char' and numDims > 0:
+            # the inner-most char dimension becomes the length of a numpy byte string
+            fmt = '"S" + ' + dims.pop()
+        line = '    layout += ";' + fieldName + ':" + std::to_string(offsetof(' + payloadName + ', ' + fieldName + '))'
+        line += ' + ":" + ' + fmt + ' + ":"'
+        if dims:
+            line += ' + ' + ' + "," + '.join(dims)
+        lines.append(line + ';')
+    lines.append('    return layout;')
+    return '\n'.join(lines)
+
 if __name__ == "__main__":
      moduleOutputPath = sys.argv[1]
      headerinputPath = sys.argv[2]
@@ -18,8 +91,11 @@ if __name__ == "__main__":
      swigCTemplateData = swigCFid.read()
      swigCFid.close()
 
+     payloadFields = parsePayloadFields(os.path.join('..', headerinputPath), structType + 'Payload')
+     payloadLayout = generatePayloadLayout(structType + 'Payload', payloadFields)
+
      moduleFileOut = open(moduleOutputPath, 'w')
-     moduleFileOut.write(swigTemplateData.format(type=structType, baseDir=baseDir))
+     moduleFileOut.write(swigTemplateData.format(type=structType, baseDir=baseDir, payloadLayout=payloadLayout))
      if(generateCInfo):
          moduleFileOut.write(swigCTemplateData.format(type=structType))
      moduleFileOut.close()
@@ -0,0 +1,34 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef BORE_ANGLE_ARRAY_H
+#define BORE_ANGLE_ARRAY_H
+
+#include "architecture/utilities/macroDefinitions.h"
+
+
+/*! @brief Structure used to define the boresight angles of several spacecraft */
+typedef struct {
+    int numSc;                      //!< [-] number of spacecraft with valid angles
+    double azimuth[MAX_SC_CNT];     //!< [r] the location angle to put the miss in a quadrant
+    double missAngle[MAX_SC_CNT];   //!< [r] the angular distance between the boresight and body
+}BoreAngleArrayMsgPayload;
+
+
+#endif
@@ -0,0 +1,42 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef CLASSIC_ELEMENTS_ARRAY_H
+#define CLASSIC_ELEMENTS_ARRAY_H
+
+#include "architecture/utilities/macroDefinitions.h"
+
+
+/*! @brief Structure used to define the classic orbit elements of several spacecraft, stored element by element */
+typedef struct {
+    int numSc;                  //!< [-] number of spacecraft with valid elements
+    double a[MAX_SC_CNT];       //!< [m] semi-major axis
+    double e[MAX_SC_CNT];       //!< [-] eccentricity of the orbit
+    double i[MAX_SC_CNT];       //!< [r] inclination of the orbital plane
+    double Omega[MAX_SC_CNT];   //!< [r] right ascension of the ascending node
+    double omega[MAX_SC_CNT];   //!< [r] argument of periapsis of the orbit
+    double f[MAX_SC_CNT];       //!< [r] true anomaly of the orbit
+    double rmag[MAX_SC_CNT];    //!< [m] magnitude of the position vector (extra)
+    double alpha[MAX_SC_CNT];   //!< [1/m] inverted semi-major axis (extra)
+    double rPeriap[MAX_SC_CNT]; //!< [m] radius of periapsis (extra)
+    double rApoap[MAX_SC_CNT];  //!< [m] radius of apoapsis (extra)
+}ClassicElementsArrayMsgPayload;
+
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef REAL_TIME_STATS_MESSAGE_H
+#define REAL_TIME_STATS_MESSAGE_H
+
+#include <stdint.h>
+#include "architecture/utilities/macroDefinitions.h"
+
+
+/*! @brief Frame timing statistics of the real-time synchronization module.  Bin 0 of the latency histogram counts
+    wake-up latencies below 1 us, bin k counts latencies in [2^(k-1), 2^k) us and the last bin also collects all
+    larger latencies. */
+typedef struct {
+    uint64_t frameCount;                        //!< [-] Number of frames since the module was reset
+    uint64_t deadlineMissCount;                 //!< [-] Number of frames that started later than their deadline plus the tolerance
+    int64_t lastLatency;                        //!< [ns] Latency of the last frame start with respect to its deadline
+    int64_t maxLatency;                         //!< [ns] Largest frame start latency since reset
+    double meanLatency;                         //!< [ns] Mean frame start latency since reset
+    double frameLoad;                           //!< [-] Fraction of the last frame used by the simulation before the module was called
+    uint64_t latencyHistogram[MAX_RT_LATENCY_BINS]; //!< [-] Histogram of the frame start latencies
+    uint64_t allocationCount;                   //!< [-] Heap allocations on the scheduler thread since the end of the first frame
+    int32_t memoryLocked;                       //!< [-] 1 if the process memory is locked, 0 otherwise
+    int32_t fifoScheduling;                     //!< [-] 1 if the scheduler thread runs with SCHED_FIFO, 0 otherwise
+}RealTimeStatsMsgPayload;
+
+
+#endif
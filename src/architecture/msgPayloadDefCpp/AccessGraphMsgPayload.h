@@ -0,0 +1,40 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef ACCESS_GRAPH_MESSAGE_H
+#define ACCESS_GRAPH_MESSAGE_H
+
+#include <vector>
+
+
+/*! @brief Structure used to define the line-of-sight access graph of a spacecraft constellation as a list of edges */
+typedef struct
+//@cond DOXYGEN_IGNORE
+AccessGraphMsgPayload
+//@endcond
+{
+    int numSpacecraft;                  //!< [-] number of spacecraft in the graph
+    int numEdges;                       //!< [-] number of spacecraft pairs with access
+    std::vector<int> edgeSource;        //!< [-] index of the first spacecraft of each edge, lower than edgeTarget
+    std::vector<int> edgeTarget;        //!< [-] index of the second spacecraft of each edge
+    std::vector<double> slantRange;     //!< [m] range between the spacecraft of each edge
+}AccessGraphMsgPayload;
+
+
+#endif
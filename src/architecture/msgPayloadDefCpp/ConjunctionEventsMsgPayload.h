@@ -0,0 +1,41 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef CONJUNCTION_EVENTS_MESSAGE_H
+#define CONJUNCTION_EVENTS_MESSAGE_H
+
+#include <vector>
+
+
+/*! @brief Structure used to define the close approaches of a set of objects found in one screening update */
+typedef struct
+//@cond DOXYGEN_IGNORE
+ConjunctionEventsMsgPayload
+//@endcond
+{
+    int numEvents;                              //!< [-] number of close approaches
+    std::vector<int> objectA;                   //!< [-] index of the first object of each close approach, lower than objectB
+    std::vector<int> objectB;                   //!< [-] index of the second object of each close approach
+    std::vector<double> timeOfClosestApproach;  //!< [s] simulation time of each closest approach
+    std::vector<double> missDistance;           //!< [m] distance of the objects at the closest approach
+    std::vector<double> relativeSpeed;          //!< [m/s] relative speed of the objects at the closest approach
+}ConjunctionEventsMsgPayload;
+
+
+#endif
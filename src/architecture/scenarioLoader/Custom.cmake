@@ -0,0 +1,2 @@
+# C modules are wrapped in an AlgContain by the loader
+target_sources(${TARGET_NAME} PRIVATE "${CMAKE_SOURCE_DIR}/architecture/alg_contain/alg_contain.cpp")
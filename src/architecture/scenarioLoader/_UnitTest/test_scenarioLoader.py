@@ -0,0 +1,114 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+
+import json
+
+import numpy as np
+import pytest
+from Basilisk.moduleTemplates import cModuleTemplate
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+description = {
+    "processes": [{"name": "process", "priority": 10, "tasks": [
+        {"name": "envTask", "period": 1000000000, "priority": 20, "modules": [
+            {"name": "env", "type": "cppModuleTemplate.CppModuleTemplate", "priority": 10,
+             "parameters": {"dumVector": [1.0, 2.0, 3.0], "RNGSeed": 12}}]},
+        {"name": "fswTask", "period": 2000000000, "priority": 10, "modules": [
+            {"name": "fsw", "type": "cModuleTemplate.cModuleTemplateConfig",
+             "parameters": {"dumVector": [[4.0], [5.0], [6.0]]}},
+            {"name": "sink", "priority": 5}]}]}],
+    "links": {"fsw.dataInMsg": "env.dataOutMsg", "sink.dataInMsg": "fsw.dataOutMsg"}
+}
+
+
+def runSim(scSim, sink):
+    log = sink.dataOutMsg.recorder()
+    proc = scSim.CreateNewProcess("logProcess", 0)
+    proc.addTask(scSim.CreateNewTask("logTask", macros.sec2nano(1.0)))
+    scSim.AddModelToTask("logTask", log)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(6.0))
+    scSim.ExecuteSimulation()
+    return np.array(log.dataVector)
+
+
+def test_scenarioLoader(tmp_path):
+    """A loaded scenario reproduces the outputs of the same scenario built in python"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process", 10)
+    proc.addTask(scSim.CreateNewTask("envTask", macros.sec2nano(1.0)), 20)
+    proc.addTask(scSim.CreateNewTask("fswTask", macros.sec2nano(2.0)), 10)
+    env = cppModuleTemplate.CppModuleTemplate()
+    env.ModelTag = "env"
+    env.dumVector = [1.0, 2.0, 3.0]
+    scSim.AddModelToTask("envTask", env, None, 10)
+    fswConfig = cModuleTemplate.cModuleTemplateConfig()
+    fswConfig.dumVector = [4.0, 5.0, 6.0]
+    fswWrap = scSim.setModelDataWrap(fswConfig)
+    fswWrap.ModelTag = "fsw"
+    scSim.AddModelToTask("fswTask", fswWrap, fswConfig)
+    sink = cppModuleTemplate.CppModuleTemplate()
+    sink.ModelTag = "sink"
+    scSim.AddModelToTask("fswTask", sink, None, 5)
+    fswConfig.dataInMsg.subscribeTo(env.dataOutMsg)
+    sink.dataInMsg.subscribeTo(fswConfig.dataOutMsg)
+    expected = runSim(scSim, sink)
+
+    fileName = str(tmp_path / "scenario.json")
+    with open(fileName, "w") as fid:
+        json.dump(description, fid)
+    for source in (description, fileName):
+        loadedSim = SimulationBaseClass.SimBaseClass()
+        loadedSink = cppModuleTemplate.CppModuleTemplate()
+        loader = loadedSim.LoadScenario(source, {"sink": loadedSink})
+        assert sorted(loader.getModelNames()) == ["env", "fsw", "sink"]
+        assert loader.getModel("env").RNGSeed == 12
+        np.testing.assert_array_equal(runSim(loadedSim, loadedSink), expected)
+
+
+@pytest.mark.parametrize("change, error", [
+    ({"type": "cppModuleTemplate.NoSuchModule"}, "not registered"),
+    ({"parameters": {"noSuchVariable": 1.0}}, "not a variable"),
+    ({"parameters": {"dumVector": [1.0, 2.0]}}, "does not fit"),
+])
+def test_invalidModules(change, error):
+    """Unknown module types, unknown variables and values of the wrong size are reported"""
+    invalid = json.loads(json.dumps(description))
+    invalid["processes"][0]["tasks"][0]["modules"][0].update(change)
+    with pytest.raises(ValueError, match=error):
+        SimulationBaseClass.SimBaseClass().LoadScenario(invalid, {"sink": cppModuleTemplate.CppModuleTemplate()})
+
+
+def test_invalidLinks():
+    """Links to unknown messages or between different payload types are reported"""
+    invalid = json.loads(json.dumps(description))
+    invalid["links"] = {"fsw.dataInMsg": "env.noSuchMsg"}
+    with pytest.raises(ValueError, match="not an output message"):
+        SimulationBaseClass.SimBaseClass().LoadScenario(invalid, {"sink": cppModuleTemplate.CppModuleTemplate()})
+    invalid["links"] = {"sink.dataInMsg": "fsw.dataInMsg"}
+    with pytest.raises(ValueError, match="not an output message"):
+        SimulationBaseClass.SimBaseClass().LoadScenario(invalid, {"sink": cppModuleTemplate.CppModuleTemplate()})
+
+
+if __name__ == "__main__":
+    import pathlib
+    import tempfile
+    test_scenarioLoader(pathlib.Path(tempfile.mkdtemp()))
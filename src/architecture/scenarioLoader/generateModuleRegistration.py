@@ -0,0 +1,373 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+"""
+Generates the module registration source of a module library from its SWIG interface file.  The registration adds
+a factory, setters of the module variables and the messages of each module type to the ``ModuleRegistry`` when the
+library is loaded, so that the ``ScenarioLoader`` can build the module from a scenario description.
+
+The module headers included by the interface file are scanned for
+
+- C++ classes deriving from ``SysModel`` that have a public default constructor
+- C modules, i.e. a configuration structure with ``SelfInit_``, ``Update_`` and ``Reset_`` functions
+
+Public variables of a number, boolean, string, fixed size array or Eigen vector and matrix type become settable,
+``Message<>``, ``ReadFunctor<>`` and ``*Msg_C`` members become linkable messages.  Members of any other type are left
+out.
+
+Usage: ``python3 generateModuleRegistration.py <module>.i <output>.cpp``
+"""
+import os
+import re
+import sys
+
+numericTypes = {'double', 'float', 'int', 'unsigned int', 'unsigned', 'long', 'unsigned long', 'long long',
+                'unsigned long long', 'short', 'unsigned short', 'char', 'bool', 'size_t',
+                'int8_t', 'uint8_t', 'int16_t', 'uint16_t', 'int32_t', 'uint32_t', 'int64_t', 'uint64_t'}
+reservedNames = {'ModelTag', 'RNGSeed', 'moduleID', 'bskLogger'}
+fieldPattern = re.compile(r'^(?P<type>(?:unsigned\s+|signed\s+|long\s+)*[\w:]+(?:\s*<[^;]*>)?)\s+(?P<name>\w+)'
+                          r'\s*(?P<dims>(?:\[[^\]]+\]\s*)*)$')
+eigenPattern = re.compile(r'^Eigen::(?:(?:Vector|RowVector|Matrix)(?:\d|X)[dfi]|Matrix\s*<.*>)$')
+
+
+def stripSource(text):
+    """Removes the comments and preprocessor lines of a header"""
+    text = re.sub(r'/\*.*?\*/', ' ', text, flags=re.S)
+    text = re.sub(r'//[^\n]*', ' ', text)
+    text = re.sub(r'^\s*#[^\n]*(?:\\\n[^\n]*)*', ' ', text, flags=re.M)
+    return text.replace('EIGEN_MAKE_ALIGNED_OPERATOR_NEW', ' ')
+
+
+def matchingBrace(text, start):
+    """Returns the index of the brace closing the one at ``start``"""
+    depth = 0
+    for i in range(start, len(text)):
+        if text[i] == '{':
+            depth += 1
+        elif text[i] == '}':
+            depth -= 1
+            if depth == 0:
+                return i
+    return len(text)
+
+
+def topLevelStatements(body):
+    """Splits a class or structure body into statements, the bodies of inline methods and nested types end a
+    statement.  Access specifiers are kept as separate statements."""
+    flat = []
+    i = 0
+    while i < len(body):
+        if body[i] == '{':
+            i = matchingBrace(body, i) + 1
+            flat.append(';')
+        else:
+            flat.append(body[i])
+            i += 1
+    flat = re.sub(r'\b(public|private|protected)\s*:', r';\1:;', ''.join(flat))
+    return [' '.join(s.split()) for s in flat.split(';') if s.strip()]
+
+
+def parseField(statement):
+    """Returns (kind, type, name, payload) of a member declaration, or None if it cannot be set or linked"""
+    if re.search(r'[()*&]|\b(?:static|const|constexpr|typedef|using|friend|enum|struct|class|virtual|mutable)\b',
+                 statement):
+        return None
+    statement = statement.split('=')[0].strip()
+    match = fieldPattern.match(statement)
+    if match is None or match.group('name') in reservedNames:
+        return None
+    fieldType = ' '.join(match.group('type').split())
+    name = match.group('name')
+    dims = match.group('dims').strip()
+    message = re.match(r'^(Message|ReadFunctor)\s*<\s*(\w+)\s*>$', fieldType)
+    if message is not None:
+        return None if dims else (message.group(1), fieldType, name, message.group(2))
+    cMessage = re.match(r'^(\w+Msg)_C$', fieldType)
+    if cMessage is not None:
+        return None if dims else ('Msg_C', fieldType, name, cMessage.group(1) + 'Payload')
+    if fieldType in numericTypes or (fieldType == 'std::string' and not dims):
+        return ('field', fieldType, name, None)
+    if eigenPattern.match(fieldType) and not dims:
+        return ('field', fieldType, name, None)
+    return None
+
+
+def hasDefaultConstructor(className, statements):
+    """Returns True if a class declares no constructor or a public one that takes no arguments"""
+    access = 'private'
+    declared = False
+    for statement in statements:
+        label = re.match(r'^(public|private|protected):$', statement)
+        if label is not None:
+            access = label.group(1)
+            continue
+        ctor = re.match(r'^(?:explicit\s+)?' + className + r'\s*\((.*)\)(?:\s*:.*)?$', statement)
+        if ctor is None:
+            continue
+        declared = True
+        arguments = [a for a in ctor.group(1).split(',') if a.strip() and a.strip() != 'void']
+        if access == 'public' and all('=' in a for a in arguments):
+            return True
+    return not declared
+
+
+srcDir = os.path.abspath(os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..'))
+
+
+def findClass(className, headerPath, visited):
+    """Returns the header defining a class, its stripped text and the match of the class definition, searching the
+    headers included by ``headerPath``"""
+    headerPath = os.path.abspath(headerPath)
+    if headerPath in visited or not os.path.isfile(headerPath):
+        return None, None, None
+    visited.add(headerPath)
+    with open(headerPath, 'r') as fid:
+        raw = fid.read()
+    text = stripSource(raw)
+    match = re.search(r'\bclass\s+(' + className + r')\s*(?:final\s*)?(?::([^{;]*))?\{', text)
+    if match is not None:
+        return headerPath, text, match
+    for include in re.findall(r'^\s*#\s*include\s+"([^"]+)"', raw, flags=re.M):
+        for base in (os.path.dirname(headerPath), srcDir, os.path.join(srcDir, 'architecture', '_GeneralModuleFiles')):
+            found = findClass(className, os.path.join(base, include), visited)
+            if found[2] is not None:
+                return found
+    return None, None, None
+
+
+def describeClass(text, match, headerPath, depth=0, nested=True):
+    """Returns whether a class derives from SysModel, its public variables and messages including the inherited
+    ones, and the names of the pure virtual methods it leaves unimplemented.  The variables of public member
+    objects, such as the hub of a spacecraft, are named ``member.variable``."""
+    start = match.end() - 1
+    statements = topLevelStatements(text[start + 1:matchingBrace(text, start)])
+    access = 'private'
+    fields = []
+    methods = set()
+    pure = set()
+    for statement in statements:
+        label = re.match(r'^(public|private|protected):$', statement)
+        if label is not None:
+            access = label.group(1)
+            continue
+        method = re.search(r'(~?\w+)\s*\(', statement)
+        if method is not None:
+            if re.search(r'\)\s*(?:const\s*)?=\s*0$', statement):
+                pure.add(method.group(1))
+            else:
+                methods.add(method.group(1))
+        elif access == 'public':
+            field = parseField(statement)
+            member = re.match(r'^(\w+) (\w+)$', statement)
+            if field is not None:
+                fields.append(field)
+            elif member is not None and nested:
+                memberHeader, memberText, memberClass = findClass(member.group(1), headerPath, set())
+                if memberClass is not None:
+                    memberFields = describeClass(memberText, memberClass, memberHeader, depth + 1, False)[1]
+                    fields += [(kind, fieldType, member.group(2) + '.' + name, payload)
+                               for kind, fieldType, name, payload in memberFields if kind == 'field']
+
+    isSysModel = False
+    baseList = match.group(2) or ''
+    for baseMatch in re.finditer(r'\bpublic\s+(?:virtual\s+)?([\w:]+)', baseList):
+        baseName = baseMatch.group(1)
+        if baseName == 'SysModel':
+            isSysModel = True
+            continue
+        baseHeader, baseText, base = findClass(baseName, headerPath, set())
+        if base is None or depth > 8:
+            continue
+        baseIsSysModel, baseFields, basePure = describeClass(baseText, base, baseHeader, depth + 1, nested)
+        isSysModel = isSysModel or baseIsSysModel
+        names = set(f[2] for f in fields)
+        fields += [f for f in baseFields if f[2] not in names]
+        pure |= basePure - methods
+    return isSysModel, fields, pure
+
+
+def parseCppModules(text, headerPath):
+    """Returns (className, fields) of the concrete classes deriving from SysModel that can be default constructed"""
+    modules = []
+    for match in re.finditer(r'\bclass\s+(\w+)\s*(?:final\s*)?:([^{;]*)\{', text):
+        isSysModel, fields, pure = describeClass(text, match, headerPath)
+        if not isSysModel or pure:
+            continue
+        start = match.end() - 1
+        statements = topLevelStatements(text[start + 1:matchingBrace(text, start)])
+        if not hasDefaultConstructor(match.group(1), statements):
+            continue
+        modules.append((match.group(1), fields))
+    return modules
+
+
+def parseCModules(text):
+    """Returns (moduleName, configName, fields, hasLogger, hasReset) of the C modules"""
+    modules = []
+    for match in re.finditer(r'\bvoid\s+SelfInit_(\w+)\s*\(\s*(\w+)\s*\*', text):
+        algName, configName = match.group(1), match.group(2)
+        if not re.search(r'\bvoid\s+Update_' + algName + r'\s*\(\s*' + configName + r'\s*\*', text):
+            continue
+        hasReset = re.search(r'\bvoid\s+Reset_' + algName + r'\s*\(\s*' + configName + r'\s*\*', text) is not None
+        struct = re.search(r'typedef\s+struct\s*\w*\s*\{', text)
+        while struct is not None:
+            end = matchingBrace(text, struct.end() - 1)
+            if re.match(r'\s*' + configName + r'\s*;', text[end + 1:]):
+                break
+            struct = re.compile(r'typedef\s+struct\s*\w*\s*\{').search(text, end)
+        if struct is None:
+            continue
+        statements = topLevelStatements(text[struct.end():end])
+        fields = [f for f in (parseField(s) for s in statements) if f is not None]
+        hasLogger = any(re.match(r'^BSKLogger\s*\*\s*bskLogger$', s) for s in statements)
+        modules.append((algName, configName, fields, hasLogger, hasReset))
+    return modules
+
+
+def messageEntries(cast, fields):
+    """Returns the registration lines of the messages of a module"""
+    lines = []
+    for kind, fieldType, name, payload in fields:
+        member = cast + '->' + name
+        if kind == 'Message':
+            lines += ['    {',
+                      '        RegisteredMessage msg;',
+                      '        msg.payloadType = "%s";' % payload,
+                      '        msg.address = [](void *data) -> void* {return &%s;};' % member,
+                      '        module.outputs["%s"] = msg;' % name,
+                      '    }']
+        elif kind == 'ReadFunctor':
+            lines += ['    {',
+                      '        RegisteredMessage msg;',
+                      '        msg.payloadType = "%s";' % payload,
+                      '        msg.subscribe = [](void *data, void *source, bool sourceIsC) {',
+                      '            if (sourceIsC) {',
+                      '                %s.subscribeToC(source);' % member,
+                      '            } else {',
+                      '                %s.subscribeTo(static_cast<Message<%s>*>(source));' % (member, payload),
+                      '            }',
+                      '        };',
+                      '        module.inputs["%s"] = msg;' % name,
+                      '    }']
+        elif kind == 'Msg_C':
+            # C wrapped messages can be read and written, the name tells the direction where it is given
+            msgType = fieldType[:-2]
+            lines += ['    {',
+                      '        RegisteredMessage msg;',
+                      '        msg.payloadType = "%s";' % payload,
+                      '        msg.isC = true;',
+                      '        msg.address = [](void *data) -> void* {return &%s;};' % member,
+                      '        msg.subscribe = [](void *data, void *source, bool sourceIsC) {',
+                      '            if (sourceIsC) {',
+                      '                %s_C_subscribe(&%s, static_cast<%s*>(source));' % (msgType, member, fieldType),
+                      '            } else {',
+                      '                %s_cpp_subscribe(&%s, source);' % (msgType, member),
+                      '            }',
+                      '        };']
+            if 'InMsg' not in name:
+                lines.append('        module.outputs["%s"] = msg;' % name)
+            if 'OutMsg' not in name:
+                lines.append('        module.inputs["%s"] = msg;' % name)
+            lines.append('    }')
+    return lines
+
+
+def fieldEntries(cast, fields):
+    """Returns the registration lines of the variables of a module"""
+    lines = []
+    for kind, fieldType, name, payload in fields:
+        if kind == 'field':
+            lines.append('    module.fields["%s"] = [](void *data, const RegistryValue &value) '
+                         '{return assignField(%s->%s, value);};' % (name, cast, name))
+    return lines
+
+
+def generate(interfaceFile):
+    """Returns the registration source of the modules of a SWIG interface file"""
+    interfaceDir = os.path.dirname(os.path.abspath(interfaceFile))
+    with open(interfaceFile, 'r') as fid:
+        interface = fid.read()
+    library = re.search(r'%module\s*(?:\([^)]*\))?\s*(\w+)', interface).group(1)
+    headers = []
+    for header in re.findall(r'%include\s+"([^"]+\.h)"', interface):
+        if os.path.isfile(os.path.join(interfaceDir, header)) and header not in headers:
+            headers.append(header)
+
+    functions = []
+    for header in headers:
+        with open(os.path.join(interfaceDir, header), 'r') as fid:
+            text = stripSource(fid.read())
+        for className, fields in parseCppModules(text, os.path.join(interfaceDir, header)):
+            cast = 'static_cast<%s*>(data)' % className
+            lines = ['RegisteredModule register%s()' % className,
+                     '{',
+                     '    RegisteredModule module;',
+                     '    module.typeName = "%s.%s";' % (library, className),
+                     '    module.createModel = []() -> SysModel* {return new %s();};' % className,
+                     '    module.variables = [](SysModel *model) -> void* {return static_cast<%s*>(model);};'
+                     % className,
+                     '    module.destroyModel = [](SysModel *model) {delete static_cast<%s*>(model);};' % className]
+            lines += fieldEntries(cast, fields) + messageEntries(cast, fields)
+            functions.append((className, lines + ['    return module;', '}']))
+        for algName, configName, fields, hasLogger, hasReset in parseCModules(text):
+            cast = 'static_cast<%s*>(data)' % configName
+            lines = ['RegisteredModule register%s()' % configName,
+                     '{',
+                     '    RegisteredModule module;',
+                     '    module.typeName = "%s.%s";' % (library, configName),
+                     '    module.createConfig = []() -> void* {return calloc(1, sizeof(%s));};' % configName,
+                     '    module.destroyConfig = [](void *data) {free(data);};',
+                     '    module.selfInit = reinterpret_cast<void (*)(void*, uint64_t)>(&SelfInit_%s);' % algName,
+                     '    module.update = reinterpret_cast<void (*)(void*, uint64_t, uint64_t)>(&Update_%s);'
+                     % algName]
+            if hasReset:
+                lines.append('    module.reset = reinterpret_cast<void (*)(void*, uint64_t, uint64_t)>(&Reset_%s);'
+                             % algName)
+            if hasLogger:
+                lines.append('    module.setLogger = [](void *data, BSKLogger *logger) {%s->bskLogger = logger;};'
+                             % cast)
+            lines += fieldEntries(cast, fields) + messageEntries(cast, fields)
+            functions.append((configName, lines + ['    return module;', '}']))
+
+    source = ['/* Module registration of %s.i, generated by generateModuleRegistration.py */' % library,
+              '#include <cstdlib>']
+    source += ['#include "%s"' % header for header in headers]
+    source += ['#include "architecture/utilities/moduleIdGenerator/moduleRegistry.h"',
+               '#include "architecture/scenarioLoader/registryFields.h"',
+               '',
+               'namespace {',
+               '']
+    for typeName, lines in functions:
+        source += lines + ['', 'ModuleRegistration %sRegistration(register%s());' % (typeName, typeName), '']
+    source.append('}')
+    return '\n'.join(source) + '\n'
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        print("usage: generateModuleRegistration.py <module>.i <output>.cpp")
+        sys.exit(1)
+    registration = generate(sys.argv[1])
+    outputDir = os.path.dirname(os.path.abspath(sys.argv[2]))
+    os.makedirs(outputDir, exist_ok=True)
+    # only rewrite changed sources so that the module libraries are not rebuilt
+    if os.path.isfile(sys.argv[2]):
+        with open(sys.argv[2], 'r') as fid:
+            if fid.read() == registration:
+                sys.exit(0)
+    with open(sys.argv[2], 'w') as fid:
+        fid.write(registration)
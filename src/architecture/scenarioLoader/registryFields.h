@@ -0,0 +1,121 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef REGISTRY_FIELDS_H
+#define REGISTRY_FIELDS_H
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <Eigen/Dense>
+#include "architecture/utilities/moduleIdGenerator/moduleRegistry.h"
+
+/*! @brief Assignment of scenario description values to module variables, used by the generated module registration
+ code.  Each function returns false if the value does not fit the variable, which is then left unchanged. */
+
+/*! assigns a number to a numeric or boolean variable */
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value, bool>::type
+assignField(T &field, const RegistryValue &value)
+{
+    if (value.isText || value.numbers.size() != 1) {
+        return false;
+    }
+    field = static_cast<T>(value.numbers[0]);
+    return true;
+}
+
+/*! assigns a string */
+inline bool assignField(std::string &field, const RegistryValue &value)
+{
+    if (!value.isText) {
+        return false;
+    }
+    field = value.text;
+    return true;
+}
+
+/*! assigns a string to a character array, the string must leave room for the terminating zero */
+template <size_t N>
+bool assignField(char (&field)[N], const RegistryValue &value)
+{
+    if (!value.isText || value.text.size() >= N) {
+        return false;
+    }
+    memset(field, 0, N);
+    memcpy(field, value.text.c_str(), value.text.size());
+    return true;
+}
+
+/*! assigns a list, or a nested list row by row, to a fixed size array of one or more dimensions */
+template <typename T, size_t N>
+bool assignField(T (&field)[N], const RegistryValue &value)
+{
+    typedef typename std::remove_all_extents<T>::type Scalar;
+    static_assert(std::is_arithmetic<Scalar>::value, "only arrays of numbers can be assigned");
+    const size_t count = sizeof(field) / sizeof(Scalar);
+    if (value.isText || value.numbers.size() != count) {
+        return false;
+    }
+    Scalar *elements = reinterpret_cast<Scalar*>(&field);
+    for (size_t i = 0; i < count; i++) {
+        elements[i] = static_cast<Scalar>(value.numbers[i]);
+    }
+    return true;
+}
+
+/*! assigns a list to an Eigen vector, or a nested list row by row to an Eigen matrix.  Dynamic sizes are taken from
+ the value. */
+template <typename Scalar, int Rows, int Cols, int Options, int MaxRows, int MaxCols>
+bool assignField(Eigen::Matrix<Scalar, Rows, Cols, Options, MaxRows, MaxCols> &field, const RegistryValue &value)
+{
+    if (value.isText) {
+        return false;
+    }
+    size_t size = value.numbers.size();
+    size_t rows;
+    size_t cols;
+    if (Cols == 1) {
+        rows = size;
+        cols = 1;
+    } else if (Rows == 1) {
+        rows = 1;
+        cols = size;
+    } else if (Rows != Eigen::Dynamic) {
+        rows = Rows;
+        cols = size / rows;
+    } else {
+        rows = size > 0 ? value.rows : 0;
+        cols = rows > 0 ? size / rows : 0;
+    }
+    if (rows * cols != size
+        || (Rows != Eigen::Dynamic && (size_t) Rows != rows)
+        || (Cols != Eigen::Dynamic && (size_t) Cols != cols)) {
+        return false;
+    }
+    field.resize(rows, cols);
+    for (size_t r = 0; r < rows; r++) {
+        for (size_t c = 0; c < cols; c++) {
+            field(r, c) = static_cast<Scalar>(value.numbers[r * cols + c]);
+        }
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,256 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+#include "scenarioJson.h"
+#include <cstdlib>
+#include <cstring>
+
+/*! Recursive descent parser of a JSON document, tracks the line for the error messages */
+class JsonParser {
+public:
+    JsonParser(const std::string &document) : text(document), pos(0), line(1) {}
+
+    bool parseDocument(JsonValue &value, std::string &error)
+    {
+        bool ok = this->parseValue(value, 0) && (this->skipSpace(), this->pos == this->text.size());
+        if (ok) {
+            return true;
+        }
+        if (this->message.empty()) {
+            this->message = "unexpected content";
+        }
+        error = "line " + std::to_string(this->line) + ": " + this->message;
+        return false;
+    }
+
+private:
+    bool fail(const std::string &what)
+    {
+        if (this->message.empty()) {
+            this->message = what;
+        }
+        return false;
+    }
+
+    void skipSpace()
+    {
+        while (this->pos < this->text.size()) {
+            char c = this->text[this->pos];
+            if (c == '\n') {
+                this->line++;
+            } else if (c != ' ' && c != '\t' && c != '\r') {
+                return;
+            }
+            this->pos++;
+        }
+    }
+
+    bool consume(const char *word)
+    {
+        size_t n = strlen(word);
+        if (this->text.compare(this->pos, n, word) != 0) {
+            return false;
+        }
+        this->pos += n;
+        return true;
+    }
+
+    bool parseValue(JsonValue &value, int depth)
+    {
+        if (depth > 64) {
+            return this->fail("nesting too deep");
+        }
+        this->skipSpace();
+        if (this->pos >= this->text.size()) {
+            return this->fail("unexpected end of document");
+        }
+        char c = this->text[this->pos];
+        if (c == '{') {
+            return this->parseObject(value, depth);
+        } else if (c == '[') {
+            return this->parseArray(value, depth);
+        } else if (c == '"') {
+            value.type = JsonValue::JSON_STRING;
+            return this->parseString(value.text);
+        } else if (this->consume("true")) {
+            value.type = JsonValue::JSON_BOOL;
+            value.boolean = true;
+            return true;
+        } else if (this->consume("false")) {
+            value.type = JsonValue::JSON_BOOL;
+            return true;
+        } else if (this->consume("null")) {
+            value.type = JsonValue::JSON_NULL;
+            return true;
+        }
+        return this->parseNumber(value);
+    }
+
+    bool parseNumber(JsonValue &value)
+    {
+        const char *start = this->text.c_str() + this->pos;
+        char *end;
+        value.number = strtod(start, &end);
+        if (end == start || !(*start == '-' || (*start >= '0' && *start <= '9'))) {
+            return this->fail("invalid value");
+        }
+        value.type = JsonValue::JSON_NUMBER;
+        this->pos += end - start;
+        return true;
+    }
+
+    bool parseString(std::string &out)
+    {
+        this->pos++;
+        while (this->pos < this->text.size()) {
+            char c = this->text[this->pos++];
+            if (c == '"') {
+                return true;
+            } else if (c == '\n') {
+                return this->fail("unterminated string");
+            } else if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (this->pos >= this->text.size()) {
+                break;
+            }
+            char e = this->text[this->pos++];
+            switch (e) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/': out += '/'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case 'u': {
+                    if (this->pos + 4 > this->text.size()) {
+                        return this->fail("invalid escape sequence");
+                    }
+                    unsigned long code = strtoul(this->text.substr(this->pos, 4).c_str(), NULL, 16);
+                    this->pos += 4;
+                    // encode the basic multilingual plane as UTF-8
+                    if (code < 0x80) {
+                        out += (char) code;
+                    } else if (code < 0x800) {
+                        out += (char) (0xC0 | (code >> 6));
+                        out += (char) (0x80 | (code & 0x3F));
+                    } else {
+                        out += (char) (0xE0 | (code >> 12));
+                        out += (char) (0x80 | ((code >> 6) & 0x3F));
+                        out += (char) (0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                default:
+                    return this->fail("invalid escape sequence");
+            }
+        }
+        return this->fail("unterminated string");
+    }
+
+    bool parseArray(JsonValue &value, int depth)
+    {
+        value.type = JsonValue::JSON_ARRAY;
+        this->pos++;
+        this->skipSpace();
+        if (this->consume("]")) {
+            return true;
+        }
+        while (true) {
+            value.items.push_back(JsonValue());
+            if (!this->parseValue(value.items.back(), depth + 1)) {
+                return false;
+            }
+            this->skipSpace();
+            if (this->consume("]")) {
+                return true;
+            } else if (!this->consume(",")) {
+                return this->fail("expected ',' or ']'");
+            }
+        }
+    }
+
+    bool parseObject(JsonValue &value, int depth)
+    {
+        value.type = JsonValue::JSON_OBJECT;
+        this->pos++;
+        this->skipSpace();
+        if (this->consume("}")) {
+            return true;
+        }
+        while (true) {
+            this->skipSpace();
+            if (this->pos >= this->text.size() || this->text[this->pos] != '"') {
+                return this->fail("expected a member name");
+            }
+            std::string key;
+            if (!this->parseString(key)) {
+                return false;
+            }
+            this->skipSpace();
+            if (!this->consume(":")) {
+                return this->fail("expected ':'");
+            }
+            value.members.push_back(std::make_pair(key, JsonValue()));
+            if (!this->parseValue(value.members.back().second, depth + 1)) {
+                return false;
+            }
+            this->skipSpace();
+            if (this->consume("}")) {
+                return true;
+            } else if (!this->consume(",")) {
+                return this->fail("expected ',' or '}'");
+            }
+        }
+    }
+
+    const std::string &text;    //!< document being parsed
+    size_t pos;                 //!< current character
+    int line;                   //!< current line
+    std::string message;        //!< first error found
+};
+
+/*! This method returns a member of an object.
+ @param key member name
+ @return const JsonValue* the first member with this name, NULL if there is none or the value is not an object
+ */
+const JsonValue* JsonValue::find(const std::string &key) const
+{
+    for (size_t i = 0; i < this->members.size(); i++) {
+        if (this->members[i].first == key) {
+            return &this->members[i].second;
+        }
+    }
+    return NULL;
+}
+
+/*! This function parses a JSON document.
+ @param document text of the document
+ @param value parsed document
+ @param error line and description of the first syntax error
+ @return bool true if the document is valid
+ */
+bool parseJson(const std::string &document, JsonValue &value, std::string &error)
+{
+    value = JsonValue();
+    JsonParser parser(document);
+    return parser.parseDocument(value, error);
+}
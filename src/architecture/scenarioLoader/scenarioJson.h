@@ -0,0 +1,44 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef SCENARIO_JSON_H
+#define SCENARIO_JSON_H
+
+#include <string>
+#include <utility>
+#include <vector>
+
+/*! @brief value of a JSON document, objects keep the order of their members */
+class JsonValue {
+public:
+    enum JsonType {JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT};
+
+    const JsonValue* find(const std::string &key) const;  //!< returns the object member or NULL
+
+    JsonType type = JSON_NULL;                                  //!< -- type of the value
+    bool boolean = false;                                       //!< -- value of a boolean
+    double number = 0.0;                                        //!< -- value of a number
+    std::string text;                                           //!< -- value of a string
+    std::vector<JsonValue> items;                               //!< -- elements of an array
+    std::vector<std::pair<std::string, JsonValue>> members;     //!< -- members of an object in document order
+};
+
+bool parseJson(const std::string &document, JsonValue &value, std::string &error);
+
+#endif
@@ -0,0 +1,455 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+#include "scenarioLoader.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+/*! This function converts a JSON value to the value assigned to a module variable.  Nested lists are flattened
+ row by row, all rows must have the same length.
+ @param json number, boolean, string or (nested) list of numbers
+ @param value converted value
+ @return bool false if the value cannot be assigned to a module variable
+ */
+bool jsonToRegistryValue(const JsonValue &json, RegistryValue &value)
+{
+    value = RegistryValue();
+    switch (json.type) {
+        case JsonValue::JSON_NUMBER:
+            value.numbers.push_back(json.number);
+            return true;
+        case JsonValue::JSON_BOOL:
+            value.numbers.push_back(json.boolean ? 1.0 : 0.0);
+            return true;
+        case JsonValue::JSON_STRING:
+            value.text = json.text;
+            value.isText = true;
+            return true;
+        case JsonValue::JSON_ARRAY: {
+            value.rows = json.items.size();
+            size_t rowSize = 0;
+            for (size_t i = 0; i < json.items.size(); i++) {
+                RegistryValue row;
+                if (!jsonToRegistryValue(json.items[i], row) || row.isText) {
+                    return false;
+                }
+                if (i > 0 && row.numbers.size() != rowSize) {
+                    return false;
+                }
+                rowSize = row.numbers.size();
+                value.numbers.insert(value.numbers.end(), row.numbers.begin(), row.numbers.end());
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/*! The constructor */
+ScenarioLoader::ScenarioLoader()
+{
+    this->descriptionLoaded = false;
+}
+
+/*! The destructor deletes the processes, tasks and modules created by the loader.  The simulation they were built
+ into must not be executed afterwards. */
+ScenarioLoader::~ScenarioLoader()
+{
+    for (std::map<std::string, ScenarioModule>::iterator it = this->modules.begin(); it != this->modules.end(); it++) {
+        ScenarioModule &module = it->second;
+        if (!module.owned) {
+            continue;
+        }
+        if (module.type->createModel) {
+            module.type->destroyModel(module.model);
+        } else {
+            delete module.model;
+            module.type->destroyConfig(module.variables);
+        }
+    }
+    for (size_t i = 0; i < this->tasks.size(); i++) {
+        delete this->tasks[i];
+    }
+    for (size_t i = 0; i < this->processes.size(); i++) {
+        delete this->processes[i];
+    }
+}
+
+/*! This method records an error and logs it.
+ @param message description of the error
+ @return bool false, to be returned by the failing method
+ */
+bool ScenarioLoader::fail(std::string message)
+{
+    this->errorMessage = message;
+    this->bskLogger.bskLog(BSK_ERROR, "ScenarioLoader: %s", message.c_str());
+    return false;
+}
+
+/*! This method reads a scenario description file.
+ @param fileName path of the JSON file
+ @return bool false if the file cannot be read or is not valid JSON
+ */
+bool ScenarioLoader::loadFile(std::string fileName)
+{
+    std::ifstream input(fileName.c_str());
+    if (!input) {
+        return this->fail("cannot open " + fileName);
+    }
+    std::stringstream document;
+    document << input.rdbuf();
+    return this->loadString(document.str());
+}
+
+/*! This method parses a scenario description.  The description can be built into several simulations by
+ several loaders, the text can be cached and shared between worker processes.
+ @param document JSON scenario description
+ @return bool false if the document is not valid JSON
+ */
+bool ScenarioLoader::loadString(std::string document)
+{
+    std::string error;
+    this->descriptionLoaded = parseJson(document, this->description, error);
+    if (!this->descriptionLoaded) {
+        return this->fail("invalid scenario description, " + error);
+    }
+    if (this->description.type != JsonValue::JSON_OBJECT) {
+        this->descriptionLoaded = false;
+        return this->fail("the scenario description must be an object");
+    }
+    return true;
+}
+
+/*! This method adds a module that was created outside of the loader, e.g. in Python, so that the description can
+ link its messages.  The module is not deleted by the loader.
+ @param name name used for the module in the description
+ @param typeName registered type of the module
+ @param model the module
+ @return bool false if the type is not registered, is a C module type or the name is taken
+ */
+bool ScenarioLoader::addModel(std::string name, std::string typeName, SysModel *model)
+{
+    const RegisteredModule *type = ModuleRegistry::GetInstance()->findModule(typeName);
+    if (type == NULL || !type->createModel) {
+        return this->fail("module type " + typeName + " is not a registered C++ module type");
+    }
+    if (this->modules.count(name) > 0) {
+        return this->fail("module name " + name + " is used twice");
+    }
+    ScenarioModule module;
+    module.type = type;
+    module.model = model;
+    module.variables = type->variables(model);
+    module.owned = false;
+    this->modules[name] = module;
+    return true;
+}
+
+/*! This method builds the loaded description into a simulation.  Processes and tasks are created in the order
+ of the description, then the message links are made.
+ @param sim the simulation, e.g. the TotalSim of a SimBaseClass
+ @return bool false if the description references unknown modules, variables or messages
+ */
+bool ScenarioLoader::build(SimModel *sim)
+{
+    if (!this->descriptionLoaded) {
+        return this->fail("no scenario description was loaded");
+    }
+    const JsonValue *procList = this->description.find("processes");
+    if (procList != NULL) {
+        if (procList->type != JsonValue::JSON_ARRAY) {
+            return this->fail("processes must be a list");
+        }
+        for (size_t i = 0; i < procList->items.size(); i++) {
+            if (!this->buildProcess(sim, procList->items[i])) {
+                return false;
+            }
+        }
+    }
+    const JsonValue *links = this->description.find("links");
+    if (links != NULL && !this->linkMessages(*links)) {
+        return false;
+    }
+    return true;
+}
+
+/*! This function orders module descriptions by execution order, higher priority first.
+ @param first description of a module
+ @param second description of another module
+ @return bool true if the first module executes before the second one
+ */
+static bool higherModulePriority(const JsonValue *first, const JsonValue *second)
+{
+    const JsonValue *firstPriority = first->find("priority");
+    const JsonValue *secondPriority = second->find("priority");
+    double firstValue = firstPriority != NULL ? firstPriority->number : -1.0;
+    double secondValue = secondPriority != NULL ? secondPriority->number : -1.0;
+    return firstValue > secondValue;
+}
+
+/*! This method creates a process with its tasks and modules.
+ @param sim simulation to add the process to
+ @param procDesc description of the process
+ @return bool false if the description is invalid
+ */
+bool ScenarioLoader::buildProcess(SimModel *sim, const JsonValue &procDesc)
+{
+    const JsonValue *name = procDesc.find("name");
+    if (name == NULL || name->type != JsonValue::JSON_STRING) {
+        return this->fail("every process needs a name");
+    }
+    SysProcess *proc = new SysProcess(name->text);
+    this->processes.push_back(proc);
+    const JsonValue *priority = procDesc.find("priority");
+    proc->processPriority = priority != NULL ? (int64_t) priority->number : -1;
+    sim->addNewProcess(proc);
+
+    const JsonValue *taskList = procDesc.find("tasks");
+    if (taskList == NULL) {
+        return true;
+    }
+    if (taskList->type != JsonValue::JSON_ARRAY) {
+        return this->fail("the tasks of process " + name->text + " must be a list");
+    }
+    const JsonValue *messageArena = procDesc.find("messageArena");
+    if (messageArena != NULL && messageArena->type == JsonValue::JSON_BOOL && messageArena->boolean) {
+        proc->openMessageArena();
+    }
+    bool built = this->buildTasks(proc, *taskList);
+    proc->closeMessageArena();
+    return built;
+}
+
+/*! This method creates the tasks of a process and their modules.  The modules of a task are created in the order
+ the task executes them, so that their messages are placed in that order in the message arena of the process.
+ @param proc process executing the tasks
+ @param taskList list of task descriptions
+ @return bool false if the description is invalid
+ */
+bool ScenarioLoader::buildTasks(SysProcess *proc, const JsonValue &taskList)
+{
+    const std::string &procName = proc->processName;
+    for (size_t i = 0; i < taskList.items.size(); i++) {
+        const JsonValue &taskDesc = taskList.items[i];
+        const JsonValue *taskName = taskDesc.find("name");
+        const JsonValue *period = taskDesc.find("period");
+        if (taskName == NULL || taskName->type != JsonValue::JSON_STRING
+            || period == NULL || period->type != JsonValue::JSON_NUMBER || period->number <= 0.0) {
+            return this->fail("every task of process " + procName + " needs a name and a positive period [ns]");
+        }
+        const JsonValue *delay = taskDesc.find("delay");
+        const JsonValue *firstStart = taskDesc.find("firstStart");
+        SysModelTask *task = new SysModelTask((uint64_t) period->number,
+                                              delay != NULL ? (uint64_t) delay->number : 0,
+                                              firstStart != NULL ? (uint64_t) firstStart->number : 0);
+        this->tasks.push_back(task);
+        task->TaskName = taskName->text;
+        const JsonValue *taskPriority = taskDesc.find("priority");
+        proc->addNewTask(task, taskPriority != NULL ? (int32_t) taskPriority->number : -1);
+
+        const JsonValue *modelList = taskDesc.find("modules");
+        if (modelList == NULL) {
+            continue;
+        }
+        if (modelList->type != JsonValue::JSON_ARRAY) {
+            return this->fail("the modules of task " + taskName->text + " must be a list");
+        }
+        std::vector<const JsonValue*> modelOrder;
+        for (size_t j = 0; j < modelList->items.size(); j++) {
+            modelOrder.push_back(&modelList->items[j]);
+        }
+        std::stable_sort(modelOrder.begin(), modelOrder.end(), higherModulePriority);
+        for (size_t j = 0; j < modelOrder.size(); j++) {
+            if (!this->buildModule(task, *modelOrder[j])) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/*! This method creates a module and adds it to a task.  A module without a type is a module created earlier,
+ which is added to one more task.
+ @param task task executing the module
+ @param modelDesc description of the module
+ @return bool false if the type is unknown or a parameter cannot be assigned
+ */
+bool ScenarioLoader::buildModule(SysModelTask *task, const JsonValue &modelDesc)
+{
+    const JsonValue *name = modelDesc.find("name");
+    if (name == NULL || name->type != JsonValue::JSON_STRING) {
+        return this->fail("every module of task " + task->TaskName + " needs a name");
+    }
+    const JsonValue *priority = modelDesc.find("priority");
+    int32_t modelPriority = priority != NULL ? (int32_t) priority->number : -1;
+    const JsonValue *typeName = modelDesc.find("type");
+    if (typeName == NULL) {
+        std::map<std::string, ScenarioModule>::iterator it = this->modules.find(name->text);
+        if (it == this->modules.end()) {
+            return this->fail("module " + name->text + " has no type and was not created before");
+        }
+        task->AddNewObject(it->second.model, modelPriority);
+        return true;
+    }
+    if (typeName->type != JsonValue::JSON_STRING) {
+        return this->fail("the type of module " + name->text + " must be a string");
+    }
+    if (this->modules.count(name->text) > 0) {
+        return this->fail("module name " + name->text + " is used twice");
+    }
+    const RegisteredModule *type = ModuleRegistry::GetInstance()->findModule(typeName->text);
+    if (type == NULL) {
+        return this->fail("module type " + typeName->text + " is not registered, its library must be loaded first");
+    }
+
+    ScenarioModule module;
+    module.type = type;
+    module.owned = true;
+    if (type->createModel) {
+        module.model = type->createModel();
+        module.variables = type->variables(module.model);
+    } else {
+        module.variables = type->createConfig();
+        module.model = new AlgContain(module.variables, type->update, type->selfInit, type->reset);
+        if (type->setLogger) {
+            type->setLogger(module.variables, &this->bskLogger);
+        }
+    }
+    module.model->ModelTag = name->text;
+    this->modules[name->text] = module;
+    task->AddNewObject(module.model, modelPriority);
+
+    const JsonValue *parameters = modelDesc.find("parameters");
+    if (parameters != NULL) {
+        return this->setParameters(name->text, this->modules[name->text], *parameters);
+    }
+    return true;
+}
+
+/*! This method assigns the module variables given in the description.
+ @param name name of the module
+ @param module the module
+ @param parameters object of variable names and values
+ @return bool false if a variable is unknown or the value does not fit
+ */
+bool ScenarioLoader::setParameters(const std::string &name, ScenarioModule &module, const JsonValue &parameters)
+{
+    if (parameters.type != JsonValue::JSON_OBJECT) {
+        return this->fail("the parameters of module " + name + " must be an object");
+    }
+    for (size_t i = 0; i < parameters.members.size(); i++) {
+        const std::string &field = parameters.members[i].first;
+        RegistryValue value;
+        if (!jsonToRegistryValue(parameters.members[i].second, value)) {
+            return this->fail("the value of " + name + "." + field + " is not a number, string or list of numbers");
+        }
+        std::map<std::string, std::function<bool (void*, const RegistryValue&)>>::const_iterator setter;
+        setter = module.type->fields.find(field);
+        if (setter != module.type->fields.end()) {
+            if (!setter->second(module.variables, value)) {
+                return this->fail("the value of " + name + "." + field + " does not fit the variable");
+            }
+        } else if (field == "RNGSeed" && !value.isText && value.numbers.size() == 1) {
+            module.model->RNGSeed = (uint32_t) value.numbers[0];
+        } else {
+            return this->fail(name + "." + field + " is not a variable of module type " + module.type->typeName);
+        }
+    }
+    return true;
+}
+
+/*! This method finds the message of a module.
+ @param path module name and message name separated by a dot
+ @param input flag indicating that an input message is looked up
+ @param module found module
+ @param message found message
+ @return bool false if the module or the message does not exist
+ */
+bool ScenarioLoader::findMessage(const std::string &path, bool input, ScenarioModule *&module,
+                                 const RegisteredMessage *&message)
+{
+    size_t dot = path.rfind('.');
+    std::map<std::string, ScenarioModule>::iterator moduleIt = this->modules.find(path.substr(0, dot));
+    if (dot == std::string::npos || moduleIt == this->modules.end()) {
+        return this->fail("no module for message " + path);
+    }
+    module = &moduleIt->second;
+    const std::map<std::string, RegisteredMessage> &messages = input ? module->type->inputs : module->type->outputs;
+    std::map<std::string, RegisteredMessage>::const_iterator messageIt = messages.find(path.substr(dot + 1));
+    if (messageIt == messages.end()) {
+        return this->fail(path + (input ? " is not an input message" : " is not an output message"));
+    }
+    message = &messageIt->second;
+    return true;
+}
+
+/*! This method subscribes the input messages to their sources.
+ @param links object of input messages and the output messages they read, both as moduleName.messageName
+ @return bool false if a message is unknown or the payload types differ
+ */
+bool ScenarioLoader::linkMessages(const JsonValue &links)
+{
+    if (links.type != JsonValue::JSON_OBJECT) {
+        return this->fail("links must be an object of input and output messages");
+    }
+    for (size_t i = 0; i < links.members.size(); i++) {
+        const std::string &inputPath = links.members[i].first;
+        const JsonValue &outputPath = links.members[i].second;
+        if (outputPath.type != JsonValue::JSON_STRING) {
+            return this->fail("the source of " + inputPath + " must be a string");
+        }
+        ScenarioModule *reader;
+        ScenarioModule *writer;
+        const RegisteredMessage *inputMsg;
+        const RegisteredMessage *outputMsg;
+        if (!this->findMessage(inputPath, true, reader, inputMsg)
+            || !this->findMessage(outputPath.text, false, writer, outputMsg)) {
+            return false;
+        }
+        if (inputMsg->payloadType != outputMsg->payloadType) {
+            return this->fail(inputPath + " reads " + inputMsg->payloadType + " but " + outputPath.text
+                              + " writes " + outputMsg->payloadType);
+        }
+        inputMsg->subscribe(reader->variables, outputMsg->address(writer->variables), outputMsg->isC);
+    }
+    return true;
+}
+
+/*! This method returns a module created or added by the loader.
+ @param name name of the module in the description
+ @return SysModel* the module, the AlgContain wrapper for a C module, NULL if there is no such module
+ */
+SysModel* ScenarioLoader::getModel(std::string name)
+{
+    std::map<std::string, ScenarioModule>::iterator it = this->modules.find(name);
+    return it != this->modules.end() ? it->second.model : NULL;
+}
+
+/*! This method lists the modules of the loader.
+ @return std::vector<std::string> the module names in alphabetical order
+ */
+std::vector<std::string> ScenarioLoader::getModelNames()
+{
+    std::vector<std::string> names;
+    for (std::map<std::string, ScenarioModule>::iterator it = this->modules.begin(); it != this->modules.end(); it++) {
+        names.push_back(it->first);
+    }
+    return names;
+}
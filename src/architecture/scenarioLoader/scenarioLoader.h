@@ -0,0 +1,79 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef SCENARIO_LOADER_H
+#define SCENARIO_LOADER_H
+
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+#include "architecture/alg_contain/alg_contain.h"
+#include "architecture/system_model/sim_model.h"
+#include "architecture/utilities/moduleIdGenerator/moduleRegistry.h"
+#include "architecture/utilities/bskLogging.h"
+#include "scenarioJson.h"
+
+/*! @brief module created or adopted by the scenario loader */
+typedef struct {
+    const RegisteredModule *type;       //!< -- registered type of the module
+    SysModel *model;                    //!< -- module added to the tasks, the AlgContain wrapper of a C module
+    void *variables;                    //!< -- object holding the module variables and messages
+    bool owned;                         //!< -- flag indicating that the loader deletes the module
+}ScenarioModule;
+
+/*! @brief builds processes, tasks, modules and message links of a simulation from a JSON scenario description */
+class ScenarioLoader {
+public:
+    ScenarioLoader();
+    ~ScenarioLoader();
+
+    bool loadFile(std::string fileName);
+    bool loadString(std::string document);
+    bool build(SimModel *sim);
+    bool addModel(std::string name, std::string typeName, SysModel *model);
+    SysModel* getModel(std::string name);
+    std::vector<std::string> getModelNames();
+    std::string getErrorMessage() {return this->errorMessage;} //!< returns the description of the last error
+
+public:
+    BSKLogger bskLogger;                //!< -- BSK Logging, also assigned to the C modules
+
+private:
+    bool fail(std::string message);
+    bool buildProcess(SimModel *sim, const JsonValue &procDesc);
+    bool buildTasks(SysProcess *proc, const JsonValue &taskList);
+    bool buildModule(SysModelTask *task, const JsonValue &modelDesc);
+    bool setParameters(const std::string &name, ScenarioModule &module, const JsonValue &parameters);
+    bool linkMessages(const JsonValue &links);
+    bool findMessage(const std::string &path, bool input, ScenarioModule *&module, const RegisteredMessage *&message);
+
+private:
+    JsonValue description;                          //!< -- parsed scenario description
+    bool descriptionLoaded;                         //!< -- flag indicating that a description was loaded
+    std::string errorMessage;                       //!< -- description of the last error
+    std::map<std::string, ScenarioModule> modules;  //!< -- modules by name
+    std::vector<SysProcess*> processes;             //!< -- processes created by the loader
+    std::vector<SysModelTask*> tasks;               //!< -- tasks created by the loader
+};
+
+bool jsonToRegistryValue(const JsonValue &json, RegistryValue &value);
+
+#endif
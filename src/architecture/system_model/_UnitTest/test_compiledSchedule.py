@@ -0,0 +1,72 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+from Basilisk.moduleTemplates import cModuleTemplate
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def test_compiledSchedule():
+    """The compiled dispatch table updates C++ and C modules in priority order, calling the C update directly"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(1.0)))
+
+    first = cppModuleTemplate.CppModuleTemplate()
+    cConfig = cModuleTemplate.cModuleTemplateConfig()
+    cWrap = scSim.setModelDataWrap(cConfig)
+    last = cppModuleTemplate.CppModuleTemplate()
+    # added in reverse order, the priorities set the execution order
+    scSim.AddModelToTask("task", last, None, 10)
+    scSim.AddModelToTask("task", cWrap, cConfig, 20)
+    scSim.AddModelToTask("task", first, None, 30)
+    cConfig.dataInMsg.subscribeTo(first.dataOutMsg)
+    last.dataInMsg.subscribeTo(cConfig.dataOutMsg)
+
+    scSim.InitializeSimulation()
+    task = scSim.TaskList[0].TaskData
+    assert task.scheduleCompiled()
+    scSim.ConfigureStopTime(macros.sec2nano(3.0))
+    scSim.ExecuteSimulation()
+
+    # each module adds its update count, so the chain only sums to 3 * 4 if it ran in priority order
+    assert last.dataOutMsg.read().dataVector[0] == 12.0
+    assert last.dataInMsg.moduleID() == cWrap.moduleID
+    assert [first.CallCounts, cWrap.CallCounts, last.CallCounts] == [4, 4, 4]
+
+    # a module added after the initialization is executed from the next step on
+    extra = cppModuleTemplate.CppModuleTemplate()
+    extra.dataInMsg.subscribeTo(last.dataOutMsg)
+    scSim.AddModelToTask("task", extra, None, 5)
+    assert not task.scheduleCompiled()
+    scSim.ConfigureStopTime(macros.sec2nano(4.0))
+    scSim.ExecuteSimulation()
+    assert task.scheduleCompiled()
+    assert extra.CallCounts == 1
+    assert last.dataOutMsg.read().dataVector[0] == 15.0
+
+    # a disabled task does not update its modules
+    scSim.disableTask("task")
+    scSim.ConfigureStopTime(macros.sec2nano(6.0))
+    scSim.ExecuteSimulation()
+    assert [first.CallCounts, cWrap.CallCounts, extra.CallCounts] == [5, 5, 1]
+
+
+if __name__ == "__main__":
+    test_compiledSchedule()
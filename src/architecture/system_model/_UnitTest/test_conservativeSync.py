@@ -0,0 +1,169 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import numpy as np
+import pytest
+from Basilisk.architecture import bskLogging
+from Basilisk.architecture import sim_model
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simulationArchTypes
+
+
+class PythonClock(simulationArchTypes.PythonModelClass):
+    """records the largest lead of its thread over the last step executed by the other thread"""
+    def __init__(self, modelName, clocks, index):
+        super(PythonClock, self).__init__(modelName, True, -1)
+        self.clocks = clocks
+        self.index = index
+        self.maxLead = 0
+
+    def reset(self, currentTime):
+        self.clocks[self.index] = 0
+
+    def updateState(self, currentTime):
+        self.clocks[self.index] = currentTime
+        self.maxLead = max(self.maxLead, currentTime - self.clocks[1 - self.index])
+
+
+def runClocks(lookahead, conservative=True):
+    scSim = SimulationBaseClass.SimBaseClass()
+    clocks = [0, 0]
+    periods = [macros.sec2nano(0.01), macros.sec2nano(0.1)]
+    modList = []
+    procList = []
+    for i in range(2):
+        proc = scSim.CreateNewPythonProcess("proc" + str(i))
+        proc.createPythonTask("task" + str(i), periods[i], True, -1)
+        mod = PythonClock("clock" + str(i), clocks, i)
+        proc.addModelToTask("task" + str(i), mod)
+        modList.append(mod)
+        procList.append(proc)
+
+    scSim.TotalSim.resetThreads(2)
+    for i in range(2):
+        scSim.TotalSim.addProcessToThread(procList[i].processData, i)
+    scSim.TotalSim.setConservativeSync(conservative)
+    scSim.TotalSim.setThreadLookahead(0, lookahead)
+    scSim.TotalSim.setThreadLookahead(1, lookahead)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(2.0))
+    scSim.ExecuteSimulation()
+
+    return scSim, modList, periods, clocks
+
+
+@pytest.mark.parametrize("lookahead", [macros.sec2nano(0.01), macros.sec2nano(0.02), macros.sec2nano(0.5)])
+def test_conservativeSync(lookahead):
+    """
+    Runs a 100 Hz and a 10 Hz python process on two threads in the conservative mode and checks that neither
+    thread runs further ahead of the last step of the other thread than the lookahead allows.  A thread may step
+    at time t once the other thread has finished its steps up to t minus the lookahead, so the lead over the last
+    executed step of the other thread is less than the lookahead plus the step period of the other thread.
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    scSim, modList, periods, clocks = runClocks(lookahead)
+
+    assert scSim.TotalSim.getConservativeSync()
+    assert scSim.TotalSim.getChannelLookahead(0, 1) == lookahead
+    assert clocks == [macros.sec2nano(2.0)] * 2
+    for i in range(2):
+        assert modList[i].maxLead < lookahead + periods[1 - i], \
+            "thread " + str(i) + " ran ahead of the lookahead"
+
+
+def test_conservativeSyncDecoupled():
+    """Checks that decoupled threads in the conservative mode still run to the stop time"""
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    scSim, modList, periods, clocks = runClocks(sim_model.THREAD_DECOUPLED)
+
+    assert scSim.TotalSim.getChannelLookahead(1, 0) == sim_model.THREAD_DECOUPLED
+    assert clocks == [macros.sec2nano(2.0)] * 2
+
+
+def test_zeroLookaheadRejected():
+    """A zero lookahead would let a thread read the messages of a step the other thread is still executing"""
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_SILENT)
+    scSim = SimulationBaseClass.SimBaseClass()
+    scSim.TotalSim.resetThreads(2)
+    assert scSim.TotalSim.getChannelLookahead(0, 1) == sim_model.THREAD_DECOUPLED
+    scSim.TotalSim.setChannelLookahead(0, 1, 0)
+    assert scSim.TotalSim.getChannelLookahead(0, 1) == sim_model.THREAD_DECOUPLED
+    scSim.TotalSim.setChannelLookahead(0, 1, macros.sec2nano(0.1))
+    assert scSim.TotalSim.getChannelLookahead(0, 1) == macros.sec2nano(0.1)
+
+
+@pytest.mark.parametrize("conservative", [True, False])
+def test_threadChannel(conservative):
+    """
+    Declares the link between a 100 Hz module on one thread and a 10 Hz module on another thread as a channel
+    with a 50 ms lookahead.  In the conservative mode the 10 Hz module reads at time t the output of the 100 Hz
+    module at t - 50 ms in every run.  Without it, it reads a snapshot of some earlier step of the other thread.
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    lookahead = macros.sec2nano(0.05)
+    for run in range(3):
+        scSim = SimulationBaseClass.SimBaseClass()
+        procs = []
+        mods = []
+        for i, period in enumerate([0.01, 0.1]):
+            proc = scSim.CreateNewProcess("proc" + str(i))
+            proc.addTask(scSim.CreateNewTask("task" + str(i), macros.sec2nano(period)))
+            mod = cppModuleTemplate.CppModuleTemplate()
+            mod.ModelTag = "module" + str(i)
+            scSim.AddModelToTask("task" + str(i), mod)
+            procs.append(proc)
+            mods.append(mod)
+        mods[1].dataInMsg.subscribeTo(mods[0].dataOutMsg)
+
+        scSim.TotalSim.resetThreads(2)
+        for i in range(2):
+            scSim.TotalSim.addProcessToThread(procs[i].processData, i)
+        scSim.TotalSim.setConservativeSync(conservative)
+        with pytest.raises(ValueError):
+            scSim.addThreadChannel(mods[1].dataInMsg, 1, 1, lookahead)
+        msgCopy = scSim.addThreadChannel(mods[1].dataInMsg, 0, 1, lookahead)
+        assert mods[1].dataInMsg.isSubscribedTo(msgCopy)
+        assert scSim.TotalSim.getChannelLookahead(0, 1) == lookahead
+        assert scSim.TotalSim.getChannelLookahead(1, 0) == sim_model.THREAD_DECOUPLED
+        # the recorder keeps the message the input message is subscribed to when it is created
+        inRec = mods[1].dataInMsg.recorder()
+        scSim.AddModelToTask("task1", inRec)
+
+        scSim.InitializeSimulation()
+        scSim.ConfigureStopTime(macros.sec2nano(2.0))
+        scSim.ExecuteSimulation()
+
+        # the 100 Hz module writes dataVector[0] = k + 1 at its k-th step, at k * 10 ms
+        values = inRec.dataVector[:, 0]
+        steps = (inRec.times()[1:] - lookahead) // macros.sec2nano(0.01)
+        if conservative:
+            np.testing.assert_array_equal(values[1:], steps + 1)
+            np.testing.assert_array_equal(inRec.timesWritten()[1:], inRec.times()[1:] - lookahead)
+        else:
+            assert np.all(values[1:] <= steps + 1)
+        # no step of the other thread is old enough at t = 0, the copy keeps the message as it was initialized
+        assert values[0] == 0.0
+
+
+if __name__ == "__main__":
+    test_conservativeSync(macros.sec2nano(0.01))
+    test_conservativeSyncDecoupled()
+    test_threadChannel(True)
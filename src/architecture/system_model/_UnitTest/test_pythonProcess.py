@@ -0,0 +1,175 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import numpy as np
+import pytest
+from Basilisk.architecture import bskLogging
+from Basilisk.architecture import messaging
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import simulationArchTypes
+
+
+class PythonAddOne(simulationArchTypes.PythonModelClass):
+    """adds one to the first component of the input message data vector"""
+    def __init__(self, modelName, modelActive=True, modelPriority=-1):
+        super(PythonAddOne, self).__init__(modelName, modelActive, modelPriority)
+        self.dataInMsg = messaging.CModuleTemplateMsgReader()
+        self.dataOutMsg = messaging.CModuleTemplateMsg()
+        self.resetCount = 0
+
+    def reset(self, currentTime):
+        self.resetCount += 1
+
+    def updateState(self, currentTime):
+        payload = self.dataInMsg()
+        payload.dataVector[0] += 1.0
+        self.dataOutMsg.write(payload, currentTime, self.moduleID)
+
+
+class PythonFailure(simulationArchTypes.PythonModelClass):
+    """raises an exception once the simulation time passes 2 seconds"""
+    def updateState(self, currentTime):
+        if currentTime > macros.sec2nano(2.0):
+            raise ValueError("python module failure")
+
+
+def setupSim(pyPriority):
+    scSim = SimulationBaseClass.SimBaseClass()
+    dt = macros.sec2nano(1.0)
+
+    upstreamProc = scSim.CreateNewProcess("upstream", 10)
+    upstreamProc.addTask(scSim.CreateNewTask("upstreamTask", dt))
+    downstreamProc = scSim.CreateNewProcess("downstream", 1)
+    downstreamProc.addTask(scSim.CreateNewTask("downstreamTask", dt))
+    pyProc = scSim.CreateNewPythonProcess("pyProcess", pyPriority)
+    pyProc.createPythonTask("pyTask", dt, True, -1)
+
+    mod1 = cppModuleTemplate.CppModuleTemplate()
+    mod1.ModelTag = "upstreamModule"
+    scSim.AddModelToTask("upstreamTask", mod1)
+
+    pyMod = PythonAddOne("pyModule", True, 10)
+    pyMod.dataInMsg.subscribeTo(mod1.dataOutMsg)
+    pyProc.addModelToTask("pyTask", pyMod)
+
+    mod2 = cppModuleTemplate.CppModuleTemplate()
+    mod2.ModelTag = "downstreamModule"
+    mod2.dataInMsg.subscribeTo(pyMod.dataOutMsg)
+    scSim.AddModelToTask("downstreamTask", mod2)
+
+    msgRec = mod2.dataOutMsg.recorder()
+    pyRec = pyMod.dataOutMsg.recorder()
+    scSim.AddModelToTask("downstreamTask", msgRec)
+    scSim.AddModelToTask("downstreamTask", pyRec)
+
+    return scSim, pyProc, pyMod, msgRec, pyRec
+
+
+@pytest.mark.parametrize("pyPriority", [5, 0])
+def test_pythonProcess(pyPriority):
+    """
+    Checks that the native scheduler interleaves a python process with the regular processes by priority.
+    With priority 5 the python module runs between the upstream and downstream processes, so the downstream
+    module sees the python output of the same time step.  With priority 0 it sees the output of the previous step.
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    scSim, pyProc, pyMod, msgRec, pyRec = setupSim(pyPriority)
+
+    scSim.InitializeSimulation()
+    assert pyMod.resetCount == 1
+    scSim.ConfigureStopTime(macros.sec2nano(5.0))
+    scSim.ExecuteSimulation()
+
+    upstream = np.arange(1, 7, dtype=float)     # upstream module output dataVector[0] at each step
+    pyOut = upstream + 1.0
+    if pyPriority == 5:
+        downstreamIn = pyOut
+        # the recorder runs after the python process, so it sees the output of the current step
+        np.testing.assert_array_equal(pyRec.times(), pyRec.timesWritten())
+        np.testing.assert_allclose(pyRec.dataVector[:, 0], pyOut)
+    else:
+        # the downstream process runs first and sees the python output of the previous step
+        downstreamIn = np.concatenate(([0.0], pyOut[:-1]))
+    np.testing.assert_allclose(msgRec.dataVector[:, 0], downstreamIn + np.arange(1, 7))
+
+
+def test_pythonProcessError():
+    """
+    Checks that an exception raised by a python module in the native scheduler stops the simulation at the
+    failing step and is re-raised to the caller
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    scSim, pyProc, pyMod, msgRec, pyRec = setupSim(5)
+    pyProc.addModelToTask("pyTask", PythonFailure("failure"))
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(50.0))
+    with pytest.raises(ValueError):
+        scSim.ExecuteSimulation()
+    # the module fails at t = 3 s, the first step after 2 s
+    assert scSim.TotalSim.CurrentNanos == macros.sec2nano(3.0)
+    assert scSim.getStopCondition() == ("pythonTaskError", macros.sec2nano(3.0), True)
+    assert msgRec.times()[-1] == macros.sec2nano(3.0)
+
+
+def setupThreadedSim(threadCount):
+    scSim, pyProc, pyMod, msgRec, pyRec = setupSim(5)
+    scSim.TotalSim.resetThreads(threadCount)
+    scSim.TotalSim.addProcessToThread(pyProc.processData, threadCount - 1)
+    return scSim, pyProc, pyMod, pyRec
+
+
+def test_pythonProcessThreads():
+    """
+    Checks that a python process does not make the threads of a multi-threaded simulation step together, and
+    that a python module failing on its own thread still stops the run at the failing step
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    scSim, pyProc, pyMod, pyRec = setupThreadedSim(2)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(5.0))
+    scSim.ExecuteSimulation()
+    assert not scSim.TotalSim.threadsInLockstep
+    assert scSim.getStopCondition() is None
+    assert pyRec.times()[-1] == macros.sec2nano(5.0)
+
+    # a stop condition, unlike the python error condition, steps the threads together
+    scSim, pyProc, pyMod, pyRec = setupThreadedSim(2)
+    scSim.addMessageStopCondition("pyLimit", pyMod.dataOutMsg, "dataVector", ">", 1.0e9, index=0)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(5.0))
+    scSim.ExecuteSimulation()
+    assert scSim.TotalSim.threadsInLockstep
+
+    scSim, pyProc, pyMod, pyRec = setupThreadedSim(2)
+    pyProc.addModelToTask("pyTask", PythonFailure("failure"))
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(50.0))
+    with pytest.raises(ValueError):
+        scSim.ExecuteSimulation()
+    assert not scSim.TotalSim.threadsInLockstep
+    # the other thread stops at whichever step it reached when the module failed at t = 3 s
+    assert scSim.getStopCondition() == ("pythonTaskError", macros.sec2nano(3.0), True)
+
+
+if __name__ == "__main__":
+    test_pythonProcess(5)
+    test_pythonProcessError()
+    test_pythonProcessThreads()
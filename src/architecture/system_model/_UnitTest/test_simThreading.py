@@ -0,0 +1,79 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import threading
+
+import numpy as np
+from Basilisk.architecture import bskLogging
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def buildAndRun(results, index, numModules=20):
+    """build a chain of C++ template modules and run it for a simulated minute"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("proc")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(0.01)))
+
+    modList = []
+    for i in range(numModules):
+        mod = cppModuleTemplate.CppModuleTemplate()
+        mod.ModelTag = "cppModule" + str(i)
+        if i > 0:
+            mod.dataInMsg.subscribeTo(modList[-1].dataOutMsg)
+        scSim.AddModelToTask("task", mod, None, numModules - i)
+        modList.append(mod)
+    msgRec = modList[-1].dataOutMsg.recorder()
+    scSim.AddModelToTask("task", msgRec)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(60.0))
+    scSim.ExecuteSimulation()
+
+    results[index] = (np.array(msgRec.dataVector), [mod.moduleID for mod in modList])
+
+
+def test_simThreading():
+    """
+    Runs several simulations concurrently from python threads and checks that they match the serial result
+    and that the module IDs handed out while building in parallel are unique.
+    """
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    numSims = 4
+
+    serial = [None]
+    buildAndRun(serial, 0)
+
+    results = [None] * numSims
+    threadList = [threading.Thread(target=buildAndRun, args=(results, i)) for i in range(numSims)]
+    for thr in threadList:
+        thr.start()
+    for thr in threadList:
+        thr.join()
+
+    allIDs = []
+    for res in results:
+        assert res is not None, "threaded simulation did not finish"
+        np.testing.assert_allclose(res[0], serial[0][0], atol=1e-12)
+        allIDs += res[1]
+    assert len(allIDs) == len(set(allIDs)), "module IDs were handed out twice"
+
+
+if __name__ == "__main__":
+    test_simThreading()
@@ -0,0 +1,121 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import pytest
+from Basilisk.moduleTemplates import cModuleTemplate
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def setupSim():
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(1.0)))
+    mod = cppModuleTemplate.CppModuleTemplate()
+    mod.ModelTag = "module"
+    scSim.AddModelToTask("task", mod)
+    return scSim, mod
+
+
+@pytest.mark.parametrize("index", [0, None])
+def test_messageFieldCondition(index):
+    """The run stops at the first step where the message field crosses the threshold"""
+    scSim, mod = setupSim()
+    # the module writes dataVector[0] = 1, 2, 3, ... at t = 0, 1, 2, ... seconds
+    scSim.addMessageStopCondition("limit", mod.dataOutMsg, "dataVector", ">=", 5.0, index=index, isFailure=True)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(20.0))
+    scSim.ExecuteSimulation()
+
+    assert scSim.TotalSim.CurrentNanos == macros.sec2nano(4.0)
+    assert mod.dataOutMsg.read().dataVector[0] == 5.0
+    assert scSim.getStopCondition() == ("limit", macros.sec2nano(4.0), True)
+
+
+def test_holdCountAndReset():
+    """The hold count delays the stop and resetting the simulation clears the met condition"""
+    scSim, mod = setupSim()
+    condition = scSim.addMessageStopCondition("settledLimit", mod.dataOutMsg, "dataVector", ">", 2.5, index=0,
+                                              holdCount=3)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(20.0))
+    scSim.ExecuteSimulation()
+    # the value is above 2.5 from t = 2 s, and held for three writes at t = 4 s
+    assert scSim.getStopCondition() == ("settledLimit", macros.sec2nano(4.0), False)
+    assert not condition.isFailure
+
+    scSim.TotalSim.ResetSimulation()
+    assert scSim.getStopCondition() is None
+
+
+def test_cMessageCondition():
+    """Stop conditions also watch the C-wrapped output messages of C modules"""
+    scSim, mod = setupSim()
+    moduleConfig = cModuleTemplate.cModuleTemplateConfig()
+    moduleWrap = scSim.setModelDataWrap(moduleConfig)
+    moduleWrap.ModelTag = "cModule"
+    scSim.AddModelToTask("task", moduleWrap, moduleConfig)
+    moduleConfig.dataInMsg.subscribeTo(mod.dataOutMsg)
+    # the C module writes dataVector[0] = 2, 4, 6, ... at t = 0, 1, 2, ... seconds
+    scSim.addMessageStopCondition("cLimit", moduleConfig.dataOutMsg, "dataVector", ">", 9.0, index=0)
+    with pytest.raises(ValueError):
+        scSim.addMessageStopCondition("bad", moduleConfig.dataOutMsg, "noSuchField", ">", 0.0)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(20.0))
+    scSim.ExecuteSimulation()
+    assert scSim.getStopCondition() == ("cLimit", macros.sec2nano(4.0), False)
+
+
+@pytest.mark.parametrize("threadCount", [2, 3])
+def test_multiThreadCondition(threadCount):
+    """
+    A condition watching a module on one thread stops the modules of all threads at the same step, also if the
+    first thread has no processes
+    """
+    scSim = SimulationBaseClass.SimBaseClass()
+    mods = []
+    procs = []
+    for i, period in enumerate([0.1, 1.0]):
+        proc = scSim.CreateNewProcess("process" + str(i))
+        proc.addTask(scSim.CreateNewTask("task" + str(i), macros.sec2nano(period)))
+        mod = cppModuleTemplate.CppModuleTemplate()
+        mod.ModelTag = "module" + str(i)
+        scSim.AddModelToTask("task" + str(i), mod)
+        mods.append(mod)
+        procs.append(proc)
+    scSim.TotalSim.resetThreads(threadCount)
+    for i in range(2):
+        scSim.TotalSim.addProcessToThread(procs[i].processData, threadCount - 2 + i)
+    # the slow module writes dataVector[0] = 1, 2, 3, ... at t = 0, 1, 2, ... seconds
+    scSim.addMessageStopCondition("slowLimit", mods[1].dataOutMsg, "dataVector", ">=", 5.0, index=0)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(20.0))
+    scSim.ExecuteSimulation()
+
+    assert scSim.getStopCondition() == ("slowLimit", macros.sec2nano(4.0), False)
+    assert scSim.TotalSim.CurrentNanos == macros.sec2nano(4.0)
+    for mod in mods:
+        assert mod.dataOutMsg.addSubscriber().timeWritten() == macros.sec2nano(4.0)
+
+
+if __name__ == "__main__":
+    test_messageFieldCondition(0)
+    test_holdCountAndReset()
+    test_cMessageCondition()
+    test_multiThreadCondition(3)
@@ -18,6 +18,7 @@
  */
 
 #include "sim_model.h"
+#include "architecture/utilities/moduleIdGenerator/allocationGuard.h"
 #include <cstring>
 #include <iostream>
 
@@ -78,6 +79,11 @@ SimThreadExecution::SimThreadExecution() {
     stopThreadNanos=0;
     nextProcPriority = -1;
     threadContext = nullptr;
+    errorCondition = nullptr;
+    metStopCondition = nullptr;
+    conservativeSync = false;
+    publishedNanos = 0;
+    runComplete = true;
 
 }
 
@@ -169,12 +175,138 @@ void SimThreadExecution::StepUntilStop()
      (that's less than all process priorities, so it will run through the next
      process)*/
     int64_t inPri = stopThreadNanos == this->NextTaskTime ? stopThreadPriority : -1;
-    while(this->threadValid() && (this->NextTaskTime < stopThreadNanos || (this->NextTaskTime == stopThreadNanos &&
+    //! - An allocation guard armed by a real-time module only watches the thread while it steps the simulation
+    AllocationGuard::resume();
+    while(this->threadValid() && this->metStopCondition == nullptr &&
+          (this->NextTaskTime < stopThreadNanos || (this->NextTaskTime == stopThreadNanos &&
                                                this->nextProcPriority >= stopThreadPriority)) )
     {
+        if(this->conservativeSync)
+        {
+            this->waitOnInputChannels();
+        }
+        this->readChannelMessages();
         this->SingleStepProcesses(inPri);
+        this->writeChannelMessages();
+        this->checkStopConditions();
+        if(this->conservativeSync)
+        {
+            this->publishThreadTime(false);
+        }
         inPri = stopThreadNanos == this->NextTaskTime ? stopThreadPriority : -1;
     }
+    AllocationGuard::suspend();
+    if(this->conservativeSync)
+    {
+        this->publishThreadTime(true);
+    }
+}
+
+/*! This method is called by the "parent" thread before the threads are released for a run.  It sets whether
+    the thread waits on its input channels and publishes the time of its next step, so that no thread reads a
+    stale time from the previous run.
+ @param enable flag indicating that the run uses the conservative synchronization
+ @return void
+ */
+void SimThreadExecution::startConservativeRun(bool enable)
+{
+    std::unique_lock<std::mutex> lck(this->publishLock);
+    this->conservativeSync = enable;
+    this->publishedNanos = this->NextTaskTime;
+    this->runComplete = !enable || this->procCount() == 0;
+}
+
+/*! This method publishes the time of the next step of the thread to the threads that read its messages.  All
+    of the messages written before that time are visible to them once they see the new time.
+ @param complete flag indicating that the thread will not step any further in this run
+ @return void
+ */
+void SimThreadExecution::publishThreadTime(bool complete)
+{
+    {
+        std::unique_lock<std::mutex> lck(this->publishLock);
+        this->publishedNanos = this->NextTaskTime;
+        this->runComplete = complete;
+    }
+    this->publishVar.notify_all();
+}
+
+/*! This method holds the thread until the next step is safe.  A step at time t is safe once every thread
+    writing to this one has finished all of its steps up to t minus the lookahead of the channel, that is once
+    its published next step time plus the lookahead is past t, or once that thread has finished the run.  As
+    every lookahead is positive, the thread with the earliest next step can always proceed, so the threads can
+    not deadlock.
+ @return void
+ */
+void SimThreadExecution::waitOnInputChannels()
+{
+    std::vector<ThreadChannel>::iterator it;
+    for(it = this->inputChannels.begin(); it != this->inputChannels.end(); it++)
+    {
+        SimThreadExecution *source = it->source;
+        uint64_t lookahead = it->lookaheadNanos;
+        uint64_t stepNanos = this->NextTaskTime;
+        auto stepIsSafe = [source, lookahead, stepNanos]() {
+            uint64_t sourceNanos = source->publishedNanos;
+            return source->runComplete ||
+                   sourceNanos > stepNanos || stepNanos - sourceNanos < lookahead;
+        };
+        //! - the atomic read of the published time also makes the messages written before it visible
+        if(stepIsSafe())
+        {
+            continue;
+        }
+        std::unique_lock<std::mutex> lck(source->publishLock);
+        source->publishVar.wait(lck, stepIsSafe);
+    }
+}
+
+/*! This method updates the copies of the messages this thread reads from other threads before a step, with the
+    values they had one lookahead earlier
+ @return void
+ */
+void SimThreadExecution::readChannelMessages()
+{
+    std::vector<ThreadChannelMessage*>::iterator it;
+    for(it = this->inputMessages.begin(); it != this->inputMessages.end(); it++)
+    {
+        (*it)->applySnapshot(this->NextTaskTime);
+    }
+}
+
+/*! This method records the messages this thread writes for other threads after a step.  It is called before the
+    time of the next step is published, so the threads waiting on that time find the snapshots of the step.
+ @return void
+ */
+void SimThreadExecution::writeChannelMessages()
+{
+    std::vector<ThreadChannelMessage*>::iterator it;
+    for(it = this->outputMessages.begin(); it != this->outputMessages.end(); it++)
+    {
+        (*it)->recordSnapshot(this->CurrentNanos);
+    }
+}
+
+/*! This method evaluates the stop conditions of the thread after a simulation step.  The first
+    condition that is met stops the thread.  A triggered error condition stops the thread before any other.
+ @return void
+ */
+void SimThreadExecution::checkStopConditions()
+{
+    if(this->errorCondition != nullptr && this->errorCondition->isTriggered())
+    {
+        this->metStopCondition = this->errorCondition;
+        return;
+    }
+    std::vector<StopCondition*>::iterator it;
+    for(it = this->stopConditions.begin(); it != this->stopConditions.end(); it++)
+    {
+        if((*it)->isMet(this->CurrentNanos))
+        {
+            this->metStopCondition = *it;
+            return;
+        }
+    }
 }
 
 /*! This method is currently vestigial and needs to be populated once the message
@@ -283,12 +415,19 @@ SimModel::SimModel()
     this->CurrentNanos = 0;
     this->NextTaskTime = 0;
     this->nextProcPriority = -1;
+    this->errorCondition = nullptr;
+    this->metStopCondition = nullptr;
+    this->stopConditionNanos = 0;
+    this->threadsInLockstep = false;
+    this->conservativeSync = false;
+    this->channelLookahead.assign(1, THREAD_DECOUPLED);
 }
 
 /*! Nothing to destroy really */
 SimModel::~SimModel()
 {
     this->deleteThreads();
+    this->clearChannelMessages();
 }
 
 /*! This method steps the simulation until the specified stop time and
@@ -300,14 +439,113 @@ SimModel::~SimModel()
 void SimModel::StepUntilStop(uint64_t SimStopTime, int64_t stopPri)
 {
     std::vector<SimThreadExecution*>::iterator thrIt;
-    std::cout << std::flush;
+    //! - with the asynchronous log backend the output is written by its own thread, no need to flush here
+    if (!asyncLoggingEnabled())
+    {
+        std::cout << std::flush;
+    }
+    uint64_t activeThreads = 0;
     for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
     {
         (*thrIt)->moveProcessMessages();
+        activeThreads += (*thrIt)->procCount() > 0 ? 1 : 0;
+    }
+    //! - a single thread evaluates the stop conditions after each of its steps.  With several threads they are
+    //!   evaluated here between steps that all threads take together, so that every thread stops at the same step
+    //!   The error condition is not one of them: each thread checks it after its own steps, so a failed module
+    //!   stops the threads without making them step together
+    bool lockstep = !this->stopConditions.empty() && activeThreads > 1;
+    this->threadsInLockstep = lockstep;
+    for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
+    {
+        (*thrIt)->stopConditions.clear();
+        (*thrIt)->errorCondition = this->errorCondition;
+        if(!lockstep && (*thrIt)->procCount() > 0)
+        {
+            (*thrIt)->stopConditions = this->stopConditions;
+        }
+    }
+    this->assignChannelMessages();
+    //! - in the conservative mode the threads only wait on their input channels, not on each other's steps
+    if(this->conservativeSync)
+    {
+        this->configureThreadChannels();
+    }
+    if(!lockstep)
+    {
+        this->runThreads(SimStopTime, stopPri);
+        //! - the threads that see the error condition after the failing one stop at other steps, so the run
+        //!   reports the step of the failure
+        if(this->checkErrorCondition())
+        {
+            return;
+        }
+        for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
+        {
+            if(this->metStopCondition == nullptr && (*thrIt)->metStopCondition != nullptr)
+            {
+                this->metStopCondition = (*thrIt)->metStopCondition;
+                this->stopConditionNanos = (*thrIt)->CurrentNanos;
+            }
+        }
+        return;
+    }
+    while(this->metStopCondition == nullptr)
+    {
+        uint64_t stepNanos = (uint64_t) ~0;
+        int64_t stepPriority = -1;
+        for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
+        {
+            if((*thrIt)->procCount() == 0)
+            {
+                continue;
+            }
+            if((*thrIt)->NextTaskTime < stepNanos ||
+               ((*thrIt)->NextTaskTime == stepNanos && (*thrIt)->nextProcPriority > stepPriority))
+            {
+                stepNanos = (*thrIt)->NextTaskTime;
+                stepPriority = (*thrIt)->nextProcPriority;
+            }
+        }
+        if(stepNanos > SimStopTime || (stepNanos == SimStopTime && stepPriority < stopPri))
+        {
+            break;
+        }
+        this->runThreads(stepNanos, stepNanos == SimStopTime ? stopPri : -1);
+        this->CurrentNanos = stepNanos;
+        if(this->checkErrorCondition())
+        {
+            break;
+        }
+        std::vector<StopCondition*>::iterator condIt;
+        for(condIt = this->stopConditions.begin(); condIt != this->stopConditions.end(); condIt++)
+        {
+            if((*condIt)->isMet(stepNanos))
+            {
+                this->metStopCondition = *condIt;
+                this->stopConditionNanos = stepNanos;
+                break;
+            }
+        }
     }
+}
+
+/*! This method releases the threads with processes to step until the given stop time and priority, and waits
+    until they are done.
+ @param stopNanos [ns] time the threads step to
+ @param stopPri The priority level below which the threads won't go
+ @return void
+ */
+void SimModel::runThreads(uint64_t stopNanos, int64_t stopPri)
+{
+    std::vector<SimThreadExecution*>::iterator thrIt;
     for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
     {
-        (*thrIt)->stopThreadNanos = SimStopTime;
+        (*thrIt)->startConservativeRun(this->conservativeSync);
+    }
+    for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
+    {
+        (*thrIt)->stopThreadNanos = stopNanos;
         (*thrIt)->stopThreadPriority = stopPri;
         if((*thrIt)->procCount() > 0) {
             (*thrIt)->unlockThread();
@@ -327,6 +565,262 @@ void SimModel::StepUntilStop(uint64_t SimStopTime, int64_t stopPri)
     }
 }
 
+/*! This method builds the input channels of each thread from the lookahead table.  Threads without processes
+    never step, so they are not used as sources.
+
+    Without the conservative mode the threads run unsynchronized to the stop time, so a thread may read the
+    messages of another thread from any time of that run, and the values it reads differ from run to run.  The
+    conservative mode adds a wait on the declared channels only: a thread steps time t once each of its sources
+    has finished its steps up to t minus the lookahead, while the threads still do not wait on each other at every
+    step.  The messages declared with addChannelMessage() are read through snapshots, so the target thread reads
+    the values of the source thread one lookahead before t, and never the memory the source thread is writing.
+ @return void
+ */
+void SimModel::configureThreadChannels()
+{
+    uint64_t threadCount = this->threadList.size();
+    for(uint64_t target = 0; target < threadCount; target++)
+    {
+        std::vector<ThreadChannel> *channels = &(this->threadList[target]->inputChannels);
+        channels->clear();
+        for(uint64_t source = 0; source < threadCount; source++)
+        {
+            uint64_t lookahead = this->channelLookahead[source*threadCount + target];
+            if(source == target || lookahead == THREAD_DECOUPLED ||
+               this->threadList[source]->procCount() == 0)
+            {
+                continue;
+            }
+            ThreadChannel newChannel;
+            newChannel.source = this->threadList[source];
+            newChannel.lookaheadNanos = lookahead;
+            channels->push_back(newChannel);
+        }
+    }
+}
+
+/*! This method sets the lookahead of a thread towards all of the other threads, that is the minimum latency
+    between the time a message is written on the thread and the time it is read on another thread.  The other
+    threads may run up to that much ahead of this thread.  The lookahead must be positive, THREAD_DECOUPLED
+    marks a thread that writes no messages read by the other threads.
+ @param threadSel index of the thread writing the messages
+ @param lookaheadNanos [ns] lookahead of the thread
+ @return void
+ */
+void SimModel::setThreadLookahead(uint64_t threadSel, uint64_t lookaheadNanos)
+{
+    for(uint64_t target = 0; target < this->threadList.size(); target++)
+    {
+        if(target != threadSel)
+        {
+            this->setChannelLookahead(threadSel, target, lookaheadNanos);
+        }
+    }
+}
+
+/*! This method sets the lookahead of the channel between a pair of threads.
+ @param sourceThread index of the thread writing the messages
+ @param targetThread index of the thread reading the messages
+ @param lookaheadNanos [ns] positive lookahead of the channel, THREAD_DECOUPLED if the threads exchange no messages
+ @return void
+ */
+void SimModel::setChannelLookahead(uint64_t sourceThread, uint64_t targetThread, uint64_t lookaheadNanos)
+{
+    uint64_t threadCount = this->threadList.size();
+    if(sourceThread >= threadCount || targetThread >= threadCount)
+    {
+        this->bskLogger.bskLog(BSK_ERROR, "SimModel: thread index out of range when setting the channel lookahead.");
+        return;
+    }
+    //! - with a zero lookahead two threads reading each other's messages would wait on each other's step
+    if(lookaheadNanos == 0)
+    {
+        this->bskLogger.bskLog(BSK_ERROR, "SimModel: the channel lookahead must be positive, use THREAD_DECOUPLED "
+                                          "for threads that exchange no messages.");
+        return;
+    }
+    this->channelLookahead[sourceThread*threadCount + targetThread] = lookaheadNanos;
+}
+
+/*! This method returns the lookahead of the channel between a pair of threads.
+ @param sourceThread index of the thread writing the messages
+ @param targetThread index of the thread reading the messages
+ @return uint64_t [ns] lookahead of the channel
+ */
+uint64_t SimModel::getChannelLookahead(uint64_t sourceThread, uint64_t targetThread)
+{
+    uint64_t threadCount = this->threadList.size();
+    if(sourceThread >= threadCount || targetThread >= threadCount)
+    {
+        this->bskLogger.bskLog(BSK_ERROR, "SimModel: thread index out of range when reading the channel lookahead.");
+        return 0;
+    }
+    return this->channelLookahead[sourceThread*threadCount + targetThread];
+}
+
+/*! This method adds a condition that ends the simulation run once it is met.  The conditions are evaluated
+    natively after each simulation step, so a run stops without returning to python at every step.  If several
+    threads have processes, the threads take each step together while conditions are set, so that all of them
+    stop at the step where a condition is met.  The caller keeps ownership of the condition.
+ @param condition the stop condition to add
+ @return void
+ */
+void SimModel::addStopCondition(StopCondition *condition)
+{
+    this->stopConditions.push_back(condition);
+}
+
+/*! This method declares a message written by a module on the source thread and read by modules on the target
+    thread.  The reading modules must be subscribed to a copy of the message with the given target address, which
+    the target thread updates from snapshots of the source message before each of its steps.  The copy holds the
+    values of the message one lookahead before the step, and the channel lookahead between the two threads is
+    lowered to the lookahead of the message.  The payload must not own memory, as it is copied byte by byte.
+ @param sourceThread index of the thread writing the message
+ @param targetThread index of the thread reading the copy
+ @param sourceHeaderAddress address of the header of the message
+ @param sourcePayloadAddress address of the payload of the message
+ @param targetHeaderAddress address of the header of the copy
+ @param targetPayloadAddress address of the payload of the copy
+ @param payloadSize [bytes] size of the payload
+ @param lookaheadNanos [ns] age of the values read by the target thread, positive
+ @return void
+ */
+void SimModel::addChannelMessage(uint64_t sourceThread, uint64_t targetThread, uint64_t sourceHeaderAddress,
+                                 uint64_t sourcePayloadAddress, uint64_t targetHeaderAddress,
+                                 uint64_t targetPayloadAddress, uint64_t payloadSize, uint64_t lookaheadNanos)
+{
+    uint64_t threadCount = this->threadList.size();
+    if(sourceThread >= threadCount || targetThread >= threadCount || sourceThread == targetThread)
+    {
+        this->bskLogger.bskLog(BSK_ERROR, "SimModel: a channel message needs two different threads of the model.");
+        return;
+    }
+    if(lookaheadNanos == 0 || lookaheadNanos == THREAD_DECOUPLED)
+    {
+        this->bskLogger.bskLog(BSK_ERROR, "SimModel: the lookahead of a channel message must be positive.");
+        return;
+    }
+    ThreadChannelMessage *newMessage = new ThreadChannelMessage(sourceThread, targetThread,
+        reinterpret_cast<MsgHeader *>(sourceHeaderAddress), reinterpret_cast<void *>(sourcePayloadAddress),
+        reinterpret_cast<MsgHeader *>(targetHeaderAddress), reinterpret_cast<void *>(targetPayloadAddress),
+        payloadSize, lookaheadNanos);
+    this->channelMessages.push_back(newMessage);
+    if(lookaheadNanos < this->getChannelLookahead(sourceThread, targetThread))
+    {
+        this->setChannelLookahead(sourceThread, targetThread, lookaheadNanos);
+    }
+}
+
+/*! This method removes all channel messages.  The modules subscribed to their copies keep reading the last values.
+ @return void
+ */
+void SimModel::clearChannelMessages()
+{
+    std::vector<ThreadChannelMessage*>::iterator it;
+    for(it = this->channelMessages.begin(); it != this->channelMessages.end(); it++)
+    {
+        delete (*it);
+    }
+    this->channelMessages.clear();
+    std::vector<SimThreadExecution*>::iterator thrIt;
+    for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
+    {
+        (*thrIt)->inputMessages.clear();
+        (*thrIt)->outputMessages.clear();
+    }
+}
+
+/*! This method copies the channel messages directly into the copies read by the target threads.  It is called
+    while the threads are held after the initialization of the modules, when no snapshot has been recorded yet.
+ @return void
+ */
+void SimModel::copyChannelMessages()
+{
+    std::vector<ThreadChannelMessage*>::iterator it;
+    for(it = this->channelMessages.begin(); it != this->channelMessages.end(); it++)
+    {
+        (*it)->copyMessage();
+    }
+}
+
+/*! This method hands the channel messages to the threads writing and reading them.  Messages of threads that no
+    longer exist are skipped.
+ @return void
+ */
+void SimModel::assignChannelMessages()
+{
+    std::vector<SimThreadExecution*>::iterator thrIt;
+    for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
+    {
+        (*thrIt)->inputMessages.clear();
+        (*thrIt)->outputMessages.clear();
+    }
+    std::vector<ThreadChannelMessage*>::iterator it;
+    for(it = this->channelMessages.begin(); it != this->channelMessages.end(); it++)
+    {
+        if((*it)->sourceThread < this->threadList.size() && (*it)->targetThread < this->threadList.size())
+        {
+            this->threadList[(*it)->sourceThread]->outputMessages.push_back(*it);
+            this->threadList[(*it)->targetThread]->inputMessages.push_back(*it);
+        }
+    }
+}
+
+/*! This method sets the condition that modules trigger when they fail, such as python modules raising an
+    exception.  Unlike the stop conditions, it does not make the threads step together: each thread checks it
+    after its own steps, and the run reports the step at which it was triggered.  The caller keeps ownership of
+    the condition.
+ @param condition the error condition, nullptr to remove it
+ @return void
+ */
+void SimModel::setErrorCondition(FlagCondition *condition)
+{
+    this->errorCondition = condition;
+}
+
+/*! This method records the error condition as the condition that ended the run if it has been triggered
+ @return bool true if the error condition was triggered
+ */
+bool SimModel::checkErrorCondition()
+{
+    if(this->errorCondition == nullptr || !this->errorCondition->isTriggered())
+    {
+        return false;
+    }
+    this->metStopCondition = this->errorCondition;
+    this->stopConditionNanos = this->errorCondition->getTriggerNanos();
+    return true;
+}
+
+/*! This method removes all stop conditions
+ @return void
+ */
+void SimModel::clearStopConditions()
+{
+    this->stopConditions.clear();
+    std::vector<SimThreadExecution*>::iterator thrIt;
+    for(thrIt=this->threadList.begin(); thrIt != this->threadList.end(); thrIt++)
+    {
+        (*thrIt)->stopConditions.clear();
+    }
+}
+
+/*! This method returns the name of the stop condition that ended the run, or an empty string
+ @return std::string
+ */
+std::string SimModel::getStopConditionName()
+{
+    return this->metStopCondition != nullptr ? this->metStopCondition->name : std::string();
+}
+
+/*! This method returns true if the stop condition that ended the run marks a failure of the run
+ @return bool
+ */
+bool SimModel::stopConditionFailed()
+{
+    return this->metStopCondition != nullptr && this->metStopCondition->isFailure;
+}
+
 
 /*! This method allows the user to attach a process to the simulation for
     execution.  Note that the priority level of the process determines what
@@ -367,6 +861,8 @@ void SimModel::selfInitSimulation()
     }
     this->NextTaskTime = 0;
     this->CurrentNanos = 0;
+    //! - the reset of the modules reading messages of other threads sees their initial values
+    this->copyChannelMessages();
 
 }
 
@@ -390,6 +886,7 @@ void SimModel::resetInitSimulation()
         (*thrIt)->lockParent();
 
     }
+    this->copyChannelMessages();
 }
 
 /*! This method steps all of the processes forward to the current time.  It also
@@ -453,7 +950,24 @@ void SimModel::ResetSimulation()
     {
         (*thrIt)->NextTaskTime = 0;
         (*thrIt)->CurrentNanos = 0;
+        (*thrIt)->metStopCondition = nullptr;
+    }
+    std::vector<StopCondition*>::iterator condIt;
+    for(condIt = this->stopConditions.begin(); condIt != this->stopConditions.end(); condIt++)
+    {
+        (*condIt)->reset();
     }
+    if(this->errorCondition != nullptr)
+    {
+        this->errorCondition->reset();
+    }
+    std::vector<ThreadChannelMessage*>::iterator msgIt;
+    for(msgIt = this->channelMessages.begin(); msgIt != this->channelMessages.end(); msgIt++)
+    {
+        (*msgIt)->clearSnapshots();
+    }
+    this->metStopCondition = nullptr;
+    this->stopConditionNanos = 0;
 }
 
 /*! This method removes all of the active processes from the "thread pool" that
@@ -495,6 +1009,11 @@ void SimModel::resetThreads(uint64_t threadCount)
         SimThreadExecution *newThread = new SimThreadExecution(0, 0);
         this->threadList.push_back(newThread);
     }
+    //! - new threads start decoupled, the channels between them are declared with setChannelLookahead()
+    if(this->channelLookahead.size() != threadCount*threadCount)
+    {
+        this->channelLookahead.assign(threadCount*threadCount, THREAD_DECOUPLED);
+    }
 
 }
 
@@ -25,11 +25,25 @@
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
 #include <iostream>
 #include "architecture/system_model/sys_process.h"
+#include "architecture/system_model/stop_condition.h"
+#include "architecture/system_model/thread_channel.h"
 #include "architecture/utilities/bskLogging.h"
 #include "architecture/utilities/bskSemaphore.h"
 
+class SimThreadExecution;
+
+//! Lookahead value that marks two threads as not exchanging any messages
+#define THREAD_DECOUPLED 0xFFFFFFFFFFFFFFFFULL
+
+//! Cross-thread message channel that bounds how far a thread may run ahead of the thread writing its input messages
+typedef struct {
+    SimThreadExecution *source;  //!< Thread that writes the messages read through the channel
+    uint64_t lookaheadNanos;     //!< [ns] Minimum latency of the messages written by the source thread, positive
+}ThreadChannel;
+
 //! This class handles the management of a given "thread" of execution and provides the main mechanism for running concurrent jobs inside BSK
 class SimThreadExecution
 {
@@ -57,6 +71,12 @@ public:
     void StepUntilStop();  //!< Step simulation until stop time uint64_t reached
     void SingleStepProcesses(int64_t stopPri=-1); //!< Step only the next Task in the simulation
     void moveProcessMessages();
+    void checkStopConditions();
+    void startConservativeRun(bool enable);
+    void publishThreadTime(bool runComplete);
+    void waitOnInputChannels();
+    void readChannelMessages();
+    void writeChannelMessages();
 public:
     uint64_t currentThreadNanos;  //!< Current simulation time available at thread
     uint64_t stopThreadNanos;   //!< Current stop conditions for the thread
@@ -69,6 +89,12 @@ public:
     bool selfInitNow;              //!< Flag requesting self init
     bool crossInitNow;             //!< Flag requesting cross-init
     bool resetNow;                 //!< Flag requesting that the thread execute reset
+    std::vector<StopCondition*> stopConditions;  //!< Conditions evaluated after each step of this thread
+    FlagCondition *errorCondition;  //!< Condition triggered by a failed module, checked after each step of this thread
+    StopCondition *metStopCondition;  //!< Condition that stopped the thread, nullptr if none
+    std::vector<ThreadChannel> inputChannels;  //!< Channels from the threads this thread reads messages from
+    std::vector<ThreadChannelMessage*> inputMessages;  //!< Messages of other threads read by this thread
+    std::vector<ThreadChannelMessage*> outputMessages;  //!< Messages of this thread read by other threads
 private:
     bool threadRunning;            //!< Flag that will allow for easy concurrent locking
     bool terminateThread;          //!< Flag that indicates that it is time to take thread down
@@ -77,6 +103,11 @@ private:
     std::vector<SysProcess*> processList;  //!< List of processes associated with thread
     std::mutex initReadyLock;      //!< Lock function to ensure runtime locks are configured
     std::condition_variable initHoldVar; //!< Conditional variable used to prevent race conditions
+    bool conservativeSync;         //!< Flag indicating that the thread waits on its input channels before each step
+    std::atomic<uint64_t> publishedNanos;  //!< [ns] Time of the next step of the thread, all earlier steps are complete
+    std::atomic<bool> runComplete; //!< Flag indicating that the thread has finished the current run
+    std::mutex publishLock;        //!< Lock protecting the published time of the thread
+    std::condition_variable publishVar;  //!< Conditional variable used to wake the threads reading from this one
 };
 
 //! The top-level container for an entire simulation
@@ -98,6 +129,22 @@ public:
     void deleteThreads();
     void assignRemainingProcs();
     uint64_t getThreadCount() {return threadList.size();} //!< returns the number of threads used
+    void addStopCondition(StopCondition *condition);
+    void clearStopConditions();
+    void setErrorCondition(FlagCondition *condition);
+    bool stopConditionMet() {return this->metStopCondition != nullptr;} //!< returns true if a stop condition ended the run
+    std::string getStopConditionName();
+    bool stopConditionFailed();
+    void setConservativeSync(bool enable) {this->conservativeSync = enable;} //!< Enables the lookahead based synchronization of the threads
+    bool getConservativeSync() {return this->conservativeSync;} //!< returns true if the threads are synchronized by lookahead
+    void setThreadLookahead(uint64_t threadSel, uint64_t lookaheadNanos);
+    void setChannelLookahead(uint64_t sourceThread, uint64_t targetThread, uint64_t lookaheadNanos);
+    uint64_t getChannelLookahead(uint64_t sourceThread, uint64_t targetThread);
+    void addChannelMessage(uint64_t sourceThread, uint64_t targetThread, uint64_t sourceHeaderAddress,
+                           uint64_t sourcePayloadAddress, uint64_t targetHeaderAddress, uint64_t targetPayloadAddress,
+                           uint64_t payloadSize, uint64_t lookaheadNanos);
+    void clearChannelMessages();
+    uint64_t getChannelMessageCount() {return this->channelMessages.size();} //!< returns the number of messages read across threads
 
     BSKLogger bskLogger;                      //!< -- BSK Logging
 
@@ -108,6 +155,22 @@ public:
     uint64_t CurrentNanos;  //!< [ns] Current sim time
     uint64_t NextTaskTime;  //!< [ns] time for the next Task
     int64_t nextProcPriority;  //!< [-] Priority level for the next process
+    std::vector<StopCondition*> stopConditions;  //!< -- Conditions that end the run, evaluated after each step
+    FlagCondition *errorCondition;  //!< -- Condition triggered by a failed module, it does not step the threads together
+    StopCondition *metStopCondition;  //!< -- Condition that ended the run, nullptr if none
+    uint64_t stopConditionNanos;  //!< [ns] Sim time at which the stop condition was met
+    bool threadsInLockstep;  //!< -- Flag indicating that the last run stepped its threads together
+
+private:
+    void configureThreadChannels();
+    void assignChannelMessages();
+    void copyChannelMessages();
+    void runThreads(uint64_t stopNanos, int64_t stopPri);
+    bool checkErrorCondition();
+
+    bool conservativeSync;  //!< -- Flag indicating that threads advance up to the lookahead of their input channels
+    std::vector<uint64_t> channelLookahead;  //!< [ns] Lookahead of the channel from each thread (row) to each thread (column)
+    std::vector<ThreadChannelMessage*> channelMessages;  //!< -- Messages read across threads, owned by the model
 };
 
 #endif /* _SimModel_H_ */
@@ -16,7 +16,7 @@
  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
  */
-%module sim_model
+%module(directors="1", threads="1") sim_model
 %{
    #include "sim_model.h"
 %}
@@ -73,7 +73,28 @@ namespace std {
     } 
 }
 
+// Release the GIL only around the calls that run the native scheduler so that
+// several simulations can step concurrently from different Python threads.
+// Everything else keeps the GIL to avoid the per-call overhead.  The director
+// calls below still re-acquire the GIL when the scheduler calls into Python.
+%nothreadallow;
+%threadallow SimModel::StepUntilStop;
+%threadallow SimModel::SingleStepProcesses;
+%threadallow SimModel::selfInitSimulation;
+%threadallow SimModel::resetInitSimulation;
+%threadallow SimModel::ResetSimulation;
+%threadallow SimModel::assignRemainingProcs;
+%threadallow SimModel::resetThreads;
+%threadallow SimModel::deleteThreads;
+
+// Python tasks derive from SysModel so the native scheduler can call them directly
+%feature("director") SysModel;
+%feature("nodirector") SysModel::directUpdate;
+%ignore SysModel::directUpdate;
+
 %include "sys_model_task.h"
 %include "sys_model.h"
+%include "architecture/utilities/moduleIdGenerator/messageArena.h"
 %include "sys_process.h"
+%include "stop_condition.h"
 %include "sim_model.h"
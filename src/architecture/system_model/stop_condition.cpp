@@ -0,0 +1,201 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "stop_condition.h"
+#include <cmath>
+#include <cstring>
+
+StopCondition::StopCondition()
+{
+    this->isFailure = false;
+}
+
+/*! This method clears the state of the condition, it is called when the simulation is reset.
+ @return void
+ */
+void StopCondition::reset()
+{
+}
+
+MessageFieldCondition::MessageFieldCondition()
+{
+    this->fieldPointer = nullptr;
+    this->header = nullptr;
+    this->format = Format::Float64;
+    this->elementCount = 1;
+    this->relation = Relation::Greater;
+    this->threshold = 0.0;
+    this->holdCount = 1;
+    this->reset();
+}
+
+/*! This method points the condition at a field of a message payload.  The addresses and offset are
+    obtained from the message payload layout, see the python helper SimBaseClass.addMessageStopCondition().
+ @param payloadAddress address of the message payload
+ @param headerAddress address of the message header
+ @param byteOffset offset of the field within the payload
+ @param format numpy type string of the field elements ("f8", "f4", "i8", "i4", "u8", "u4", "i1", "u1")
+ @param elementCount number of consecutive elements, more than one compares their Euclidean norm
+ @return void
+ */
+void MessageFieldCondition::configure(uint64_t payloadAddress, uint64_t headerAddress, uint64_t byteOffset,
+                                      std::string format, uint64_t elementCount)
+{
+    if (format == "f8") {this->format = Format::Float64;}
+    else if (format == "f4") {this->format = Format::Float32;}
+    else if (format == "i8") {this->format = Format::Int64;}
+    else if (format == "i4") {this->format = Format::Int32;}
+    else if (format == "u8") {this->format = Format::UInt64;}
+    else if (format == "u4") {this->format = Format::UInt32;}
+    else if (format == "i1") {this->format = Format::Int8;}
+    else if (format == "u1") {this->format = Format::UInt8;}
+    else {
+        bskLogger.bskLog(BSK_ERROR, "MessageFieldCondition %s: unsupported field format %s.",
+                         this->name.c_str(), format.c_str());
+        return;
+    }
+    this->fieldPointer = reinterpret_cast<const char *>(payloadAddress) + byteOffset;
+    this->header = reinterpret_cast<const MsgHeader *>(headerAddress);
+    this->elementCount = elementCount > 0 ? elementCount : 1;
+}
+
+/*! This method sets the relation that stops the simulation.
+ @param relation one of "<", "<=", ">", ">=" or "settled".  "settled" holds when the value changes by
+        less than the threshold between two consecutive evaluations.
+ @param threshold threshold of the relation
+ @param holdCount number of consecutive evaluations the relation must hold before the condition is met
+ @return void
+ */
+void MessageFieldCondition::setRelation(std::string relation, double threshold, uint64_t holdCount)
+{
+    if (relation == "<") {this->relation = Relation::Less;}
+    else if (relation == "<=") {this->relation = Relation::LessEqual;}
+    else if (relation == ">") {this->relation = Relation::Greater;}
+    else if (relation == ">=") {this->relation = Relation::GreaterEqual;}
+    else if (relation == "settled") {this->relation = Relation::Settled;}
+    else {
+        bskLogger.bskLog(BSK_ERROR, "MessageFieldCondition %s: unknown relation %s.",
+                         this->name.c_str(), relation.c_str());
+        return;
+    }
+    this->threshold = threshold;
+    this->holdCount = holdCount > 0 ? holdCount : 1;
+}
+
+/*! This method clears the hold counter and the previous value
+ @return void
+ */
+void MessageFieldCondition::reset()
+{
+    this->holdCounter = 0;
+    this->hasLastValue = false;
+    this->lastValue = 0.0;
+    this->lastTimeWritten = 0;
+}
+
+/*! This method reads the field value, or the norm of the field elements
+ @return double
+ */
+double MessageFieldCondition::readValue()
+{
+    double sumSquares = 0.0;
+    double element = 0.0;
+    for (uint64_t i = 0; i < this->elementCount; i++) {
+        switch (this->format) {
+            case Format::Float64: {double v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = v; break;}
+            case Format::Float32: {float v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = v; break;}
+            case Format::Int64: {int64_t v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = (double) v; break;}
+            case Format::Int32: {int32_t v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = v; break;}
+            case Format::UInt64: {uint64_t v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = (double) v; break;}
+            case Format::UInt32: {uint32_t v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = v; break;}
+            case Format::Int8: {int8_t v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = v; break;}
+            case Format::UInt8: {uint8_t v; std::memcpy(&v, this->fieldPointer + i*sizeof(v), sizeof(v)); element = v; break;}
+        }
+        sumSquares += element*element;
+    }
+    return this->elementCount == 1 ? element : std::sqrt(sumSquares);
+}
+
+/*! This method evaluates the relation on the current field value.  Messages that were not written yet
+    never meet the condition, and the relation is only re-evaluated when the message was written again.
+ @param CurrentSimNanos current simulation time in nano-seconds
+ @return bool
+ */
+bool MessageFieldCondition::isMet(uint64_t CurrentSimNanos)
+{
+    if (this->fieldPointer == nullptr || (this->header != nullptr && !this->header->isWritten)) {
+        return false;
+    }
+    if (this->header != nullptr) {
+        if (this->hasLastValue && this->header->timeWritten == this->lastTimeWritten) {
+            return this->holdCounter >= this->holdCount;
+        }
+        this->lastTimeWritten = this->header->timeWritten;
+    }
+    double value = this->readValue();
+    bool holds = false;
+    switch (this->relation) {
+        case Relation::Less: holds = value < this->threshold; break;
+        case Relation::LessEqual: holds = value <= this->threshold; break;
+        case Relation::Greater: holds = value > this->threshold; break;
+        case Relation::GreaterEqual: holds = value >= this->threshold; break;
+        case Relation::Settled: holds = this->hasLastValue && std::fabs(value - this->lastValue) < this->threshold; break;
+    }
+    this->lastValue = value;
+    this->hasLastValue = true;
+    this->holdCounter = holds ? this->holdCounter + 1 : 0;
+    return this->holdCounter >= this->holdCount;
+}
+
+
+FlagCondition::FlagCondition()
+{
+    this->reset();
+}
+
+/*! This method clears the flag
+ @return void
+ */
+void FlagCondition::reset()
+{
+    this->triggered = false;
+    this->triggerNanos = 0;
+}
+
+/*! This method marks the condition as met at the end of the current step
+ @param CurrentSimNanos [ns] sim time of the step that triggers the condition
+ @return void
+ */
+void FlagCondition::trigger(uint64_t CurrentSimNanos)
+{
+    if(!this->triggered)
+    {
+        this->triggerNanos = CurrentSimNanos;
+        this->triggered = true;
+    }
+}
+
+/*! This method returns true once the condition has been triggered
+ @param CurrentSimNanos [ns] current simulation time
+ @return bool
+ */
+bool FlagCondition::isMet(uint64_t CurrentSimNanos)
+{
+    return this->triggered;
+}
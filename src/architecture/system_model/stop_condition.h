@@ -0,0 +1,94 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _StopCondition_HH_
+#define _StopCondition_HH_
+
+#include <stdint.h>
+#include <string>
+#include <atomic>
+#include "architecture/messaging/msgHeader.h"
+#include "architecture/utilities/bskLogging.h"
+
+//! Condition that ends a simulation run.  It is evaluated by the scheduler after each simulation step.
+class StopCondition
+{
+public:
+    StopCondition();
+    virtual ~StopCondition() {};
+    virtual void reset();                               //!< clears the condition state at the start of a run
+    virtual bool isMet(uint64_t CurrentSimNanos) = 0;   //!< evaluates the condition at the current step
+
+public:
+    std::string name;           //!< -- name reported when the condition stops the simulation
+    bool isFailure;             //!< -- flag marking the condition as a failure (constraint violation) of the run
+    BSKLogger bskLogger;        //!< -- BSK Logging
+};
+
+//! Stop condition comparing a numeric element, or the norm of consecutive elements, of a message payload to a threshold
+class MessageFieldCondition : public StopCondition
+{
+public:
+    MessageFieldCondition();
+    ~MessageFieldCondition() {};
+    void configure(uint64_t payloadAddress, uint64_t headerAddress, uint64_t byteOffset,
+                   std::string format, uint64_t elementCount=1);
+    void setRelation(std::string relation, double threshold, uint64_t holdCount=1);
+    void reset();
+    bool isMet(uint64_t CurrentSimNanos);
+    double readValue();
+
+public:
+    double threshold;           //!< -- threshold of the relation, or tolerance on the change of the value for "settled"
+    uint64_t holdCount;         //!< -- number of consecutive steps the relation must hold
+    double lastValue;           //!< -- value read at the last evaluation
+
+private:
+    enum class Relation {Less, LessEqual, Greater, GreaterEqual, Settled};
+    enum class Format {Float64, Float32, Int64, Int32, UInt64, UInt32, Int8, UInt8};
+
+    const char *fieldPointer;   //!< -- address of the first element of the payload field
+    const MsgHeader *header;    //!< -- header of the message, the condition is only evaluated once it is written
+    Format format;              //!< -- element type of the field
+    uint64_t elementCount;      //!< -- number of elements, more than one uses the Euclidean norm
+    Relation relation;          //!< -- relation between the value and the threshold
+    uint64_t holdCounter;       //!< -- number of consecutive steps the relation has held
+    bool hasLastValue;          //!< -- flag indicating that lastValue holds a previous evaluation
+    uint64_t lastTimeWritten;   //!< [ns] write time of the message at the last evaluation
+};
+
+//! Stop condition that is met once it has been triggered, e.g. by a python task that raised an exception.  It may
+//! be triggered on one thread while other threads read it.
+class FlagCondition : public StopCondition
+{
+public:
+    FlagCondition();
+    ~FlagCondition() {};
+    void reset();
+    bool isMet(uint64_t CurrentSimNanos);
+    void trigger(uint64_t CurrentSimNanos=0);
+    bool isTriggered() {return this->triggered;}  //!< returns true once the condition has been triggered
+    uint64_t getTriggerNanos() {return this->triggerNanos;}  //!< returns the sim time of the step that triggered it
+
+private:
+    std::atomic<uint64_t> triggerNanos;  //!< [ns] sim time of the step that triggered the condition
+    std::atomic<bool> triggered;         //!< -- flag indicating that the condition has been triggered
+};
+
+#endif /* _StopCondition_HH_ */
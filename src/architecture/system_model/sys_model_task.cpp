@@ -85,10 +85,38 @@ void SysModelTask::ResetTaskList(uint64_t CurrentSimTime)
 	for (ModelPair = this->TaskModels.begin(); ModelPair != this->TaskModels.end();
 	ModelPair++)
 	{
+		setLogContext((*ModelPair).ModelPtr->moduleID, CurrentSimTime);
 		(*ModelPair).ModelPtr->Reset(CurrentSimTime);
 	}
+	setLogContext(-1, CurrentSimTime);
 	this->NextStartTime = CurrentSimTime;
     this->NextPickupTime = this->NextStartTime + this->TaskPeriod;
+    this->compileSchedule();
+}
+
+/*! This method flattens the models of the Task into a contiguous dispatch table that ExecuteTaskList() walks
+ instead of the model list.  C modules in an AlgContain have their update function called directly with their
+ configuration, without the virtual UpdateState() call of the container.  The table is compiled when the Task is
+ reset, and again before the next execution if models are added or replaced.  A C update function or configuration
+ changed in an AlgContain after the reset is used from the next reset on.
+ @return void
+ */
+void SysModelTask::compileSchedule()
+{
+    this->dispatchTable.clear();
+    this->dispatchTable.reserve(this->TaskModels.size());
+    for (const auto &ModelPair : this->TaskModels)
+    {
+        TaskDispatchEntry entry;
+        entry.model = ModelPair.ModelPtr;
+        entry.moduleID = ModelPair.ModelPtr->moduleID;
+        entry.update = entry.model->directUpdate(&entry.data);
+        if (entry.update == NULL) {
+            entry.data = entry.model;
+        }
+        this->dispatchTable.push_back(entry);
+    }
+    this->dispatchCompiled = true;
 }
 
 /*! This method executes all of the models on the Task during runtime.
@@ -98,16 +126,37 @@ void SysModelTask::ResetTaskList(uint64_t CurrentSimTime)
  */
 void SysModelTask::ExecuteTaskList(uint64_t CurrentSimNanos)
 {
-    std::vector<ModelPriorityPair>::iterator ModelPair;
-    SysModel* NonIt;
-    
-    //! - Loop over all of the models in the simulation and call their UpdateState
-    for(ModelPair = this->TaskModels.begin(); (ModelPair != this->TaskModels.end() && this->taskActive);
-        ModelPair++)
-    {
-        NonIt = (ModelPair->ModelPtr);
-        NonIt->UpdateState(CurrentSimNanos);
-        NonIt->CallCounts += 1;
+    //! - Compile the dispatch table if models were added since the last reset
+    if (!this->dispatchCompiled) {
+        this->compileSchedule();
+    }
+    //! - The module context of the log records is only read by the asynchronous log backend, check it once per task
+    const bool tagLogRecords = asyncLoggingEnabled();
+    //! - Loop over the dispatch table and update each model, prefetching the data of the next one
+    if (this->taskActive) {
+        const TaskDispatchEntry *entry = this->dispatchTable.data();
+        const TaskDispatchEntry *end = entry + this->dispatchTable.size();
+        for (; entry != end; entry++)
+        {
+#if defined(__GNUC__)
+            if (entry + 1 != end) {
+                __builtin_prefetch(entry[1].data);
+                __builtin_prefetch(entry[1].model);
+            }
+#endif
+            if (tagLogRecords) {
+                setLogContext(entry->moduleID, CurrentSimNanos);
+            }
+            if (entry->update != NULL) {
+                entry->update(entry->data, CurrentSimNanos, (uint32_t) entry->moduleID);
+            } else {
+                entry->model->UpdateState(CurrentSimNanos);
+            }
+            entry->model->CallCounts += 1;
+        }
+    }
+    if (tagLogRecords) {
+        setLogContext(-1, CurrentSimNanos);
     }
     //! - NextStartTime is set to allow the scheduler to fit the next call in
     this->NextStartTime += this->TaskPeriod;
@@ -129,6 +178,7 @@ void SysModelTask::AddNewObject(SysModel *NewModel, int32_t Priority)
     LocalPair.ModelPtr = NewModel;
 //    SystemMessaging::GetInstance()->addModuleToProcess(NewModel->moduleID,
 //            parentProc);
+    this->dispatchCompiled = false;
     //! - Loop through the ModelPair vector and if Priority is higher than next, insert
     for(ModelPair = this->TaskModels.begin(); ModelPair != this->TaskModels.end();
         ModelPair++)
@@ -143,6 +193,26 @@ void SysModelTask::AddNewObject(SysModel *NewModel, int32_t Priority)
     this->TaskModels.push_back(LocalPair);
 }
 
+/*! This method replaces a model of the Task by another model, which takes over its priority and
+ place in the execution order.
+ @return bool true if the model was found in the Task
+ @param oldModel The model to remove from the Task
+ @param newModel The model taking its place
+ */
+bool SysModelTask::replaceObject(SysModel *oldModel, SysModel *newModel)
+{
+    for(auto &ModelPair : this->TaskModels)
+    {
+        if(ModelPair.ModelPtr == oldModel)
+        {
+            ModelPair.ModelPtr = newModel;
+            this->dispatchCompiled = false;
+            return true;
+        }
+    }
+    return false;
+}
+
 /*! This method changes the period of a given task over to the requested period.
    It attempts to keep the same offset relative to the original offset that
    was specified at task creation.
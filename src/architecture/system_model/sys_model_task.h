@@ -31,6 +31,14 @@ typedef struct {
     SysModel *ModelPtr;  //!< The model associated with this priority
 }ModelPriorityPair;
 
+//! Entry of the compiled dispatch table of a task, see SysModelTask::compileSchedule()
+typedef struct {
+    SysModelUpdatePtr update;  //!< C update function called directly, NULL to call UpdateState() of the model
+    void *data;  //!< data passed to the C update function, the model itself otherwise
+    SysModel *model;  //!< model updated by this entry
+    int64_t moduleID;  //!< ID of the model
+}TaskDispatchEntry;
+
 //! Class used to group a set of models into one "Task" of execution
 class SysModelTask
 {
@@ -41,6 +49,7 @@ public:
                    uint64_t FirstStartTime=0); //!< class method
     ~SysModelTask();
     void AddNewObject(SysModel *NewModel, int32_t Priority = -1);
+    bool replaceObject(SysModel *oldModel, SysModel *newModel);
     void SelfInitTaskList();
     //void CrossInitTaskList();
     void ExecuteTaskList(uint64_t CurrentSimTime);
@@ -50,6 +59,8 @@ public:
 	void disableTask() {this->taskActive = false;} //!< Disables the task.  I know.
     void updatePeriod(uint64_t newPeriod);
     void updateParentProc(std::string parent) {this->parentProc = parent;} //!< Allows the system to move task to a different process
+    void compileSchedule();
+    bool scheduleCompiled() {return this->dispatchCompiled;} //!< Returns true if the task executes from its compiled dispatch table
     
 public:
     std::vector<ModelPriorityPair> TaskModels;  //!< -- Array that has pointers to all task sysModels
@@ -62,6 +73,10 @@ public:
     uint64_t FirstTaskTime;  //!< [ns] Time to start Task for first time
 	bool taskActive;  //!< -- Flag indicating whether the Task has been disabled
   BSKLogger bskLogger;                      //!< -- BSK Logging
+
+private:
+    std::vector<TaskDispatchEntry> dispatchTable;  //!< -- models in execution order, compiled by compileSchedule()
+    bool dispatchCompiled = false;  //!< -- flag indicating that the dispatch table matches TaskModels
 };
 
 #endif /* _SysModelTask_H_ */
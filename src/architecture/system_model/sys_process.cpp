@@ -53,7 +53,7 @@ SysProcess::~SysProcess()
 }
 
 /*! This method sets the nextTaskTime = 0 and calls SelfInitTaskList() for
- * all process tasks.
+ * all process tasks.  It runs on the thread executing the process, which is where the message arena is placed.
  @return void
  */
 void SysProcess::selfInitProcess()
@@ -61,6 +61,10 @@ void SysProcess::selfInitProcess()
     std::vector<ModelScheduleEntry>::iterator it;
 
     this->nextTaskTime = 0;
+    //! - Move the placed messages to the memory of the thread executing the process
+    if (this->messageArena.messageCount() > 0) {
+        this->messageArena.placeOnCurrentNode();
+    }
     //! - Iterate through model list and call the Task model self-initializer
     for(it = this->processTasks.begin(); it != this->processTasks.end(); it++)
     {
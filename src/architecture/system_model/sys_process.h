@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include "architecture/system_model/sys_model_task.h"
 #include "architecture/utilities/bskLogging.h"
+#include "architecture/utilities/moduleIdGenerator/messageArena.h"
 
 //! Structure that contains the information needed to call a Task
 typedef struct {
@@ -59,6 +60,8 @@ public:
     void enableAllTasks(); //!< class method
     bool getProcessControlStatus() {return this->processOnThread;} //!< Allows caller to see if this process is parented by a thread
     void setProcessControlStatus(bool processTaken) {processOnThread = processTaken;} //!< Provides a mechanism to say that this process is allocated to a thread
+    void openMessageArena() {this->messageArena.open();} //!< Places the C++ messages created on the calling thread in the message arena of the process
+    void closeMessageArena() {this->messageArena.close();} //!< Stops placing messages in the message arena of the process
     
 public:
     std::vector<ModelScheduleEntry> processTasks;  //!< -- Array that has pointers to all process tasks
@@ -69,6 +72,7 @@ public:
 	bool processOnThread; //!< -- Flag indicating that the process has been added to a thread for execution
     int64_t processPriority;  //!< [-] Priority level for process (higher first)
     BSKLogger bskLogger;                      //!< -- BSK Logging
+    MessageArena messageArena;  //!< -- contiguous storage of the messages written by the process, see openMessageArena()
 };
 
 #endif /* _SysProcess_H_ */
@@ -0,0 +1,115 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "thread_channel.h"
+#include <cstring>
+#include <utility>
+
+ThreadChannelMessage::ThreadChannelMessage(uint64_t sourceThread, uint64_t targetThread, MsgHeader *sourceHeader,
+                                           void *sourcePayload, MsgHeader *targetHeader, void *targetPayload,
+                                           uint64_t payloadSize, uint64_t lookaheadNanos)
+{
+    this->sourceThread = sourceThread;
+    this->targetThread = targetThread;
+    this->sourceHeader = sourceHeader;
+    this->sourcePayload = (const char *) sourcePayload;
+    this->targetHeader = targetHeader;
+    this->targetPayload = (char *) targetPayload;
+    this->payloadSize = payloadSize;
+    this->lookaheadNanos = lookaheadNanos;
+}
+
+/*! This method is called by the source thread after each of its steps.  It records the header and payload of the
+    message, replacing the snapshot of an earlier part of the same step.
+ @param CurrentSimNanos [ns] time of the step of the source thread
+ @return void
+ */
+void ThreadChannelMessage::recordSnapshot(uint64_t CurrentSimNanos)
+{
+    std::unique_lock<std::mutex> lck(this->snapshotLock);
+    if(this->snapshots.empty() || this->snapshots.back().stepNanos != CurrentSimNanos)
+    {
+        Snapshot newSnapshot;
+        newSnapshot.stepNanos = CurrentSimNanos;
+        if(!this->freeRecords.empty())
+        {
+            newSnapshot.record.swap(this->freeRecords.back());
+            this->freeRecords.pop_back();
+        }
+        newSnapshot.record.resize(sizeof(MsgHeader) + this->payloadSize);
+        this->snapshots.push_back(std::move(newSnapshot));
+    }
+    char *record = this->snapshots.back().record.data();
+    memcpy(record, this->sourceHeader, sizeof(MsgHeader));
+    memcpy(record + sizeof(MsgHeader), this->sourcePayload, this->payloadSize);
+}
+
+/*! This method is called by the target thread before each of its steps.  It copies the latest snapshot recorded
+    at least one lookahead before the step into the copy of the message, and drops the snapshots it replaces.  In
+    the conservative mode the source thread has recorded all of these snapshots before the target thread steps, so
+    the target thread reads the same values in every run.
+ @param CurrentSimNanos [ns] time of the step of the target thread
+ @return void
+ */
+void ThreadChannelMessage::applySnapshot(uint64_t CurrentSimNanos)
+{
+    if(CurrentSimNanos < this->lookaheadNanos)
+    {
+        return;
+    }
+    uint64_t latestNanos = CurrentSimNanos - this->lookaheadNanos;
+    std::unique_lock<std::mutex> lck(this->snapshotLock);
+    if(this->snapshots.empty() || this->snapshots.front().stepNanos > latestNanos)
+    {
+        return;
+    }
+    while(this->snapshots.size() > 1 && this->snapshots[1].stepNanos <= latestNanos)
+    {
+        this->freeRecords.push_back(std::move(this->snapshots.front().record));
+        this->snapshots.pop_front();
+    }
+    const char *record = this->snapshots.front().record.data();
+    memcpy(this->targetHeader, record, sizeof(MsgHeader));
+    memcpy(this->targetPayload, record + sizeof(MsgHeader), this->payloadSize);
+    this->freeRecords.push_back(std::move(this->snapshots.front().record));
+    this->snapshots.pop_front();
+}
+
+/*! This method copies the message directly into the copy read by the target thread.  It is only called while the
+    threads are held, after the initialization of the modules.
+ @return void
+ */
+void ThreadChannelMessage::copyMessage()
+{
+    memcpy(this->targetHeader, this->sourceHeader, sizeof(MsgHeader));
+    memcpy(this->targetPayload, this->sourcePayload, this->payloadSize);
+}
+
+/*! This method drops the snapshots of a previous run
+ @return void
+ */
+void ThreadChannelMessage::clearSnapshots()
+{
+    std::unique_lock<std::mutex> lck(this->snapshotLock);
+    while(!this->snapshots.empty())
+    {
+        this->freeRecords.push_back(std::move(this->snapshots.front().record));
+        this->snapshots.pop_front();
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _ThreadChannel_HH_
+#define _ThreadChannel_HH_
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+#include <mutex>
+#include "architecture/messaging/msgHeader.h"
+
+//! Message written on one thread and read on another.  The reading modules are subscribed to a copy of the message
+//! owned by the target thread.  The source thread records a snapshot of the message after each of its steps, and
+//! the target thread copies the latest snapshot that is at least one lookahead old into its copy before each of its
+//! steps, so the two threads never access the same message memory.
+class ThreadChannelMessage
+{
+public:
+    ThreadChannelMessage(uint64_t sourceThread, uint64_t targetThread, MsgHeader *sourceHeader,
+                         void *sourcePayload, MsgHeader *targetHeader, void *targetPayload, uint64_t payloadSize,
+                         uint64_t lookaheadNanos);
+    ~ThreadChannelMessage() {};
+    void recordSnapshot(uint64_t CurrentSimNanos);
+    void applySnapshot(uint64_t CurrentSimNanos);
+    void copyMessage();
+    void clearSnapshots();
+
+public:
+    uint64_t sourceThread;      //!< -- index of the thread writing the message
+    uint64_t targetThread;      //!< -- index of the thread reading the copy of the message
+    uint64_t lookaheadNanos;    //!< [ns] age of the snapshot read by the target thread, positive
+
+private:
+    //! Header and payload of the message after a step of the source thread
+    typedef struct {
+        uint64_t stepNanos;         //!< [ns] time of the source step that recorded the snapshot
+        std::vector<char> record;   //!< header followed by the payload
+    }Snapshot;
+
+    MsgHeader *sourceHeader;    //!< -- header of the message written by the source thread
+    const char *sourcePayload;  //!< -- payload of the message written by the source thread
+    MsgHeader *targetHeader;    //!< -- header of the copy read by the target thread
+    char *targetPayload;        //!< -- payload of the copy read by the target thread
+    uint64_t payloadSize;       //!< [bytes] size of the payload
+    std::deque<Snapshot> snapshots;  //!< snapshots not yet read by the target thread, oldest first
+    std::vector<std::vector<char>> freeRecords;  //!< records of the read snapshots, reused by later snapshots
+    std::mutex snapshotLock;    //!< lock protecting the snapshots shared by the two threads
+};
+
+#endif /* _ThreadChannel_HH_ */
@@ -22,6 +22,157 @@
 #include <iostream>
 #include <cstring>
 #include <math.h>
+#include <algorithm>
+
+/*! Maximum polynomial order of the BSpline, so that the basis function tables can be allocated on the stack */
+static const int MAX_P = 14;
+typedef Eigen::Matrix<double, Eigen::Dynamic, 1, Eigen::ColMajor, MAX_P+1, 1> BasisVector;
+
+/*! This function calculates the P+1 basis functions of order P that are non-zero at time t, and their derivatives.
+ It returns the index of the first non-zero basis function, or -1 if t lies outside the knot vector.
+ The recursion is the same as in basisFunction(), but it is restricted to the knot span that contains t. */
+static int basisFunctionSpan(double t, const Eigen::VectorXd &U, int I, int P, double *NN, double *NN1, double *NN2)
+{
+    /* find the knot span U(span) <= t < U(span+1) */
+    int span;
+    if (fabs(t - U[I]) < 1e-5 * (U[I] - U[0])) {
+        span = I - 1;
+    }
+    else if (t < U[0] || t >= U[I]) {
+        return -1;
+    }
+    else {
+        span = (int) (std::upper_bound(U.data(), U.data() + I + 1, t) - U.data()) - 1;
+    }
+    int first = span - P;
+
+    /* local triangular tables of the De Boor recursion, column p holds the order p basis functions */
+    double N[MAX_P+2][MAX_P+1], N1[MAX_P+2][MAX_P+1], N2[MAX_P+2][MAX_P+1];
+    for (int l = 0; l < P+2; l++) {
+        for (int p = 0; p < P+1; p++) {
+            N[l][p]  = 0;
+            N1[l][p] = 0;
+            N2[l][p] = 0;
+        }
+    }
+    N[P][0] = 1;
+    for (int p = 1; p < P+1; p++) {
+        /* only the last p+1 basis functions of order p are non-zero */
+        for (int l = P-p; l < P+1; l++) {
+            int i = first + l;
+            if (i < 0) {
+                continue;
+            }
+            double d = U[i+p]-U[i];
+            if (d != 0) {
+                double q = p / d;
+                N[l][p]  += (t-U[i]) / d * N[l][p-1];
+                N1[l][p] += q * N[l][p-1];
+                N2[l][p] += q * N1[l][p-1];
+            }
+            d = U[i+p+1]-U[i+1];
+            if (d != 0) {
+                double q = p / d;
+                N[l][p]  += (U[i+p+1]-t) / d * N[l+1][p-1];
+                N1[l][p] -= q * N[l+1][p-1];
+                N2[l][p] -= q * N1[l+1][p-1];
+            }
+        }
+    }
+    for (int l = 0; l < P+1; l++) {
+        NN[l]  = N[l][P];
+        NN1[l] = N1[l][P];
+        NN2[l] = N2[l][P];
+    }
+
+    return first;
+}
+
+/*! This function solves the banded linear system stored in AB, with kl sub-diagonals and ku super-diagonals, using
+ Gaussian elimination with partial pivoting.  Element (i,j) is stored in AB(kl+ku+i-j, j), and AB must have 2*kl+ku+1
+ rows to hold the fill-in.  The elimination steps from kStart onwards are performed on AB and on the right hand side R.
+ If kCheckpoint >= kStart, the state of the system before step kCheckpoint is copied into checkpointAB and checkpointR. */
+static void bandedElimination(Eigen::MatrixXd &AB, Eigen::MatrixXd &R, int kl, int ku, int kStart, int kCheckpoint,
+                              Eigen::MatrixXd *checkpointAB, Eigen::MatrixXd *checkpointR)
+{
+    int n = (int) AB.cols();
+    int kv = kl + ku;
+    for (int k = kStart; k < n; k++) {
+        if (k == kCheckpoint) {
+            *checkpointAB = AB.rightCols(n - k);
+            *checkpointR = R.bottomRows(n - k);
+        }
+        int iEnd = std::min(n - 1, k + kl);
+        int jEnd = std::min(n - 1, k + kv);
+        /* partial pivoting within the band */
+        int pivot = k;
+        for (int i = k + 1; i <= iEnd; i++) {
+            if (fabs(AB(kv + i - k, k)) > fabs(AB(kv + pivot - k, k))) {
+                pivot = i;
+            }
+        }
+        if (AB(kv + pivot - k, k) == 0) {
+            std::cout << "Error in BSpline: \n the collocation matrix is singular. \n";
+        }
+        if (pivot != k) {
+            for (int j = k; j <= jEnd; j++) {
+                std::swap(AB(kv + k - j, j), AB(kv + pivot - j, j));
+            }
+            R.row(k).swap(R.row(pivot));
+        }
+        for (int i = k + 1; i <= iEnd; i++) {
+            double l = AB(kv + i - k, k) / AB(kv, k);
+            AB(kv + i - k, k) = l;
+            if (l != 0) {
+                for (int j = k + 1; j <= jEnd; j++) {
+                    AB(kv + i - j, j) -= l * AB(kv + k - j, j);
+                }
+                R.row(i) -= l * R.row(k);
+            }
+        }
+    }
+    if (kCheckpoint >= n) {
+        checkpointAB->resize(AB.rows(), 0);
+        checkpointR->resize(0, R.cols());
+    }
+}
+
+/*! This function solves the symmetric positive definite banded system A X = R, where A has bandwidth P and its lower
+ band is stored as L(d, j) = A(j+d, j), with a banded Cholesky factorization.  The solution overwrites R. */
+static void bandedCholeskySolve(Eigen::MatrixXd &L, int P, Eigen::MatrixXd &R)
+{
+    int n = (int) L.cols();
+    for (int j = 0; j < n; j++) {
+        double d = L(0, j);
+        for (int k = std::max(0, j - P); k < j; k++) {
+            d -= L(j - k, k) * L(j - k, k);
+        }
+        if (d <= 0) {
+            std::cout << "Error in BSpline.approximate: \n the least squares matrix is not positive definite. \n";
+        }
+        L(0, j) = sqrt(d);
+        for (int i = j + 1; i <= std::min(n - 1, j + P); i++) {
+            double v = L(i - j, j);
+            for (int k = std::max(0, i - P); k < j; k++) {
+                v -= L(i - k, k) * L(j - k, k);
+            }
+            L(i - j, j) = v / L(0, j);
+        }
+    }
+    /* forward substitution with L, then back substitution with L^T */
+    for (int i = 0; i < n; i++) {
+        for (int k = std::max(0, i - P); k < i; k++) {
+            R.row(i) -= L(i - k, k) * R.row(k);
+        }
+        R.row(i) /= L(0, i);
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        for (int k = i + 1; k <= std::min(n - 1, i + P); k++) {
+            R.row(i) -= L(k - i, i) * R.row(k);
+        }
+        R.row(i) /= L(0, i);
+    }
+}
 
 /*! This constructor initializes an Input structure for BSpline interpolation */
 InputDataSet::InputDataSet()
@@ -103,17 +254,30 @@ void OutputDataSet::getData(double T, double x[3], double xDot[3], double xDDot[
     if (T <= Ttot) {
         double t = T / Ttot;
         int Q = (int) this->C1.size();
-        Eigen::VectorXd NN(Q), NN1(Q), NN2(Q);
-        basisFunction(t, this->U, Q, this->P, &NN[0], &NN1[0], &NN2[0]);
-        x[0] = NN.dot(this->C1);
-        x[1] = NN.dot(this->C2);
-        x[2] = NN.dot(this->C3);
-        xDot[0] = NN1.dot(this->C1) / Ttot;
-        xDot[1] = NN1.dot(this->C2) / Ttot;
-        xDot[2] = NN1.dot(this->C3) / Ttot;
-        xDDot[0] = NN2.dot(this->C1) / pow(Ttot,2);
-        xDDot[1] = NN2.dot(this->C2) / pow(Ttot,2);
-        xDDot[2] = NN2.dot(this->C3) / pow(Ttot,2);
+        BasisVector NN(this->P+1), NN1(this->P+1), NN2(this->P+1);
+        int first = basisFunctionSpan(t, this->U, Q, this->P, &NN[0], &NN1[0], &NN2[0]);
+        for (int i = 0; i < 3; i++) {
+            x[i] = 0;
+            xDot[i] = 0;
+            xDDot[i] = 0;
+        }
+        if (first >= 0) {
+            for (int l = 0; l < this->P+1; l++) {
+                x[0] += NN[l] * this->C1[first+l];
+                x[1] += NN[l] * this->C2[first+l];
+                x[2] += NN[l] * this->C3[first+l];
+                xDot[0] += NN1[l] * this->C1[first+l];
+                xDot[1] += NN1[l] * this->C2[first+l];
+                xDot[2] += NN1[l] * this->C3[first+l];
+                xDDot[0] += NN2[l] * this->C1[first+l];
+                xDDot[1] += NN2[l] * this->C2[first+l];
+                xDDot[2] += NN2[l] * this->C3[first+l];
+            }
+        }
+        for (int i = 0; i < 3; i++) {
+            xDot[i] = xDot[i] / Ttot;
+            xDDot[i] = xDDot[i] / pow(Ttot,2);
+        }
     }
     // if t > Ttot return final value with zero derivatives
     else {
@@ -129,283 +293,511 @@ void OutputDataSet::getData(double T, double x[3], double xDot[3], double xDDot[
     }
 }
 
+/*! This method returns x, xDot and xDDot at num input times t.  Each evaluation only involves the P+1 basis
+ functions that are non-zero at that time, so its cost does not depend on the number of control points. */
+void OutputDataSet::getDataBatch(int num, const double *t, double (*x)[3], double (*xDot)[3], double (*xDDot)[3])
+{
+    for (int k = 0; k < num; k++) {
+        this->getData(t[k], x[k], xDot[k], xDDot[k]);
+    }
+}
+
+/*! This method returns the coordinates of x (derivative = 0), xDot (derivative = 1) or xDDot (derivative = 2)
+ at all the desired input times T, as the rows of a matrix. */
+/*! It is designed to be accessible from Python */
+Eigen::MatrixXd OutputDataSet::getStatesBatch(Eigen::VectorXd T, int derivative)
+{
+    int num = (int) T.size();
+    Eigen::MatrixXd states(num, 3);
+    if (derivative < 0 || derivative > 2) {
+        std::cout << "Error in Output.getStatesBatch: invalid derivative \n";
+        states.setConstant(1000);
+        return states;
+    }
+    std::vector<double> x(3*num), xDot(3*num), xDDot(3*num);
+    this->getDataBatch(num, T.data(), (double (*)[3]) x.data(), (double (*)[3]) xDot.data(), (double (*)[3]) xDDot.data());
+    const std::vector<double> &source = (derivative == 0) ? x : ((derivative == 1) ? xDot : xDDot);
+    for (int k = 0; k < num; k++) {
+        for (int i = 0; i < 3; i++) {
+            states(k, i) = source[3*k + i];
+        }
+    }
+    return states;
+}
+
 /*! This method returns single coordinates of x, xDot and xDDot at the desired input time T. */
 /*! It is designed to be accessible from Python */
 double OutputDataSet::getStates(double T, int derivative, int index)
 {
-    int N = (int) this->T.size()-1;
-    double Ttot = this->T[N];
+    double x[3], xDot[3], xDDot[3];
+    this->getData(T, x, xDot, xDDot);
 
-    // if T < Ttot calculalte the values
-    if (T <= Ttot) {
-        double t = T / Ttot;
-        int Q = (int) this->C1.size();
-        Eigen::VectorXd NN(Q), NN1(Q), NN2(Q);
-        basisFunction(t, this->U, Q, this->P, &NN[0], &NN1[0], &NN2[0]);
-
-        switch (derivative) {
-            case 0 :
-                switch(index) {
-                    case 0 :
-                        return NN.dot(this->C1);
-                    case 1 :
-                        return NN.dot(this->C2);
-                    case 2 :
-                        return NN.dot(this->C3);
-                    default :
-                        std::cout << "Error in Output.getStates: invalid index \n";
-                        return 1000;
-                }
-            case 1 :
-                switch(index) {
-                    case 0 :
-                        return NN1.dot(this->C1) / Ttot;
-                    case 1 :
-                        return NN1.dot(this->C2) / Ttot;
-                    case 2 :
-                        return NN1.dot(this->C3) / Ttot;
-                    default :
-                        std::cout << "Error in Output.getStates: invalid index \n";
-                        return 1000;
-                }
-            case 2 :
-                switch(index) {
-                    case 0 :
-                        return NN2.dot(this->C1) / pow(Ttot,2);
-                    case 1 :
-                        return NN2.dot(this->C2) / pow(Ttot,2);
-                    case 2 :
-                        return NN2.dot(this->C3) / pow(Ttot,2);
-                    default :
-                        std::cout << "Error in Output.getStates: invalid index \n";
-                        return 1000;
-                }
-            default :
-                std::cout << "Error in Output.getStates: invalid derivative \n";
-                return 1000;
-        }
+    if (index < 0 || index > 2) {
+        std::cout << "Error in Output.getStates: invalid index \n";
+        return 1000;
     }
-    // if t > Ttot return final value with zero derivatives
-    else {
-        switch (derivative) {
-            case 0 :
-                switch(index) {
-                    case 0 :
-                        return this->X1[N];
-                    case 1 :
-                        return this->X2[N];
-                    case 2 :
-                        return this->X3[N];
-                    default :
-                        std::cout << "Error in Output.getStates: invalid index \n";
-                        return 1000;
-                }
-            case 1 :
-                switch(index) {
-                    case 0 :
-                        return 0;
-                    case 1 :
-                        return 0;
-                    case 2 :
-                        return 0;
-                    default :
-                        std::cout << "Error in Output.getStates: invalid index \n";
-                        return 1000;
-                }
-            case 2 :
-                switch(index) {
-                    case 0 :
-                        return 0;
-                    case 1 :
-                        return 0;
-                    case 2 :
-                        return 0;
-                    default :
-                        std::cout << "Error in Output.getStates: invalid index \n";
-                        return 1000;
-                }
-            default :
-                std::cout << "Error in Output.getStates: invalid derivative \n";
-                return 1000;
+    switch (derivative) {
+        case 0 :
+            return x[index];
+        case 1 :
+            return xDot[index];
+        case 2 :
+            return xDDot[index];
+        default :
+            std::cout << "Error in Output.getStates: invalid derivative \n";
+            return 1000;
+    }
+}
+
+/*! This function samples the BSpline stored in Output at Num equally spaced times, filling the time tags and the
+ interpolated trajectory of the Output structure */
+static void sampleOutput(int Num, double Ttot, OutputDataSet *Output)
+{
+    int P = Output->P;
+    int Q = (int) Output->C1.size();
+    double dt = 1.0 / (Num - 1);
+    double t = 0;
+    BasisVector NN(P+1), NN1(P+1), NN2(P+1);
+    // store the interpolated trajectory information into Output structure
+    Output->T.resize(Num);
+    Output->X1.resize(Num);
+    Output->X2.resize(Num);
+    Output->X3.resize(Num);
+    Output->XD1.resize(Num);
+    Output->XD2.resize(Num);
+    Output->XD3.resize(Num);
+    Output->XDD1.resize(Num);
+    Output->XDD2.resize(Num);
+    Output->XDD3.resize(Num);
+    for (int i = 0; i < Num; i++) {
+        int first = basisFunctionSpan(t, Output->U, Q, P, &NN[0], &NN1[0], &NN2[0]);
+        double x[3] = {0, 0, 0}, xD[3] = {0, 0, 0}, xDD[3] = {0, 0, 0};
+        if (first >= 0) {
+            for (int l = 0; l < P+1; l++) {
+                x[0] += NN[l] * Output->C1[first+l];
+                x[1] += NN[l] * Output->C2[first+l];
+                x[2] += NN[l] * Output->C3[first+l];
+                xD[0] += NN1[l] * Output->C1[first+l];
+                xD[1] += NN1[l] * Output->C2[first+l];
+                xD[2] += NN1[l] * Output->C3[first+l];
+                xDD[0] += NN2[l] * Output->C1[first+l];
+                xDD[1] += NN2[l] * Output->C2[first+l];
+                xDD[2] += NN2[l] * Output->C3[first+l];
+            }
         }
+        Output->T[i] = t * Ttot;
+        Output->X1[i] = x[0];
+        Output->X2[i] = x[1];
+        Output->X3[i] = x[2];
+        Output->XD1[i]  = xD[0] / Ttot;
+        Output->XD2[i]  = xD[1] / Ttot;
+        Output->XD3[i]  = xD[2] / Ttot;
+        Output->XDD1[i] = xDD[0] / pow(Ttot,2);
+        Output->XDD2[i] = xDD[1] / pow(Ttot,2);
+        Output->XDD3[i] = xDD[2] / pow(Ttot,2);
+        t += dt;
     }
 }
 
-/*! This function takes the Input structure, performs the BSpline interpolation and outputs the result into Output structure */
-void interpolate(InputDataSet Input, int Num, int P, OutputDataSet *Output)
-{   
-    Output->P = P;
+/*! The constructor initializes an empty interpolator */
+BSplineInterpolator::BSplineInterpolator()
+{
+    this->P = 0;
+    this->N = -1;
+    this->K = 0;
+    this->n0 = 0;
+    this->kl = 0;
+    this->ku = 0;
+    this->checkpointStep = 0;
+    this->fitted = false;
+
+    return;
+}
+
+/*! Generic destructor */
+BSplineInterpolator::~BSplineInterpolator()
+{
+    return;
+}
+
+/*! This method computes the BSpline of order P that interpolates the waypoints contained in the Input structure.
+ The system is assembled and solved in the time units of the waypoints, which is equivalent to the normalized
+ formulation of interpolate(), but leaves the rows of the first waypoints unchanged when waypoints are appended. */
+void BSplineInterpolator::fit(InputDataSet Input, int P)
+{
+    this->fitted = false;
+    if (P < 1 || P > MAX_P) {
+        std::cout << "Error in BSpline.interpolate: \n the polynomial order P must be between 1 and 14. \n";
+        return;
+    }
+    this->input = Input;
+    this->P = P;
+
+    // N = number of waypoints - 1
+    this->N = (int) Input.X1.size() - 1;
+    int N = this->N;
 
-    // N = number of waypoints - 1 
-    int N = (int) Input.X1.size() - 1;
-    
     // T = time tags; if not specified, it is computed from a cartesian distance assuming a constant velocity norm on average
-    Eigen::VectorXd T(N+1);
+    this->T.resize(N+1);
     double S = 0;
     if (Input.T_flag == true) {
-        T = Input.T;
+        this->T = Input.T;
     }
     else {
-        T[0] = 0;
+        this->T[0] = 0;
         for (int n = 1; n < N+1; n++) {
-            T[n] = T[n-1] + pow( (pow(Input.X1[n]-Input.X1[n-1], 2) + pow(Input.X2[n]-Input.X2[n-1], 2) + pow(Input.X3[n]-Input.X3[n-1], 2)), 0.5 );
-            S += T[n] - T[n-1];
+            this->T[n] = this->T[n-1] + pow( (pow(Input.X1[n]-Input.X1[n-1], 2) + pow(Input.X2[n]-Input.X2[n-1], 2) + pow(Input.X3[n]-Input.X3[n-1], 2)), 0.5 );
+            S += this->T[n] - this->T[n-1];
         }
     }
     if (Input.AvgXDot_flag == true) {
         for (int n = 0; n < N+1; n++) {
-            T[n] = T[n] / T[N] * S / Input.AvgXDot;
+            this->T[n] = this->T[n] / this->T[N] * S / Input.AvgXDot;
         }
     }
 
-    double Ttot = T[N];
-
-    // build uk vector: normalized waypoint time tags
-    Eigen::VectorXd uk(N+1);
-    for (int n = 0; n < N+1; n++) {
-        uk[n] = T[n] / Ttot;
-    }
-
     // K = number of endpoint derivatives
-    int K = 0;
-    if (Input.XDot_0_flag == true) {K += 1;}
-    if (Input.XDot_N_flag == true) {K += 1;}
-    if (Input.XDDot_0_flag == true) {K += 1;}
-    if (Input.XDDot_N_flag == true) {K += 1;}
-    
+    this->K = 0;
+    this->n0 = 0;
+    if (Input.XDot_0_flag == true) {this->K += 1;  this->n0 += 1;}
+    if (Input.XDot_N_flag == true) {this->K += 1;}
+    if (Input.XDDot_0_flag == true) {this->K += 1;  this->n0 += 1;}
+    if (Input.XDDot_N_flag == true) {this->K += 1;}
+
     // The maximum polynomial order is N + K. If a higher order is requested, print a BSK_ERROR
-    if (P > N + K) {
+    if (P > N + this->K) {
         std::cout << "Error in BSpline.interpolate: \n the desired polynomial order P is too high. Mass matrix A will be singular. \n" ;
     }
 
-    int M = N + P + K + 1;
+    this->computeKnots(0);
+    this->span.resize(N+1);
+
+    // assemble the collocation matrix in banded storage
+    int n = N + this->K + 1;
+    std::vector<BandRow> rows;
+    this->computeRows(0, rows);
+    this->kl = 0;
+    this->ku = 0;
+    for (int i = 0; i < n; i++) {
+        this->kl = std::max(this->kl, i - rows[i].firstCol);
+        this->ku = std::max(this->ku, rows[i].firstCol + (int) rows[i].values.size() - 1 - i);
+    }
+    int kv = this->kl + this->ku;
+    this->AB = Eigen::MatrixXd::Zero(2*this->kl + this->ku + 1, n);
+    this->R.resize(n, 3);
+    for (int i = 0; i < n; i++) {
+        for (int b = 0; b < (int) rows[i].values.size(); b++) {
+            int j = rows[i].firstCol + b;
+            this->AB(kv + i - j, j) = rows[i].values[b];
+        }
+        this->R.row(i) << rows[i].rhs[0], rows[i].rhs[1], rows[i].rhs[2];
+    }
+
+    // factorize, keeping a checkpoint before the rows that the next appended waypoint modifies
+    this->factorize(0, std::max(0, this->firstChangedRow() - this->kl));
+    this->solve();
+    this->fitted = true;
+
+    return;
+}
+
+/*! This method appends a waypoint at the end of the interpolated trajectory and updates the BSpline.  Only the knots
+ and rows of the collocation matrix that depend on the last waypoints are recomputed, and the LU factorization is
+ resumed from the checkpoint stored by the previous fit, so the cost of the update does not grow with the number of
+ waypoints, except for the back substitution.  The time tag T is used when the time tags were specified with setT(),
+ otherwise it is computed from the cartesian distance to the last waypoint.  When the time tags are scaled by
+ setAvgXDot(), the whole BSpline is recomputed. */
+void BSplineInterpolator::appendWaypoint(double T, Eigen::Vector3d X)
+{
+    if (!this->fitted) {
+        std::cout << "Error in BSplineInterpolator.appendWaypoint: \n fit() must be called before appending waypoints. \n";
+        return;
+    }
+    int N = this->N;
+    double Tnew;
+    if (this->input.T_flag == true) {
+        Tnew = T;
+    }
+    else {
+        Tnew = this->T[N] + pow( (pow(X[0]-this->input.X1[N], 2) + pow(X[1]-this->input.X2[N], 2) + pow(X[2]-this->input.X3[N], 2)), 0.5 );
+    }
+    if (Tnew <= this->T[N]) {
+        std::cout << "Error in BSplineInterpolator.appendWaypoint: \n the time tag of the new waypoint must be larger than the last time tag. \n";
+        return;
+    }
+
+    // extend the stored waypoints
+    this->input.X1.conservativeResize(N+2);
+    this->input.X2.conservativeResize(N+2);
+    this->input.X3.conservativeResize(N+2);
+    this->input.X1[N+1] = X[0];
+    this->input.X2[N+1] = X[1];
+    this->input.X3[N+1] = X[2];
+    if (this->input.T_flag == true) {
+        this->input.T.conservativeResize(N+2);
+        this->input.T[N+1] = Tnew;
+    }
+    if (this->input.AvgXDot_flag == true) {
+        this->fit(this->input, this->P);
+        return;
+    }
+
+    int r = this->firstChangedRow();
+    int kStart = this->checkpointStep;
+    int firstKnot = this->firstChangedKnot();
+    int nOld = N + this->K + 1;
+    this->N = N + 1;
+    this->T.conservativeResize(this->N+1);
+    this->T[this->N] = Tnew;
+    this->span.conservativeResize(this->N+1);
+    this->computeKnots(firstKnot);
+
+    // recompute the trailing rows; the bandwidth must not grow for the checkpoint to be valid
+    int n = this->N + this->K + 1;
+    std::vector<BandRow> rows;
+    this->computeRows(r, rows);
+    for (int i = r; i < n; i++) {
+        const BandRow &row = rows[i - r];
+        if (i - row.firstCol > this->kl || row.firstCol + (int) row.values.size() - 1 - i > this->ku) {
+            this->fit(this->input, this->P);
+            return;
+        }
+    }
+    int kCheckpoint = std::max(0, this->firstChangedRow() - this->kl);
+    if (kCheckpoint < kStart) {
+        this->fit(this->input, this->P);
+        return;
+    }
+
+    // restore the system at the checkpoint and replace the trailing rows
+    int kv = this->kl + this->ku;
+    Eigen::MatrixXd &AB = this->AB;
+    Eigen::MatrixXd &R = this->R;
+    AB.conservativeResize(Eigen::NoChange, n);
+    R.conservativeResize(n, Eigen::NoChange);
+    AB.middleCols(kStart, nOld - kStart) = this->checkpointAB;
+    AB.rightCols(n - nOld).setZero();
+    R.middleRows(kStart, nOld - kStart) = this->checkpointR;
+    R.bottomRows(n - nOld).setZero();
+    for (int i = r; i < n; i++) {
+        for (int j = std::max(0, i - this->kl); j <= std::min(n - 1, i + kv); j++) {
+            AB(kv + i - j, j) = 0;
+        }
+        const BandRow &row = rows[i - r];
+        for (int b = 0; b < (int) row.values.size(); b++) {
+            int j = row.firstCol + b;
+            AB(kv + i - j, j) = row.values[b];
+        }
+        R.row(i) << row.rhs[0], row.rhs[1], row.rhs[2];
+    }
+
+    this->factorize(kStart, kCheckpoint);
+    this->solve();
+
+    return;
+}
+
+/*! This method stores the BSpline and Num equally spaced samples of the interpolated trajectory into Output */
+void BSplineInterpolator::getOutput(int Num, OutputDataSet *Output)
+{
+    if (!this->fitted) {
+        std::cout << "Error in BSplineInterpolator.getOutput: \n fit() must be called before getOutput(). \n";
+        return;
+    }
+    double Ttot = this->T[this->N];
+    Output->P = this->P;
+    Output->U = this->U / Ttot;
+    Output->C1 = this->C.col(0);
+    Output->C2 = this->C.col(1);
+    Output->C3 = this->C.col(2);
+    sampleOutput(Num, Ttot, Output);
+
+    return;
+}
+
+/*! This method returns the number of interpolated waypoints */
+int BSplineInterpolator::getNumberOfWaypoints()
+{
+    return this->N + 1;
+}
+
+/*! This method builds the knot vector U by averaging the time tags of the waypoints.  The knots before firstKnot
+ are assumed to be up to date. */
+void BSplineInterpolator::computeKnots(int firstKnot)
+{
+    int N = this->N;
+    int P = this->P;
+    int M = N + P + this->K + 1;
 
     // build knot vector U of size M + 1
-    Eigen::VectorXd U(M+1);
+    this->U.conservativeResize(M+1);
     double u;
     for (int p = 0; p < P+1; p++) {
-        U[p] = 0;
+        this->U[p] = 0;
     }
-    for (int j = 0; j < M-2*P-1; j++) {
+    for (int j = std::max(0, firstKnot-P-1); j < M-2*P-1; j++) {
         u = 0.0;
         for (int i = j; i < j+P; i++) {
-            if (i >= uk.size()) {
-                u += uk[N] / P;
+            if (i >= N+1) {
+                u += this->T[N] / P;
             }
             else {
-                u += uk[i] / P;
+                u += this->T[i] / P;
             }
-        U[P+j+1] = u;
         }
+        this->U[P+j+1] = u;
     }
     for (int p = 0; p < P+1; p++) {
-        U[M-P+p] = 1;
+        this->U[M-P+p] = this->T[N];
     }
+}
 
-    // build stiffness matrix A of size (N+K+1)x(N+K+1)
-    Eigen::MatrixXd A(N+K+1,N+K+1);
-    // build vectors Q1, Q2, Q3 (left hand side of linear system)
-    Eigen::VectorXd Q1(N+K+1), Q2(N+K+1), Q3(N+K+1);
-    // populate A with zeros
-    for (int n = 0; n < N+K+1; n++) {
-        for (int m = 0; m < N+K+1; m++) {
-            A(n,m) = 0;
-        }
-    }
+/*! This method computes the rows of the collocation system from firstRow onwards.  The rows are, in order: the
+ starting point derivative constraints, one row per waypoint, and the final point derivative constraints. */
+void BSplineInterpolator::computeRows(int firstRow, std::vector<BandRow> &rows)
+{
+    int N = this->N;
+    int P = this->P;
+    int M = N + P + this->K + 1;
+    double Te = this->T[N];
+    BandRow row;
     int n = -1;
+    rows.clear();
+
     // constrain first derivative at starting point
-    if (Input.XDot_0_flag == true) {
+    if (this->input.XDot_0_flag == true) {
         n += 1;
-        A(n,0) = -1;
-        A(n,1) =  1;
-        Q1[n] = U[P+1] / P * Input.XDot_0[0] * Ttot;
-        Q2[n] = U[P+1] / P * Input.XDot_0[1] * Ttot;
-        Q3[n] = U[P+1] / P * Input.XDot_0[2] * Ttot;
+        if (n >= firstRow) {
+            row.firstCol = 0;
+            row.values = {-1, 1};
+            for (int c = 0; c < 3; c++) {
+                row.rhs[c] = this->U[P+1] / P * this->input.XDot_0[c];
+            }
+            rows.push_back(row);
+        }
     }
     // constrain second derivative at starting point
-    if (Input.XDDot_0_flag == true) {
+    if (this->input.XDDot_0_flag == true) {
         n += 1;
-        A(n,0) = U[P+2];
-        A(n,1) = -(U[P+1] + U[P+2]);
-        A(n,2) = U[P+1];
-        Q1[n] = ( pow(U[P+1],2) * U[P+2] / (P*(P-1)) ) * Input.XDDot_0[0] * pow(Ttot,2);
-        Q2[n] = ( pow(U[P+1],2) * U[P+2] / (P*(P-1)) ) * Input.XDDot_0[1] * pow(Ttot,2);
-        Q3[n] = ( pow(U[P+1],2) * U[P+2] / (P*(P-1)) ) * Input.XDDot_0[2] * pow(Ttot,2);
+        if (n >= firstRow) {
+            row.firstCol = 0;
+            row.values = {this->U[P+2], -(this->U[P+1] + this->U[P+2]), this->U[P+1]};
+            for (int c = 0; c < 3; c++) {
+                row.rhs[c] = ( pow(this->U[P+1],2) * this->U[P+2] / (P*(P-1)) ) * this->input.XDDot_0[c];
+            }
+            rows.push_back(row);
+        }
     }
-    n += 1;
-    int m = -1;
-    int n0 = n;
-    Eigen::VectorXd NN(N+K+1), NN1(N+K+1), NN2(N+K+1);
     // constrain waypoints
-    for (n = n0; n < N+n0+1; n++) {
-        m += 1;
-        basisFunction(uk[m], U, N+K+1, P, &NN[0], &NN1[0], &NN2[0]);
-        for (int b = 0; b < N+K+1; b++) {
-            A(n,b) = NN[b];
+    BasisVector NN(P+1), NN1(P+1), NN2(P+1);
+    for (int m = 0; m < N+1; m++) {
+        n += 1;
+        if (n >= firstRow) {
+            int first = basisFunctionSpan(this->T[m], this->U, N+this->K+1, P, &NN[0], &NN1[0], &NN2[0]);
+            if (first < 0) {
+                std::cout << "Error in BSpline.interpolate: \n the waypoint time tags must start at zero and be increasing. \n";
+                first = 0;
+                NN.setZero();
+            }
+            this->span[m] = first + P;
+            row.firstCol = first;
+            row.values.assign(NN.data(), NN.data() + P+1);
+            row.rhs[0] = this->input.X1[m];
+            row.rhs[1] = this->input.X2[m];
+            row.rhs[2] = this->input.X3[m];
+            rows.push_back(row);
         }
-        Q1[n] = Input.X1[m];
-        Q2[n] = Input.X2[m];
-        Q3[n] = Input.X3[m];
     }
-    n = N+n0;
     // constrain second derivative at final point
-    if (Input.XDDot_N_flag == true) {
+    if (this->input.XDDot_N_flag == true) {
         n += 1;
-        A(n,N+K-2) = 1 - U[M-P-1];
-        A(n,N+K-1) = -(2 - U[M-P-1] - U[M-P-2]);
-        A(n,N+K) = 1 - U[M-P-2];
-        Q1[n] = ( pow((1-U[M-P-1]),2) * (1-U[M-P-2]) / (P*(P-1)) ) * Input.XDDot_N[0] * pow(Ttot,2);
-        Q2[n] = ( pow((1-U[M-P-1]),2) * (1-U[M-P-2]) / (P*(P-1)) ) * Input.XDDot_N[1] * pow(Ttot,2);
-        Q3[n] = ( pow((1-U[M-P-1]),2) * (1-U[M-P-2]) / (P*(P-1)) ) * Input.XDDot_N[2] * pow(Ttot,2);
+        if (n >= firstRow) {
+            row.firstCol = N + this->K - 2;
+            row.values = {Te - this->U[M-P-1], -(2*Te - this->U[M-P-1] - this->U[M-P-2]), Te - this->U[M-P-2]};
+            for (int c = 0; c < 3; c++) {
+                row.rhs[c] = ( pow((Te - this->U[M-P-1]),2) * (Te - this->U[M-P-2]) / (P*(P-1)) ) * this->input.XDDot_N[c];
+            }
+            rows.push_back(row);
+        }
     }
     // constrain first derivative at final point
-    if (Input.XDot_N_flag == true) {
+    if (this->input.XDot_N_flag == true) {
         n += 1;
-        A(n,N+K-1) = -1;
-        A(n,N+K) = 1;
-        Q1[n] = (1-U[M-P-1]) / P * Input.XDot_N[0] * Ttot;
-        Q2[n] = (1-U[M-P-1]) / P * Input.XDot_N[1] * Ttot;
-        Q3[n] = (1-U[M-P-1]) / P * Input.XDot_N[2] * Ttot;
+        if (n >= firstRow) {
+            row.firstCol = N + this->K - 1;
+            row.values = {-1, 1};
+            for (int c = 0; c < 3; c++) {
+                row.rhs[c] = (Te - this->U[M-P-1]) / P * this->input.XDot_N[c];
+            }
+            rows.push_back(row);
+        }
     }
+}
 
-    // solve linear systems
-    Eigen::MatrixXd B = A.inverse();
-    Eigen::VectorXd C1 = B * Q1;
-    Eigen::VectorXd C2 = B * Q2;
-    Eigen::VectorXd C3 = B * Q3;
+/*! This method returns the index of the first knot that changes when a waypoint is appended, which is the first
+ knot that averages the last time tag, or the first of the end knots */
+int BSplineInterpolator::firstChangedKnot()
+{
+    int N = this->N;
+    int P = this->P;
+    int M = N + P + this->K + 1;
+    return std::min(P + std::max(N-P+1, 0) + 1, M-P);
+}
 
-    Output->U = U;
-    Output->C1 = C1;
-    Output->C2 = C2;
-    Output->C3 = C3;
+/*! This method returns the index of the first row of the collocation system that changes when a waypoint is appended.
+ Appending a waypoint modifies the knots that average the last time tags, hence only the rows whose basis functions
+ depend on those knots. */
+int BSplineInterpolator::firstChangedRow()
+{
+    int N = this->N;
+    int P = this->P;
+    int firstKnot = this->firstChangedKnot();
+    if (firstKnot <= P+2 && this->n0 > 0) {
+        return 0;
+    }
+    // the knot spans and time tags increase with the waypoint index, so search backwards from the last waypoint
+    int m = N;
+    while (m > 0 && (this->span[m-1] + P + 1 >= firstKnot
+                     || fabs(this->T[m-1] - this->T[N]) < 1e-5 * (this->T[N] - this->U[0]))) {
+        m -= 1;
+    }
+    return this->n0 + m;
+}
 
-    double dt = 1.0 / (Num - 1);
-    double t = 0;
-    // store the interpolated trajectory information into Output structure
-    Output->T.resize(Num);
-    Output->X1.resize(Num);
-    Output->X2.resize(Num);
-    Output->X3.resize(Num);
-    Output->XD1.resize(Num);
-    Output->XD2.resize(Num);
-    Output->XD3.resize(Num);
-    Output->XDD1.resize(Num);
-    Output->XDD2.resize(Num);    
-    Output->XDD3.resize(Num);
-    for (int i = 0; i < Num; i++) {
-        basisFunction(t, U, N+K+1, P, &NN[0], &NN1[0], &NN2[0]);
-        Output->T[i] = t * Ttot;
-        Output->X1[i] = NN.dot(C1);
-        Output->X2[i] = NN.dot(C2);
-        Output->X3[i] = NN.dot(C3);
-        Output->XD1[i]  = NN1.dot(C1) / Ttot;
-        Output->XD2[i]  = NN1.dot(C2) / Ttot;
-        Output->XD3[i]  = NN1.dot(C3) / Ttot;
-        Output->XDD1[i] = NN2.dot(C1) / pow(Ttot,2);
-        Output->XDD2[i] = NN2.dot(C2) / pow(Ttot,2);
-        Output->XDD3[i] = NN2.dot(C3) / pow(Ttot,2);
-        t += dt;
+/*! This method performs the banded LU factorization from step kStart onwards, storing a checkpoint before step
+ kCheckpoint */
+void BSplineInterpolator::factorize(int kStart, int kCheckpoint)
+{
+    bandedElimination(this->AB, this->R, this->kl, this->ku, kStart, kCheckpoint, &this->checkpointAB, &this->checkpointR);
+    this->checkpointStep = kCheckpoint;
+}
+
+/*! This method computes the control points by back substitution with the upper triangular factor */
+void BSplineInterpolator::solve()
+{
+    int n = (int) this->AB.cols();
+    int kv = this->kl + this->ku;
+    this->C.resize(n, 3);
+    for (int i = 0; i < 3; i++) {
+        const double *r = this->R.col(i).data();
+        double *c = this->C.col(i).data();
+        for (int k = n - 1; k >= 0; k--) {
+            const double *a = this->AB.col(0).data();
+            double v = r[k];
+            for (int j = k + 1; j <= std::min(n - 1, k + kv); j++) {
+                v -= a[j * this->AB.rows() + kv + k - j] * c[j];
+            }
+            c[k] = v / a[k * this->AB.rows() + kv];
+        }
     }
+}
+
+/*! This function takes the Input structure, performs the BSpline interpolation and outputs the result into Output structure */
+void interpolate(InputDataSet Input, int Num, int P, OutputDataSet *Output)
+{
+    BSplineInterpolator interpolator;
+    interpolator.fit(Input, P);
+    interpolator.getOutput(Num, Output);
 
     return;
 }
@@ -413,6 +805,10 @@ void interpolate(InputDataSet Input, int Num, int P, OutputDataSet *Output)
 /*! This function takes the Input structure, performs the BSpline LS approximation and outputs the result into Output structure */
 void approximate(InputDataSet Input, int Num, int Q, int P, OutputDataSet *Output)
 {   
+    if (P < 1 || P > MAX_P) {
+        std::cout << "Error in BSpline.approximate: \n the polynomial order P must be between 1 and 14. \n";
+        return;
+    }
     Output->P = P;
 
     // N = number of waypoints - 1 
@@ -542,78 +938,71 @@ void approximate(InputDataSet Input, int Num, int Q, int P, OutputDataSet *Outpu
     Eigen::VectorXd C2_1 = B * T2;
     Eigen::VectorXd C3_1 = B * T3;
 
-    // populate Rk vectors with the base points for LS minimization
-    Eigen::VectorXd Rk1(N-1), Rk2(N-1), Rk3(N-1);
+    // populate the LS normal matrix ND^T * W * ND and the vectors ND^T * W * Rk, where Rk are the base points for LS
+    // minimization. ND only has P+1 non-zero basis functions per row, so the normal matrix is banded with bandwidth P
+    // and it is stored by its lower band, NWN(d,b) being the element in row b+d and column b
+    int k = 1;
+    if (Input.XDot_0_flag == true) {k += 1;}
+    if (Input.XDDot_0_flag == true) {k += 1;}
+    int nLS = Q-K-1;
+    Eigen::MatrixXd NWN = Eigen::MatrixXd::Zero(P+1, nLS);
+    Eigen::MatrixXd R = Eigen::MatrixXd::Zero(nLS, 3);
+    BasisVector Nk(P+1), Nk1(P+1), Nk2(P+1);
     for (int n = 1; n < N; n++) {
-        basisFunction(uk[n], U, Q+1, P, &NN[0], &NN1[0], &NN2[0]);
-        Rk1[n-1] = Input.X1[n] - NN[0]*C1_1[0] - NN[Q]*C1_1[K+1];
-        Rk2[n-1] = Input.X2[n] - NN[0]*C2_1[0] - NN[Q]*C2_1[K+1];
-        Rk3[n-1] = Input.X3[n] - NN[0]*C3_1[0] - NN[Q]*C3_1[K+1];
+        int first = basisFunctionSpan(uk[n], U, Q+1, P, &Nk[0], &Nk1[0], &Nk2[0]);
+        auto basis = [&](int i) { return (first >= 0 && i >= first && i <= first + P) ? Nk[i-first] : 0.0; };
+        double Rk1 = Input.X1[n] - basis(0)*C1_1[0] - basis(Q)*C1_1[K+1];
+        double Rk2 = Input.X2[n] - basis(0)*C2_1[0] - basis(Q)*C2_1[K+1];
+        double Rk3 = Input.X3[n] - basis(0)*C3_1[0] - basis(Q)*C3_1[K+1];
         if (Input.XDot_0_flag == true) {
-            Rk1[n-1] -= NN[1]*C1_1[1];
-            Rk2[n-1] -= NN[1]*C2_1[1];
-            Rk3[n-1] -= NN[1]*C3_1[1];
+            Rk1 -= basis(1)*C1_1[1];
+            Rk2 -= basis(1)*C2_1[1];
+            Rk3 -= basis(1)*C3_1[1];
         }
         if (Input.XDDot_0_flag == true) {
-            Rk1[n-1] -= NN[2]*C1_1[2];
-            Rk2[n-1] -= NN[2]*C2_1[2];
-            Rk3[n-1] -= NN[2]*C3_1[2];
+            Rk1 -= basis(2)*C1_1[2];
+            Rk2 -= basis(2)*C2_1[2];
+            Rk3 -= basis(2)*C3_1[2];
         }
         if (Input.XDDot_N_flag == true) {
-            Rk1[n-1] -= NN[Q-2]*C1_1[K-1];
-            Rk2[n-1] -= NN[Q-2]*C2_1[K-1];
-            Rk3[n-1] -= NN[Q-2]*C3_1[K-1];
+            Rk1 -= basis(Q-2)*C1_1[K-1];
+            Rk2 -= basis(Q-2)*C2_1[K-1];
+            Rk3 -= basis(Q-2)*C3_1[K-1];
         }
         if (Input.XDot_N_flag == true) {
-            Rk1[n-1] -= NN[Q-1]*C1_1[K];
-            Rk2[n-1] -= NN[Q-1]*C2_1[K];
-            Rk3[n-1] -= NN[Q-1]*C3_1[K];
+            Rk1 -= basis(Q-1)*C1_1[K];
+            Rk2 -= basis(Q-1)*C2_1[K];
+            Rk3 -= basis(Q-1)*C3_1[K];
         }
-    }
-    
-    // populate LS matrix ND
-    Eigen::MatrixXd ND(N-1,Q-K-1);
-    for (int n = 0; n < N-1; n++) {
-        basisFunction(uk[1+n], U, Q+1, P, &NN[0], &NN1[0], &NN2[0]);
-        int k = 1;
-        if (Input.XDot_0_flag == true) {k += 1;}
-        if (Input.XDDot_0_flag == true) {k += 1;}
-        for (int b = 0; b < Q-K-1; b++) {
-            ND(n,b) = NN[k+b];
-        }
-    }
-
-    // populate weight matrix W
-    Eigen::MatrixXd W(N-1,N-1);
-    for (int n = 0; n < N-1; n++) {
-        for (int m = 0; m < N-1; m++) {
-            if (n == m) {
-                if (Input.W_flag) {
-                    W(n,m) = Input.W[n+1];
-                }
-                else {
-                    W(n,m) = 1;
-                }
+        if (first < 0) {
+            continue;
+        }
+        double w = 1;
+        if (Input.W_flag) {
+            w = Input.W[n];
+        }
+        for (int a = 0; a < P+1; a++) {
+            int ba = first + a - k;
+            if (ba < 0 || ba >= nLS) {
+                continue;
             }
-            else {
-                W(n,m) = 0;
+            R(ba,0) += w * Nk[a] * Rk1;
+            R(ba,1) += w * Nk[a] * Rk2;
+            R(ba,2) += w * Nk[a] * Rk3;
+            for (int c = a; c < P+1; c++) {
+                int bc = first + c - k;
+                if (bc >= 0 && bc < nLS) {
+                    NWN(bc-ba, ba) += w * Nk[a] * Nk[c];
+                }
             }
         }
     }
 
-    Eigen::VectorXd R1(Q-K-1), R2(Q-K-1), R3(Q-K-1);
-    B = ND.transpose() * W;
-    R1 = B * Rk1;
-    R2 = B * Rk2;
-    R3 = B * Rk3;
-
-    // compute LS values R for the control points
-    Eigen::MatrixXd NWN(Q-K-1,Q-K-1), NWN_inv(Q-K-1,Q-K-1);
-    NWN = B * ND;
-    NWN_inv = NWN.inverse();
-    Eigen::VectorXd C1_2 = NWN_inv * R1;
-    Eigen::VectorXd C2_2 = NWN_inv * R2;
-    Eigen::VectorXd C3_2 = NWN_inv * R3;
+    // compute LS values R for the control points with a banded Cholesky factorization
+    bandedCholeskySolve(NWN, P, R);
+    Eigen::VectorXd C1_2 = R.col(0);
+    Eigen::VectorXd C2_2 = R.col(1);
+    Eigen::VectorXd C3_2 = R.col(2);
     
     // build control point vectors C
     Eigen::VectorXd C1(Q+1), C2(Q+1), C3(Q+1);
@@ -645,34 +1034,7 @@ void approximate(InputDataSet Input, int Num, int Q, int P, OutputDataSet *Outpu
     Output->C1 = C1;
     Output->C2 = C2;
     Output->C3 = C3;
-
-    double dt = 1.0 / (Num - 1);
-    double t = 0;
-    // store the interpolated trajectory information into Output structure
-    Output->T.resize(Num);
-    Output->X1.resize(Num);
-    Output->X2.resize(Num);
-    Output->X3.resize(Num);
-    Output->XD1.resize(Num);
-    Output->XD2.resize(Num);
-    Output->XD3.resize(Num);
-    Output->XDD1.resize(Num);
-    Output->XDD2.resize(Num);    
-    Output->XDD3.resize(Num);
-    for (int i = 0; i < Num; i++) {
-        basisFunction(t, U, Q+1, P, &NN[0], &NN1[0], &NN2[0]);
-        Output->T[i] = t * Ttot;
-        Output->X1[i] = NN.dot(C1);
-        Output->X2[i] = NN.dot(C2);
-        Output->X3[i] = NN.dot(C3);
-        Output->XD1[i]  = NN1.dot(C1) / Ttot;
-        Output->XD2[i]  = NN1.dot(C2) / Ttot;
-        Output->XD3[i]  = NN1.dot(C3) / Ttot;
-        Output->XDD1[i] = NN2.dot(C1) / pow(Ttot,2);
-        Output->XDD2[i] = NN2.dot(C2) / pow(Ttot,2);
-        Output->XDD3[i] = NN2.dot(C3) / pow(Ttot,2);
-        t += dt;
-    }
+    sampleOutput(Num, Ttot, Output);
 
     return;
 }
@@ -680,46 +1042,29 @@ void approximate(InputDataSet Input, int Num, int Q, int P, OutputDataSet *Outpu
 /*! This function calculates the basis functions NN of order P, and derivatives NN1, NN2, for a given time t and knot vector U */
 void basisFunction(double t, Eigen::VectorXd U, int I, int P, double *NN, double *NN1, double *NN2)
 {   
-    Eigen::MatrixXd N(I, P+1);
-    Eigen::MatrixXd N1(I, P+1);
-    Eigen::MatrixXd N2(I, P+1);
-    /* populate matrices with zeros */
+    /* populate outputs with zeros */
     for (int i = 0; i < I; i++) {
-        for (int p = 0; p < P+1; p++) {
-            N(i,p)  = 0;
-            N1(i,p) = 0;
-            N2(i,p) = 0;
-        }
+        *(NN+i)  = 0;
+        *(NN1+i) = 0;
+        *(NN2+i) = 0;
     }
-    /* zero order */
-    for (int i = 0; i < I; i++) {
-        if ( (t >= U(i)) && (t < U(i+1)) ) {
-            N(i,0) = 1;
-        }
-    }
-    if (abs(t-1.0) < 1e-5) {
-        N(I-1,0) = 1;
+    if (P > MAX_P) {
+        std::cout << "Error in BSpline: \n the polynomial order P can't be higher than 14. \n";
+        return;
     }
-    /* higher order - De Boor formula */
-    for (int p = 1; p < P+1; p++) {
-        for (int i = 0; i < I; i++) {
-            if (U[i+p]-U[i] != 0) {
-                N(i,p)  += (t-U[i]) / (U[i+p]-U[i]) * N(i,p-1);
-                N1(i,p) += p / (U[i+p]-U[i]) * N(i,p-1);
-                N2(i,p) += p / (U[i+p]-U[i]) * N1(i,p-1);
-            }
-            if (U[i+p+1]-U[i+1] != 0) {
-                N(i,p)  += (U[i+p+1]-t) / (U[i+p+1]-U[i+1]) * N(i+1,p-1);
-                N1(i,p) -= p / (U[i+p+1]-U[i+1]) * N(i+1,p-1);
-                N2(i,p) -= p / (U[i+p+1]-U[i+1]) * N1(i+1,p-1);
-            }
-        }
+    /* only the P+1 basis functions of the knot span that contains t are non-zero */
+    BasisVector N(P+1), N1(P+1), N2(P+1);
+    int first = basisFunctionSpan(t, U, I, P, &N[0], &N1[0], &N2[0]);
+    if (first < 0) {
+        return;
     }
     // output result
-    for (int i = 0; i < I; i++) {
-        *(NN+i)  = N(i,P);
-        *(NN1+i) = N1(i,P);
-        *(NN2+i) = N2(i,P);
+    for (int l = 0; l < P+1; l++) {
+        if (first + l < I) {
+            *(NN+first+l)  = N[l];
+            *(NN1+first+l) = N1[l];
+            *(NN2+first+l) = N2[l];
+        }
     }
 
     return;
@@ -19,6 +19,7 @@
 
 
 #include <Eigen/Dense>
+#include <vector>
 #include "architecture/utilities/avsEigenSupport.h"
 #include "architecture/utilities/macroDefinitions.h"
 
@@ -67,6 +68,8 @@ public:
     ~OutputDataSet();
     void getData(double t, double x[3], double xDot[3], double xDDot[3]);
     double getStates(double t, int derivative,  int index);
+    void getDataBatch(int num, const double *t, double (*x)[3], double (*xDot)[3], double (*xDDot)[3]);
+    Eigen::MatrixXd getStatesBatch(Eigen::VectorXd t, int derivative);
     
     Eigen::VectorXd T;               //!< time tags for each point of the interpolated trajectory
     Eigen::VectorXd X1;              //!< coordinate #1 of the interpolated trajectory
@@ -86,6 +89,52 @@ public:
     Eigen::VectorXd C3;              //!< coordinate #3 of the control points
 };
 
+//! @brief The BSplineInterpolator class solves the interpolation problem of the interpolate() function with a banded
+//! LU factorization of the collocation matrix, in O(N) operations.  It keeps the factorization, so that appending a
+//! waypoint only refactors the trailing rows of the system that the new waypoint modifies.
+class BSplineInterpolator {
+public:
+    BSplineInterpolator();
+    ~BSplineInterpolator();
+    void fit(InputDataSet Input, int P);
+    void appendWaypoint(double T, Eigen::Vector3d X);
+    void getOutput(int Num, OutputDataSet *Output);
+    int getNumberOfWaypoints();
+
+private:
+    //! row of the collocation system, stored as a contiguous set of non-zero coefficients
+    struct BandRow {
+        int firstCol;                //!< column of the first non-zero coefficient
+        std::vector<double> values;  //!< non-zero coefficients
+        double rhs[3];               //!< right hand side of the three coordinates
+    };
+
+    void computeKnots(int firstKnot);
+    void computeRows(int firstRow, std::vector<BandRow> &rows);
+    int firstChangedKnot();
+    int firstChangedRow();
+    void factorize(int kStart, int kCheckpoint);
+    void solve();
+
+    InputDataSet input;              //!< waypoints, time tags and end point derivatives
+    Eigen::VectorXd T;               //!< [s] waypoint time tags
+    Eigen::VectorXd U;               //!< knot vector, in the same units as T
+    Eigen::VectorXi span;            //!< knot span of each waypoint
+    int P;                           //!< polynomial degree of the BSpline
+    int N;                           //!< number of waypoints - 1
+    int K;                           //!< number of end point derivatives
+    int n0;                          //!< number of starting point derivative rows
+    int kl;                          //!< number of sub-diagonals of the collocation matrix
+    int ku;                          //!< number of super-diagonals of the collocation matrix
+    Eigen::MatrixXd AB;              //!< collocation matrix and its LU factors in banded storage
+    Eigen::MatrixXd R;               //!< right hand side, overwritten by the forward elimination
+    Eigen::MatrixXd C;               //!< control points
+    int checkpointStep;              //!< elimination step at which the checkpoint was stored
+    Eigen::MatrixXd checkpointAB;    //!< banded matrix columns from checkpointStep onwards at the checkpoint
+    Eigen::MatrixXd checkpointR;     //!< right hand side rows from checkpointStep onwards at the checkpoint
+    bool fitted;                     //!< indicates that fit() has been called
+};
+
 void interpolate(InputDataSet Input, int Num, int P, OutputDataSet *Output);
 
 void approximate(InputDataSet Input, int Num, int Q, int P, OutputDataSet *Output);
@@ -26,6 +26,7 @@ from Basilisk.architecture.swig_common_model import *
 %}
 %include "swig_eigen.i"
 
+%ignore OutputDataSet::getDataBatch;
 %include "BSpline.h"
 
 %pythoncode %{
@@ -0,0 +1,659 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+/// \cond DO_NOT_DOCUMENT
+
+/* Asynchronous backend of BSKLogger. A log call captures the level, the module ID and sim time of the calling
+   thread, the format string and the raw printf arguments into a fixed size binary record. The record is pushed into a
+   lock-free single producer/single consumer ring owned by the calling thread. A background thread drains the rings,
+   does the printf formatting and writes the text to stdout, to a file or to a memory buffer that Python reads back.
+   A full ring drops the record instead of blocking the simulation.
+
+   Records are rate limited per call site, identified by a hash of the format string. At most maxRecords records of a
+   call site are kept per window of sim time, and with deduplication on a record whose arguments are identical to the
+   previous record of the same call site is dropped. The number of records dropped this way is appended to the next
+   record of the call site that goes through. */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include "architecture/utilities/bskLogging.h"
+
+namespace {
+
+const int MAX_LOG_ARGS = 16;                        //!< printf arguments kept per record
+const int LOG_TEXT_LENGTH = 2 * MAX_LOGGING_LENGTH;  //!< format string followed by the string arguments
+const uint64_t LOG_QUEUE_DEPTH = 1024;              //!< records per thread, must be a power of two
+
+typedef enum {
+    ARG_INT,
+    ARG_UINT,
+    ARG_DOUBLE,
+    ARG_STRING,
+    ARG_POINTER
+} logArg_t;
+
+typedef union {
+    long long i;
+    unsigned long long u;
+    double d;
+    const void *p;
+    size_t offset;      // string arguments are stored in the record text
+} LogArg;
+
+typedef struct {
+    logLevel_t level;
+    const char *levelStr;
+    int64_t moduleID;
+    uint64_t simNanos;
+    uint64_t formatId;
+    uint32_t suppressed;
+    int argCount;
+    logArg_t argTypes[MAX_LOG_ARGS];
+    LogArg args[MAX_LOG_ARGS];
+    size_t textUsed;
+    char text[LOG_TEXT_LENGTH + 1];
+} LogRecord;
+
+/* one printf conversion specification of the format string */
+typedef struct {
+    const char *start;  // the '%'
+    const char *end;    // one past the conversion character
+    int stars;          // '*' width or precision arguments
+    char length[3];     // length modifier
+    char conversion;
+} FormatSpec;
+
+/* single producer/single consumer ring, the producer is the thread owning it */
+struct LogQueue {
+    LogQueue() : ring(LOG_QUEUE_DEPTH), head(0), tail(0), closed(false) {}
+    std::vector<LogRecord> ring;
+    std::atomic<uint64_t> head;     // next record to drain
+    std::atomic<uint64_t> tail;     // next free slot
+    std::atomic<bool> closed;       // the owning thread has exited
+};
+
+/* rate limiting state of one call site on one thread */
+typedef struct {
+    uint64_t windowStart;
+    uint32_t count;
+    uint32_t suppressed;
+    uint64_t lastArgsHash;
+    bool hasLast;
+} CallSite;
+
+struct LogBackend {
+    LogBackend() : enabled(false), running(false), maxRecords(0), windowNanos(0), deduplicate(false),
+                   generation(0), dropped(0), suppressed(0), file(nullptr), ownsFile(false), toMemory(false) {}
+    ~LogBackend() { stop(); }
+    void start();
+    void stop();
+    size_t drain();
+
+    std::atomic<bool> enabled;
+    std::atomic<bool> running;
+    std::atomic<uint32_t> maxRecords;
+    std::atomic<uint64_t> windowNanos;
+    std::atomic<bool> deduplicate;
+    std::atomic<uint32_t> generation;               // bumped when the rate limit settings change
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> suppressed;
+
+    std::mutex controlLock;                         // serializes the worker start/stop
+    std::mutex queueLock;                           // protects queues
+    std::vector<std::shared_ptr<LogQueue>> queues;
+    std::thread worker;
+    std::mutex sinkLock;                            // protects the sink and the drained records
+    FILE *file;
+    bool ownsFile;
+    bool toMemory;
+    std::vector<std::string> memoryRecords;
+};
+
+LogBackend &backend()
+{
+    static LogBackend instance;
+    return instance;
+}
+
+/* module and sim time of the code running on this thread */
+struct LogContext {
+    int64_t moduleID = -1;
+    uint64_t simNanos = 0;
+};
+thread_local LogContext logContext;
+
+/* the ring of this thread, marked closed when the thread exits so the worker can release it */
+struct LocalQueue {
+    std::shared_ptr<LogQueue> queue;
+    std::unordered_map<uint64_t, CallSite> callSites;
+    uint32_t generation = 0;
+    ~LocalQueue() { if (queue) { queue->closed.store(true); } }
+};
+thread_local LocalQueue localQueue;
+
+uint64_t fnv1a(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL)
+{
+    const unsigned char *bytes = (const unsigned char *) data;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+/* returns false at the end of the format or on a malformed specification */
+bool nextSpec(const char *p, FormatSpec &spec)
+{
+    while (*p != '\0') {
+        if (*p != '%') {
+            p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            p += 2;
+            continue;
+        }
+        spec.start = p++;
+        spec.stars = 0;
+        while (*p != '\0' && strchr("-+ #0'", *p)) { p++; }
+        while (*p == '*' || (*p >= '0' && *p <= '9')) { spec.stars += (*p == '*'); p++; }
+        if (*p == '.') {
+            p++;
+            while (*p == '*' || (*p >= '0' && *p <= '9')) { spec.stars += (*p == '*'); p++; }
+        }
+        int len = 0;
+        while (*p != '\0' && strchr("hlLjzt", *p) && len < 2) { spec.length[len++] = *p++; }
+        spec.length[len] = '\0';
+        if (*p == '\0' || !strchr("diuoxXcfFeEgGaAspn", *p)) {
+            return false;
+        }
+        spec.conversion = *p;
+        spec.end = p + 1;
+        return true;
+    }
+    return false;
+}
+
+/* copies the format string and its printf arguments into the record */
+void captureRecord(LogRecord &record, const char *format, va_list args)
+{
+    size_t formatLength = strlen(format);
+    if (formatLength > MAX_LOGGING_LENGTH) { formatLength = MAX_LOGGING_LENGTH; }
+    memcpy(record.text, format, formatLength);
+    record.text[formatLength] = '\0';
+    record.textUsed = formatLength + 1;
+    record.formatId = fnv1a(record.text, formatLength);
+    record.argCount = 0;
+
+    va_list argsCopy;
+    va_copy(argsCopy, args);
+    FormatSpec spec;
+    const char *p = record.text;
+    while (nextSpec(p, spec) && record.argCount + spec.stars < MAX_LOG_ARGS) {
+        for (int s = 0; s < spec.stars; s++) {
+            record.argTypes[record.argCount] = ARG_INT;
+            record.args[record.argCount++].i = va_arg(argsCopy, int);
+        }
+        LogArg &arg = record.args[record.argCount];
+        logArg_t &type = record.argTypes[record.argCount];
+        std::string length(spec.length);
+        switch (spec.conversion) {
+            case 'd': case 'i':
+                type = ARG_INT;
+                if (length == "l") { arg.i = va_arg(argsCopy, long); }
+                else if (length == "ll") { arg.i = va_arg(argsCopy, long long); }
+                else if (length == "z" || length == "t") { arg.i = (long long) va_arg(argsCopy, ptrdiff_t); }
+                else if (length == "j") { arg.i = va_arg(argsCopy, intmax_t); }
+                else { arg.i = va_arg(argsCopy, int); }
+                break;
+            case 'u': case 'o': case 'x': case 'X':
+                type = ARG_UINT;
+                if (length == "l") { arg.u = va_arg(argsCopy, unsigned long); }
+                else if (length == "ll") { arg.u = va_arg(argsCopy, unsigned long long); }
+                else if (length == "z" || length == "t") { arg.u = va_arg(argsCopy, size_t); }
+                else if (length == "j") { arg.u = va_arg(argsCopy, uintmax_t); }
+                else { arg.u = va_arg(argsCopy, unsigned int); }
+                if (length == "hh") { arg.u = (unsigned char) arg.u; }
+                else if (length == "h") { arg.u = (unsigned short) arg.u; }
+                break;
+            case 'c':
+                type = ARG_INT;
+                arg.i = va_arg(argsCopy, int);
+                break;
+            case 's': {
+                type = ARG_STRING;
+                const char *str = va_arg(argsCopy, const char *);
+                if (str == nullptr) { str = "(null)"; }
+                size_t room = LOG_TEXT_LENGTH - record.textUsed;
+                size_t strLength = strnlen(str, room);
+                arg.offset = record.textUsed;
+                memcpy(record.text + record.textUsed, str, strLength);
+                record.text[record.textUsed + strLength] = '\0';
+                record.textUsed += strLength + (record.textUsed + strLength < LOG_TEXT_LENGTH);
+                break;
+            }
+            case 'p': case 'n':
+                type = ARG_POINTER;
+                arg.p = va_arg(argsCopy, void *);
+                break;
+            default:
+                type = ARG_DOUBLE;
+                if (length == "L") { arg.d = (double) va_arg(argsCopy, long double); }
+                else { arg.d = va_arg(argsCopy, double); }
+                break;
+        }
+        record.argCount++;
+        p = spec.end;
+    }
+    va_end(argsCopy);
+}
+
+/* printf formatting of a captured record */
+std::string formatRecord(const LogRecord &record)
+{
+    std::string message;
+    char buffer[MAX_LOGGING_LENGTH + 1];
+    const char *p = record.text;
+    int argIndex = 0;
+    FormatSpec spec;
+    while (nextSpec(p, spec) && argIndex + spec.stars < record.argCount) {
+        for (const char *c = p; c < spec.start; c++) {
+            message += *c;
+            if (*c == '%' && c[1] == '%') { c++; }
+        }
+        /* rebuild the specification with the '*' arguments and the length of the stored type */
+        std::string fmt;
+        for (const char *c = spec.start; c < spec.end - 1 - strlen(spec.length); c++) {
+            if (*c == '*') { fmt += std::to_string(record.args[argIndex++].i); }
+            else { fmt += *c; }
+        }
+        const LogArg &arg = record.args[argIndex];
+        switch (record.argTypes[argIndex]) {
+            case ARG_INT:
+                if (spec.conversion == 'c') { snprintf(buffer, sizeof(buffer), (fmt + "c").c_str(), (int) arg.i); }
+                else { snprintf(buffer, sizeof(buffer), (fmt + "ll" + spec.conversion).c_str(), arg.i); }
+                break;
+            case ARG_UINT:
+                snprintf(buffer, sizeof(buffer), (fmt + "ll" + spec.conversion).c_str(), arg.u);
+                break;
+            case ARG_DOUBLE:
+                snprintf(buffer, sizeof(buffer), (fmt + spec.conversion).c_str(), arg.d);
+                break;
+            case ARG_STRING:
+                snprintf(buffer, sizeof(buffer), (fmt + "s").c_str(), record.text + arg.offset);
+                break;
+            case ARG_POINTER:
+                buffer[0] = '\0';
+                if (spec.conversion == 'p') { snprintf(buffer, sizeof(buffer), "%p", arg.p); }
+                break;
+        }
+        message += buffer;
+        argIndex++;
+        p = spec.end;
+    }
+    for (const char *c = p; *c != '\0'; c++) {
+        message += *c;
+        if (*c == '%' && c[1] == '%') { c++; }
+    }
+    if (message.size() > MAX_LOGGING_LENGTH - 1) { message.resize(MAX_LOGGING_LENGTH - 1); }
+    return message;
+}
+
+/* full output line of a record */
+std::string formatLine(const LogRecord &record, const char *levelStr)
+{
+    char prefix[128];
+    if (record.moduleID >= 0) {
+        snprintf(prefix, sizeof(prefix), "%s [t = %.9g s, moduleID = %lld]: ", levelStr,
+                 record.simNanos * 1.0e-9, (long long) record.moduleID);
+    } else {
+        snprintf(prefix, sizeof(prefix), "%s [t = %.9g s]: ", levelStr, record.simNanos * 1.0e-9);
+    }
+    std::string line = prefix + formatRecord(record);
+    if (record.suppressed > 0) {
+        line += " [" + std::to_string(record.suppressed) + " similar messages suppressed]";
+    }
+    return line;
+}
+
+/* applies the call site rate limit and deduplication, returns false if the record is dropped */
+bool admitRecord(LogRecord &record)
+{
+    LogBackend &b = backend();
+    uint32_t maxRecords = b.maxRecords.load(std::memory_order_relaxed);
+    bool deduplicate = b.deduplicate.load(std::memory_order_relaxed);
+    record.suppressed = 0;
+    if (maxRecords == 0 && !deduplicate) {
+        return true;
+    }
+    uint32_t generation = b.generation.load(std::memory_order_relaxed);
+    if (generation != localQueue.generation) {
+        localQueue.callSites.clear();
+        localQueue.generation = generation;
+    }
+    CallSite &site = localQueue.callSites[record.formatId ^ (uint64_t) record.level];
+    if (deduplicate) {
+        uint64_t argsHash = fnv1a(record.args, record.argCount * sizeof(LogArg));
+        argsHash = fnv1a(record.text, record.textUsed, argsHash);
+        if (site.hasLast && site.lastArgsHash == argsHash) {
+            site.suppressed++;
+            b.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        site.lastArgsHash = argsHash;
+        site.hasLast = true;
+    }
+    if (maxRecords > 0) {
+        uint64_t window = b.windowNanos.load(std::memory_order_relaxed);
+        if (site.count == 0 || record.simNanos < site.windowStart || record.simNanos - site.windowStart >= window) {
+            site.windowStart = record.simNanos;
+            site.count = 0;
+        }
+        if (site.count >= maxRecords) {
+            site.suppressed++;
+            b.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        site.count++;
+    }
+    record.suppressed = site.suppressed;
+    site.suppressed = 0;
+    return true;
+}
+
+void writeLine(LogBackend &b, const std::string &line)
+{
+    if (b.toMemory) {
+        b.memoryRecords.push_back(line);
+    } else {
+        fprintf(b.file != nullptr ? b.file : stdout, "%s\n", line.c_str());
+    }
+}
+
+const char *plainLevelStr(logLevel_t level)
+{
+    static const char *levelStr[] = {"BSK_DEBUG", "BSK_INFORMATION", "BSK_WARNING", "BSK_ERROR", "BSK_SILENT"};
+    return levelStr[level];
+}
+
+/* drains every ring once, returns the number of records written */
+size_t LogBackend::drain()
+{
+    std::vector<std::shared_ptr<LogQueue>> snapshot;
+    {
+        std::lock_guard<std::mutex> lock(this->queueLock);
+        snapshot = this->queues;
+    }
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(this->sinkLock);
+    for (auto &queue : snapshot) {
+        uint64_t head = queue->head.load(std::memory_order_relaxed);
+        uint64_t tail = queue->tail.load(std::memory_order_acquire);
+        for (; head != tail; head++) {
+            const LogRecord &record = queue->ring[head & (LOG_QUEUE_DEPTH - 1)];
+            const char *levelStr = (this->file == nullptr && !this->toMemory) ? record.levelStr
+                                                                             : plainLevelStr(record.level);
+            writeLine(*this, formatLine(record, levelStr));
+            count++;
+        }
+        queue->head.store(head, std::memory_order_release);
+    }
+    if (count > 0 && !this->toMemory) {
+        fflush(this->file != nullptr ? this->file : stdout);
+    }
+
+    /* release the rings of exited threads */
+    std::lock_guard<std::mutex> queues(this->queueLock);
+    for (auto it = this->queues.begin(); it != this->queues.end();) {
+        if ((*it)->closed.load() && (*it)->head.load() == (*it)->tail.load()) {
+            it = this->queues.erase(it);
+        } else {
+            it++;
+        }
+    }
+    return count;
+}
+
+void LogBackend::start()
+{
+    this->running.store(true);
+    this->worker = std::thread([this]() {
+        while (this->running.load()) {
+            if (this->drain() == 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+    this->enabled.store(true);
+}
+
+void LogBackend::stop()
+{
+    this->enabled.store(false);
+    if (this->running.load()) {
+        this->running.store(false);
+        this->worker.join();
+    }
+    this->drain();
+    std::lock_guard<std::mutex> lock(this->sinkLock);
+    if (this->ownsFile) {
+        fclose(this->file);
+    }
+    this->file = nullptr;
+    this->ownsFile = false;
+}
+
+void startBackend(FILE *file, bool ownsFile, bool toMemory)
+{
+    LogBackend &b = backend();
+    std::lock_guard<std::mutex> lock(b.controlLock);
+    if (b.running.load()) {
+        b.stop();
+    }
+    {
+        std::lock_guard<std::mutex> sink(b.sinkLock);
+        b.file = file;
+        b.ownsFile = ownsFile;
+        b.toMemory = toMemory;
+    }
+    b.start();
+}
+
+}
+
+/*! Sets the module ID and sim time attached to the records logged from the calling thread. The task execution
+    updates it before calling each module.
+    @param moduleID module ID, -1 if no module is running
+    @param simNanos [ns] current sim time
+ */
+void setLogContext(int64_t moduleID, uint64_t simNanos)
+{
+    logContext.moduleID = moduleID;
+    logContext.simNanos = simNanos;
+}
+
+/*! Routes all BSKLogger output through the background thread
+    @param fileName file the log is written to, stdout if empty
+ */
+void enableAsyncLogging(std::string fileName)
+{
+    FILE *file = nullptr;
+    if (!fileName.empty()) {
+        file = fopen(fileName.c_str(), "w");
+        if (file == nullptr) {
+            printf("%s: enableAsyncLogging() could not open %s, logging to stdout.\n",
+                   plainLevelStr(BSK_ERROR), fileName.c_str());
+        }
+    }
+    startBackend(file, file != nullptr, false);
+}
+
+/*! Routes all BSKLogger output through the background thread into a memory buffer read with readAsyncLogRecords() */
+void enableAsyncLoggingToMemory()
+{
+    startBackend(nullptr, false, true);
+}
+
+/*! Drains the pending records and returns to synchronous logging */
+void disableAsyncLogging()
+{
+    LogBackend &b = backend();
+    std::lock_guard<std::mutex> lock(b.controlLock);
+    if (b.running.load()) {
+        b.stop();
+    }
+}
+
+/*! Returns true if the asynchronous backend is running */
+bool asyncLoggingEnabled()
+{
+    return backend().enabled.load(std::memory_order_relaxed);
+}
+
+/*! Waits until all records pushed before this call are written */
+void flushAsyncLogging()
+{
+    LogBackend &b = backend();
+    std::vector<std::pair<std::shared_ptr<LogQueue>, uint64_t>> pending;
+    {
+        std::lock_guard<std::mutex> lock(b.queueLock);
+        for (auto &queue : b.queues) {
+            pending.push_back(std::make_pair(queue, queue->tail.load()));
+        }
+    }
+    for (auto &entry : pending) {
+        while (entry.first->head.load() < entry.second) {
+            if (!b.running.load()) {
+                b.drain();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(b.sinkLock);
+}
+
+/*! Returns and clears the records written to the memory sink */
+std::vector<std::string> readAsyncLogRecords()
+{
+    flushAsyncLogging();
+    LogBackend &b = backend();
+    std::lock_guard<std::mutex> lock(b.sinkLock);
+    std::vector<std::string> records;
+    records.swap(b.memoryRecords);
+    return records;
+}
+
+/*! Limits the number of records of each call site
+    @param maxRecords records kept per call site and window, 0 turns the limit off
+    @param windowNanos [ns] sim time window of the limit
+ */
+void setLogRateLimit(uint32_t maxRecords, uint64_t windowNanos)
+{
+    backend().windowNanos.store(windowNanos);
+    backend().maxRecords.store(maxRecords);
+    backend().generation.fetch_add(1);
+}
+
+/*! Drops records whose arguments are identical to the previous record of the same call site
+    @param deduplicate flag turning the deduplication on
+ */
+void setLogDeduplication(bool deduplicate)
+{
+    backend().deduplicate.store(deduplicate);
+    backend().generation.fetch_add(1);
+}
+
+/*! Returns the number of records dropped because a ring was full */
+uint64_t getDroppedLogCount()
+{
+    return backend().dropped.load();
+}
+
+/*! Returns the number of records dropped by the rate limit or the deduplication */
+uint64_t getSuppressedLogCount()
+{
+    return backend().suppressed.load();
+}
+
+/*! Returns true if a log call has to go through the backend instead of the plain printf */
+bool logBackendActive()
+{
+    LogBackend &b = backend();
+    return b.enabled.load(std::memory_order_relaxed) || b.maxRecords.load(std::memory_order_relaxed) > 0 ||
+           b.deduplicate.load(std::memory_order_relaxed);
+}
+
+/*! Captures a log call. The record is pushed to the ring of the calling thread if the asynchronous backend runs,
+    otherwise it is printed right away once it passed the rate limit.
+    @param level log level of the record
+    @param levelStr level string used on stdout
+    @param format printf format string
+    @param args printf arguments
+ */
+void logThroughBackend(logLevel_t level, const char* levelStr, const char* format, va_list args)
+{
+    LogBackend &b = backend();
+    if (!b.enabled.load(std::memory_order_acquire)) {
+        LogRecord record;
+        record.level = level;
+        record.levelStr = levelStr;
+        record.moduleID = logContext.moduleID;
+        record.simNanos = logContext.simNanos;
+        captureRecord(record, format, args);
+        if (admitRecord(record)) {
+            printf("%s: %s", levelStr, formatRecord(record).c_str());
+            if (record.suppressed > 0) {
+                printf(" [%u similar messages suppressed]", record.suppressed);
+            }
+            printf("\n");
+        }
+        return;
+    }
+
+    if (!localQueue.queue) {
+        localQueue.queue = std::make_shared<LogQueue>();
+        std::lock_guard<std::mutex> lock(b.queueLock);
+        b.queues.push_back(localQueue.queue);
+    }
+    LogQueue &queue = *localQueue.queue;
+    uint64_t tail = queue.tail.load(std::memory_order_relaxed);
+    if (tail - queue.head.load(std::memory_order_acquire) >= LOG_QUEUE_DEPTH) {
+        b.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    LogRecord &record = queue.ring[tail & (LOG_QUEUE_DEPTH - 1)];
+    record.level = level;
+    record.levelStr = levelStr;
+    record.moduleID = logContext.moduleID;
+    record.simNanos = logContext.simNanos;
+    captureRecord(record, format, args);
+    if (admitRecord(record)) {
+        queue.tail.store(tail + 1, std::memory_order_release);
+    }
+}
+
+/// \endcond
@@ -21,21 +21,25 @@
 
 #include <stdio.h>
 #include <stdarg.h>
+#include <mutex>
 #include "architecture/utilities/bskLogging.h"
 
 logLevel_t LogLevel = BSK_DEBUG;
+static std::mutex defaultLogLevelLock;   //!< protects LogLevel when sims are built in parallel threads
 
 /*! This method sets the default logging verbosity
     @param logLevel
  */
 void setDefaultLogLevel(logLevel_t logLevel)
 {
+    std::lock_guard<std::mutex> lock(defaultLogLevelLock);
     LogLevel = logLevel;
 }
 
 /*! This method gets the default logging verbosity */
 logLevel_t getDefaultLogLevel()
 {
+    std::lock_guard<std::mutex> lock(defaultLogLevelLock);
     return LogLevel;
 }
 
@@ -50,7 +54,7 @@ void printDefaultLogLevel()
         {3, "BSK_ERROR"},
         {4, "BSK_SILENT"}
     };
-    const char* defaultLevelStr = logLevelMap[LogLevel];
+    const char* defaultLevelStr = logLevelMap[getDefaultLogLevel()];
     printf("Default Logging Level: %s\n", defaultLevelStr);
 }
 
@@ -89,7 +93,8 @@ int BSKLogger::getLogLevel()
     return this->_logLevel;
 }
 
-/*! This method logs information. The current behavior is to simply print out the message and the targeted logging level.
+/*! This method logs information. The message is printed with the targeted logging level, or handed to the
+    asynchronous backend of bskLogBackend.cpp when it is enabled or when a rate limit is set.
     This should be the main method called in user code.
     @param targetLevel
     @param info
@@ -99,10 +104,17 @@ void BSKLogger::bskLog(logLevel_t targetLevel, const char* info, ...)
     if(targetLevel >= this->_logLevel)
     {
         const char* targetLevelStr = this->logLevelMap[targetLevel];
-        char formatMessage[MAX_LOGGING_LENGTH];
         va_list args;
         va_start (args, info);
+        if (logBackendActive())
+        {
+            logThroughBackend(targetLevel, targetLevelStr, info, args);
+            va_end(args);
+            return;
+        }
+        char formatMessage[MAX_LOGGING_LENGTH];
         vsnprintf(formatMessage, sizeof(formatMessage), info, args);
+        va_end(args);
         printf("%s: %s\n", targetLevelStr, formatMessage);
     }
 }
@@ -42,10 +42,28 @@ void printDefaultLogLevel();
 #ifdef __cplusplus
 #include <map>
 #include <string>
+#include <vector>
+#include <stdarg.h>
+#include <stdint.h>
 
 void setDefaultLogLevel(logLevel_t logLevel);
 logLevel_t getDefaultLogLevel();
 
+/* asynchronous logging backend, see bskLogBackend.cpp */
+void setLogContext(int64_t moduleID, uint64_t simNanos);
+void enableAsyncLogging(std::string fileName="");
+void enableAsyncLoggingToMemory();
+void disableAsyncLogging();
+bool asyncLoggingEnabled();
+void flushAsyncLogging();
+std::vector<std::string> readAsyncLogRecords();
+void setLogRateLimit(uint32_t maxRecords, uint64_t windowNanos);
+void setLogDeduplication(bool deduplicate);
+uint64_t getDroppedLogCount();
+uint64_t getSuppressedLogCount();
+bool logBackendActive();
+void logThroughBackend(logLevel_t level, const char* levelStr, const char* format, va_list args);
+
 /*! BSK logging class */
 class BSKLogger
 {
@@ -21,6 +21,12 @@
   #include "bskLogging.h"
 %}
 
+%include "std_string.i"
+%include "std_vector.i"
+namespace std {
+   %template(StringVector) vector<string>;
+}
+%ignore logThroughBackend;
 %include "bskLogging.h"
 %pythoncode %{
 from Basilisk.architecture.swig_common_model import *
@@ -128,3 +128,428 @@ Eigen::Matrix3d C_PCPF2SEZ(double lat, double longitude)
      Eigen::MatrixXd rot3 = cArray2EigenMatrix3d(*m2);
      return rot2*rot3;
 }
+
+/*
+ The batched conversions below process the positions in blocks of ARRAY_BLOCK positions.  Each block is converted in
+ passes over local buffers: the algebraic passes are free of branches and function calls so that the compiler can
+ vectorize them, and the trigonometric functions are evaluated in separate passes.
+ */
+#define ARRAY_RESTRICT __restrict
+#define ARRAY_BLOCK 64
+
+/*! Runs a block conversion over positions in the array of structures layout, through local buffers in the structure
+ of arrays layout.
+@param num : [-] number of positions
+@param in : input positions
+@param out : output positions
+@param block : block conversion taking the block size, the input rows and the output rows
+*/
+template <typename BlockConversion>
+static void convertArray(int num, const double in[][3], double out[][3], BlockConversion block)
+{
+    double inBlock[3][ARRAY_BLOCK];
+    double outBlock[3][ARRAY_BLOCK];
+
+    for (int start = 0; start < num; start += ARRAY_BLOCK) {
+        int n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < 3; k++) {
+                inBlock[k][i] = in[start + i][k];
+            }
+        }
+        block(n, inBlock[0], inBlock[1], inBlock[2], outBlock[0], outBlock[1], outBlock[2]);
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < 3; k++) {
+                out[start + i][k] = outBlock[k][i];
+            }
+        }
+    }
+}
+
+/*! Runs a block conversion over positions in the structure of arrays layout.
+@param num : [-] number of positions
+@param in : input positions, component k of position i at index k*num + i
+@param out : output positions, component k of position i at index k*num + i
+@param block : block conversion taking the block size, the input rows and the output rows
+*/
+template <typename BlockConversion>
+static void convertArraySoA(int num, const double *in, double *out, BlockConversion block)
+{
+    for (int start = 0; start < num; start += ARRAY_BLOCK) {
+        int n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        block(n, in + start, in + num + start, in + 2*num + start, out + start, out + num + start, out + 2*num + start);
+    }
+}
+
+/*! Rotates a block of positions by a DCM or by its transpose.  As in PCI2PCPF() and PCPF2PCI(), which map the C
+ array J20002Pfix to an Eigen matrix column by column, PCI positions are converted with the transpose of J20002Pfix. */
+static void rotateBlock(int n, const double *ARRAY_RESTRICT x, const double *ARRAY_RESTRICT y,
+                        const double *ARRAY_RESTRICT z, const double dcm[3][3], bool transpose,
+                        double *ARRAY_RESTRICT outX, double *ARRAY_RESTRICT outY, double *ARRAY_RESTRICT outZ)
+{
+    double c[3][3];
+    for (int r = 0; r < 3; r++) {
+        for (int k = 0; k < 3; k++) {
+            c[r][k] = transpose ? dcm[k][r] : dcm[r][k];
+        }
+    }
+    for (int i = 0; i < n; i++) {
+        outX[i] = c[0][0]*x[i] + c[0][1]*y[i] + c[0][2]*z[i];
+        outY[i] = c[1][0]*x[i] + c[1][1]*y[i] + c[1][2]*z[i];
+        outZ[i] = c[2][0]*x[i] + c[2][1]*y[i] + c[2][2]*z[i];
+    }
+}
+
+/*! Converts a block of PCPF positions to latitude/longitude/altitude coordinates.  The geodetic latitude and the
+ altitude above an ellipsoid are found in closed form with the method of Vermeille (Journal of Geodesy, 2002), which
+ is exact up to rounding for positions further than about e^2 times the equatorial radius (43 km for the Earth) from
+ the center of the planet.  On a sphere the latitude is the geocentric latitude.
+ */
+static void pcpf2LLABlock(int n, const double *ARRAY_RESTRICT x, const double *ARRAY_RESTRICT y,
+                          const double *ARRAY_RESTRICT z, double planetEqRad, double planetPoRad,
+                          double *ARRAY_RESTRICT lat, double *ARRAY_RESTRICT lon, double *ARRAY_RESTRICT alt)
+{
+    double rho[ARRAY_BLOCK];
+    double den[ARRAY_BLOCK];
+
+    if (planetPoRad == planetEqRad) {
+        for (int i = 0; i < n; i++) {
+            rho[i] = sqrt(x[i]*x[i] + y[i]*y[i]);
+            alt[i] = sqrt(rho[i]*rho[i] + z[i]*z[i]) - planetEqRad;
+        }
+        for (int i = 0; i < n; i++) {
+            lat[i] = atan2(z[i], rho[i]);
+            lon[i] = atan2(y[i], x[i]);
+        }
+        return;
+    }
+
+    double e2 = 1.0 - (planetPoRad*planetPoRad)/(planetEqRad*planetEqRad);
+    double e4 = e2*e2;
+    double invA2 = 1.0/(planetEqRad*planetEqRad);
+    double p[ARRAY_BLOCK];
+    double q[ARRAY_BLOCK];
+    double r[ARRAY_BLOCK];
+    double t[ARRAY_BLOCK];
+
+    for (int i = 0; i < n; i++) {
+        rho[i] = sqrt(x[i]*x[i] + y[i]*y[i]);
+        p[i] = rho[i]*rho[i]*invA2;
+        q[i] = (1.0 - e2)*z[i]*z[i]*invA2;
+        r[i] = (p[i] + q[i] - e4)/6.0;
+        double s = e4*p[i]*q[i]/(4.0*r[i]*r[i]*r[i]);
+        t[i] = 1.0 + s + sqrt(s*(2.0 + s));
+    }
+    for (int i = 0; i < n; i++) {
+        t[i] = cbrt(t[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        double u = r[i]*(1.0 + t[i] + 1.0/t[i]);
+        double v = sqrt(u*u + e4*q[i]);
+        double w = e2*(u + v - q[i])/(2.0*v);
+        double k = sqrt(u + v + w*w) - w;
+        double d = k*rho[i]/(k + e2);
+        double g = sqrt(d*d + z[i]*z[i]);
+        alt[i] = (k + e2 - 1.0)/k*g;
+        den[i] = d + g;
+    }
+    for (int i = 0; i < n; i++) {
+        lat[i] = 2.0*atan2(z[i], den[i]);
+        lon[i] = atan2(y[i], x[i]);
+    }
+}
+
+/*! Converts a block of latitude/longitude/altitude coordinates to PCPF positions. */
+static void lla2PCPFBlock(int n, const double *ARRAY_RESTRICT lat, const double *ARRAY_RESTRICT lon,
+                          const double *ARRAY_RESTRICT alt, double planetEqRad, double planetPoRad,
+                          double *ARRAY_RESTRICT x, double *ARRAY_RESTRICT y, double *ARRAY_RESTRICT z)
+{
+    double e2 = 1.0 - (planetPoRad*planetPoRad)/(planetEqRad*planetEqRad);
+    double cosLat[ARRAY_BLOCK];
+    double sinLat[ARRAY_BLOCK];
+    double cosLon[ARRAY_BLOCK];
+    double sinLon[ARRAY_BLOCK];
+
+    for (int i = 0; i < n; i++) {
+        cosLat[i] = cos(lat[i]);
+        sinLat[i] = sin(lat[i]);
+        cosLon[i] = cos(lon[i]);
+        sinLon[i] = sin(lon[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        /* radius of curvature in the prime vertical */
+        double radius = planetEqRad/sqrt(1.0 - e2*sinLat[i]*sinLat[i]);
+        x[i] = (radius + alt[i])*cosLat[i]*cosLon[i];
+        y[i] = (radius + alt[i])*cosLat[i]*sinLon[i];
+        z[i] = (radius*(1.0 - e2) + alt[i])*sinLat[i];
+    }
+}
+
+/*! Converts an array of planet-centered inertial positions to planet-centered, planet-fixed positions, as PCI2PCPF().
+@param num : [-] number of positions
+@param pciPosition : [m] positions in PCI coordinates
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param pcpfPosition : [m] positions in PCPF coordinates
+*/
+void PCI2PCPFArray(int num, const double pciPosition[][3], const double J20002Pfix[3][3], double pcpfPosition[][3])
+{
+    convertArray(num, pciPosition, pcpfPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                     double *outX, double *outY, double *outZ) {
+        rotateBlock(n, x, y, z, J20002Pfix, true, outX, outY, outZ);
+    });
+}
+
+/*! Converts planet-centered inertial positions to planet-centered, planet-fixed positions in the structure of arrays
+ layout, as PCI2PCPF().
+@param num : [-] number of positions
+@param pciPosition : [m] positions in PCI coordinates
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param pcpfPosition : [m] positions in PCPF coordinates
+*/
+void PCI2PCPFArraySoA(int num, const double *pciPosition, const double J20002Pfix[3][3], double *pcpfPosition)
+{
+    convertArraySoA(num, pciPosition, pcpfPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                        double *outX, double *outY, double *outZ) {
+        rotateBlock(n, x, y, z, J20002Pfix, true, outX, outY, outZ);
+    });
+}
+
+/*! Converts an array of planet-centered, planet-fixed positions to planet-centered inertial positions, as PCPF2PCI().
+@param num : [-] number of positions
+@param pcpfPosition : [m] positions in PCPF coordinates
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param pciPosition : [m] positions in PCI coordinates
+*/
+void PCPF2PCIArray(int num, const double pcpfPosition[][3], const double J20002Pfix[3][3], double pciPosition[][3])
+{
+    convertArray(num, pcpfPosition, pciPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                     double *outX, double *outY, double *outZ) {
+        rotateBlock(n, x, y, z, J20002Pfix, false, outX, outY, outZ);
+    });
+}
+
+/*! Converts planet-centered, planet-fixed positions to planet-centered inertial positions in the structure of arrays
+ layout, as PCPF2PCI().
+@param num : [-] number of positions
+@param pcpfPosition : [m] positions in PCPF coordinates
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param pciPosition : [m] positions in PCI coordinates
+*/
+void PCPF2PCIArraySoA(int num, const double *pcpfPosition, const double J20002Pfix[3][3], double *pciPosition)
+{
+    convertArraySoA(num, pcpfPosition, pciPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                        double *outX, double *outY, double *outZ) {
+        rotateBlock(n, x, y, z, J20002Pfix, false, outX, outY, outZ);
+    });
+}
+
+/*! Converts an array of planet-centered, planet-fixed positions to geodetic latitude/longitude/altitude
+ coordinates.  On a sphere this equals PCPF2LLA().
+@param num : [-] number of positions
+@param pcpfPosition : [m] positions in PCPF coordinates
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+*/
+void PCPF2LLAArray(int num, const double pcpfPosition[][3], double planetEqRad, double planetPoRad,
+                   double llaPosition[][3])
+{
+    convertArray(num, pcpfPosition, llaPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                     double *lat, double *lon, double *alt) {
+        pcpf2LLABlock(n, x, y, z, planetEqRad, planetPoRad, lat, lon, alt);
+    });
+}
+
+/*! Converts planet-centered, planet-fixed positions to geodetic latitude/longitude/altitude coordinates in the
+ structure of arrays layout.  On a sphere this equals PCPF2LLA().
+@param num : [-] number of positions
+@param pcpfPosition : [m] positions in PCPF coordinates
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+*/
+void PCPF2LLAArraySoA(int num, const double *pcpfPosition, double planetEqRad, double planetPoRad,
+                      double *llaPosition)
+{
+    convertArraySoA(num, pcpfPosition, llaPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                        double *lat, double *lon, double *alt) {
+        pcpf2LLABlock(n, x, y, z, planetEqRad, planetPoRad, lat, lon, alt);
+    });
+}
+
+/*! Converts an array of geodetic latitude/longitude/altitude coordinates to planet-centered, planet-fixed positions.
+ On a sphere this equals LLA2PCPF().
+@param num : [-] number of positions
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param pcpfPosition : [m] positions in PCPF coordinates
+*/
+void LLA2PCPFArray(int num, const double llaPosition[][3], double planetEqRad, double planetPoRad,
+                   double pcpfPosition[][3])
+{
+    convertArray(num, llaPosition, pcpfPosition, [&](int n, const double *lat, const double *lon, const double *alt,
+                                                     double *x, double *y, double *z) {
+        lla2PCPFBlock(n, lat, lon, alt, planetEqRad, planetPoRad, x, y, z);
+    });
+}
+
+/*! Converts geodetic latitude/longitude/altitude coordinates to planet-centered, planet-fixed positions in the
+ structure of arrays layout.  On a sphere this equals LLA2PCPF().
+@param num : [-] number of positions
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param pcpfPosition : [m] positions in PCPF coordinates
+*/
+void LLA2PCPFArraySoA(int num, const double *llaPosition, double planetEqRad, double planetPoRad,
+                      double *pcpfPosition)
+{
+    convertArraySoA(num, llaPosition, pcpfPosition, [&](int n, const double *lat, const double *lon, const double *alt,
+                                                        double *x, double *y, double *z) {
+        lla2PCPFBlock(n, lat, lon, alt, planetEqRad, planetPoRad, x, y, z);
+    });
+}
+
+/*! Converts an array of planet-centered inertial positions to geodetic latitude/longitude/altitude coordinates.
+@param num : [-] number of positions
+@param pciPosition : [m] positions in PCI coordinates
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+*/
+void PCI2LLAArray(int num, const double pciPosition[][3], const double J20002Pfix[3][3], double planetEqRad,
+                  double planetPoRad, double llaPosition[][3])
+{
+    convertArray(num, pciPosition, llaPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                    double *lat, double *lon, double *alt) {
+        double pcpf[3][ARRAY_BLOCK];
+        rotateBlock(n, x, y, z, J20002Pfix, true, pcpf[0], pcpf[1], pcpf[2]);
+        pcpf2LLABlock(n, pcpf[0], pcpf[1], pcpf[2], planetEqRad, planetPoRad, lat, lon, alt);
+    });
+}
+
+/*! Converts planet-centered inertial positions to geodetic latitude/longitude/altitude coordinates in the structure
+ of arrays layout.
+@param num : [-] number of positions
+@param pciPosition : [m] positions in PCI coordinates
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+*/
+void PCI2LLAArraySoA(int num, const double *pciPosition, const double J20002Pfix[3][3], double planetEqRad,
+                     double planetPoRad, double *llaPosition)
+{
+    convertArraySoA(num, pciPosition, llaPosition, [&](int n, const double *x, const double *y, const double *z,
+                                                       double *lat, double *lon, double *alt) {
+        double pcpf[3][ARRAY_BLOCK];
+        rotateBlock(n, x, y, z, J20002Pfix, true, pcpf[0], pcpf[1], pcpf[2]);
+        pcpf2LLABlock(n, pcpf[0], pcpf[1], pcpf[2], planetEqRad, planetPoRad, lat, lon, alt);
+    });
+}
+
+/*! Converts an array of geodetic latitude/longitude/altitude coordinates to planet-centered inertial positions.
+@param num : [-] number of positions
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param pciPosition : [m] positions in PCI coordinates
+*/
+void LLA2PCIArray(int num, const double llaPosition[][3], const double J20002Pfix[3][3], double planetEqRad,
+                  double planetPoRad, double pciPosition[][3])
+{
+    convertArray(num, llaPosition, pciPosition, [&](int n, const double *lat, const double *lon, const double *alt,
+                                                    double *x, double *y, double *z) {
+        double pcpf[3][ARRAY_BLOCK];
+        lla2PCPFBlock(n, lat, lon, alt, planetEqRad, planetPoRad, pcpf[0], pcpf[1], pcpf[2]);
+        rotateBlock(n, pcpf[0], pcpf[1], pcpf[2], J20002Pfix, false, x, y, z);
+    });
+}
+
+/*! Converts geodetic latitude/longitude/altitude coordinates to planet-centered inertial positions in the structure
+ of arrays layout.
+@param num : [-] number of positions
+@param llaPosition : [rad, rad, m] latitude, longitude and altitude above the planet surface
+@param J20002Pfix : [-] rotation matrix between the PCI and PCPF frames, used as in PCI2PCPF()
+@param planetEqRad : [m] equatorial radius of the planet
+@param planetPoRad : [m] polar radius of the planet
+@param pciPosition : [m] positions in PCI coordinates
+*/
+void LLA2PCIArraySoA(int num, const double *llaPosition, const double J20002Pfix[3][3], double planetEqRad,
+                     double planetPoRad, double *pciPosition)
+{
+    convertArraySoA(num, llaPosition, pciPosition, [&](int n, const double *lat, const double *lon, const double *alt,
+                                                       double *x, double *y, double *z) {
+        double pcpf[3][ARRAY_BLOCK];
+        lla2PCPFBlock(n, lat, lon, alt, planetEqRad, planetPoRad, pcpf[0], pcpf[1], pcpf[2]);
+        rotateBlock(n, pcpf[0], pcpf[1], pcpf[2], J20002Pfix, false, x, y, z);
+    });
+}
+
+/*! Computes the DCMs from the PCPF frame to the South-East-Zenith frames of a block of locations, with the nine
+ components spaced by stride. */
+static void sezBlock(int n, const double *ARRAY_RESTRICT lat, const double *ARRAY_RESTRICT longitude,
+                     double *ARRAY_RESTRICT C, int stride)
+{
+    double cosLat[ARRAY_BLOCK];
+    double sinLat[ARRAY_BLOCK];
+    double cosLon[ARRAY_BLOCK];
+    double sinLon[ARRAY_BLOCK];
+
+    for (int i = 0; i < n; i++) {
+        cosLat[i] = cos(lat[i]);
+        sinLat[i] = sin(lat[i]);
+        cosLon[i] = cos(longitude[i]);
+        sinLon[i] = sin(longitude[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        C[0*stride + i] = sinLat[i]*cosLon[i];
+        C[1*stride + i] = sinLat[i]*sinLon[i];
+        C[2*stride + i] = -cosLat[i];
+        C[3*stride + i] = -sinLon[i];
+        C[4*stride + i] = cosLon[i];
+        C[5*stride + i] = 0.0;
+        C[6*stride + i] = cosLat[i]*cosLon[i];
+        C[7*stride + i] = cosLat[i]*sinLon[i];
+        C[8*stride + i] = sinLat[i];
+    }
+}
+
+/*! Computes the DCMs from the PCPF frame to the South-East-Zenith frames of an array of locations, as C_PCPF2SEZ().
+@param num : [-] number of locations
+@param lat : [rad] latitudes of the locations
+@param longitude : [rad] longitudes of the locations
+@param C : [-] DCMs from the PCPF to the SEZ frames
+*/
+void C_PCPF2SEZArray(int num, const double *lat, const double *longitude, double C[][3][3])
+{
+    double block[9][ARRAY_BLOCK];
+
+    for (int start = 0; start < num; start += ARRAY_BLOCK) {
+        int n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        sezBlock(n, lat + start, longitude + start, block[0], ARRAY_BLOCK);
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < 9; k++) {
+                C[start + i][k/3][k%3] = block[k][i];
+            }
+        }
+    }
+}
+
+/*! Computes the DCMs from the PCPF frame to the South-East-Zenith frames of locations in the structure of arrays
+ layout, as C_PCPF2SEZ().
+@param num : [-] number of locations
+@param lat : [rad] latitudes of the locations
+@param longitude : [rad] longitudes of the locations
+@param C : [-] DCMs from the PCPF to the SEZ frames, component k of the DCM i row by row at index k*num + i
+*/
+void C_PCPF2SEZArraySoA(int num, const double *lat, const double *longitude, double *C)
+{
+    for (int start = 0; start < num; start += ARRAY_BLOCK) {
+        int n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        sezBlock(n, lat + start, longitude + start, C + start, num);
+    }
+}
@@ -32,7 +32,12 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 The geodeticConversion library contains simple transformations between inertial coordinates and planet-fixed coordinates in a general way.
 
-No support is provided for non-spherical bodies. Transformations are scripted from Vallado.
+The scalar functions assume a spherical body. Transformations are scripted from Vallado.
+
+The Array and ArraySoA versions convert num positions at once.  The Array versions take arrays of positions such as
+pcpfPosition[i][0..2], the ArraySoA versions store component k of position i at index k*num + i, and a DCM row by row.
+The planet is an ellipsoid of revolution with the equatorial and polar radii planetEqRad and planetPoRad, such as the
+WGS-84 Earth, and a sphere if the radii are equal.  The inputs and outputs must not overlap.
 
  */
 
@@ -44,4 +49,27 @@ Eigen::Vector3d PCPF2PCI(Eigen::Vector3d pcpfPosition, double J20002Pfix[3][3]);
 Eigen::Vector3d LLA2PCI(Eigen::Vector3d llaPosition, double J20002Pfix[3][3], double planetRad);
 Eigen::Matrix3d C_PCPF2SEZ(double lat, double longitude);
 
+void PCI2PCPFArray(int num, const double pciPosition[][3], const double J20002Pfix[3][3], double pcpfPosition[][3]);
+void PCI2PCPFArraySoA(int num, const double *pciPosition, const double J20002Pfix[3][3], double *pcpfPosition);
+void PCPF2PCIArray(int num, const double pcpfPosition[][3], const double J20002Pfix[3][3], double pciPosition[][3]);
+void PCPF2PCIArraySoA(int num, const double *pcpfPosition, const double J20002Pfix[3][3], double *pciPosition);
+void PCPF2LLAArray(int num, const double pcpfPosition[][3], double planetEqRad, double planetPoRad,
+                   double llaPosition[][3]);
+void PCPF2LLAArraySoA(int num, const double *pcpfPosition, double planetEqRad, double planetPoRad,
+                      double *llaPosition);
+void LLA2PCPFArray(int num, const double llaPosition[][3], double planetEqRad, double planetPoRad,
+                   double pcpfPosition[][3]);
+void LLA2PCPFArraySoA(int num, const double *llaPosition, double planetEqRad, double planetPoRad,
+                      double *pcpfPosition);
+void PCI2LLAArray(int num, const double pciPosition[][3], const double J20002Pfix[3][3], double planetEqRad,
+                  double planetPoRad, double llaPosition[][3]);
+void PCI2LLAArraySoA(int num, const double *pciPosition, const double J20002Pfix[3][3], double planetEqRad,
+                     double planetPoRad, double *llaPosition);
+void LLA2PCIArray(int num, const double llaPosition[][3], const double J20002Pfix[3][3], double planetEqRad,
+                  double planetPoRad, double pciPosition[][3]);
+void LLA2PCIArraySoA(int num, const double *llaPosition, const double J20002Pfix[3][3], double planetEqRad,
+                     double planetPoRad, double *pciPosition);
+void C_PCPF2SEZArray(int num, const double *lat, const double *longitude, double C[][3][3]);
+void C_PCPF2SEZArraySoA(int num, const double *lat, const double *longitude, double *C);
+
 #endif
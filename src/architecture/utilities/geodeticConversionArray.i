@@ -0,0 +1,202 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+%module(threads="1") geodeticConversionArray
+%{
+   #include "geodeticConversion.h"
+%}
+
+%include "stdint.i"
+
+/*
+ * As in rigidBodyKinematicsArray, the batched conversions are wrapped with the addresses of the numpy arrays and
+ * release the GIL while they run.
+ */
+%threadallow;
+%inline %{
+#define ARRAY_ADDRESS(address, type) reinterpret_cast<type>(static_cast<uintptr_t>(address))
+typedef double (*array3)[3];
+typedef const double (*constArray3)[3];
+typedef double (*array33)[3][3];
+
+void PCI2PCPFAddress(int num, uint64_t pci, uint64_t dcm, uint64_t pcpf, bool soa) {
+    if (soa) {
+        PCI2PCPFArraySoA(num, ARRAY_ADDRESS(pci, const double *), ARRAY_ADDRESS(dcm, constArray3),
+                         ARRAY_ADDRESS(pcpf, double *));
+    } else {
+        PCI2PCPFArray(num, ARRAY_ADDRESS(pci, constArray3), ARRAY_ADDRESS(dcm, constArray3),
+                      ARRAY_ADDRESS(pcpf, array3));
+    }
+}
+void PCPF2PCIAddress(int num, uint64_t pcpf, uint64_t dcm, uint64_t pci, bool soa) {
+    if (soa) {
+        PCPF2PCIArraySoA(num, ARRAY_ADDRESS(pcpf, const double *), ARRAY_ADDRESS(dcm, constArray3),
+                         ARRAY_ADDRESS(pci, double *));
+    } else {
+        PCPF2PCIArray(num, ARRAY_ADDRESS(pcpf, constArray3), ARRAY_ADDRESS(dcm, constArray3),
+                      ARRAY_ADDRESS(pci, array3));
+    }
+}
+void PCPF2LLAAddress(int num, uint64_t pcpf, double eqRad, double poRad, uint64_t lla, bool soa) {
+    if (soa) {
+        PCPF2LLAArraySoA(num, ARRAY_ADDRESS(pcpf, const double *), eqRad, poRad, ARRAY_ADDRESS(lla, double *));
+    } else {
+        PCPF2LLAArray(num, ARRAY_ADDRESS(pcpf, constArray3), eqRad, poRad, ARRAY_ADDRESS(lla, array3));
+    }
+}
+void LLA2PCPFAddress(int num, uint64_t lla, double eqRad, double poRad, uint64_t pcpf, bool soa) {
+    if (soa) {
+        LLA2PCPFArraySoA(num, ARRAY_ADDRESS(lla, const double *), eqRad, poRad, ARRAY_ADDRESS(pcpf, double *));
+    } else {
+        LLA2PCPFArray(num, ARRAY_ADDRESS(lla, constArray3), eqRad, poRad, ARRAY_ADDRESS(pcpf, array3));
+    }
+}
+void PCI2LLAAddress(int num, uint64_t pci, uint64_t dcm, double eqRad, double poRad, uint64_t lla, bool soa) {
+    if (soa) {
+        PCI2LLAArraySoA(num, ARRAY_ADDRESS(pci, const double *), ARRAY_ADDRESS(dcm, constArray3), eqRad, poRad,
+                        ARRAY_ADDRESS(lla, double *));
+    } else {
+        PCI2LLAArray(num, ARRAY_ADDRESS(pci, constArray3), ARRAY_ADDRESS(dcm, constArray3), eqRad, poRad,
+                     ARRAY_ADDRESS(lla, array3));
+    }
+}
+void LLA2PCIAddress(int num, uint64_t lla, uint64_t dcm, double eqRad, double poRad, uint64_t pci, bool soa) {
+    if (soa) {
+        LLA2PCIArraySoA(num, ARRAY_ADDRESS(lla, const double *), ARRAY_ADDRESS(dcm, constArray3), eqRad, poRad,
+                        ARRAY_ADDRESS(pci, double *));
+    } else {
+        LLA2PCIArray(num, ARRAY_ADDRESS(lla, constArray3), ARRAY_ADDRESS(dcm, constArray3), eqRad, poRad,
+                     ARRAY_ADDRESS(pci, array3));
+    }
+}
+void C_PCPF2SEZAddress(int num, uint64_t lat, uint64_t longitude, uint64_t C, bool soa) {
+    if (soa) {
+        C_PCPF2SEZArraySoA(num, ARRAY_ADDRESS(lat, const double *), ARRAY_ADDRESS(longitude, const double *),
+                           ARRAY_ADDRESS(C, double *));
+    } else {
+        C_PCPF2SEZArray(num, ARRAY_ADDRESS(lat, const double *), ARRAY_ADDRESS(longitude, const double *),
+                        ARRAY_ADDRESS(C, array33));
+    }
+}
+%}
+%nothreadallow;
+
+%pythoncode %{
+import numpy as np
+
+WGS84_EQ_RADIUS = 6378137.0
+WGS84_PO_RADIUS = 6356752.314245
+
+
+def _samples(array, soa, name):
+    """Returns the C contiguous float array and the number of samples of an (N,3) or, with soa, (3,N) input."""
+    array = np.ascontiguousarray(array, dtype=np.float64)
+    if array.ndim == 1 and array.shape[0] == 3:
+        array = array.reshape((3, 1)) if soa else array.reshape((1, 3))
+    if array.ndim != 2 or array.shape[0 if soa else 1] != 3:
+        raise ValueError("%s must be an array of shape %s" % (name, "(3,N)" if soa else "(N,3)"))
+    return array, array.shape[1 if soa else 0]
+
+
+def _dcm(J20002Pfix):
+    J20002Pfix = np.ascontiguousarray(J20002Pfix, dtype=np.float64)
+    if J20002Pfix.shape != (3, 3):
+        raise ValueError("J20002Pfix must be a 3x3 matrix")
+    return J20002Pfix
+
+
+def _output(num, soa):
+    return np.empty((3, num)) if soa else np.empty((num, 3))
+
+
+def _radii(planetEqRad, planetPoRad):
+    return float(planetEqRad), float(planetEqRad if planetPoRad is None else planetPoRad)
+
+
+def PCI2PCPF(pciPosition, J20002Pfix, soa=False):
+    """Returns the (N,3) PCPF positions of the (N,3) PCI positions, as the C++ ``PCI2PCPF()`` with the same
+    ``J20002Pfix`` matrix.  With soa the positions are (3,N)."""
+    pciPosition, num = _samples(pciPosition, soa, "pciPosition")
+    J20002Pfix = _dcm(J20002Pfix)
+    pcpfPosition = _output(num, soa)
+    PCI2PCPFAddress(num, pciPosition.ctypes.data, J20002Pfix.ctypes.data, pcpfPosition.ctypes.data, soa)
+    return pcpfPosition
+
+
+def PCPF2PCI(pcpfPosition, J20002Pfix, soa=False):
+    """Returns the (N,3) PCI positions of the (N,3) PCPF positions, as the C++ ``PCPF2PCI()``."""
+    pcpfPosition, num = _samples(pcpfPosition, soa, "pcpfPosition")
+    J20002Pfix = _dcm(J20002Pfix)
+    pciPosition = _output(num, soa)
+    PCPF2PCIAddress(num, pcpfPosition.ctypes.data, J20002Pfix.ctypes.data, pciPosition.ctypes.data, soa)
+    return pciPosition
+
+
+def PCPF2LLA(pcpfPosition, planetEqRad, planetPoRad=None, soa=False):
+    """Returns the (N,3) latitude [rad], longitude [rad] and altitude [m] of the (N,3) PCPF positions on the
+    ellipsoid with the equatorial and polar radii, or on a sphere if ``planetPoRad`` is not given."""
+    pcpfPosition, num = _samples(pcpfPosition, soa, "pcpfPosition")
+    planetEqRad, planetPoRad = _radii(planetEqRad, planetPoRad)
+    llaPosition = _output(num, soa)
+    PCPF2LLAAddress(num, pcpfPosition.ctypes.data, planetEqRad, planetPoRad, llaPosition.ctypes.data, soa)
+    return llaPosition
+
+
+def LLA2PCPF(llaPosition, planetEqRad, planetPoRad=None, soa=False):
+    """Returns the (N,3) PCPF positions of the (N,3) latitude, longitude and altitude coordinates."""
+    llaPosition, num = _samples(llaPosition, soa, "llaPosition")
+    planetEqRad, planetPoRad = _radii(planetEqRad, planetPoRad)
+    pcpfPosition = _output(num, soa)
+    LLA2PCPFAddress(num, llaPosition.ctypes.data, planetEqRad, planetPoRad, pcpfPosition.ctypes.data, soa)
+    return pcpfPosition
+
+
+def PCI2LLA(pciPosition, J20002Pfix, planetEqRad, planetPoRad=None, soa=False):
+    """Returns the (N,3) latitude, longitude and altitude coordinates of the (N,3) PCI positions."""
+    pciPosition, num = _samples(pciPosition, soa, "pciPosition")
+    J20002Pfix = _dcm(J20002Pfix)
+    planetEqRad, planetPoRad = _radii(planetEqRad, planetPoRad)
+    llaPosition = _output(num, soa)
+    PCI2LLAAddress(num, pciPosition.ctypes.data, J20002Pfix.ctypes.data, planetEqRad, planetPoRad,
+                   llaPosition.ctypes.data, soa)
+    return llaPosition
+
+
+def LLA2PCI(llaPosition, J20002Pfix, planetEqRad, planetPoRad=None, soa=False):
+    """Returns the (N,3) PCI positions of the (N,3) latitude, longitude and altitude coordinates."""
+    llaPosition, num = _samples(llaPosition, soa, "llaPosition")
+    J20002Pfix = _dcm(J20002Pfix)
+    planetEqRad, planetPoRad = _radii(planetEqRad, planetPoRad)
+    pciPosition = _output(num, soa)
+    LLA2PCIAddress(num, llaPosition.ctypes.data, J20002Pfix.ctypes.data, planetEqRad, planetPoRad,
+                   pciPosition.ctypes.data, soa)
+    return pciPosition
+
+
+def C_PCPF2SEZ(lat, longitude, soa=False):
+    """Returns the (N,3,3) DCMs from the PCPF to the South-East-Zenith frames at the N latitudes and longitudes,
+    or the (9,N) DCMs with their components row by row with soa."""
+    lat = np.ascontiguousarray(np.atleast_1d(lat), dtype=np.float64)
+    longitude = np.ascontiguousarray(np.atleast_1d(longitude), dtype=np.float64)
+    if lat.ndim != 1 or lat.shape != longitude.shape:
+        raise ValueError("lat and longitude must be arrays of shape (N,)")
+    num = lat.shape[0]
+    C = np.empty((9, num)) if soa else np.empty((num, 3, 3))
+    C_PCPF2SEZAddress(num, lat.ctypes.data, longitude.ctypes.data, C.ctypes.data, soa)
+    return C
+%}
@@ -0,0 +1,177 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+#include "allocationGuard.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+/*! Per-thread guard state, plain thread_local PODs so that reading them never allocates */
+static thread_local bool guardArmed = false;
+static thread_local bool guardSuspended = false;
+static thread_local bool guardAbort = false;
+static thread_local uint64_t guardCount = 0;
+
+/*!
+ * This method starts counting the allocations made on the calling thread
+ * @param abortOnAllocation flag to abort the process on the first allocation
+ */
+void AllocationGuard::arm(bool abortOnAllocation)
+{
+    guardAbort = abortOnAllocation;
+    guardSuspended = false;
+    guardArmed = true;
+}
+
+/*!
+ * This method stops counting and clears the allocation count of the calling thread
+ */
+void AllocationGuard::disarm()
+{
+    guardArmed = false;
+    guardSuspended = false;
+    guardCount = 0;
+}
+
+/*!
+ * This method pauses an armed guard, for instance while the thread is idle between simulation runs
+ */
+void AllocationGuard::suspend()
+{
+    if (guardArmed) {
+        guardArmed = false;
+        guardSuspended = true;
+    }
+}
+
+/*!
+ * This method resumes a guard that was paused with suspend()
+ */
+void AllocationGuard::resume()
+{
+    if (guardSuspended) {
+        guardSuspended = false;
+        guardArmed = true;
+    }
+}
+
+/*!
+ * @return bool true if the guard of the calling thread is counting
+ */
+bool AllocationGuard::isArmed()
+{
+    return guardArmed;
+}
+
+/*!
+ * @return uint64_t the number of allocations counted on the calling thread
+ */
+uint64_t AllocationGuard::count()
+{
+    return guardCount;
+}
+
+/*!
+ * This method records an allocation on the calling thread and aborts the process if requested
+ */
+void AllocationGuard::noteAllocation()
+{
+    if (!guardArmed) {
+        return;
+    }
+    guardCount++;
+    if (guardAbort) {
+        guardArmed = false;
+        fprintf(stderr, "AllocationGuard: heap allocation on a thread that must not allocate\n");
+        abort();
+    }
+}
+
+#if defined(__linux__) && defined(BSK_ALLOCATION_GUARD)
+/* Replacements of the global allocation functions, only built with the BUILD_ALLOCATION_GUARD cmake option.  They
+ keep the standard behavior of the default ones and only add the call to the guard. */
+void* operator new(std::size_t size)
+{
+    AllocationGuard::noteAllocation();
+    if (size == 0) {
+        size = 1;
+    }
+    void *ptr;
+    while ((ptr = std::malloc(size)) == nullptr) {
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+    return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try {
+        return ::operator new(size);
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, const std::nothrow_t&) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
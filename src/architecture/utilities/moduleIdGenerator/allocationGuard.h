@@ -0,0 +1,67 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _AllocationGuard_HH_
+#define _AllocationGuard_HH_
+
+#include <inttypes.h>
+
+/*! @brief Counts the heap allocations made through the global operator new on the calling thread.
+
+ Replacing the global allocation functions affects every allocation of the process, so the replacement is only
+ compiled into the shared ModuleIdGenerator library on Linux when Basilisk is built with the
+ ``BUILD_ALLOCATION_GUARD`` cmake option.  All the Basilisk modules of a process then share one replacement.
+ Counting is per thread and only happens while the guard is armed, so a real-time module can check that the
+ scheduler thread does not allocate once the simulation is initialized.  In other builds the guard counts nothing;
+ isActive() reports if the allocations of the calling library are routed through the guard. */
+#ifdef _WIN32
+class __declspec( dllexport) AllocationGuard
+#else
+class AllocationGuard
+#endif
+{
+public:
+    static void arm(bool abortOnAllocation);  //! -- Starts counting the allocations of the calling thread
+    static void disarm();                     //! -- Stops counting and clears the count of the calling thread
+    static void suspend();                    //! -- Pauses an armed guard of the calling thread, keeping the count
+    static void resume();                     //! -- Resumes a guard paused by suspend()
+    static bool isArmed();                    //! -- Returns true if the guard of the calling thread is counting
+    static uint64_t count();                  //! -- Number of allocations counted on the calling thread since arm()
+    static void noteAllocation();             //! -- Records an allocation, called by the replaced operator new
+
+    /*! Returns true if an allocation made by the caller is seen by the guard.  This is inline on purpose so that the
+     test allocation is made from the library of the caller. */
+    static bool isActive()
+    {
+        bool wasArmed = isArmed();
+        uint64_t countBefore = count();
+        if (!wasArmed) {
+            arm(false);
+        }
+        char * volatile probe = new char;
+        delete probe;
+        bool active = count() > countBefore;
+        if (!wasArmed) {
+            disarm();
+        }
+        return active;
+    }
+};
+
+#endif /* _AllocationGuard_HH_ */
@@ -0,0 +1,178 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+#include "messageArena.h"
+#include <cstdlib>
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/*! Arena opened on each thread, a plain thread_local pointer so that message construction stays cheap */
+static thread_local MessageArena *openArena = nullptr;
+
+/*! Memory policy constants of the mbind system call, defined here to avoid a dependency on libnuma */
+#define ARENA_MPOL_PREFERRED 1
+#define ARENA_MPOL_MF_MOVE (1 << 1)
+
+/*! This method allocates a zeroed, page aligned block.  Anonymous mappings are used on Linux so that the pages can
+ be moved between NUMA nodes.
+ @param size size of the block, a multiple of the page size
+ @return char* the block, NULL if out of memory
+ */
+static char* allocateBlock(size_t size)
+{
+#if defined(__linux__)
+    void *memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return memory == MAP_FAILED ? nullptr : (char *) memory;
+#else
+    return (char *) std::calloc(size, 1);
+#endif
+}
+
+/*! This method frees a block allocated by allocateBlock()
+ @param memory the block
+ @param size size of the block
+ */
+static void freeBlock(char *memory, size_t size)
+{
+#if defined(__linux__)
+    munmap(memory, size);
+#else
+    (void) size;
+    std::free(memory);
+#endif
+}
+
+/*! The constructor does not allocate, the first block is allocated by the first message placed in the arena.
+ @param blockSize minimum size of the memory blocks of the arena in bytes
+ */
+MessageArena::MessageArena(size_t blockSize)
+{
+    const size_t pageSize = 4096;
+    this->blockSize = blockSize < pageSize ? pageSize : (blockSize + pageSize - 1) / pageSize * pageSize;
+    this->used = 0;
+    this->count = 0;
+    this->node = -1;
+    this->previous = nullptr;
+}
+
+/*! The destructor frees the arena memory.  The messages placed in the arena must not be used anymore. */
+MessageArena::~MessageArena()
+{
+    if (openArena == this) {
+        this->close();
+    }
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        freeBlock(this->blocks[i].memory, this->blocks[i].size);
+    }
+}
+
+/*! This method makes this arena the one the messages created on the calling thread are placed in */
+void MessageArena::open()
+{
+    if (openArena == this) {
+        return;
+    }
+    this->previous = openArena;
+    openArena = this;
+}
+
+/*! This method stops placing messages in this arena and reopens the arena that was open before open() */
+void MessageArena::close()
+{
+    if (openArena != this) {
+        return;
+    }
+    openArena = this->previous;
+    this->previous = nullptr;
+}
+
+/*!
+ @return MessageArena* the arena opened on the calling thread, NULL if none is open
+ */
+MessageArena* MessageArena::current()
+{
+    return openArena;
+}
+
+/*! This method returns zeroed memory following the previous allocation.  Allocations are never freed individually,
+ the memory is released with the arena.
+ @param size number of bytes
+ @param alignment required alignment, a power of two not larger than the page size
+ @return void* the memory, NULL if the system is out of memory
+ */
+void* MessageArena::allocate(size_t size, size_t alignment)
+{
+    if (!this->blocks.empty()) {
+        Block &block = this->blocks.back();
+        size_t start = (block.used + alignment - 1) & ~(alignment - 1);
+        if (start + size <= block.size) {
+            block.used = start + size;
+            this->used += size;
+            this->count++;
+            return block.memory + start;
+        }
+    }
+    size_t blockSize = this->blockSize;
+    while (blockSize < size) {
+        blockSize += this->blockSize;
+    }
+    char *memory = allocateBlock(blockSize);
+    if (memory == nullptr) {
+        return nullptr;
+    }
+    Block block = {memory, blockSize, size};
+    this->blocks.push_back(block);
+    this->used += size;
+    this->count++;
+    return memory;
+}
+
+/*! This method moves the arena memory to the NUMA node of the CPU the calling thread runs on, and makes the pages
+ allocated later prefer that node.  It only has an effect on Linux, on a single node machine it does nothing.
+ @return bool true if the memory was placed on the node of the calling thread
+ */
+bool MessageArena::placeOnCurrentNode()
+{
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_getcpu)
+    unsigned int cpu = 0;
+    unsigned int cpuNode = 0;
+    unsigned long nodeMask[16] = {0};
+    const size_t maskBits = 8 * sizeof(nodeMask);
+    const size_t wordBits = 8 * sizeof(unsigned long);
+    if (syscall(SYS_getcpu, &cpu, &cpuNode, nullptr) != 0 || cpuNode >= maskBits) {
+        return false;
+    }
+    nodeMask[cpuNode / wordBits] = 1UL << (cpuNode % wordBits);
+    bool placed = true;
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        if (syscall(SYS_mbind, this->blocks[i].memory, this->blocks[i].size, ARENA_MPOL_PREFERRED,
+                    nodeMask, maskBits + 1, ARENA_MPOL_MF_MOVE) != 0) {
+            placed = false;
+        }
+    }
+    if (placed) {
+        this->node = (int) cpuNode;
+    }
+    return placed;
+#else
+    return false;
+#endif
+}
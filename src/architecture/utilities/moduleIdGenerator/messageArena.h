@@ -0,0 +1,70 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _MessageArena_HH_
+#define _MessageArena_HH_
+
+#include <stddef.h>
+#include <vector>
+
+/*! @brief Contiguous storage for the headers and payloads of the C++ messages of a process.
+
+ While an arena is opened on a thread, the C++ messages created on that thread place their header and payload in
+ the arena instead of inside the module owning them.  The messages are placed one after the other in the order they
+ are created, which for modules created in task and priority order is the order in which the process writes them.
+ placeOnCurrentNode() moves the arena memory to the NUMA node of the calling thread, the process calls it when it
+ is initialized on the thread executing it.  The arena is compiled into the shared ModuleIdGenerator library so
+ that all the module libraries see the same opened arena. */
+#ifdef _WIN32
+class __declspec( dllexport) MessageArena
+#else
+class MessageArena
+#endif
+{
+public:
+    MessageArena(size_t blockSize = 65536);
+    ~MessageArena();
+    void open();  //! -- Places the messages created on the calling thread in this arena until close() is called
+    void close();  //! -- Stops placing messages in this arena, reopening the arena that was open before
+    static MessageArena* current();  //! -- Returns the arena opened on the calling thread or NULL
+    void* allocate(size_t size, size_t alignment);  //! -- Returns zeroed memory from the arena, NULL if out of memory
+    bool placeOnCurrentNode();  //! -- Moves the arena memory to the NUMA node of the calling thread
+    size_t bytesUsed() {return this->used;}  //!< -- Number of bytes allocated from the arena
+    size_t messageCount() {return this->count;}  //!< -- Number of messages placed in the arena
+    int numaNode() {return this->node;}  //!< -- NUMA node the arena was placed on, -1 if not placed
+
+private:
+    /*! memory block of the arena */
+    struct Block {
+        char *memory;  //!< -- start of the block, page aligned
+        size_t size;  //!< -- size of the block in bytes
+        size_t used;  //!< -- bytes of the block already allocated
+    };
+    std::vector<Block> blocks;  //!< -- blocks of the arena, only the last one is allocated from
+    size_t blockSize;  //!< -- minimum size of a new block
+    size_t used;  //!< -- bytes allocated from all the blocks
+    size_t count;  //!< -- number of allocations
+    int node;  //!< -- NUMA node of the memory, -1 if not placed
+    MessageArena *previous;  //!< -- arena that was open on the thread when this one was opened
+
+    MessageArena(MessageArena const &) {};
+    MessageArena& operator =(MessageArena const &){return(*this);};
+};
+
+#endif /* _MessageArena_HH_ */
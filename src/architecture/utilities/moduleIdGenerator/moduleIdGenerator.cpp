@@ -19,6 +19,11 @@
 #include "moduleIdGenerator.h"
 #include <cstring>
 #include <stdio.h>
+#include <mutex>
+
+/*! Guards the singleton creation and the ID counter as modules can be
+ * constructed from several Python threads at once */
+static std::mutex moduleIdLock;
 
 /*!
  * This constructor for TheInstance just sets it NULL
@@ -48,6 +53,7 @@ ModuleIdGenerator::~ModuleIdGenerator()
  */
 ModuleIdGenerator* ModuleIdGenerator::GetInstance()
 {
+    std::lock_guard<std::mutex> lock(moduleIdLock);
     if(TheInstance == NULL)
     {
         TheInstance = new ModuleIdGenerator();
@@ -61,5 +67,6 @@ ModuleIdGenerator* ModuleIdGenerator::GetInstance()
  */
 int64_t ModuleIdGenerator::checkoutModuleID()
 {
+    std::lock_guard<std::mutex> lock(moduleIdLock);
     return(this->nextModuleID++);
 }
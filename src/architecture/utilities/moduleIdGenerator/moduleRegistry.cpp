@@ -0,0 +1,80 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+#include "moduleRegistry.h"
+
+/*! Guards the creation of the registry, module libraries register their types while they are loaded */
+static std::mutex registryCreationLock;
+
+ModuleRegistry* ModuleRegistry::TheInstance = NULL;
+
+/*!
+ * This gives a pointer to the registry to whoever asks for it.
+ * @return ModuleRegistry* TheInstance
+ */
+ModuleRegistry* ModuleRegistry::GetInstance()
+{
+    std::lock_guard<std::mutex> lock(registryCreationLock);
+    if(TheInstance == NULL)
+    {
+        TheInstance = new ModuleRegistry();
+    }
+    return(TheInstance);
+}
+
+/*!
+ * This method adds a module type to the registry.  A type registered again, e.g. by a rebuilt
+ * library, replaces the previous entry.
+ * @param module the factory, variable setters and messages of the module type
+ */
+void ModuleRegistry::registerModule(const RegisteredModule &module)
+{
+    std::lock_guard<std::mutex> lock(this->registryLock);
+    this->modules[module.typeName] = module;
+}
+
+/*!
+ * This method looks up a module type.
+ * @param typeName library and class name of the module type
+ * @return const RegisteredModule* the module type, NULL if no loaded library registered it
+ */
+const RegisteredModule* ModuleRegistry::findModule(const std::string &typeName)
+{
+    std::lock_guard<std::mutex> lock(this->registryLock);
+    std::map<std::string, RegisteredModule>::iterator it = this->modules.find(typeName);
+    if(it == this->modules.end())
+    {
+        return(NULL);
+    }
+    return(&it->second);
+}
+
+/*!
+ * This method lists the registered module types.
+ * @return std::vector<std::string> the type names in alphabetical order
+ */
+std::vector<std::string> ModuleRegistry::moduleTypes()
+{
+    std::lock_guard<std::mutex> lock(this->registryLock);
+    std::vector<std::string> names;
+    for(std::map<std::string, RegisteredModule>::iterator it = this->modules.begin(); it != this->modules.end(); it++)
+    {
+        names.push_back(it->first);
+    }
+    return(names);
+}
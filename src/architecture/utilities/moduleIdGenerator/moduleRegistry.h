@@ -0,0 +1,96 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _ModuleRegistry_HH_
+#define _ModuleRegistry_HH_
+
+#include <inttypes.h>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class SysModel;
+class BSKLogger;
+
+/*! @brief value of a module variable given in a scenario description */
+struct RegistryValue {
+    std::vector<double> numbers;        //!< -- numbers of the value, matrices are stored row by row
+    size_t rows = 1;                    //!< -- number of rows, the length of a list of numbers
+    std::string text;                   //!< -- text of a string value
+    bool isText = false;                //!< -- flag indicating a string value
+};
+
+/*! @brief message of a registered module type */
+struct RegisteredMessage {
+    std::string payloadType;                                //!< -- name of the payload structure
+    bool isC = false;                                       //!< -- flag indicating a C wrapped message
+    std::function<void* (void*)> address;                   //!< -- returns the message of the module variables
+    std::function<void (void*, void*, bool)> subscribe;     //!< -- subscribes the input of the module variables to a source message, the flag indicates a C wrapped source
+};
+
+/*! @brief factory, variable setters and messages of a module type, registered by the library defining the module */
+struct RegisteredModule {
+    std::string typeName;                                   //!< -- library and class name, e.g. cppModuleTemplate.CppModuleTemplate
+    std::function<SysModel* ()> createModel;                //!< -- creates a C++ module, empty for C modules
+    std::function<void* (SysModel*)> variables;             //!< -- returns the object holding the variables of a C++ module
+    std::function<void (SysModel*)> destroyModel;           //!< -- deletes a C++ module
+    std::function<void* ()> createConfig;                   //!< -- creates the zeroed configuration structure of a C module
+    std::function<void (void*)> destroyConfig;              //!< -- frees the configuration structure of a C module
+    std::function<void (void*, BSKLogger*)> setLogger;      //!< -- assigns the logger of a C module configuration
+    void (*selfInit)(void*, uint64_t) = nullptr;            //!< -- SelfInit function of a C module
+    void (*update)(void*, uint64_t, uint64_t) = nullptr;    //!< -- Update function of a C module
+    void (*reset)(void*, uint64_t, uint64_t) = nullptr;     //!< -- Reset function of a C module
+    std::map<std::string, std::function<bool (void*, const RegistryValue&)>> fields;  //!< -- setters of the module variables
+    std::map<std::string, RegisteredMessage> outputs;       //!< -- messages other modules can subscribe to
+    std::map<std::string, RegisteredMessage> inputs;        //!< -- messages that can subscribe to other messages
+};
+
+/*! @brief registry of the module types of all loaded module libraries, used to build simulations natively */
+#ifdef _WIN32
+class __declspec( dllexport) ModuleRegistry
+#else
+class ModuleRegistry
+#endif
+{
+public:
+    static ModuleRegistry* GetInstance();  //! -- returns the registry shared by all module libraries
+    void registerModule(const RegisteredModule &module);  //! -- adds or replaces a module type
+    const RegisteredModule* findModule(const std::string &typeName);  //! -- returns the module type or NULL
+    std::vector<std::string> moduleTypes();  //! -- returns the names of the registered module types
+
+private:
+    std::map<std::string, RegisteredModule> modules;  //!< -- registered module types by name
+    std::mutex registryLock;  //!< -- guards the module map, libraries can be loaded from several threads
+    static ModuleRegistry *TheInstance;  //!< -- registry instance
+
+    ModuleRegistry() {};
+    ModuleRegistry(ModuleRegistry const &) {};
+    ModuleRegistry& operator =(ModuleRegistry const &){return(*this);};
+};
+
+/*! @brief registers a module type when the library defining it is loaded, used by the generated registration code */
+class ModuleRegistration
+{
+public:
+    ModuleRegistration(const RegisteredModule &module) {ModuleRegistry::GetInstance()->registerModule(module);} //!< -- constructor
+};
+
+#endif /* _ModuleRegistry_HH_ */
@@ -580,6 +580,92 @@ void rv2elem(double mu, double *rVec, double *vVec, classicElements *elements)
     return;
 }
 
+/*!
+ * Purpose: Batched version of rv2elem() converting the inertial states of several objects at once.
+ *   The singular cases are handled with selections instead of branches, so the loop over the
+ *   objects is free of function calls other than the math library and can be vectorized.
+ *   Divisions are replaced by multiplications with reciprocals, so the elements agree with
+ *   those of rv2elem() to rounding rather than bitwise.
+ * Inputs:
+ *   mu = gravitational parameter
+ *   count = number of objects
+ *   rVec = count inertial position vectors
+ *   vVec = count inertial velocity vectors
+ * Outputs:
+ *   elements = count sets of orbit elements
+ */
+void rv2elemArray(double mu, int count, double rVec[][3], double vVec[][3], classicElements *elements)
+{
+    const double eps = 1e-12;   /* small numerical value parameter, as in rv2elem() */
+    int k;
+
+    for (k = 0; k < count; k++) {
+        const double *rv = rVec[k];
+        const double *vv = vVec[k];
+
+        /* norms of position and velocity vectors */
+        double r = sqrt(rv[0]*rv[0] + rv[1]*rv[1] + rv[2]*rv[2]);
+        double v = sqrt(vv[0]*vv[0] + vv[1]*vv[1] + vv[2]*vv[2]);
+        double rInv = r > DB0_EPS ? 1. / r : 0.0;
+        double irHat[3] = {rv[0]*rInv, rv[1]*rInv, rv[2]*rInv};
+
+        /* specific angular momentum, its magnitude and the parameter */
+        double hVec[3] = {rv[1]*vv[2] - rv[2]*vv[1], rv[2]*vv[0] - rv[0]*vv[2], rv[0]*vv[1] - rv[1]*vv[0]};
+        double h = sqrt(hVec[0]*hVec[0] + hVec[1]*hVec[1] + hVec[2]*hVec[2]);
+        double hInv = h > DB0_EPS ? 1. / h : 0.0;
+        double ihHat[3] = {hVec[0]*hInv, hVec[1]*hInv, hVec[2]*hInv};
+        double p = h*h / mu;
+
+        /* line of nodes, the first inertial axis for near equatorial orbits */
+        double nNorm = sqrt(hVec[1]*hVec[1] + hVec[0]*hVec[0]);
+        int equatorial = nNorm < eps;
+        double nInv = equatorial ? 0.0 : 1. / nNorm;
+        double inHat[3] = {equatorial ? 1.0 : -hVec[1]*nInv, equatorial ? 0.0 : hVec[0]*nInv, 0.0};
+
+        /* eccentricity vector, the line of nodes for near circular orbits */
+        double c1 = v * v / mu - 1.0 / r;
+        double c2 = (rv[0]*vv[0] + rv[1]*vv[1] + rv[2]*vv[2]) / mu;
+        double eVec[3] = {c1*rv[0] - c2*vv[0], c1*rv[1] - c2*vv[1], c1*rv[2] - c2*vv[2]};
+        double e = sqrt(eVec[0]*eVec[0] + eVec[1]*eVec[1] + eVec[2]*eVec[2]);
+        int circular = !(e > eps);
+        double eInv = circular ? 0.0 : 1. / e;
+        double ieHat[3] = {circular ? inHat[0] : eVec[0]*eInv,
+                           circular ? inHat[1] : eVec[1]*eInv,
+                           circular ? inHat[2] : eVec[2]*eInv};
+
+        /* semi-major axis, zero for parabolic orbits */
+        double alpha = 2.0 / r - v*v / mu;
+        int parabolic = !(fabs(alpha) > eps);
+
+        /* angles */
+        double v3[3];
+        double Omega = atan2(inHat[1], inHat[0]);
+        double omega;
+        double f;
+        v3[0] = inHat[1]*ieHat[2] - inHat[2]*ieHat[1];
+        v3[1] = inHat[2]*ieHat[0] - inHat[0]*ieHat[2];
+        v3[2] = inHat[0]*ieHat[1] - inHat[1]*ieHat[0];
+        omega = atan2(ihHat[0]*v3[0] + ihHat[1]*v3[1] + ihHat[2]*v3[2],
+                      inHat[0]*ieHat[0] + inHat[1]*ieHat[1] + inHat[2]*ieHat[2]);
+        v3[0] = ieHat[1]*irHat[2] - ieHat[2]*irHat[1];
+        v3[1] = ieHat[2]*irHat[0] - ieHat[0]*irHat[2];
+        v3[2] = ieHat[0]*irHat[1] - ieHat[1]*irHat[0];
+        f = atan2(ihHat[0]*v3[0] + ihHat[1]*v3[1] + ihHat[2]*v3[2],
+                  ieHat[0]*irHat[0] + ieHat[1]*irHat[1] + ieHat[2]*irHat[2]);
+
+        elements[k].rmag = r;
+        elements[k].e = e;
+        elements[k].rPeriap = p / (1.0 + e);
+        elements[k].alpha = alpha;
+        elements[k].a = parabolic ? 0.0 : 1.0 / alpha;
+        elements[k].rApoap = parabolic ? 0.0 : p / (1.0 - e);
+        elements[k].i = safeAcos(hVec[2] / h);
+        elements[k].Omega = Omega < 0.0 ? Omega + 2*M_PI : Omega;
+        elements[k].omega = omega < 0.0 ? omega + 2*M_PI : omega;
+        elements[k].f = f < 0.0 ? f + 2*M_PI : f;
+    }
+}
+
 /*!
  * Purpose: This program computes the atmospheric density based on altitude
  *   supplied by user.  This function uses a curve fit based on
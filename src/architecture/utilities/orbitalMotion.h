@@ -79,6 +79,7 @@ extern "C" {
     double  N2H(double N, double e);
     void    elem2rv(double mu, classicElements *elements, double *rVec, double *vVec);
     void    rv2elem(double mu, double *rVec, double *vVec, classicElements *elements);
+    void    rv2elemArray(double mu, int count, double rVec[][3], double vVec[][3], classicElements *elements);
     void    clMeanOscMap(double req, double J2, classicElements *elements, classicElements *elements_p, double sgn);
     void    clElem2eqElem(classicElements *elements_cl, equinoctialElements *elements_eq);
 
@@ -0,0 +1,356 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "relativeMotion.h"
+#include "architecture/utilities/bsk_Print.h"
+#include <math.h>
+
+typedef Eigen::Matrix<double, 6, 6> StateMatrix;
+
+/*! Mean orbit elements of the chief used by the Gim-Alfriend STM. The set (a, lambda, i, q1, q2, Omega) with the mean
+ argument of latitude lambda = M + omega, q1 = e cos(omega) and q2 = e sin(omega) is not singular for circular orbits.
+ */
+typedef struct {
+    double a;       //!< [m] semi-major axis
+    double lambda;  //!< [rad] mean argument of latitude
+    double i;       //!< [rad] inclination
+    double q1;      //!< [-] e cos(omega)
+    double q2;      //!< [-] e sin(omega)
+    double Omega;   //!< [rad] right ascension of the ascending node
+} nonsingularElements;
+
+/*! Checks that the chief orbit is elliptic
+ @return bool true if the STM can be evaluated about the chief
+ @param chief chief orbit elements
+ @param caller name of the calling function
+ */
+static bool checkChief(const classicElements &chief, const char *caller)
+{
+    if (chief.a <= 0.0 || chief.e < 0.0 || chief.e >= 1.0) {
+        BSK_PRINT(MSG_ERROR, "%s() requires an elliptic chief orbit, received a = %g and e = %g.",
+                  caller, chief.a, chief.e);
+        return false;
+    }
+    return true;
+}
+
+/*! Sensitivity of the Hill frame relative state to the chief mean nonsingular elements. The orbit is expressed in the
+ node frame, whose first axis points to the ascending node and whose third axis is the orbit normal, through the
+ eccentric argument of latitude F, solution of lambda = F - q1 sin(F) + q2 cos(F). The partials of the in-plane position
+ and velocity are taken analytically and rotated into the Hill frame of the chief.
+ @return StateMatrix d[rho_H, rhoPrime_H]/d[a, lambda, i, q1, q2, Omega]
+ @param mu [m^3/s^2] gravitational constant
+ @param oe chief mean nonsingular elements
+ */
+static StateMatrix hillSensitivity(double mu, const nonsingularElements &oe)
+{
+    double a = oe.a;
+    double k = oe.q1;
+    double h = oe.q2;
+
+    /* solve the generalized Kepler equation for F */
+    double F = oe.lambda;
+    for (int iter = 0; iter < 50; iter++) {
+        double dF = (F - k * sin(F) + h * cos(F) - oe.lambda) / (1.0 - k * cos(F) - h * sin(F));
+        F -= dF;
+        if (fabs(dF) < 1e-15) {
+            break;
+        }
+    }
+
+    double eta = sqrt(1.0 - k * k - h * h);
+    double b = 1.0 / (1.0 + eta);
+    double n = sqrt(mu / (a * a * a));
+    double cF = cos(F);
+    double sF = sin(F);
+    double D = 1.0 - k * cF - h * sF;
+    double r = a * D;
+
+    /* in-plane position and velocity in the node frame */
+    double X = a * ((1.0 - h * h * b) * cF + h * k * b * sF - k);
+    double Y = a * ((1.0 - k * k * b) * sF + h * k * b * cF - h);
+    double G = n * a / D;
+    double A = h * k * b * cF - (1.0 - h * h * b) * sF;
+    double B = (1.0 - k * k * b) * cF - h * k * b * sF;
+    double Xd = G * A;
+    double Yd = G * B;
+
+    /* partials with respect to F, q1, q2 and b, each holding the others fixed */
+    double XF = a * (-(1.0 - h * h * b) * sF + h * k * b * cF);
+    double YF = a * ((1.0 - k * k * b) * cF - h * k * b * sF);
+    double Xk = a * (h * b * sF - 1.0);
+    double Xh = a * (-2.0 * h * b * cF + k * b * sF);
+    double Xb = a * (-h * h * cF + h * k * sF);
+    double Yk = a * (-2.0 * k * b * sF + h * b * cF);
+    double Yh = a * (k * b * cF - 1.0);
+    double Yb = a * (-k * k * sF + h * k * cF);
+    double GF = -n * a * (k * sF - h * cF) / (D * D);
+    double Gk = n * a * cF / (D * D);
+    double Gh = n * a * sF / (D * D);
+    double AF = -h * k * b * sF - (1.0 - h * h * b) * cF;
+    double Ak = h * b * cF;
+    double Ah = k * b * cF + 2.0 * h * b * sF;
+    double Ab = h * k * cF + h * h * sF;
+    double BF = -(1.0 - k * k * b) * sF - h * k * b * cF;
+    double Bk = -2.0 * k * b * cF - h * b * sF;
+    double Bh = -k * b * sF;
+    double Bb = -k * k * cF - h * k * sF;
+
+    /* chain rule through F(lambda, q1, q2) and b(q1, q2) */
+    double Fk = sF / D;
+    double Fh = -cF / D;
+    double bk = b * b * k / eta;
+    double bh = b * b * h / eta;
+    double XdF = GF * A + G * AF;
+    double YdF = GF * B + G * BF;
+
+    Eigen::Vector3d p(X, Y, 0.0);
+    Eigen::Vector3d v(Xd, Yd, 0.0);
+    Eigen::Matrix<double, 3, 6> dp;
+    Eigen::Matrix<double, 3, 6> dv;
+    dp.col(0) = p / a;
+    dv.col(0) = -v / (2.0 * a);
+    dp.col(1) = v / n;
+    dv.col(1) = -mu / (n * r * r * r) * p;
+    dp.col(2) = Eigen::Vector3d::UnitX().cross(p);
+    dv.col(2) = Eigen::Vector3d::UnitX().cross(v);
+    dp.col(3) << Xk + XF * Fk + Xb * bk, Yk + YF * Fk + Yb * bk, 0.0;
+    dv.col(3) << Gk * A + G * Ak + XdF * Fk + G * Ab * bk, Gk * B + G * Bk + YdF * Fk + G * Bb * bk, 0.0;
+    dp.col(4) << Xh + XF * Fh + Xb * bh, Yh + YF * Fh + Yb * bh, 0.0;
+    dv.col(4) << Gh * A + G * Ah + XdF * Fh + G * Ab * bh, Gh * B + G * Bh + YdF * Fh + G * Bb * bh, 0.0;
+    Eigen::Vector3d z_N(0.0, sin(oe.i), cos(oe.i));  // inertial third axis in the node frame
+    dp.col(5) = z_N.cross(p);
+    dv.col(5) = z_N.cross(v);
+
+    /* rotate into the Hill frame, whose angular velocity is h/r^2 about the orbit normal */
+    double theta = atan2(Y, X);
+    Eigen::Matrix3d HO;
+    HO << cos(theta), sin(theta), 0.0,
+         -sin(theta), cos(theta), 0.0,
+          0.0, 0.0, 1.0;
+    double thetaDot = (X * Yd - Y * Xd) / (r * r);
+    StateMatrix sigma;
+    sigma.topRows<3>() = HO * dp;
+    sigma.bottomRows<3>() = HO * dv;
+    sigma.row(3) += thetaDot * sigma.row(1);
+    sigma.row(4) -= thetaDot * sigma.row(0);
+    return sigma;
+}
+
+/*! Clohessy-Wiltshire STM about a circular chief orbit
+ @return Eigen::MatrixXd 6x6 STM of the Hill frame relative state
+ @param n [rad/s] chief mean motion
+ @param dt [s] propagation time
+ */
+Eigen::MatrixXd clohessyWiltshireSTM(double n, double dt)
+{
+    double nt = n * dt;
+    double c = cos(nt);
+    double s = sin(nt);
+    Eigen::MatrixXd stm = Eigen::MatrixXd::Zero(6, 6);
+    stm(0, 0) = 4.0 - 3.0 * c;
+    stm(0, 3) = s / n;
+    stm(0, 4) = 2.0 * (1.0 - c) / n;
+    stm(1, 0) = 6.0 * (s - nt);
+    stm(1, 1) = 1.0;
+    stm(1, 3) = -2.0 * (1.0 - c) / n;
+    stm(1, 4) = (4.0 * s - 3.0 * nt) / n;
+    stm(2, 2) = c;
+    stm(2, 5) = s / n;
+    stm(3, 0) = 3.0 * n * s;
+    stm(3, 3) = c;
+    stm(3, 4) = 2.0 * s;
+    stm(4, 0) = -6.0 * n * (1.0 - c);
+    stm(4, 3) = -2.0 * s;
+    stm(4, 4) = 4.0 * c - 3.0;
+    stm(5, 2) = -n * s;
+    stm(5, 5) = c;
+    return stm;
+}
+
+/*! Yamanaka-Ankersen STM about an elliptic chief orbit. The solution is evaluated in the transformed variables
+ x~ = (1 + e cos f) x with the true anomaly f as independent variable, then mapped back to the Hill frame states.
+ @return Eigen::MatrixXd 6x6 STM of the Hill frame relative state
+ @param mu [m^3/s^2] gravitational constant
+ @param chief chief orbit elements at the initial time, only a, e and f are used
+ @param dt [s] propagation time
+ */
+Eigen::MatrixXd yamanakaAnkersenSTM(double mu, classicElements chief, double dt)
+{
+    if (!checkChief(chief, "yamanakaAnkersenSTM")) {
+        return Eigen::MatrixXd::Zero(6, 6);
+    }
+    double e = chief.e;
+    double eta2 = 1.0 - e * e;
+    double p = chief.a * eta2;
+    double n = sqrt(mu / (chief.a * chief.a * chief.a));
+    double k2 = sqrt(mu / (p * p * p));     // h/p^2
+    double J = k2 * dt;
+
+    double f0 = chief.f;
+    double f = E2f(M2E(E2M(f2E(f0, e), e) + n * dt, e), e);
+
+    /* in-plane solution in the YA frame (along-track, -radial) */
+    double rho0 = 1.0 + e * cos(f0);
+    double s0 = rho0 * sin(f0);
+    double c0 = rho0 * cos(f0);
+    double rho = 1.0 + e * cos(f);
+    double s = rho * sin(f);
+    double c = rho * cos(f);
+    double sp = cos(f) + e * cos(2.0 * f);
+    double cp = -(sin(f) + e * sin(2.0 * f));
+
+    Eigen::Matrix4d pseudoInit;
+    pseudoInit << eta2, 3.0 * e * s0 * (1.0 / rho0 + 1.0 / (rho0 * rho0)), -e * s0 * (1.0 + 1.0 / rho0), -e * c0 + 2.0,
+                  0.0, -3.0 * s0 * (1.0 / rho0 + e * e / (rho0 * rho0)), s0 * (1.0 + 1.0 / rho0), c0 - 2.0 * e,
+                  0.0, -3.0 * (c0 / rho0 + e), c0 * (1.0 + 1.0 / rho0) + e, -s0,
+                  0.0, 3.0 * rho0 + e * e - 1.0, -rho0 * rho0, e * s0;
+    pseudoInit /= eta2;
+    Eigen::Matrix4d fundamental;
+    fundamental << 1.0, -c * (1.0 + 1.0 / rho), s * (1.0 + 1.0 / rho), 3.0 * rho * rho * J,
+                   0.0, s, c, 2.0 - 3.0 * e * s * J,
+                   0.0, 2.0 * s, 2.0 * c - e, 3.0 * (1.0 - 2.0 * e * s * J),
+                   0.0, sp, cp, -3.0 * e * (sp * J + s / (rho * rho));
+
+    /* map [x, z, xDot, zDot] to the transformed variables and back */
+    Eigen::Matrix4d T0 = Eigen::Matrix4d::Zero();
+    T0(0, 0) = T0(1, 1) = rho0;
+    T0(2, 0) = T0(3, 1) = -e * sin(f0);
+    T0(2, 2) = T0(3, 3) = 1.0 / (k2 * rho0);
+    Eigen::Matrix4d T1inv = Eigen::Matrix4d::Zero();
+    T1inv(0, 0) = T1inv(1, 1) = 1.0 / rho;
+    T1inv(2, 0) = T1inv(3, 1) = k2 * e * sin(f);
+    T1inv(2, 2) = T1inv(3, 3) = k2 * rho;
+    Eigen::Matrix4d inPlane = T1inv * fundamental * pseudoInit * T0;
+
+    /* out-of-plane solution, y~ is harmonic in f */
+    double df = f - f0;
+    Eigen::Matrix2d harmonic;
+    harmonic << cos(df), sin(df),
+               -sin(df), cos(df);
+    Eigen::Matrix2d Y0;
+    Y0 << T0(0, 0), 0.0,
+          T0(2, 0), T0(2, 2);
+    Eigen::Matrix2d Y1inv;
+    Y1inv << T1inv(0, 0), 0.0,
+             T1inv(2, 0), T1inv(2, 2);
+    Eigen::Matrix2d outPlane = Y1inv * harmonic * Y0;
+
+    /* Hill axes are (-z, x, -y) in the YA frame */
+    const int inPlaneHill[4] = {1, 0, 4, 3};
+    const double inPlaneSign[4] = {1.0, -1.0, 1.0, -1.0};
+    Eigen::MatrixXd stm = Eigen::MatrixXd::Zero(6, 6);
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            stm(inPlaneHill[row], inPlaneHill[col]) = inPlaneSign[row] * inPlaneSign[col] * inPlane(row, col);
+        }
+    }
+    stm(2, 2) = outPlane(0, 0);
+    stm(2, 5) = outPlane(0, 1);
+    stm(5, 2) = outPlane(1, 0);
+    stm(5, 5) = outPlane(1, 1);
+    return stm;
+}
+
+/*! Gim-Alfriend STM with the secular J2 drift. The chief mean nonsingular elements drift at the first order J2 rates of
+ Omega, omega and M, and the relative elements are propagated with the analytic Jacobian of that drift. The geometric
+ transformation of hillSensitivity() maps the relative elements to and from the Hill frame relative state. The
+ short-period J2 terms are not included, so the chief elements and the relative states are mean quantities.
+ @return Eigen::MatrixXd 6x6 STM of the Hill frame relative state
+ @param mu [m^3/s^2] gravitational constant
+ @param req [m] planet equatorial radius
+ @param J2 [-] second zonal harmonic
+ @param chief chief mean orbit elements at the initial time
+ @param dt [s] propagation time
+ */
+Eigen::MatrixXd gimAlfriendSTM(double mu, double req, double J2, classicElements chief, double dt)
+{
+    if (!checkChief(chief, "gimAlfriendSTM")) {
+        return Eigen::MatrixXd::Zero(6, 6);
+    }
+    nonsingularElements oe0;
+    oe0.a = chief.a;
+    oe0.lambda = E2M(f2E(chief.f, chief.e), chief.e) + chief.omega;
+    oe0.i = chief.i;
+    oe0.q1 = chief.e * cos(chief.omega);
+    oe0.q2 = chief.e * sin(chief.omega);
+    oe0.Omega = chief.Omega;
+
+    /* secular J2 rates and their partials with respect to [a, i, q1, q2] */
+    double a = oe0.a;
+    double n = sqrt(mu / (a * a * a));
+    double eta2 = 1.0 - oe0.q1 * oe0.q1 - oe0.q2 * oe0.q2;
+    double eta = sqrt(eta2);
+    double p = a * eta2;
+    double gamma = n * J2 * (req / p) * (req / p);
+    double ci = cos(oe0.i);
+    double si = sin(oe0.i);
+    double OmegaDot = -1.5 * gamma * ci;
+    double omegaDot = 0.75 * gamma * (5.0 * ci * ci - 1.0);
+    double MDot = 0.75 * gamma * eta * (3.0 * ci * ci - 1.0);
+    Eigen::Vector4d dOmegaDot(-3.5 / a * OmegaDot, 1.5 * gamma * si,
+                              4.0 * oe0.q1 / eta2 * OmegaDot, 4.0 * oe0.q2 / eta2 * OmegaDot);
+    Eigen::Vector4d dOmegaDotPeri(-3.5 / a * omegaDot, -7.5 * gamma * ci * si,
+                                  4.0 * oe0.q1 / eta2 * omegaDot, 4.0 * oe0.q2 / eta2 * omegaDot);
+    Eigen::Vector4d dLambdaDot(-3.5 / a * MDot - 1.5 * n / a, -4.5 * gamma * eta * ci * si,
+                               3.0 * oe0.q1 / eta2 * MDot, 3.0 * oe0.q2 / eta2 * MDot);
+    dLambdaDot += dOmegaDotPeri;
+
+    /* propagated chief mean elements */
+    double phi = omegaDot * dt;
+    nonsingularElements oe1 = oe0;
+    oe1.lambda = oe0.lambda + (n + MDot + omegaDot) * dt;
+    oe1.q1 = oe0.q1 * cos(phi) - oe0.q2 * sin(phi);
+    oe1.q2 = oe0.q1 * sin(phi) + oe0.q2 * cos(phi);
+    oe1.Omega = oe0.Omega + OmegaDot * dt;
+
+    /* relative mean element STM, columns [a, i, q1, q2] carry the rate partials */
+    const int rateCols[4] = {0, 2, 3, 4};
+    StateMatrix phiOe = StateMatrix::Identity();
+    phiOe(3, 3) = cos(phi);
+    phiOe(3, 4) = -sin(phi);
+    phiOe(4, 3) = sin(phi);
+    phiOe(4, 4) = cos(phi);
+    for (int j = 0; j < 4; j++) {
+        phiOe(1, rateCols[j]) += dt * dLambdaDot(j);
+        phiOe(3, rateCols[j]) -= oe1.q2 * dt * dOmegaDotPeri(j);
+        phiOe(4, rateCols[j]) += oe1.q1 * dt * dOmegaDotPeri(j);
+        phiOe(5, rateCols[j]) += dt * dOmegaDot(j);
+    }
+
+    StateMatrix sigma0 = hillSensitivity(mu, oe0);
+    StateMatrix sigma1 = hillSensitivity(mu, oe1);
+    StateMatrix stm = sigma1 * phiOe * sigma0.inverse();
+    return stm;
+}
+
+/*! Propagates the relative states of many deputies with a common STM
+ @return Eigen::MatrixXd Nx6 propagated relative states, one deputy per row
+ @param stm 6x6 STM from one of the STM functions
+ @param states Nx6 initial relative states, one deputy per row
+ */
+Eigen::MatrixXd propagateRelativeStates(Eigen::MatrixXd stm, Eigen::MatrixXd states)
+{
+    if (stm.rows() != 6 || stm.cols() != 6 || states.cols() != 6) {
+        BSK_PRINT(MSG_ERROR, "propagateRelativeStates() requires a 6x6 STM and Nx6 states, received %dx%d and %dx%d.",
+                  (int) stm.rows(), (int) stm.cols(), (int) states.rows(), (int) states.cols());
+        return states;
+    }
+    return states * stm.transpose();
+}
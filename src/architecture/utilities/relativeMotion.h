@@ -0,0 +1,47 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef _RELATIVE_MOTION_H_
+#define _RELATIVE_MOTION_H_
+
+#include <Eigen/Dense>
+#include "architecture/utilities/orbitalMotion.h"
+
+/*! @brief Closed-form state transition matrices for the linearized relative motion of a deputy about a chief.
+
+All matrices map the relative state \f$[\rho_H, \rho'_H]\f$ of the deputy in the chief Hill frame at the initial time
+to the relative state at a time \f$\Delta t\f$ later. The Hill frame and the state follow the same convention as
+rv2hill() and hill2rv(): the first axis is radial, the third axis is along the chief orbit normal and \f$\rho'_H\f$ is
+the velocity as seen from the rotating Hill frame.
+
+ - clohessyWiltshireSTM() assumes a circular chief orbit with mean motion n.
+ - yamanakaAnkersenSTM() solves the Tschauner-Hempel equations about an elliptic chief orbit.
+ - gimAlfriendSTM() propagates the relative mean orbit elements under the secular J2 drift. The chief elements and the
+   relative states are mean quantities. Use clMeanOscMap() to map the chief between mean and osculating elements.
+
+The STM only depends on the chief orbit, so a whole formation is propagated with a single matrix product in
+propagateRelativeStates().
+ */
+
+Eigen::MatrixXd clohessyWiltshireSTM(double n, double dt);
+Eigen::MatrixXd yamanakaAnkersenSTM(double mu, classicElements chief, double dt);
+Eigen::MatrixXd gimAlfriendSTM(double mu, double req, double J2, classicElements chief, double dt);
+Eigen::MatrixXd propagateRelativeStates(Eigen::MatrixXd stm, Eigen::MatrixXd states);
+
+#endif
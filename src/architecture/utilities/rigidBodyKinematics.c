@@ -4521,3 +4521,421 @@ void   tilde(double *v, double mat[3][3])
 
     return;
 }
+
+/*
+ * Batched conversions.  The functions below apply a conversion to num attitudes at once.  The Array versions use the
+ * array of structures layout of C and numpy, e.g. sigma[i][0..2] is the MRP set of sample i.  The ArraySoA versions
+ * use the structure of arrays layout, where component k of sample i is found at index k*num + i, and a DCM has its
+ * nine components stored row by row.  The loops of the MRP and Euler parameter to DCM conversions and of the MRP
+ * addition and subtraction are free of branches and function calls so that they can be vectorized.  The results
+ * equal those of the scalar functions, up to the rounding of multiply-adds if the compiler contracts them
+ * differently.  The inputs and outputs must not overlap.
+ */
+#define ARRAY_RESTRICT __restrict
+
+/* The SoA loops compute blocks of ARRAY_BLOCK samples in a local buffer, whose rows are known not to overlap */
+#define ARRAY_BLOCK 64
+
+/*
+ * copyBlockSoA(B,n,num,start,rows,out) copies the first n samples of the rows of the block B to the samples
+ * start..start+n-1 of the num samples of out
+ */
+static void copyBlockSoA(double block[][ARRAY_BLOCK], int n, int num, int start, int rows, double *ARRAY_RESTRICT out)
+{
+    int i;
+    int k;
+
+    for (k = 0; k < rows; k++) {
+        for (i = 0; i < n; i++) {
+            out[k * num + start + i] = block[k][i];
+        }
+    }
+}
+
+/*
+ * mrp2CKernel(q1,q2,q3,C,stride) writes the DCM of the MRP set (q1,q2,q3), with the components of C spaced by stride
+ */
+static void mrp2CKernel(double q1, double q2, double q3, double *C, int stride)
+{
+    double d1 = q1 * q1 + q2 * q2 + q3 * q3;
+    double S = 1 - d1;
+    double d = (1 + d1) * (1 + d1);
+    double scale = 1. / d;
+
+    C[0 * stride] = scale * (4 * (2 * q1 * q1 - d1) + S * S);
+    C[1 * stride] = scale * (8 * q1 * q2 + 4 * q3 * S);
+    C[2 * stride] = scale * (8 * q1 * q3 - 4 * q2 * S);
+    C[3 * stride] = scale * (8 * q2 * q1 - 4 * q3 * S);
+    C[4 * stride] = scale * (4 * (2 * q2 * q2 - d1) + S * S);
+    C[5 * stride] = scale * (8 * q2 * q3 + 4 * q1 * S);
+    C[6 * stride] = scale * (8 * q3 * q1 + 4 * q2 * S);
+    C[7 * stride] = scale * (8 * q3 * q2 - 4 * q1 * S);
+    C[8 * stride] = scale * (4 * (2 * q3 * q3 - d1) + S * S);
+}
+
+/*
+ * ep2CKernel(q0,q1,q2,q3,C,stride) writes the DCM of the Euler parameter set (q0,q1,q2,q3), with the components of C
+ * spaced by stride
+ */
+static void ep2CKernel(double q0, double q1, double q2, double q3, double *C, int stride)
+{
+    C[0 * stride] = q0 * q0 + q1 * q1 - q2 * q2 - q3 * q3;
+    C[1 * stride] = 2 * (q1 * q2 + q0 * q3);
+    C[2 * stride] = 2 * (q1 * q3 - q0 * q2);
+    C[3 * stride] = 2 * (q1 * q2 - q0 * q3);
+    C[4 * stride] = q0 * q0 - q1 * q1 + q2 * q2 - q3 * q3;
+    C[5 * stride] = 2 * (q2 * q3 + q0 * q1);
+    C[6 * stride] = 2 * (q1 * q3 + q0 * q2);
+    C[7 * stride] = 2 * (q2 * q3 - q0 * q1);
+    C[8 * stride] = q0 * q0 - q1 * q1 - q2 * q2 + q3 * q3;
+}
+
+/*
+ * addMRPKernel(s,q,sign,result,stride) adds (sign = 1) the MRP set q to the MRP set s as addMRP() does, or subtracts
+ * (sign = -1) q from s as subMRP() does.  The shadow set switches are made with selections instead of branches.
+ */
+static void addMRPKernel(const double s[3], const double q[3], double sign, double *result, int stride)
+{
+    double s1[3];
+    double r[3];
+    double qq = q[0] * q[0] + q[1] * q[1] + q[2] * q[2];
+    double ss = s[0] * s[0] + s[1] * s[1] + s[2] * s[2];
+    double sq = s[0] * q[0] + s[1] * q[1] + s[2] * q[2];
+    double det = (1 + ss * qq) - sign * 2 * sq;
+    double factor = fabs(det) < 0.1 ? -1. / ss : 1.0;
+    double mag;
+    int k;
+
+    /* switch s to its shadow set if the composition is singular */
+    for (k = 0; k < 3; k++) {
+        s1[k] = factor * s[k];
+    }
+    ss = s1[0] * s1[0] + s1[1] * s1[1] + s1[2] * s1[2];
+    sq = s1[0] * q[0] + s1[1] * q[1] + s1[2] * q[2];
+    det = (1 + ss * qq) - sign * 2 * sq;
+
+    r[0] = (1 - qq) * s1[0] + 2. * (s1[1] * q[2] - s1[2] * q[1]);
+    r[1] = (1 - qq) * s1[1] + 2. * (s1[2] * q[0] - s1[0] * q[2]);
+    r[2] = (1 - qq) * s1[2] + 2. * (s1[0] * q[1] - s1[1] * q[0]);
+    for (k = 0; k < 3; k++) {
+        r[k] = (r[k] + sign * ((1 - ss) * q[k])) * (1 / det);
+    }
+
+    /* map MRP to inner set */
+    mag = r[0] * r[0] + r[1] * r[1] + r[2] * r[2];
+    factor = mag > 1.0 ? -1. / mag : 1.0;
+    for (k = 0; k < 3; k++) {
+        result[k * stride] = factor * r[k];
+    }
+}
+
+/*
+ * eulerSequenceIndex(sequence) returns the index of an Euler angle sequence such as 321 in the tables below, or -1
+ */
+static int eulerSequenceIndex(int sequence)
+{
+    static const int sequences[12] = {121, 123, 131, 132, 212, 213, 231, 232, 312, 313, 321, 323};
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        if (sequences[i] == sequence) {
+            return i;
+        }
+    }
+    BSK_PRINT(MSG_ERROR, "Euler angle sequence %d is not a valid sequence.", sequence);
+    return -1;
+}
+
+static void (*const euler2CFunctions[12])(double *, double [3][3]) = {
+    Euler1212C, Euler1232C, Euler1312C, Euler1322C, Euler2122C, Euler2132C,
+    Euler2312C, Euler2322C, Euler3122C, Euler3132C, Euler3212C, Euler3232C};
+
+static void (*const C2EulerFunctions[12])(double [3][3], double *) = {
+    C2Euler121, C2Euler123, C2Euler131, C2Euler132, C2Euler212, C2Euler213,
+    C2Euler231, C2Euler232, C2Euler312, C2Euler313, C2Euler321, C2Euler323};
+
+/*
+ * MRP2CArray(N,Q,C) returns the N DCMs C corresponding to the N MRP sets Q.
+ */
+void MRP2CArray(int num, double sigma[][3], double C[][3][3])
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        mrp2CKernel(sigma[i][0], sigma[i][1], sigma[i][2], &C[i][0][0], 1);
+    }
+}
+
+/*
+ * MRP2CArraySoA(N,Q,C) returns the N DCMs C corresponding to the N MRP sets Q, in the structure of arrays layout.
+ */
+void MRP2CArraySoA(int num, const double *ARRAY_RESTRICT sigma, double *ARRAY_RESTRICT C)
+{
+    double block[9][ARRAY_BLOCK];
+    int start;
+    int n;
+    int i;
+
+    for (start = 0; start < num; start += n) {
+        n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        for (i = 0; i < n; i++) {
+            mrp2CKernel(sigma[start + i], sigma[num + start + i], sigma[2 * num + start + i], &block[0][i],
+                        ARRAY_BLOCK);
+        }
+        copyBlockSoA(block, n, num, start, 9, C);
+    }
+}
+
+/*
+ * C2MRPArray(N,C,Q) returns the N MRP sets Q corresponding to the N DCMs C.
+ */
+void C2MRPArray(int num, double C[][3][3], double sigma[][3])
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        C2MRP(C[i], sigma[i]);
+    }
+}
+
+/*
+ * C2MRPArraySoA(N,C,Q) returns the N MRP sets Q corresponding to the N DCMs C, in the structure of arrays layout.
+ */
+void C2MRPArraySoA(int num, const double *ARRAY_RESTRICT C, double *ARRAY_RESTRICT sigma)
+{
+    double dcm[3][3];
+    double q[3];
+    int i;
+    int k;
+
+    for (i = 0; i < num; i++) {
+        for (k = 0; k < 9; k++) {
+            dcm[k / 3][k % 3] = C[k * num + i];
+        }
+        C2MRP(dcm, q);
+        for (k = 0; k < 3; k++) {
+            sigma[k * num + i] = q[k];
+        }
+    }
+}
+
+/*
+ * EP2CArray(N,Q,C) returns the N DCMs C corresponding to the N Euler parameter sets Q.
+ */
+void EP2CArray(int num, double beta[][4], double C[][3][3])
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        ep2CKernel(beta[i][0], beta[i][1], beta[i][2], beta[i][3], &C[i][0][0], 1);
+    }
+}
+
+/*
+ * EP2CArraySoA(N,Q,C) returns the N DCMs C corresponding to the N Euler parameter sets Q, in the structure of
+ * arrays layout.
+ */
+void EP2CArraySoA(int num, const double *ARRAY_RESTRICT beta, double *ARRAY_RESTRICT C)
+{
+    double block[9][ARRAY_BLOCK];
+    int start;
+    int n;
+    int i;
+
+    for (start = 0; start < num; start += n) {
+        n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        for (i = 0; i < n; i++) {
+            ep2CKernel(beta[start + i], beta[num + start + i], beta[2 * num + start + i], beta[3 * num + start + i],
+                       &block[0][i], ARRAY_BLOCK);
+        }
+        copyBlockSoA(block, n, num, start, 9, C);
+    }
+}
+
+/*
+ * C2EPArray(N,C,Q) returns the N Euler parameter sets Q corresponding to the N DCMs C.
+ */
+void C2EPArray(int num, double C[][3][3], double beta[][4])
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        C2EP(C[i], beta[i]);
+    }
+}
+
+/*
+ * C2EPArraySoA(N,C,Q) returns the N Euler parameter sets Q corresponding to the N DCMs C, in the structure of arrays
+ * layout.
+ */
+void C2EPArraySoA(int num, const double *ARRAY_RESTRICT C, double *ARRAY_RESTRICT beta)
+{
+    double dcm[3][3];
+    double b[4];
+    int i;
+    int k;
+
+    for (i = 0; i < num; i++) {
+        for (k = 0; k < 9; k++) {
+            dcm[k / 3][k % 3] = C[k * num + i];
+        }
+        C2EP(dcm, b);
+        for (k = 0; k < 4; k++) {
+            beta[k * num + i] = b[k];
+        }
+    }
+}
+
+/*
+ * addMRPArray(N,Q1,Q2,Q) returns the N MRP sets Q of performing the successive rotations Q1 and Q2, as addMRP().
+ */
+void addMRPArray(int num, double sigma1[][3], double sigma2[][3], double result[][3])
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        addMRPKernel(sigma1[i], sigma2[i], 1.0, result[i], 1);
+    }
+}
+
+/*
+ * addMRPArraySoA(N,Q1,Q2,Q) returns the N MRP sets Q of performing the successive rotations Q1 and Q2, as addMRP(),
+ * in the structure of arrays layout.
+ */
+void addMRPArraySoA(int num, const double *ARRAY_RESTRICT sigma1, const double *ARRAY_RESTRICT sigma2, double *ARRAY_RESTRICT result)
+{
+    double block[3][ARRAY_BLOCK];
+    int start;
+    int n;
+    int i;
+
+    for (start = 0; start < num; start += n) {
+        n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        for (i = 0; i < n; i++) {
+            int j = start + i;
+            double s1[3] = {sigma1[j], sigma1[num + j], sigma1[2 * num + j]};
+            double s2[3] = {sigma2[j], sigma2[num + j], sigma2[2 * num + j]};
+            addMRPKernel(s1, s2, 1.0, &block[0][i], ARRAY_BLOCK);
+        }
+        copyBlockSoA(block, n, num, start, 3, result);
+    }
+}
+
+/*
+ * subMRPArray(N,Q1,Q2,Q) returns the N MRP sets Q of the relative rotations from Q2 to Q1, as subMRP().
+ */
+void subMRPArray(int num, double sigma1[][3], double sigma2[][3], double result[][3])
+{
+    int i;
+
+    for (i = 0; i < num; i++) {
+        addMRPKernel(sigma1[i], sigma2[i], -1.0, result[i], 1);
+    }
+}
+
+/*
+ * subMRPArraySoA(N,Q1,Q2,Q) returns the N MRP sets Q of the relative rotations from Q2 to Q1, as subMRP(), in the
+ * structure of arrays layout.
+ */
+void subMRPArraySoA(int num, const double *ARRAY_RESTRICT sigma1, const double *ARRAY_RESTRICT sigma2, double *ARRAY_RESTRICT result)
+{
+    double block[3][ARRAY_BLOCK];
+    int start;
+    int n;
+    int i;
+
+    for (start = 0; start < num; start += n) {
+        n = num - start < ARRAY_BLOCK ? num - start : ARRAY_BLOCK;
+        for (i = 0; i < n; i++) {
+            int j = start + i;
+            double s1[3] = {sigma1[j], sigma1[num + j], sigma1[2 * num + j]};
+            double s2[3] = {sigma2[j], sigma2[num + j], sigma2[2 * num + j]};
+            addMRPKernel(s1, s2, -1.0, &block[0][i], ARRAY_BLOCK);
+        }
+        copyBlockSoA(block, n, num, start, 3, result);
+    }
+}
+
+/*
+ * Euler2CArray(N,S,E,C) returns the N DCMs C corresponding to the N Euler angle sets E of the sequence S, e.g. 321.
+ */
+void Euler2CArray(int num, int sequence, double angles[][3], double C[][3][3])
+{
+    int index = eulerSequenceIndex(sequence);
+    int i;
+
+    if (index < 0) {
+        return;
+    }
+    for (i = 0; i < num; i++) {
+        euler2CFunctions[index](angles[i], C[i]);
+    }
+}
+
+/*
+ * Euler2CArraySoA(N,S,E,C) returns the N DCMs C corresponding to the N Euler angle sets E of the sequence S, in the
+ * structure of arrays layout.
+ */
+void Euler2CArraySoA(int num, int sequence, const double *ARRAY_RESTRICT angles, double *ARRAY_RESTRICT C)
+{
+    int index = eulerSequenceIndex(sequence);
+    double e[3];
+    double dcm[3][3];
+    int i;
+    int k;
+
+    if (index < 0) {
+        return;
+    }
+    for (i = 0; i < num; i++) {
+        for (k = 0; k < 3; k++) {
+            e[k] = angles[k * num + i];
+        }
+        euler2CFunctions[index](e, dcm);
+        for (k = 0; k < 9; k++) {
+            C[k * num + i] = dcm[k / 3][k % 3];
+        }
+    }
+}
+
+/*
+ * C2EulerArray(N,S,C,E) returns the N Euler angle sets E of the sequence S corresponding to the N DCMs C.
+ */
+void C2EulerArray(int num, int sequence, double C[][3][3], double angles[][3])
+{
+    int index = eulerSequenceIndex(sequence);
+    int i;
+
+    if (index < 0) {
+        return;
+    }
+    for (i = 0; i < num; i++) {
+        C2EulerFunctions[index](C[i], angles[i]);
+    }
+}
+
+/*
+ * C2EulerArraySoA(N,S,C,E) returns the N Euler angle sets E of the sequence S corresponding to the N DCMs C, in the
+ * structure of arrays layout.
+ */
+void C2EulerArraySoA(int num, int sequence, const double *ARRAY_RESTRICT C, double *ARRAY_RESTRICT angles)
+{
+    int index = eulerSequenceIndex(sequence);
+    double e[3];
+    double dcm[3][3];
+    int i;
+    int k;
+
+    if (index < 0) {
+        return;
+    }
+    for (i = 0; i < num; i++) {
+        for (k = 0; k < 9; k++) {
+            dcm[k / 3][k % 3] = C[k * num + i];
+        }
+        C2EulerFunctions[index](dcm, e);
+        for (k = 0; k < 3; k++) {
+            angles[k * num + i] = e[k];
+        }
+    }
+}
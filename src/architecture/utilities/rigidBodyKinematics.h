@@ -258,6 +258,23 @@ extern "C" {
     void   subPRV(double *q10, double *q20, double *q);
     void   Mi(double angle, int axis, double C[3][3]);
     void   tilde(double *v, double mat[3][3]);
+
+    void   MRP2CArray(int num, double sigma[][3], double C[][3][3]);
+    void   MRP2CArraySoA(int num, const double *sigma, double *C);
+    void   C2MRPArray(int num, double C[][3][3], double sigma[][3]);
+    void   C2MRPArraySoA(int num, const double *C, double *sigma);
+    void   EP2CArray(int num, double beta[][4], double C[][3][3]);
+    void   EP2CArraySoA(int num, const double *beta, double *C);
+    void   C2EPArray(int num, double C[][3][3], double beta[][4]);
+    void   C2EPArraySoA(int num, const double *C, double *beta);
+    void   addMRPArray(int num, double sigma1[][3], double sigma2[][3], double result[][3]);
+    void   addMRPArraySoA(int num, const double *sigma1, const double *sigma2, double *result);
+    void   subMRPArray(int num, double sigma1[][3], double sigma2[][3], double result[][3]);
+    void   subMRPArraySoA(int num, const double *sigma1, const double *sigma2, double *result);
+    void   Euler2CArray(int num, int sequence, double angles[][3], double C[][3][3]);
+    void   Euler2CArraySoA(int num, int sequence, const double *angles, double *C);
+    void   C2EulerArray(int num, int sequence, double C[][3][3], double angles[][3]);
+    void   C2EulerArraySoA(int num, int sequence, const double *C, double *angles);
     
 #ifdef __cplusplus
 }
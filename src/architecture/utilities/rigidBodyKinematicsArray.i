@@ -0,0 +1,213 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+%module(threads="1") rigidBodyKinematicsArray
+%{
+   #include "rigidBodyKinematics.h"
+%}
+
+%include "stdint.i"
+
+/*
+ * The batched conversions are wrapped with the addresses of the numpy arrays, so that the python functions below
+ * pass the arrays to the C functions without copying them element by element.  The GIL is released while they run.
+ */
+%threadallow;
+%inline %{
+#define ARRAY_ADDRESS(address, type) reinterpret_cast<type>(static_cast<uintptr_t>(address))
+typedef double (*array3)[3];
+typedef double (*array4)[4];
+typedef double (*array33)[3][3];
+
+void MRP2CAddress(int num, uint64_t sigma, uint64_t C, bool soa) {
+    if (soa) {
+        MRP2CArraySoA(num, ARRAY_ADDRESS(sigma, const double *), ARRAY_ADDRESS(C, double *));
+    } else {
+        MRP2CArray(num, ARRAY_ADDRESS(sigma, array3), ARRAY_ADDRESS(C, array33));
+    }
+}
+void C2MRPAddress(int num, uint64_t C, uint64_t sigma, bool soa) {
+    if (soa) {
+        C2MRPArraySoA(num, ARRAY_ADDRESS(C, const double *), ARRAY_ADDRESS(sigma, double *));
+    } else {
+        C2MRPArray(num, ARRAY_ADDRESS(C, array33), ARRAY_ADDRESS(sigma, array3));
+    }
+}
+void EP2CAddress(int num, uint64_t beta, uint64_t C, bool soa) {
+    if (soa) {
+        EP2CArraySoA(num, ARRAY_ADDRESS(beta, const double *), ARRAY_ADDRESS(C, double *));
+    } else {
+        EP2CArray(num, ARRAY_ADDRESS(beta, array4), ARRAY_ADDRESS(C, array33));
+    }
+}
+void C2EPAddress(int num, uint64_t C, uint64_t beta, bool soa) {
+    if (soa) {
+        C2EPArraySoA(num, ARRAY_ADDRESS(C, const double *), ARRAY_ADDRESS(beta, double *));
+    } else {
+        C2EPArray(num, ARRAY_ADDRESS(C, array33), ARRAY_ADDRESS(beta, array4));
+    }
+}
+void addMRPAddress(int num, uint64_t sigma1, uint64_t sigma2, uint64_t result, bool soa) {
+    if (soa) {
+        addMRPArraySoA(num, ARRAY_ADDRESS(sigma1, const double *), ARRAY_ADDRESS(sigma2, const double *),
+                       ARRAY_ADDRESS(result, double *));
+    } else {
+        addMRPArray(num, ARRAY_ADDRESS(sigma1, array3), ARRAY_ADDRESS(sigma2, array3), ARRAY_ADDRESS(result, array3));
+    }
+}
+void subMRPAddress(int num, uint64_t sigma1, uint64_t sigma2, uint64_t result, bool soa) {
+    if (soa) {
+        subMRPArraySoA(num, ARRAY_ADDRESS(sigma1, const double *), ARRAY_ADDRESS(sigma2, const double *),
+                       ARRAY_ADDRESS(result, double *));
+    } else {
+        subMRPArray(num, ARRAY_ADDRESS(sigma1, array3), ARRAY_ADDRESS(sigma2, array3), ARRAY_ADDRESS(result, array3));
+    }
+}
+void euler2CAddress(int num, int sequence, uint64_t angles, uint64_t C, bool soa) {
+    if (soa) {
+        Euler2CArraySoA(num, sequence, ARRAY_ADDRESS(angles, const double *), ARRAY_ADDRESS(C, double *));
+    } else {
+        Euler2CArray(num, sequence, ARRAY_ADDRESS(angles, array3), ARRAY_ADDRESS(C, array33));
+    }
+}
+void C2EulerAddress(int num, int sequence, uint64_t C, uint64_t angles, bool soa) {
+    if (soa) {
+        C2EulerArraySoA(num, sequence, ARRAY_ADDRESS(C, const double *), ARRAY_ADDRESS(angles, double *));
+    } else {
+        C2EulerArray(num, sequence, ARRAY_ADDRESS(C, array33), ARRAY_ADDRESS(angles, array3));
+    }
+}
+%}
+%nothreadallow;
+
+%pythoncode %{
+import numpy as np
+
+EULER_SEQUENCES = (121, 123, 131, 132, 212, 213, 231, 232, 312, 313, 321, 323)
+
+
+def _samples(array, size, soa, name):
+    """Returns the C contiguous float array and the number of samples of an (N,size) or, with soa, (size,N) input."""
+    array = np.ascontiguousarray(array, dtype=np.float64)
+    if array.ndim == 1 and array.shape[0] == size:
+        array = array.reshape((size, 1)) if soa else array.reshape((1, size))
+    if array.ndim != 2 or array.shape[0 if soa else 1] != size:
+        raise ValueError("%s must be an array of shape %s" % (name, "(%d,N)" % size if soa else "(N,%d)" % size))
+    return array, array.shape[1 if soa else 0]
+
+
+def _dcms(array, soa, name):
+    """Returns the C contiguous float array and the number of samples of an (N,3,3) or, with soa, (9,N) input."""
+    array = np.ascontiguousarray(array, dtype=np.float64)
+    if soa:
+        if array.ndim != 2 or array.shape[0] != 9:
+            raise ValueError("%s must be an array of shape (9,N)" % name)
+        return array, array.shape[1]
+    if array.shape == (3, 3):
+        array = array.reshape((1, 3, 3))
+    if array.ndim != 3 or array.shape[1:] != (3, 3):
+        raise ValueError("%s must be an array of shape (N,3,3)" % name)
+    return array, array.shape[0]
+
+
+def _output(num, size, soa):
+    if soa:
+        return np.empty((size, num))
+    if size == 9:
+        return np.empty((num, 3, 3))
+    return np.empty((num, size))
+
+
+def _sequence(sequence):
+    if int(sequence) not in EULER_SEQUENCES:
+        raise ValueError("%s is not a valid Euler angle sequence" % sequence)
+    return int(sequence)
+
+
+def MRP2C(sigma, soa=False):
+    """Returns the (N,3,3) DCMs of the (N,3) MRP sets sigma.  With soa, sigma is (3,N) and the DCMs are (9,N)
+    with their components row by row."""
+    sigma, num = _samples(sigma, 3, soa, "sigma")
+    C = _output(num, 9, soa)
+    MRP2CAddress(num, sigma.ctypes.data, C.ctypes.data, soa)
+    return C
+
+
+def C2MRP(C, soa=False):
+    """Returns the (N,3) MRP sets of the (N,3,3) DCMs C, or the (3,N) MRP sets of the (9,N) DCMs with soa."""
+    C, num = _dcms(C, soa, "C")
+    sigma = _output(num, 3, soa)
+    C2MRPAddress(num, C.ctypes.data, sigma.ctypes.data, soa)
+    return sigma
+
+
+def EP2C(beta, soa=False):
+    """Returns the (N,3,3) DCMs of the (N,4) Euler parameter sets beta, or the (9,N) DCMs of (4,N) sets with soa."""
+    beta, num = _samples(beta, 4, soa, "beta")
+    C = _output(num, 9, soa)
+    EP2CAddress(num, beta.ctypes.data, C.ctypes.data, soa)
+    return C
+
+
+def C2EP(C, soa=False):
+    """Returns the (N,4) Euler parameter sets of the (N,3,3) DCMs C, or the (4,N) sets of (9,N) DCMs with soa."""
+    C, num = _dcms(C, soa, "C")
+    beta = _output(num, 4, soa)
+    C2EPAddress(num, C.ctypes.data, beta.ctypes.data, soa)
+    return beta
+
+
+def addMRP(sigma1, sigma2, soa=False):
+    """Returns the (N,3) MRP sets of the successive rotations sigma1 and sigma2, as ``RigidBodyKinematics.addMRP``."""
+    sigma1, num = _samples(sigma1, 3, soa, "sigma1")
+    sigma2, num2 = _samples(sigma2, 3, soa, "sigma2")
+    if num != num2:
+        raise ValueError("sigma1 and sigma2 must have the same number of samples")
+    result = _output(num, 3, soa)
+    addMRPAddress(num, sigma1.ctypes.data, sigma2.ctypes.data, result.ctypes.data, soa)
+    return result
+
+
+def subMRP(sigma1, sigma2, soa=False):
+    """Returns the (N,3) MRP sets of the relative rotations from sigma2 to sigma1, as ``RigidBodyKinematics.subMRP``."""
+    sigma1, num = _samples(sigma1, 3, soa, "sigma1")
+    sigma2, num2 = _samples(sigma2, 3, soa, "sigma2")
+    if num != num2:
+        raise ValueError("sigma1 and sigma2 must have the same number of samples")
+    result = _output(num, 3, soa)
+    subMRPAddress(num, sigma1.ctypes.data, sigma2.ctypes.data, result.ctypes.data, soa)
+    return result
+
+
+def euler2C(angles, sequence, soa=False):
+    """Returns the (N,3,3) DCMs of the (N,3) Euler angle sets of the sequence, e.g. 321, or (9,N) DCMs with soa."""
+    sequence = _sequence(sequence)
+    angles, num = _samples(angles, 3, soa, "angles")
+    C = _output(num, 9, soa)
+    euler2CAddress(num, sequence, angles.ctypes.data, C.ctypes.data, soa)
+    return C
+
+
+def C2Euler(C, sequence, soa=False):
+    """Returns the (N,3) Euler angle sets of the sequence, e.g. 321, of the (N,3,3) DCMs C, or (3,N) sets with soa."""
+    sequence = _sequence(sequence)
+    C, num = _dcms(C, soa, "C")
+    angles = _output(num, 3, soa)
+    C2EulerAddress(num, sequence, C.ctypes.data, angles.ctypes.data, soa)
+    return angles
+%}
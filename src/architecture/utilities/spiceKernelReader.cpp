@@ -0,0 +1,640 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "architecture/utilities/spiceKernelReader.h"
+#include <math.h>
+#include <mutex>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*! size of a DAF record in bytes */
+static const size_t dafRecordSize = 1024;
+/*! maximum number of doubles of a record of a kernel that is not in the machine byte order */
+static const int maxRecordSize = 1024;
+/*! maximum number of segments chained from a body to the root of its ephemeris tree */
+static const int maxChainLength = 16;
+/*! NAIF ids of the supported reference frames */
+static const int frameJ2000 = 1;
+static const int frameEclipJ2000 = 17;
+/*! [rad] obliquity of the ecliptic at J2000 used by the ECLIPJ2000 frame */
+static const double obliquityJ2000 = 84381.448 / 3600.0 * M_PI / 180.0;
+/*! [s] length of a Julian day and a Julian century */
+static const double secondsPerDay = 86400.0;
+static const double secondsPerCentury = 36525.0 * 86400.0;
+
+/*! Read-only mapping of a kernel file.  A file is mapped once per process and shared by all readers. */
+struct SpiceKernelReader::MappedFile {
+    std::string fileName;               //!< path of the kernel file
+    const char *data;                   //!< start of the mapped file contents
+    size_t dataSize;                    //!< [bytes] size of the mapped file
+#ifdef _WIN32
+    HANDLE fileHandle;                  //!< Windows file handle
+    HANDLE mapHandle;                   //!< Windows file mapping handle
+#else
+    int fileDescriptor;                 //!< POSIX file descriptor
+#endif
+
+    MappedFile() : data(nullptr), dataSize(0)
+#ifdef _WIN32
+        , fileHandle(INVALID_HANDLE_VALUE), mapHandle(NULL)
+#else
+        , fileDescriptor(-1)
+#endif
+    {}
+
+    ~MappedFile()
+    {
+#ifdef _WIN32
+        if (this->data != nullptr) {
+            UnmapViewOfFile(this->data);
+        }
+        if (this->mapHandle != NULL) {
+            CloseHandle(this->mapHandle);
+        }
+        if (this->fileHandle != INVALID_HANDLE_VALUE) {
+            CloseHandle(this->fileHandle);
+        }
+#else
+        if (this->data != nullptr) {
+            munmap((void *) this->data, this->dataSize);
+        }
+        if (this->fileDescriptor >= 0) {
+            ::close(this->fileDescriptor);
+        }
+#endif
+    }
+
+    /*! map the file read-only
+     @return true if the file could be mapped */
+    bool map()
+    {
+#ifdef _WIN32
+        this->fileHandle = CreateFileA(this->fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                                       FILE_ATTRIBUTE_NORMAL | FILE_FLAG_RANDOM_ACCESS, NULL);
+        if (this->fileHandle == INVALID_HANDLE_VALUE) {
+            return false;
+        }
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(this->fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+            return false;
+        }
+        this->mapHandle = CreateFileMappingA(this->fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (this->mapHandle == NULL) {
+            return false;
+        }
+        this->data = (const char *) MapViewOfFile(this->mapHandle, FILE_MAP_READ, 0, 0, 0);
+        this->dataSize = (size_t) fileSize.QuadPart;
+#else
+        this->fileDescriptor = ::open(this->fileName.c_str(), O_RDONLY);
+        if (this->fileDescriptor < 0) {
+            return false;
+        }
+        struct stat fileStat;
+        if (fstat(this->fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0) {
+            return false;
+        }
+        /* a shared read-only mapping uses the page cache, so the kernel is in memory once for all processes */
+        void *mapped = mmap(nullptr, (size_t) fileStat.st_size, PROT_READ, MAP_SHARED, this->fileDescriptor, 0);
+        if (mapped == MAP_FAILED) {
+            return false;
+        }
+        madvise(mapped, (size_t) fileStat.st_size, MADV_RANDOM);
+        this->data = (const char *) mapped;
+        this->dataSize = (size_t) fileStat.st_size;
+#endif
+        return this->data != nullptr;
+    }
+};
+
+/*! @return true if this machine stores numbers little endian */
+static bool isLittleEndian()
+{
+    const uint16_t one = 1;
+    return *((const uint8_t *) &one) == 1;
+}
+
+/*! read a 4 or 8 byte number of the file byte order */
+template <typename T> static T readNumber(const char *p, bool swapBytes)
+{
+    char bytes[sizeof(T)];
+    for (size_t k = 0; k < sizeof(T); k++) {
+        bytes[k] = swapBytes ? p[sizeof(T) - 1 - k] : p[k];
+    }
+    T value;
+    memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/*! Evaluate a Chebyshev expansion and its derivative the same way as the SPICE routine CHBINT
+ @param coeffs Chebyshev coefficients
+ @param degree degree of the expansion
+ @param s normalized time in [-1, 1]
+ @param value value of the expansion
+ @param derivative derivative of the expansion with respect to s
+ */
+static void chebyshev(const double *coeffs, int degree, double s, double &value, double &derivative)
+{
+    double w[3] = {0.0, 0.0, 0.0};
+    double dw[3] = {0.0, 0.0, 0.0};
+    double s2 = 2.0*s;
+    for (int j = degree; j > 0; j--) {
+        w[2] = w[1];
+        w[1] = w[0];
+        w[0] = coeffs[j] + (s2*w[1] - w[2]);
+        dw[2] = dw[1];
+        dw[1] = dw[0];
+        dw[0] = w[1]*2.0 + (s2*dw[1] - dw[2]);
+    }
+    value = coeffs[0] + (s*w[0] - w[1]);
+    derivative = w[0] + (s*dw[0] - dw[1]);
+}
+
+/*! rotation matrix about the first or third axis and its derivative with respect to the angle */
+static void axisRotation(int axis, double angle, double m[3][3], double dm[3][3])
+{
+    double c = cos(angle);
+    double s = sin(angle);
+    int a = axis == 1 ? 1 : 0;
+    int b = axis == 1 ? 2 : 1;
+    int k = axis == 1 ? 0 : 2;
+    memset(m, 0, 9*sizeof(double));
+    memset(dm, 0, 9*sizeof(double));
+    m[k][k] = 1.0;
+    m[a][a] = c;  m[a][b] = s;
+    m[b][a] = -s; m[b][b] = c;
+    dm[a][a] = -s; dm[a][b] = c;
+    dm[b][a] = -c; dm[b][b] = -s;
+}
+
+/*! 3x3 matrix product */
+static void matMult(const double a[3][3], const double b[3][3], double c[3][3])
+{
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            c[i][j] = a[i][0]*b[0][j] + a[i][1]*b[1][j] + a[i][2]*b[2][j];
+        }
+    }
+}
+
+/*! Rotation matrix [w]_3 [delta]_1 [phi]_3 of the 3-1-3 Euler angles of a PCK body frame and its time derivative
+ @param angles [rad] Euler angles phi, delta and w
+ @param rates [rad/s] rates of the Euler angles
+ @param dcm rotation matrix from the reference frame to the body frame
+ @param dcmDot time derivative of the rotation matrix
+ */
+static void eulerRotation(const double angles[3], const double rates[3], double dcm[3][3], double dcmDot[3][3])
+{
+    double r1[3][3], dr1[3][3], r2[3][3], dr2[3][3], r3[3][3], dr3[3][3];
+    double tmp[3][3], term[3][3];
+    axisRotation(3, angles[0], r1, dr1);
+    axisRotation(1, angles[1], r2, dr2);
+    axisRotation(3, angles[2], r3, dr3);
+
+    matMult(r2, r1, tmp);
+    matMult(r3, tmp, dcm);
+
+    matMult(dr3, tmp, dcmDot);
+    matMult(dr2, r1, tmp);
+    matMult(r3, tmp, term);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            dcmDot[i][j] = dcmDot[i][j]*rates[2] + term[i][j]*rates[1];
+        }
+    }
+    matMult(r2, dr1, tmp);
+    matMult(r3, tmp, term);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            dcmDot[i][j] += term[i][j]*rates[0];
+        }
+    }
+}
+
+/*! rotate a J2000 state from the ECLIPJ2000 frame into the J2000 frame */
+static void eclipticToJ2000(double state[6])
+{
+    double c = cos(obliquityJ2000);
+    double s = sin(obliquityJ2000);
+    for (int k = 0; k < 6; k += 3) {
+        double y = state[k + 1];
+        double z = state[k + 2];
+        state[k + 1] = c*y - s*z;
+        state[k + 2] = s*y + c*z;
+    }
+}
+
+/*! The constructor creates a reader without kernels */
+SpiceKernelReader::SpiceKernelReader()
+{
+}
+
+/*! The destructor releases the kernel files of the reader */
+SpiceKernelReader::~SpiceKernelReader()
+{
+    this->clear();
+}
+
+/*! Map an SPK or binary PCK kernel and index its segments.  Kernels of other types are not loaded.
+ @return true if the kernel was loaded
+ @param fileName path of the kernel file
+ */
+bool SpiceKernelReader::loadKernel(const std::string &fileName)
+{
+    std::shared_ptr<const MappedFile> file = mapFile(fileName);
+    if (!file || !this->readSegments(file.get())) {
+        return false;
+    }
+    this->files.push_back(file);
+    return true;
+}
+
+/*! Map a kernel file, or share the mapping of a file that is mapped by another reader of this process
+ @return mapped file, or an empty pointer if the file could not be mapped
+ @param fileName path of the kernel file
+ */
+std::shared_ptr<const SpiceKernelReader::MappedFile> SpiceKernelReader::mapFile(const std::string &fileName)
+{
+    static std::mutex mappedFilesMutex;
+    static std::map<std::string, std::weak_ptr<const MappedFile>> mappedFiles;
+
+    std::lock_guard<std::mutex> lock(mappedFilesMutex);
+    std::shared_ptr<const MappedFile> file;
+    auto it = mappedFiles.find(fileName);
+    if (it != mappedFiles.end()) {
+        file = it->second.lock();
+    }
+    if (!file) {
+        std::shared_ptr<MappedFile> newFile = std::make_shared<MappedFile>();
+        newFile->fileName = fileName;
+        if (!newFile->map()) {
+            return std::shared_ptr<const MappedFile>();
+        }
+        file = newFile;
+        mappedFiles[fileName] = file;
+    }
+    return file;
+}
+
+/*! Index the segments of a mapped DAF file
+ @return true if the file is a little endian SPK or PCK file
+ @param file mapped kernel file
+ */
+bool SpiceKernelReader::readSegments(const MappedFile *file)
+{
+    if (file->dataSize < dafRecordSize) {
+        return false;
+    }
+    const char *header = file->data;
+    bool isSpk = strncmp(header, "DAF/SPK", 7) == 0;
+    bool isPck = strncmp(header, "DAF/PCK", 7) == 0;
+    bool littleEndian = strncmp(header + 88, "LTL-IEEE", 8) == 0;
+    if ((!isSpk && !isPck) || (!littleEndian && strncmp(header + 88, "BIG-IEEE", 8) != 0)) {
+        return false;
+    }
+    bool swapBytes = littleEndian != isLittleEndian();
+    int32_t nd = readNumber<int32_t>(header + 8, swapBytes);
+    int32_t ni = readNumber<int32_t>(header + 12, swapBytes);
+    int32_t forward = readNumber<int32_t>(header + 76, swapBytes);
+    if (nd != 2 || ni != (isSpk ? 6 : 5)) {
+        return false;
+    }
+    size_t summarySize = (size_t) (nd + (ni + 1)/2) * sizeof(double);
+    size_t numWords = file->dataSize / sizeof(double);
+
+    std::vector<Segment> segments;
+    size_t record = (size_t) forward;
+    size_t numRecords = file->dataSize / dafRecordSize;
+    for (size_t visited = 0; record > 0 && record <= numRecords && visited < numRecords; visited++) {
+        const char *summaryRecord = file->data + (record - 1)*dafRecordSize;
+        int numSummaries = (int) readNumber<double>(summaryRecord + 2*sizeof(double), swapBytes);
+        for (int k = 0; k < numSummaries; k++) {
+            const char *summary = summaryRecord + 3*sizeof(double) + k*summarySize;
+            int32_t ints[6];
+            for (int i = 0; i < ni; i++) {
+                ints[i] = readNumber<int32_t>(summary + nd*sizeof(double) + i*sizeof(int32_t), swapBytes);
+            }
+            int begin = ints[ni - 2];
+            int end = ints[ni - 1];
+            if (begin < 1 || end < begin + 3 || (size_t) end > numWords) {
+                return false;
+            }
+            Segment segment;
+            segment.file = file;
+            segment.swapBytes = swapBytes;
+            segment.body = ints[0];
+            segment.center = isSpk ? ints[1] : 0;
+            segment.frame = ints[isSpk ? 2 : 1];
+            segment.type = ints[isSpk ? 3 : 2];
+            segment.startTime = readNumber<double>(summary, swapBytes);
+            segment.endTime = readNumber<double>(summary + sizeof(double), swapBytes);
+            segment.data = file->data + (size_t) (begin - 1)*sizeof(double);
+            /* the Chebyshev segments end with the record directory */
+            const char *trailer = file->data + (size_t) (end - 4)*sizeof(double);
+            segment.initialTime = readNumber<double>(trailer, swapBytes);
+            segment.intervalLength = readNumber<double>(trailer + sizeof(double), swapBytes);
+            segment.recordSize = (int) readNumber<double>(trailer + 2*sizeof(double), swapBytes);
+            segment.numRecords = (int) readNumber<double>(trailer + 3*sizeof(double), swapBytes);
+            segments.push_back(segment);
+        }
+        record = (size_t) readNumber<double>(summaryRecord, swapBytes);
+    }
+
+    std::map<int, std::vector<Segment>> &bodySegments = isSpk ? this->spkSegments : this->pckSegments;
+    for (const Segment &segment : segments) {
+        bodySegments[segment.body].push_back(segment);
+    }
+    return true;
+}
+
+/*! Unload a kernel.  The segments of the other kernels keep their precedence.
+ @return true if the kernel was loaded
+ @param fileName path of the kernel file
+ */
+bool SpiceKernelReader::unloadKernel(const std::string &fileName)
+{
+    for (auto it = this->files.rbegin(); it != this->files.rend(); ++it) {
+        if ((*it)->fileName != fileName) {
+            continue;
+        }
+        const MappedFile *file = it->get();
+        for (std::map<int, std::vector<Segment>> *segments : {&this->spkSegments, &this->pckSegments}) {
+            for (auto &body : *segments) {
+                std::vector<Segment> &list = body.second;
+                for (long int k = (long int) list.size() - 1; k >= 0; k--) {
+                    if (list[k].file == file) {
+                        list.erase(list.begin() + k);
+                    }
+                }
+            }
+        }
+        this->files.erase(std::next(it).base());
+        return true;
+    }
+    return false;
+}
+
+/*! Unload all kernels and rotation models */
+void SpiceKernelReader::clear()
+{
+    this->spkSegments.clear();
+    this->pckSegments.clear();
+    this->rotationModels.clear();
+    this->files.clear();
+}
+
+/*! Set the text PCK rotation model of a body.  Binary PCK segments of the same frame class id take precedence.
+ @param bodyId NAIF id of the body
+ @param model rotation model
+ */
+void SpiceKernelReader::setRotationModel(int bodyId, const PckRotationModel &model)
+{
+    this->rotationModels[bodyId] = model;
+}
+
+/*! @return true if an SPK segment of the body is loaded
+ @param body NAIF id of the body */
+bool SpiceKernelReader::hasBody(int body) const
+{
+    auto it = this->spkSegments.find(body);
+    return it != this->spkSegments.end() && !it->second.empty();
+}
+
+/*! @return true if a binary PCK segment or a rotation model of the frame class id is loaded
+ @param frameClassId frame class id of a PCK frame, which is the body id for the IAU frames */
+bool SpiceKernelReader::hasRotation(int frameClassId) const
+{
+    auto it = this->pckSegments.find(frameClassId);
+    return (it != this->pckSegments.end() && !it->second.empty()) || this->rotationModels.count(frameClassId) > 0;
+}
+
+/*! Find the segment of highest precedence that covers a time
+ @return segment, or nullptr if no segment covers the time
+ @param segments segments of each body
+ @param body NAIF id of the body or frame class id
+ @param et [s] ephemeris time
+ */
+const SpiceKernelReader::Segment *SpiceKernelReader::findSegment(const std::map<int, std::vector<Segment>> &segments,
+                                                                 int body, double et) const
+{
+    auto it = segments.find(body);
+    if (it == segments.end()) {
+        return nullptr;
+    }
+    for (auto segment = it->second.rbegin(); segment != it->second.rend(); ++segment) {
+        if (et >= segment->startTime && et <= segment->endTime) {
+            return &(*segment);
+        }
+    }
+    return nullptr;
+}
+
+/*! Evaluate a Chebyshev segment
+ @return true if the segment type and frame are supported
+ @param segment segment covering the time
+ @param et [s] ephemeris time
+ @param state evaluated position and velocity, or Euler angles and rates
+ */
+bool SpiceKernelReader::evaluateSegment(const Segment &segment, double et, double state[6]) const
+{
+    int numComponents = segment.type == 3 ? 6 : 3;
+    if ((segment.type != 2 && segment.type != 3) || (segment.frame != frameJ2000 && segment.frame != frameEclipJ2000)
+        || segment.recordSize < 2 + numComponents || segment.numRecords < 1) {
+        return false;
+    }
+    int recordIndex = (int) ((et - segment.initialTime) / segment.intervalLength);
+    recordIndex = recordIndex < 0 ? 0 : (recordIndex >= segment.numRecords ? segment.numRecords - 1 : recordIndex);
+    const char *recordData = segment.data + (size_t) recordIndex * segment.recordSize * sizeof(double);
+    /* records of the machine byte order are read in place, others are copied to the machine byte order */
+    double swappedRecord[maxRecordSize];
+    const double *record = (const double *) recordData;
+    if (segment.swapBytes) {
+        if (segment.recordSize > maxRecordSize) {
+            return false;
+        }
+        for (int k = 0; k < segment.recordSize; k++) {
+            swappedRecord[k] = readNumber<double>(recordData + k*sizeof(double), true);
+        }
+        record = swappedRecord;
+    }
+    int degree = (segment.recordSize - 2)/numComponents - 1;
+    double s = (et - record[0]) / record[1];
+
+    for (int k = 0; k < 3; k++) {
+        double derivative;
+        chebyshev(record + 2 + k*(degree + 1), degree, s, state[k], derivative);
+        state[k + 3] = derivative / record[1];
+    }
+    if (segment.type == 3) {
+        for (int k = 3; k < 6; k++) {
+            double derivative;
+            chebyshev(record + 2 + k*(degree + 1), degree, s, state[k], derivative);
+        }
+    }
+    return true;
+}
+
+/*! Chain the SPK segments from a body to the root of its ephemeris tree
+ @return number of bodies in the chain, or -1 if a segment can not be evaluated
+ @param body NAIF id of the body
+ @param et [s] ephemeris time
+ @param chainBodies bodies of the chain, starting with the body
+ @param chainStates [km, km/s] J2000 state of the body relative to each body of the chain
+ */
+int SpiceKernelReader::buildChain(int body, double et, int chainBodies[], double chainStates[][6]) const
+{
+    chainBodies[0] = body;
+    memset(chainStates[0], 0, 6*sizeof(double));
+    int length = 1;
+    while (length < maxChainLength) {
+        const Segment *segment = findSegment(this->spkSegments, chainBodies[length - 1], et);
+        if (segment == nullptr) {
+            break;
+        }
+        double state[6];
+        if (!this->evaluateSegment(*segment, et, state)) {
+            return -1;
+        }
+        if (segment->frame == frameEclipJ2000) {
+            eclipticToJ2000(state);
+        }
+        chainBodies[length] = segment->center;
+        for (int k = 0; k < 6; k++) {
+            chainStates[length][k] = chainStates[length - 1][k] + state[k];
+        }
+        length++;
+    }
+    return length;
+}
+
+/*! Compute the geometric state of a target relative to an observer, without light time corrections, in the same
+    way as spkgeo_c
+ @return true if the state could be computed
+ @param target NAIF id of the target
+ @param observer NAIF id of the observer
+ @param et [s] ephemeris time in seconds past J2000 TDB
+ @param state [km, km/s] J2000 position and velocity of the target relative to the observer
+ */
+bool SpiceKernelReader::getState(int target, int observer, double et, double state[6]) const
+{
+    int targetBodies[maxChainLength];
+    int observerBodies[maxChainLength];
+    double targetStates[maxChainLength][6];
+    double observerStates[maxChainLength][6];
+    int targetLength = this->buildChain(target, et, targetBodies, targetStates);
+    int observerLength = this->buildChain(observer, et, observerBodies, observerStates);
+    if (targetLength < 0 || observerLength < 0) {
+        return false;
+    }
+    /* the states are combined at the first body of the target chain that is in the observer chain */
+    for (int t = 0; t < targetLength; t++) {
+        for (int o = 0; o < observerLength; o++) {
+            if (targetBodies[t] == observerBodies[o]) {
+                for (int k = 0; k < 6; k++) {
+                    state[k] = targetStates[t][k] - observerStates[o][k];
+                }
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*! Compute the rotation from the J2000 frame to a PCK body frame from a binary PCK segment, or else from the text
+    PCK rotation model of the body, in the same way as sxform_c
+ @return true if the rotation could be computed
+ @param frameClassId frame class id of the body frame, which is the body id for the IAU frames
+ @param et [s] ephemeris time in seconds past J2000 TDB
+ @param dcm_PN rotation matrix from the J2000 frame to the body frame
+ @param dcmDot_PN time derivative of dcm_PN
+ */
+bool SpiceKernelReader::getRotation(int frameClassId, double et, double dcm_PN[3][3], double dcmDot_PN[3][3]) const
+{
+    double angles[3];
+    double rates[3];
+    int frame = frameJ2000;
+    const Segment *segment = findSegment(this->pckSegments, frameClassId, et);
+    if (segment != nullptr) {
+        double eulerState[6];
+        if (segment->type != 2 || !this->evaluateSegment(*segment, et, eulerState)) {
+            return false;
+        }
+        for (int k = 0; k < 3; k++) {
+            angles[k] = eulerState[k];
+            rates[k] = eulerState[k + 3];
+        }
+        frame = segment->frame;
+    } else {
+        auto it = this->rotationModels.find(frameClassId);
+        if (it == this->rotationModels.end()) {
+            return false;
+        }
+        const PckRotationModel &model = it->second;
+        double d = et / secondsPerDay;
+        double T = et / secondsPerCentury;
+        double ra = model.poleRa[0] + T*(model.poleRa[1] + T*model.poleRa[2]);
+        double dec = model.poleDec[0] + T*(model.poleDec[1] + T*model.poleDec[2]);
+        double w = model.pm[0] + d*(model.pm[1] + d*model.pm[2]);
+        double raRate = (model.poleRa[1] + 2.0*T*model.poleRa[2]) / secondsPerCentury;
+        double decRate = (model.poleDec[1] + 2.0*T*model.poleDec[2]) / secondsPerCentury;
+        double wRate = (model.pm[1] + 2.0*d*model.pm[2]) / secondsPerDay;
+        for (size_t j = 0; 2*j + 1 < model.nutPrecAngles.size(); j++) {
+            double theta = (model.nutPrecAngles[2*j] + T*model.nutPrecAngles[2*j + 1]) * M_PI/180.0;
+            double thetaRate = model.nutPrecAngles[2*j + 1] / secondsPerCentury * M_PI/180.0;
+            if (j < model.nutPrecRa.size()) {
+                ra += model.nutPrecRa[j]*sin(theta);
+                raRate += model.nutPrecRa[j]*cos(theta)*thetaRate;
+            }
+            if (j < model.nutPrecDec.size()) {
+                dec += model.nutPrecDec[j]*cos(theta);
+                decRate -= model.nutPrecDec[j]*sin(theta)*thetaRate;
+            }
+            if (j < model.nutPrecPm.size()) {
+                w += model.nutPrecPm[j]*sin(theta);
+                wRate += model.nutPrecPm[j]*cos(theta)*thetaRate;
+            }
+        }
+        w = fmod(w, 360.0);
+        angles[0] = (90.0 + ra) * M_PI/180.0;
+        angles[1] = (90.0 - dec) * M_PI/180.0;
+        angles[2] = w * M_PI/180.0;
+        rates[0] = raRate * M_PI/180.0;
+        rates[1] = -decRate * M_PI/180.0;
+        rates[2] = wRate * M_PI/180.0;
+    }
+
+    eulerRotation(angles, rates, dcm_PN, dcmDot_PN);
+    if (frame == frameEclipJ2000) {
+        /* rotate the J2000 axes into the ecliptic axes first */
+        double eclip_N[3][3], unused[3][3], tmp[3][3];
+        axisRotation(1, obliquityJ2000, eclip_N, unused);
+        matMult(dcm_PN, eclip_N, tmp);
+        memcpy(dcm_PN, tmp, sizeof(tmp));
+        matMult(dcmDot_PN, eclip_N, tmp);
+        memcpy(dcmDot_PN, tmp, sizeof(tmp));
+    }
+    return true;
+}
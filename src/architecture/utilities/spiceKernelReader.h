@@ -0,0 +1,104 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef SPICE_KERNEL_READER_H
+#define SPICE_KERNEL_READER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*! @brief IAU rotation model of a body as defined through the BODY<id>_POLE_RA, _POLE_DEC, _PM and _NUT_PREC_*
+    variables of a text PCK kernel.  The angles are in degrees, the polynomials in Julian centuries (pole) and days
+    (prime meridian) past J2000 TDB. */
+typedef struct {
+    double poleRa[3];                   //!< [deg] right ascension polynomial of the north pole
+    double poleDec[3];                  //!< [deg] declination polynomial of the north pole
+    double pm[3];                       //!< [deg] prime meridian polynomial
+    std::vector<double> nutPrecRa;      //!< [deg] amplitudes of the sine terms of the right ascension
+    std::vector<double> nutPrecDec;     //!< [deg] amplitudes of the cosine terms of the declination
+    std::vector<double> nutPrecPm;      //!< [deg] amplitudes of the sine terms of the prime meridian
+    std::vector<double> nutPrecAngles;  //!< [deg] constant and linear term of each nutation precession angle of the barycenter
+} PckRotationModel;
+
+/*! @brief Read-only, memory-mapped reader of SPICE SPK and binary PCK kernels.
+
+    The reader evaluates SPK segments of type 2 (Chebyshev position) and type 3 (Chebyshev position and velocity)
+    and binary PCK segments of type 2 (Chebyshev Euler angles) without the CSPICE library.  The kernel files are
+    mapped read-only, such that the pages of a kernel are shared by all readers and all processes that use the same
+    file, and the evaluation methods are const and do not modify any state, such that a reader can be evaluated from
+    several threads at once.  Loading and unloading kernels is not thread-safe.
+
+    As in CSPICE, the segments of the last loaded kernel, and the last segments within a kernel, take precedence.
+    States are given in the J2000 frame in km and km/s at ephemeris time in seconds past J2000 TDB.  Segments in the
+    ECLIPJ2000 frame are rotated into J2000.  Kernels in the byte order of the machine are evaluated in place, the
+    records of other kernels are converted when they are evaluated.
+ */
+class SpiceKernelReader {
+public:
+    SpiceKernelReader();
+    ~SpiceKernelReader();
+
+    bool loadKernel(const std::string &fileName);
+    bool unloadKernel(const std::string &fileName);
+    void clear();
+    void setRotationModel(int bodyId, const PckRotationModel &model);
+
+    bool hasBody(int body) const;
+    bool hasRotation(int frameClassId) const;
+    bool getState(int target, int observer, double et, double state[6]) const;
+    bool getRotation(int frameClassId, double et, double dcm_PN[3][3], double dcmDot_PN[3][3]) const;
+
+private:
+    /*! memory-mapped kernel file */
+    struct MappedFile;
+
+    /*! Chebyshev segment of an SPK or binary PCK kernel */
+    typedef struct {
+        const MappedFile *file;         //!< kernel file of the segment
+        bool swapBytes;                 //!< flag if the byte order of the file differs from the machine byte order
+        int body;                       //!< NAIF id of the target body, or the frame class id of a PCK segment
+        int center;                     //!< NAIF id of the center body, unused for PCK segments
+        int frame;                      //!< NAIF id of the reference frame
+        int type;                       //!< SPK or PCK segment type
+        double startTime;               //!< [s] start of the segment coverage
+        double endTime;                 //!< [s] end of the segment coverage
+        const char *data;               //!< first double of the segment data
+        double initialTime;             //!< [s] start time of the first record
+        double intervalLength;          //!< [s] time covered by each record
+        int recordSize;                 //!< [-] number of doubles of each record
+        int numRecords;                 //!< [-] number of records
+    } Segment;
+
+    static std::shared_ptr<const MappedFile> mapFile(const std::string &fileName);
+    bool readSegments(const MappedFile *file);
+    const Segment *findSegment(const std::map<int, std::vector<Segment>> &segments, int body, double et) const;
+    bool evaluateSegment(const Segment &segment, double et, double state[6]) const;
+    int buildChain(int body, double et, int chainBodies[], double chainStates[][6]) const;
+
+    std::vector<std::shared_ptr<const MappedFile>> files;           //!< loaded kernel files in load order
+    std::map<int, std::vector<Segment>> spkSegments;                //!< SPK segments of each body, highest priority last
+    std::map<int, std::vector<Segment>> pckSegments;                //!< PCK segments of each frame class id, highest priority last
+    std::map<int, PckRotationModel> rotationModels;                 //!< text PCK rotation models of each body
+};
+
+#endif
@@ -149,6 +149,60 @@ def BSplineTestFunction(P, XDot_flag, XDDot_flag, accuracy):
     return [testFailCount, ''.join(testMessages)]
 
 
+@pytest.mark.parametrize("XDDot_flag", [False, True])
+def test_BSplineIncremental(XDDot_flag):
+    r"""
+    **Validation Test Description**
+
+    This unit test checks the ``BSplineInterpolator`` class, which solves the interpolation problem with a banded
+    factorization. A BSpline is fitted through the first 8 of 40 waypoints, and the remaining waypoints are added one
+    at a time with ``appendWaypoint()``. After each append, the control points and the sampled trajectory must coincide
+    with those computed by ``BSpline.interpolate()`` on the same set of waypoints. The batch evaluation
+    ``Output.getStatesBatch()`` is checked against ``Output.getStates()``.
+    """
+    P = 5 if XDDot_flag else 4
+    n = 40
+    T = np.cumsum(np.concatenate([[0.0], 0.5 + 0.3 * (np.arange(1, n) % 3)]))
+    X1 = np.sin(0.3 * T)
+    X2 = np.cos(0.2 * T) + 0.1 * T
+    X3 = 0.05 * T**2
+
+    def makeInput(m):
+        Input = BSpline.InputDataSet(X1[:m], X2[:m], X3[:m])
+        Input.setT(T[:m])
+        Input.setXDot_0([0.1, 0.2, 0.3])
+        Input.setXDot_N([0, 0, 0.1])
+        if XDDot_flag:
+            Input.setXDDot_0([0, 0.1, 0])
+            Input.setXDDot_N([0.2, 0, 0])
+        return Input
+
+    interpolator = BSpline.BSplineInterpolator()
+    interpolator.fit(makeInput(8), P)
+    for m in range(8, n):
+        interpolator.appendWaypoint(T[m], [X1[m], X2[m], X3[m]])
+        assert interpolator.getNumberOfWaypoints() == m + 1
+        OutputIncremental = BSpline.OutputDataSet()
+        interpolator.getOutput(51, OutputIncremental)
+        Output = BSpline.OutputDataSet()
+        BSpline.interpolate(makeInput(m + 1), 51, P, Output)
+        for C in ["C1", "C2", "C3"]:
+            np.testing.assert_allclose(np.array(getattr(OutputIncremental, C)), np.array(getattr(Output, C)), atol=1e-9)
+        for X in ["T", "X1", "XD2", "XDD3"]:
+            np.testing.assert_allclose(np.array(getattr(OutputIncremental, X)), np.array(getattr(Output, X)), atol=1e-9)
+
+    # every waypoint is hit at its time tag
+    states = np.array(Output.getStatesBatch(T, 0))
+    np.testing.assert_allclose(states, np.array([X1, X2, X3]).T, atol=1e-6)
+    # batch evaluation matches single evaluations
+    times = np.linspace(0, T[-1] * 1.05, 37)
+    for derivative in range(3):
+        states = np.array(Output.getStatesBatch(times, derivative))
+        for k, t in enumerate(times):
+            for index in range(3):
+                assert abs(states[k][index] - Output.getStates(t, derivative, index)) < 1e-12
+
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
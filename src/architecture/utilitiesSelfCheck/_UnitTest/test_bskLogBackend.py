@@ -0,0 +1,125 @@
+
+# ISC License
+#
+# Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+#
+#   BSKLogger Backend Unit Test
+#
+#   Purpose:  Tests the asynchronous, rate limited backend of BSKLogger
+#
+
+import os
+
+import pytest
+from Basilisk.architecture import bskLogging
+
+
+@pytest.fixture
+def logBackend():
+    """Restores the synchronous logging after each test"""
+    yield
+    bskLogging.disableAsyncLogging()
+    bskLogging.readAsyncLogRecords()
+    bskLogging.setLogRateLimit(0, 0)
+    bskLogging.setLogDeduplication(False)
+    bskLogging.setLogContext(-1, 0)
+
+
+def test_asyncMemorySink(logBackend):
+    r"""
+    **Validation Test Description**
+
+    Records logged with the memory sink are read back in order from Python, with the module ID and sim time
+    set through ``setLogContext()``. Records below the logger level are not kept.
+    """
+    bskLogging.enableAsyncLoggingToMemory()
+    assert bskLogging.asyncLoggingEnabled()
+    logger = bskLogging.BSKLogger(bskLogging.BSK_INFORMATION)
+    bskLogging.setLogContext(5, 2500000000)
+    logger.bskLog(bskLogging.BSK_WARNING, "first message")
+    logger.bskLog(bskLogging.BSK_DEBUG, "filtered message")
+    bskLogging.setLogContext(-1, 0)
+    logger.bskLog(bskLogging.BSK_ERROR, "second message")
+    records = list(bskLogging.readAsyncLogRecords())
+    assert records == ["BSK_WARNING [t = 2.5 s, moduleID = 5]: first message",
+                       "BSK_ERROR [t = 0 s]: second message"]
+    assert len(bskLogging.readAsyncLogRecords()) == 0
+
+
+def test_asyncFileSink(logBackend, tmp_path):
+    r"""
+    **Validation Test Description**
+
+    Records logged with the file sink are in the file once the backend is disabled.
+    """
+    fileName = os.path.join(str(tmp_path), "bsk.log")
+    bskLogging.enableAsyncLogging(fileName)
+    logger = bskLogging.BSKLogger()
+    for i in range(500):
+        logger.bskLog(bskLogging.BSK_INFORMATION, "record")
+    bskLogging.disableAsyncLogging()
+    assert not bskLogging.asyncLoggingEnabled()
+    with open(fileName) as logFile:
+        lines = logFile.read().splitlines()
+    assert len(lines) == 500
+    assert lines[0] == "BSK_INFORMATION [t = 0 s]: record"
+
+
+@pytest.mark.parametrize("maxRecords", [1, 3])
+def test_rateLimit(logBackend, maxRecords):
+    r"""
+    **Validation Test Description**
+
+    With a rate limit of ``maxRecords`` per second of sim time, a call site logging every 0.1 s keeps
+    ``maxRecords`` records per second. The first record of each window reports how many records were dropped.
+    """
+    bskLogging.enableAsyncLoggingToMemory()
+    bskLogging.setLogRateLimit(maxRecords, 1000000000)
+    suppressedStart = bskLogging.getSuppressedLogCount()
+    logger = bskLogging.BSKLogger()
+    for i in range(50):
+        bskLogging.setLogContext(3, i * 100000000)
+        logger.bskLog(bskLogging.BSK_WARNING, "altitude limit exceeded")
+        logger.bskLog(bskLogging.BSK_WARNING, "other call site")
+    records = list(bskLogging.readAsyncLogRecords())
+    assert len(records) == 2 * 5 * maxRecords
+    assert bskLogging.getSuppressedLogCount() - suppressedStart == 2 * 5 * (10 - maxRecords)
+    windowStarts = [r for r in records if "altitude" in r and "similar messages suppressed" in r]
+    assert len(windowStarts) == 4
+    assert windowStarts[0].endswith("[%d similar messages suppressed]" % (10 - maxRecords))
+
+
+def test_deduplication(logBackend):
+    r"""
+    **Validation Test Description**
+
+    With deduplication on, a record identical to the previous record of the same call site is dropped. The
+    synchronous logging applies it as well.
+    """
+    bskLogging.setLogDeduplication(True)
+    bskLogging.enableAsyncLoggingToMemory()
+    logger = bskLogging.BSKLogger()
+    for i in range(4):
+        logger.bskLog(bskLogging.BSK_WARNING, "repeated")
+    logger.bskLog(bskLogging.BSK_ERROR, "repeated")
+    records = list(bskLogging.readAsyncLogRecords())
+    assert records == ["BSK_WARNING [t = 0 s]: repeated", "BSK_ERROR [t = 0 s]: repeated"]
+
+
+if __name__ == "__main__":
+    test_rateLimit(None, 3)
@@ -0,0 +1,208 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+
+#
+#   Batched Geodetic Conversions Unit Test
+#
+#   Purpose:  Tests the batched geodetic conversions against the spherical geodeticConversion functions and an
+#             iterative solution on the WGS-84 ellipsoid
+#
+
+import time
+
+import numpy as np
+import pytest
+from Basilisk.architecture import geodeticConversionArray as geoArray
+from Basilisk.utilities import RigidBodyKinematics as rbk
+
+REQ_EARTH = 6378137.0
+RP_EARTH = 6356752.314245
+
+
+def toSoA(array):
+    return np.ascontiguousarray(array.T)
+
+
+def randomPositions(rng, num, minRadius=6.0e6, maxRadius=5.0e7):
+    """Returns positions in all directions, including positions on and close to the polar axis."""
+    direction = rng.normal(size=(num, 3))
+    direction /= np.linalg.norm(direction, axis=1)[:, None]
+    direction[::11] = [0.0, 0.0, 1.0]
+    direction[5::11] = [1.0e-9, 0.0, -1.0]
+    return direction * rng.uniform(minRadius, maxRadius, size=(num, 1))
+
+
+def randomLLA(rng, num):
+    lla = np.column_stack([rng.uniform(-np.pi / 2, np.pi / 2, num), rng.uniform(-np.pi, np.pi, num),
+                           rng.uniform(-1.0e4, 4.0e7, num)])
+    lla[::13, 0] = np.pi / 2
+    return lla
+
+
+def sphericalPCPF2LLA(pcpf, planetRad):
+    """Spherical conversion of the C++ PCPF2LLA()"""
+    return np.column_stack([np.arctan2(pcpf[:, 2], np.hypot(pcpf[:, 0], pcpf[:, 1])),
+                            np.arctan2(pcpf[:, 1], pcpf[:, 0]),
+                            np.linalg.norm(pcpf, axis=1) - planetRad])
+
+
+def sphericalLLA2PCPF(lla, planetRad):
+    """Spherical conversion of the C++ LLA2PCPF()"""
+    r = planetRad + lla[:, 2]
+    return np.column_stack([r * np.cos(lla[:, 0]) * np.cos(lla[:, 1]), r * np.cos(lla[:, 0]) * np.sin(lla[:, 1]),
+                            r * np.sin(lla[:, 0])])
+
+
+def iterativePCPF2LLA(pcpf, planetEqRad, planetPoRad):
+    """Geodetic coordinates on the ellipsoid from the fixed point iteration of the latitude"""
+    e2 = 1.0 - (planetPoRad / planetEqRad) ** 2
+    p = np.hypot(pcpf[:, 0], pcpf[:, 1])
+    lat = np.arctan2(pcpf[:, 2], p * (1.0 - e2))
+    for _ in range(20):
+        N = planetEqRad / np.sqrt(1.0 - e2 * np.sin(lat) ** 2)
+        alt = np.where(np.abs(lat) < np.pi / 4, p / np.cos(lat) - N, pcpf[:, 2] / np.sin(lat) - N * (1.0 - e2))
+        lat = np.arctan2(pcpf[:, 2], p * (1.0 - e2 * N / (N + alt)))
+    N = planetEqRad / np.sqrt(1.0 - e2 * np.sin(lat) ** 2)
+    alt = np.where(np.abs(lat) < np.pi / 4, p / np.cos(lat) - N, pcpf[:, 2] / np.sin(lat) - N * (1.0 - e2))
+    return np.column_stack([lat, np.arctan2(pcpf[:, 1], pcpf[:, 0]), alt])
+
+
+def planetDCM():
+    return rbk.euler3232C([0.3, 0.2, -1.1])
+
+
+@pytest.mark.parametrize("soa", [False, True])
+def test_frameConversions(soa):
+    """The C++ PCI2PCPF() maps the J20002Pfix array to an Eigen matrix column by column, which the batched
+    conversions reproduce."""
+    rng = np.random.default_rng(1)
+    pci = randomPositions(rng, 300)
+    dcm = planetDCM()
+    pcpf = geoArray.PCI2PCPF(toSoA(pci), dcm, soa=True).T if soa else geoArray.PCI2PCPF(pci, dcm)
+    np.testing.assert_allclose(pcpf, pci @ dcm, rtol=0, atol=1e-15 * 5.0e7)
+    pciOut = geoArray.PCPF2PCI(toSoA(pcpf), dcm, soa=True).T if soa else geoArray.PCPF2PCI(pcpf, dcm)
+    np.testing.assert_allclose(pciOut, pci, rtol=0, atol=1e-15 * 5.0e7)
+
+
+@pytest.mark.parametrize("soa", [False, True])
+def test_sphericalConversions(soa):
+    rng = np.random.default_rng(2)
+    pcpf = randomPositions(rng, 300)
+    lla = geoArray.PCPF2LLA(toSoA(pcpf), REQ_EARTH, soa=True).T if soa else geoArray.PCPF2LLA(pcpf, REQ_EARTH)
+    expected = sphericalPCPF2LLA(pcpf, REQ_EARTH)
+    np.testing.assert_allclose(lla[:, 0:2], expected[:, 0:2], rtol=0, atol=1e-14)
+    np.testing.assert_allclose(lla[:, 2], expected[:, 2], rtol=0, atol=1e-7)
+
+    llaIn = randomLLA(rng, 300)
+    pcpfOut = geoArray.LLA2PCPF(toSoA(llaIn), REQ_EARTH, soa=True).T if soa else geoArray.LLA2PCPF(llaIn, REQ_EARTH)
+    np.testing.assert_allclose(pcpfOut, sphericalLLA2PCPF(llaIn, REQ_EARTH), rtol=0, atol=1e-7)
+
+    dcm = planetDCM()
+    lla = geoArray.PCI2LLA(toSoA(pcpf), dcm, REQ_EARTH, soa=True).T if soa else geoArray.PCI2LLA(pcpf, dcm, REQ_EARTH)
+    expected = sphericalPCPF2LLA(pcpf @ dcm, REQ_EARTH)
+    np.testing.assert_allclose(lla[:, 0:2], expected[:, 0:2], rtol=0, atol=1e-14)
+    np.testing.assert_allclose(lla[:, 2], expected[:, 2], rtol=0, atol=1e-7)
+    pci = geoArray.LLA2PCI(toSoA(llaIn), dcm, REQ_EARTH, soa=True).T if soa else geoArray.LLA2PCI(llaIn, dcm, REQ_EARTH)
+    np.testing.assert_allclose(pci, sphericalLLA2PCPF(llaIn, REQ_EARTH) @ dcm.T, rtol=0, atol=1e-7)
+
+
+@pytest.mark.parametrize("soa", [False, True])
+def test_ellipsoidConversions(soa):
+    rng = np.random.default_rng(3)
+    pcpf = randomPositions(rng, 1000)
+    if soa:
+        lla = geoArray.PCPF2LLA(toSoA(pcpf), REQ_EARTH, RP_EARTH, soa=True).T
+    else:
+        lla = geoArray.PCPF2LLA(pcpf, REQ_EARTH, RP_EARTH)
+    expected = iterativePCPF2LLA(pcpf, REQ_EARTH, RP_EARTH)
+    np.testing.assert_allclose(lla[:, 0:2], expected[:, 0:2], rtol=0, atol=1e-14)
+    np.testing.assert_allclose(lla[:, 2], expected[:, 2], rtol=0, atol=1e-7)
+
+    llaIn = randomLLA(rng, 1000)
+    if soa:
+        pcpfOut = geoArray.LLA2PCPF(toSoA(llaIn), REQ_EARTH, RP_EARTH, soa=True).T
+    else:
+        pcpfOut = geoArray.LLA2PCPF(llaIn, REQ_EARTH, RP_EARTH)
+    llaOut = geoArray.PCPF2LLA(pcpfOut, REQ_EARTH, RP_EARTH)
+    np.testing.assert_allclose(llaOut[:, 0], llaIn[:, 0], rtol=0, atol=1e-14)
+    np.testing.assert_allclose(llaOut[:, 2], llaIn[:, 2], rtol=0, atol=1e-7)
+    notPolar = np.abs(llaIn[:, 0]) < np.pi / 2 - 1e-6
+    np.testing.assert_allclose(llaOut[notPolar, 1], llaIn[notPolar, 1], rtol=0, atol=1e-14)
+
+    # points on the surface of the ellipsoid
+    surface = geoArray.LLA2PCPF(np.column_stack([llaIn[:, 0:2], np.zeros(1000)]), REQ_EARTH, RP_EARTH)
+    np.testing.assert_allclose((surface[:, 0] ** 2 + surface[:, 1] ** 2) / REQ_EARTH ** 2
+                               + surface[:, 2] ** 2 / RP_EARTH ** 2, 1.0, rtol=0, atol=1e-15)
+
+
+@pytest.mark.parametrize("soa", [False, True])
+def test_SEZ(soa):
+    rng = np.random.default_rng(4)
+    lat = rng.uniform(-np.pi / 2, np.pi / 2, 100)
+    longitude = rng.uniform(-np.pi, np.pi, 100)
+    C = geoArray.C_PCPF2SEZ(lat, longitude, soa=soa)
+    if soa:
+        C = C.T.reshape((100, 3, 3))
+    for k in range(100):
+        expected = rbk.euler2(np.pi / 2 - lat[k]) @ rbk.euler3(longitude[k])
+        np.testing.assert_allclose(C[k], expected, rtol=0, atol=1e-15)
+
+
+def test_inputChecks():
+    lla = geoArray.PCPF2LLA([REQ_EARTH + 1000.0, 0.0, 0.0], REQ_EARTH, RP_EARTH)
+    assert lla.shape == (1, 3)
+    np.testing.assert_allclose(lla[0], [0.0, 0.0, 1000.0], atol=1e-9)
+    assert geoArray.PCPF2LLA(np.zeros((0, 3)), REQ_EARTH).shape == (0, 3)
+    with pytest.raises(ValueError):
+        geoArray.PCPF2LLA(np.zeros((5, 2)), REQ_EARTH)
+    with pytest.raises(ValueError):
+        geoArray.PCI2PCPF(np.zeros((5, 3)), np.identity(2))
+    with pytest.raises(ValueError):
+        geoArray.C_PCPF2SEZ(np.zeros(5), np.zeros(4))
+
+
+def benchmarkConversions(num=10**6):
+    """Prints the time of the batched conversions of num positions and of the numpy conversions."""
+    rng = np.random.default_rng(0)
+    pcpf = randomPositions(rng, num)
+    pcpfSoA = toSoA(pcpf)
+    lla = geoArray.PCPF2LLA(pcpf, REQ_EARTH, RP_EARTH)
+    dcm = planetDCM()
+    cases = [("PCI2PCPF", lambda: geoArray.PCI2PCPF(pcpf, dcm), lambda: pcpf @ dcm),
+             ("PCPF2LLA", lambda: geoArray.PCPF2LLA(pcpf, REQ_EARTH), lambda: sphericalPCPF2LLA(pcpf, REQ_EARTH)),
+             ("PCPF2LLA wgs84", lambda: geoArray.PCPF2LLA(pcpf, REQ_EARTH, RP_EARTH),
+              lambda: iterativePCPF2LLA(pcpf, REQ_EARTH, RP_EARTH)),
+             ("PCPF2LLA soa", lambda: geoArray.PCPF2LLA(pcpfSoA, REQ_EARTH, RP_EARTH, soa=True), None),
+             ("LLA2PCPF", lambda: geoArray.LLA2PCPF(lla, REQ_EARTH, RP_EARTH), None)]
+    for name, batched, reference in cases:
+        start = time.perf_counter()
+        batched()
+        batchedTime = time.perf_counter() - start
+        line = "%-15s batched %8.1f ms" % (name, batchedTime * 1e3)
+        if reference is not None:
+            start = time.perf_counter()
+            reference()
+            referenceTime = time.perf_counter() - start
+            line += ", numpy %8.1f ms" % (referenceTime * 1e3)
+        print(line)
+
+
+if __name__ == "__main__":
+    test_ellipsoidConversions(False)
+    benchmarkConversions()
@@ -0,0 +1,142 @@
+
+# ISC License
+#
+# Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+#
+#   Relative Motion Unit Test
+#
+#   Purpose:  Tests the closed-form relative motion state transition matrices
+#
+
+import numpy as np
+import pytest
+from Basilisk.architecture import relativeMotion
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+
+
+def chiefElements(e, f):
+    oe = relativeMotion.ClassicElementsMsgPayload()
+    oe.a = 7000. * 1000.
+    oe.e = e
+    oe.i = 50. * macros.D2R
+    oe.Omega = 20. * macros.D2R
+    oe.omega = 15. * macros.D2R
+    oe.f = f
+    return oe
+
+
+def toPython(oe):
+    oePy = orbitalMotion.ClassicElements()
+    for name in ["a", "e", "i", "Omega", "omega", "f"]:
+        setattr(oePy, name, getattr(oe, name))
+    return oePy
+
+
+def hillState(oeChief, oeDeputy, mu):
+    rc, vc = orbitalMotion.elem2rv(mu, oeChief)
+    rd, vd = orbitalMotion.elem2rv(mu, oeDeputy)
+    rho, rhoPrime = orbitalMotion.rv2hill(rc, vc, rd, vd)
+    return np.concatenate([rho, rhoPrime])
+
+
+def propagateMean(oe, dt, mu, J2):
+    """Propagates mean elements with the first order secular J2 rates"""
+    n = np.sqrt(mu / oe.a**3)
+    p = oe.a * (1. - oe.e**2)
+    gamma = n * J2 * (orbitalMotion.REQ_EARTH * 1000. / p)**2
+    ci = np.cos(oe.i)
+    oe1 = orbitalMotion.ClassicElements()
+    oe1.a, oe1.e, oe1.i = oe.a, oe.e, oe.i
+    oe1.Omega = oe.Omega - 1.5 * gamma * ci * dt
+    oe1.omega = oe.omega + 0.75 * gamma * (5. * ci**2 - 1.) * dt
+    M = orbitalMotion.E2M(orbitalMotion.f2E(oe.f, oe.e), oe.e)
+    M += (n + 0.75 * gamma * np.sqrt(1. - oe.e**2) * (3. * ci**2 - 1.)) * dt
+    oe1.f = orbitalMotion.E2f(orbitalMotion.M2E(M % (2. * np.pi), oe.e), oe.e)
+    return oe1
+
+
+def test_circularLimit():
+    r"""
+    **Validation Test Description**
+
+    About a circular chief orbit without J2, the Yamanaka-Ankersen and Gim-Alfriend STMs must reduce to the
+    Clohessy-Wiltshire STM.
+    """
+    mu = orbitalMotion.MU_EARTH * 1e9
+    oe = chiefElements(0., 30. * macros.D2R)
+    n = np.sqrt(mu / oe.a**3)
+    for dt in [100., 2000., 12000.]:
+        stmCW = np.array(relativeMotion.clohessyWiltshireSTM(n, dt))
+        stmYA = np.array(relativeMotion.yamanakaAnkersenSTM(mu, oe, dt))
+        stmGA = np.array(relativeMotion.gimAlfriendSTM(mu, orbitalMotion.REQ_EARTH * 1000., 0., oe, dt))
+        np.testing.assert_allclose(stmYA, stmCW, atol=1e-9 * np.abs(stmCW).max())
+        np.testing.assert_allclose(stmGA, stmCW, atol=1e-9 * np.abs(stmCW).max())
+
+
+@pytest.mark.parametrize("J2", [0., orbitalMotion.J2_EARTH])
+@pytest.mark.parametrize("e", [0.0, 0.01, 0.3])
+def test_relativeMotionSTM(e, J2):
+    r"""
+    **Validation Test Description**
+
+    A deputy is placed close to the chief by offsetting the chief orbit elements. Both orbits are propagated with the
+    Keplerian motion, plus the secular J2 drift of the mean elements when ``J2`` is not zero, and the relative state is
+    computed in the chief Hill frame with ``rv2hill()``. The relative state predicted by the Gim-Alfriend STM, and by the
+    Yamanaka-Ankersen STM without J2, must agree with this reference to second order in the separation.
+    """
+    mu = orbitalMotion.MU_EARTH * 1e9
+    oeChief = chiefElements(e, 60. * macros.D2R)
+    oeDeputy = toPython(oeChief)
+    oeDeputy.a += 20.
+    oeDeputy.e += 1e-5
+    oeDeputy.i += 2e-5
+    oeDeputy.Omega -= 1e-5
+    oeDeputy.omega += 3e-5
+    oeDeputy.f -= 2e-5
+    x0 = hillState(toPython(oeChief), oeDeputy, mu)
+
+    for dt in [500., 6000., 30000.]:
+        truth = hillState(propagateMean(toPython(oeChief), dt, mu, J2), propagateMean(oeDeputy, dt, mu, J2), mu)
+        stmGA = np.array(relativeMotion.gimAlfriendSTM(mu, orbitalMotion.REQ_EARTH * 1000., J2, oeChief, dt))
+        np.testing.assert_allclose(stmGA.dot(x0)[0:3], truth[0:3], atol=2e-3 * np.linalg.norm(truth[0:3]))
+        np.testing.assert_allclose(stmGA.dot(x0)[3:6], truth[3:6], atol=2e-3 * np.linalg.norm(truth[3:6]))
+        if J2 == 0.:
+            stmYA = np.array(relativeMotion.yamanakaAnkersenSTM(mu, oeChief, dt))
+            np.testing.assert_allclose(stmYA, stmGA, atol=1e-9 * np.abs(stmGA).max())
+
+
+def test_propagateRelativeStates():
+    r"""
+    **Validation Test Description**
+
+    The batch propagation of many deputies must match the product of the STM with each deputy state.
+    """
+    mu = orbitalMotion.MU_EARTH * 1e9
+    oe = chiefElements(0.05, 10. * macros.D2R)
+    stm = np.array(relativeMotion.yamanakaAnkersenSTM(mu, oe, 1500.))
+    rng = np.random.default_rng(0)
+    states = rng.normal(size=(200, 6)) * np.array([100., 100., 100., 0.1, 0.1, 0.1])
+    propagated = np.array(relativeMotion.propagateRelativeStates(stm, states))
+    assert propagated.shape == (200, 6)
+    for k in range(200):
+        np.testing.assert_allclose(propagated[k], stm.dot(states[k]), rtol=1e-12, atol=1e-9)
+
+
+if __name__ == "__main__":
+    test_relativeMotionSTM(0.3, orbitalMotion.J2_EARTH)
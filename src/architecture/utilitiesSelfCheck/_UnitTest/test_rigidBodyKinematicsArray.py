@@ -0,0 +1,176 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+
+#
+#   Batched Attitude Conversions Unit Test
+#
+#   Purpose:  Tests the batched attitude conversions of rigidBodyKinematics against the scalar conversions
+#
+
+import time
+
+import numpy as np
+import pytest
+from Basilisk.architecture import rigidBodyKinematicsArray as rbkArray
+from Basilisk.utilities import RigidBodyKinematics as rbk
+
+
+def randomMRPs(rng, num):
+    """Returns MRP sets inside and outside the unit sphere, including sets close to the shadow set switch."""
+    sigma = rng.uniform(-1.0, 1.0, size=(num, 3))
+    sigma[::5] *= 3.0
+    sigma[::7] /= np.linalg.norm(sigma[::7], axis=1)[:, None]
+    return sigma
+
+
+def randomEPs(rng, num):
+    beta = rng.normal(size=(num, 4))
+    return beta / np.linalg.norm(beta, axis=1)[:, None]
+
+
+def toSoA(array):
+    return np.ascontiguousarray(array.reshape((array.shape[0], -1)).T)
+
+
+def fromSoA(array, shape):
+    return array.T.reshape(shape)
+
+
+def assertSameAttitudes(sigma, expected):
+    """MRP sets on the unit sphere can differ by the shadow set, so the attitudes are compared as DCMs."""
+    for k in range(len(sigma)):
+        np.testing.assert_allclose(rbk.MRP2C(sigma[k]), rbk.MRP2C(expected[k]), atol=1e-12)
+    assert np.all(np.sum(sigma * sigma, axis=1) <= 1.0 + 1e-12)
+
+
+@pytest.mark.parametrize("soa", [False, True])
+def test_MRPConversions(soa):
+    rng = np.random.default_rng(1)
+    sigma = randomMRPs(rng, 300)
+    C = rbkArray.MRP2C(toSoA(sigma), soa=True) if soa else rbkArray.MRP2C(sigma)
+    if soa:
+        C = fromSoA(C, (300, 3, 3))
+    for k in range(300):
+        np.testing.assert_allclose(C[k], rbk.MRP2C(sigma[k]), atol=1e-14)
+
+    sigmaOut = fromSoA(rbkArray.C2MRP(toSoA(C), soa=True), (300, 3)) if soa else rbkArray.C2MRP(C)
+    assertSameAttitudes(sigmaOut, sigma)
+
+
+@pytest.mark.parametrize("soa", [False, True])
+def test_EPConversions(soa):
+    rng = np.random.default_rng(2)
+    beta = randomEPs(rng, 300)
+    C = fromSoA(rbkArray.EP2C(toSoA(beta), soa=True), (300, 3, 3)) if soa else rbkArray.EP2C(beta)
+    for k in range(300):
+        np.testing.assert_allclose(C[k], rbk.EP2C(beta[k]), atol=1e-14)
+
+    betaOut = fromSoA(rbkArray.C2EP(toSoA(C), soa=True), (300, 4)) if soa else rbkArray.C2EP(C)
+    for k in range(300):
+        np.testing.assert_allclose(betaOut[k], rbk.C2EP(C[k]), atol=1e-12)
+
+
+@pytest.mark.parametrize("soa", [False, True])
+def test_MRPAddition(soa):
+    rng = np.random.default_rng(3)
+    sigma1 = randomMRPs(rng, 300)
+    sigma2 = randomMRPs(rng, 300)
+    # compositions close to the singularity switch to the shadow set of sigma1, they are checked with the DCMs
+    sigma2[::4] = -0.999 * sigma1[::4]
+    sigma2[2::4] = 0.999 * sigma1[2::4]
+    if soa:
+        added = fromSoA(rbkArray.addMRP(toSoA(sigma1), toSoA(sigma2), soa=True), (300, 3))
+        subtracted = fromSoA(rbkArray.subMRP(toSoA(sigma1), toSoA(sigma2), soa=True), (300, 3))
+    else:
+        added = rbkArray.addMRP(sigma1, sigma2)
+        subtracted = rbkArray.subMRP(sigma1, sigma2)
+    for k in range(300):
+        C1 = rbk.MRP2C(sigma1[k])
+        C2 = rbk.MRP2C(sigma2[k])
+        np.testing.assert_allclose(rbk.MRP2C(added[k]), C2.dot(C1), atol=1e-10)
+        np.testing.assert_allclose(rbk.MRP2C(subtracted[k]), C1.dot(C2.T), atol=1e-10)
+    assert np.all(np.sum(added * added, axis=1) <= 1.0 + 1e-12)
+    assert np.all(np.sum(subtracted * subtracted, axis=1) <= 1.0 + 1e-12)
+    regular = np.abs(np.sum(sigma1 * sigma2, axis=1)) < 0.2
+    assertSameAttitudes(added[regular], [rbk.addMRP(sigma1[k], sigma2[k]) for k in np.flatnonzero(regular)])
+    assertSameAttitudes(subtracted[regular], [rbk.subMRP(sigma1[k], sigma2[k]) for k in np.flatnonzero(regular)])
+
+
+@pytest.mark.parametrize("sequence", rbkArray.EULER_SEQUENCES)
+@pytest.mark.parametrize("soa", [False, True])
+def test_eulerConversions(sequence, soa):
+    rng = np.random.default_rng(sequence)
+    angles = rng.uniform(-1.5, 1.5, size=(100, 3))
+    euler2C = getattr(rbk, "euler%d2C" % sequence)
+    C2Euler = getattr(rbk, "C2Euler%d" % sequence)
+    if soa:
+        C = fromSoA(rbkArray.euler2C(toSoA(angles), sequence, soa=True), (100, 3, 3))
+        anglesOut = fromSoA(rbkArray.C2Euler(toSoA(C), sequence, soa=True), (100, 3))
+    else:
+        C = rbkArray.euler2C(angles, sequence)
+        anglesOut = rbkArray.C2Euler(C, sequence)
+    for k in range(100):
+        np.testing.assert_allclose(C[k], euler2C(angles[k]), atol=1e-14)
+        np.testing.assert_allclose(anglesOut[k], C2Euler(C[k]), atol=1e-12)
+
+
+def test_inputChecks():
+    C = rbkArray.MRP2C([0.1, 0.2, 0.3])
+    assert C.shape == (1, 3, 3)
+    np.testing.assert_allclose(C[0], rbk.MRP2C(np.array([0.1, 0.2, 0.3])), atol=1e-14)
+    assert rbkArray.MRP2C(np.zeros((0, 3))).shape == (0, 3, 3)
+    with pytest.raises(ValueError):
+        rbkArray.MRP2C(np.zeros((5, 4)))
+    with pytest.raises(ValueError):
+        rbkArray.addMRP(np.zeros((5, 3)), np.zeros((4, 3)))
+    with pytest.raises(ValueError):
+        rbkArray.euler2C(np.zeros((5, 3)), 322)
+
+
+def benchmarkConversions(num=10**6):
+    """Prints the time of the batched conversions of num samples and of the loop over the scalar conversions."""
+    rng = np.random.default_rng(0)
+    sigma1 = randomMRPs(rng, num)
+    sigma2 = randomMRPs(rng, num)
+    sigmaSoA = toSoA(sigma1)
+    beta = randomEPs(rng, num)
+    C = rbkArray.MRP2C(sigma1)
+    cases = [("MRP2C", lambda: rbkArray.MRP2C(sigma1), lambda k: rbk.MRP2C(sigma1[k])),
+             ("MRP2C soa", lambda: rbkArray.MRP2C(sigmaSoA, soa=True), None),
+             ("C2MRP", lambda: rbkArray.C2MRP(C), lambda k: rbk.C2MRP(C[k])),
+             ("EP2C", lambda: rbkArray.EP2C(beta), lambda k: rbk.EP2C(beta[k])),
+             ("addMRP", lambda: rbkArray.addMRP(sigma1, sigma2), lambda k: rbk.addMRP(sigma1[k], sigma2[k])),
+             ("euler3212C", lambda: rbkArray.euler2C(sigma1, 321), lambda k: rbk.euler3212C(sigma1[k]))]
+    for name, batched, scalar in cases:
+        start = time.perf_counter()
+        batched()
+        batchedTime = time.perf_counter() - start
+        line = "%-12s batched %8.1f ms" % (name, batchedTime * 1e3)
+        if scalar is not None:
+            start = time.perf_counter()
+            for k in range(num):
+                scalar(k)
+            scalarTime = time.perf_counter() - start
+            line += ", scalar loop %9.1f ms, speedup %6.0f" % (scalarTime * 1e3, scalarTime / batchedTime)
+        print(line)
+
+
+if __name__ == "__main__":
+    test_MRPAddition(True)
+    benchmarkConversions()
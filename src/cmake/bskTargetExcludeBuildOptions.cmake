@@ -7,3 +7,10 @@ option(BUILD_OPNAV "Build OpNav Modules" OFF)
 if(NOT BUILD_OPNAV)
   list(APPEND EXCLUDED_BSK_TARGETS "limbFinding" "centerRadiusCNN" "houghCircles" "camera")
 endif()
+
+option(BUILD_ALLOCATION_GUARD "Count the heap allocations of real-time threads, replaces the global operator new" OFF)
+
+option(BUILD_MPI "Build MPI Distributed Simulation Module" OFF)
+if(NOT BUILD_MPI)
+  list(APPEND EXCLUDED_BSK_TARGETS "mpiSynch")
+endif()
@@ -278,6 +278,76 @@ def waypointReferenceTestFunction(attType, MRPswitching, useReferenceFrame, accu
 
     return [testFailCount, ''.join(testMessages)]
 
+@pytest.mark.parametrize("interpolationOrder", [1, 3])
+def test_waypointReferenceRandomAccess(interpolationOrder):
+    r"""
+    **Validation Test Description**
+
+    This unit test checks that the memory-mapped waypoint store can be evaluated at arbitrary times after ``Reset()``,
+    including backward jumps in time, on a file with a header line and many waypoints. A smooth attitude profile
+    is sampled every 0.5 s. With ``interpolationOrder = 1`` the output must match the linear interpolation of the
+    waypoints; with ``interpolationOrder = 3`` the BSpline output must match the analytic profile between the
+    waypoints more accurately than the linear interpolation does.
+    """
+    fileName = os.path.join(path, "dataRandomAccess" + str(interpolationOrder) + ".txt")
+    numWaypoints = 20000
+    t = 1.0 + 0.5 * np.arange(numWaypoints)
+
+    def sigmaTrue(time):
+        return np.array([0.1 + 0.2 * np.sin(0.05 * time), 0.2 + 0.1 * np.cos(0.03 * time), 0.3 * np.ones_like(time)])
+
+    def omegaTrue(time):
+        return np.array([0.01 * time, 0.5 * np.ones_like(time), np.sin(0.02 * time)])
+
+    sigma = sigmaTrue(t).T
+    omega = omegaTrue(t).T
+    with open(fileName, "w") as fDataFile:
+        fDataFile.write("time, sigma_1, sigma_2, sigma_3, omega_1, omega_2, omega_3, omegaDot_1, omegaDot_2, omegaDot_3\n")
+        for i in range(numWaypoints):
+            fDataFile.write(",".join("{:.15e}".format(x) for x in [t[i], *sigma[i], *omega[i], 0.0, 0.0, 0.0]) + "\n")
+
+    testModule = waypointReference.WaypointReference()
+    testModule.ModelTag = "testModule"
+    testModule.dataFileName = fileName
+    testModule.headerLines = 1
+    testModule.attitudeType = 0
+    testModule.interpolationOrder = interpolationOrder
+    testModule.Reset(0)
+    assert testModule.getNumberOfWaypoints() == numWaypoints
+
+    rng = np.random.default_rng(1)
+    times = np.concatenate([[0.0, t[-1] + 10.0, t[0]], rng.uniform(t[0], t[-1], 200)])
+    errorSpline = []
+    errorLinear = []
+    for time in times:
+        testModule.UpdateState(macros.sec2nano(time))
+        out = testModule.attRefOutMsg.read()
+        if time < t[0]:
+            np.testing.assert_allclose(out.sigma_RN, sigma[0], atol=1e-12)
+            np.testing.assert_allclose(out.omega_RN_N, [0.0, 0.0, 0.0], atol=1e-12)
+        elif time > t[-1]:
+            np.testing.assert_allclose(out.sigma_RN, sigma[-1], atol=1e-12)
+            np.testing.assert_allclose(out.omega_RN_N, [0.0, 0.0, 0.0], atol=1e-12)
+        else:
+            tNano = macros.sec2nano(time) * macros.NANO2SEC
+            sigmaLinear = np.array([np.interp(tNano, t, sigma[:, n]) for n in range(3)])
+            omegaLinear = np.array([np.interp(tNano, t, omega[:, n]) for n in range(3)])
+            if interpolationOrder == 1:
+                np.testing.assert_allclose(out.sigma_RN, sigmaLinear, atol=1e-9)
+                np.testing.assert_allclose(out.omega_RN_N, omegaLinear, atol=1e-9)
+            else:
+                errorSpline.append(np.linalg.norm(np.array(out.sigma_RN) - sigmaTrue(tNano)))
+                errorLinear.append(np.linalg.norm(sigmaLinear - sigmaTrue(tNano)))
+
+    if interpolationOrder > 1:
+        assert max(errorSpline) < 1e-6
+        assert max(errorSpline) < max(errorLinear)
+
+    del testModule
+    if os.path.exists(fileName):
+        os.remove(fileName)
+
+
 #
 # This statement below ensures that the unitTestScript can be run as a
 # stand-along python script
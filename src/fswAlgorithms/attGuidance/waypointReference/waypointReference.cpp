@@ -20,6 +20,8 @@
 #include <sstream>
 #include <string>
 #include <string.h>
+#include <algorithm>
+#include <stdint.h>
 #include "architecture/utilities/avsEigenSupport.h"
 #include "architecture/utilities/linearAlgebra.h"
 #include "architecture/utilities/rigidBodyKinematics.h"
@@ -34,7 +36,11 @@ WaypointReference::WaypointReference()
     this->headerLines = 0;
     this->attitudeType = 0;
 	this->useReferenceFrame = false;
-	this->endOfFile = false;
+    this->interpolationOrder = 1;
+    this->splineWindow = 8;
+    this->index_a = SIZE_MAX;
+    this->splineStart = SIZE_MAX;
+    this->splineT0 = 0;
 
     return;
 }
@@ -43,8 +49,8 @@ WaypointReference::WaypointReference()
 WaypointReference::~WaypointReference()
 {
     /* close the data file if it is open */
-    if(this->fileHandle->is_open()) {
-        this->fileHandle->close();
+    if(this->waypoints.isOpen()) {
+        this->waypoints.close();
         bskLogger.bskLog(BSK_INFORMATION, "WaypointReference:\nclosed the file: %s.", this->dataFileName.c_str());
     }
 
@@ -52,7 +58,8 @@ WaypointReference::~WaypointReference()
 }
 
 
-/*! A Reset method to put the module back into a clean state
+/*! A Reset method to put the module back into a clean state.  The data file is memory mapped and indexed by time,
+ so that the module can be reset to and evaluated at any simulation time.
  @param CurrentSimNanos The current sim time in nanoseconds
  */
 void WaypointReference::Reset(uint64_t CurrentSimNanos)
@@ -60,25 +67,25 @@ void WaypointReference::Reset(uint64_t CurrentSimNanos)
     if (this->dataFileName.length() == 0) {
         bskLogger.bskLog(BSK_ERROR, "WaypointReference: dataFileName must be an non-empty string.");
     }
+    if (this->interpolationOrder != 1 && (this->interpolationOrder < 3 || this->interpolationOrder > 5)) {
+        bskLogger.bskLog(BSK_ERROR, "WaypointReference: interpolationOrder must be 1 (linear) or between 3 and 5 (BSpline).");
+    }
 
-    /* open the data file*/
-    this->fileHandle = new std::ifstream(this->dataFileName);
-    if (this->fileHandle->fail()) {
+    /* map and index the data file */
+    if (!this->waypoints.open(this->dataFileName, this->headerLines, *this->delimiter.c_str())) {
         bskLogger.bskLog(BSK_ERROR, "WaypointReference: was not able to load the file %s.", this->dataFileName.c_str());
+        return;
     }
-
-	/* read and bypass header line(s) */
-	int count = 0;
-	std::string line;
-    while (count < this->headerLines) {
-		count += 1;
-        getline(*this->fileHandle, line);
+    if (this->waypoints.size() == 0) {
+        bskLogger.bskLog(BSK_WARNING, "WaypointReference: the file %s does not contain any waypoint.", this->dataFileName.c_str());
     }
 
-    /* Pull first line of dataFileName and stores relative time and attitude in this->t_a and this->attRefMsg_a */
-	pullDataLine(&this->t_a, &this->attRefMsg_a);
-	/* Pull first line of dataFileName and stores relative time and attitude in this->t_b and this->attRefMsg_b */
-	pullDataLine(&this->t_b, &this->attRefMsg_b);
+    /* invalidate the cached waypoint interval and BSpline window */
+    this->index_a = SIZE_MAX;
+    this->splineStart = SIZE_MAX;
+    if (this->waypoints.size() > 0) {
+        this->loadInterval(0);
+    }
  
     bskLogger.bskLog(BSK_INFORMATION, "WaypointReference:\nloaded the file: %s.", this->dataFileName.c_str());
 
@@ -92,10 +99,7 @@ void WaypointReference::Reset(uint64_t CurrentSimNanos)
 void WaypointReference::UpdateState(uint64_t CurrentSimNanos)
 {
     /* ensure that a file was opened */
-    if (this->fileHandle->is_open()) {
-        /* read in next line*/
-        std::string line;
-		
+    if (this->waypoints.isOpen()) {
 	    /* create the attitude output message buffer */
 		AttRefMsgPayload attMsgBuffer;
 		
@@ -104,42 +108,52 @@ void WaypointReference::UpdateState(uint64_t CurrentSimNanos)
 		
 		/* current time */
 		uint64_t t =  CurrentSimNanos;
-		
-		/* for CurrentTime < t_0 hold initial attitude with zero angular rates and accelerations */
-		if (t < this->t_a) {
-			v3Copy(this->attRefMsg_a.sigma_RN, attMsgBuffer.sigma_RN);
-		}
-	    else {
-			/* while CurrentTime > t_b read next line and update t_a, t_b, attRefMsg_a and attRefMsg_b */
-			while (t > this->t_b && this->endOfFile == false) {
-				this->t_a = this->t_b;
-			    this->attRefMsg_a = this->attRefMsg_b;
-				pullDataLine(&this->t_b, &this->attRefMsg_b);
-			}
-			/* if t_a <= CurrentTime <= t_b interpolate between attRefMsg_a and attRefMsg_b */
-			if (t >= this->t_a && t <= this->t_b) {
-				/* check the norm of the MRP difference between two consecutive waypoints */
-				double deltaSigma[3];
-			    v3Subtract(this->attRefMsg_b.sigma_RN, this->attRefMsg_a.sigma_RN, deltaSigma);
-                double normDeltaSigma = v3Norm(deltaSigma);
-				/* if norm <= 1 interpolate between waypoints */
-				if (normDeltaSigma <= 1) {
-					linearInterpolation(this->t_a, this->attRefMsg_a.sigma_RN, this->t_b, this->attRefMsg_b.sigma_RN, t, &attMsgBuffer.sigma_RN[0]);
-				}
-				/* if norm > 1 interpolate between waypoint a and shadow set of waypoint b */
-				else {
-					double sigma_RN_b_S[3];
-                    MRPshadow(this->attRefMsg_b.sigma_RN, sigma_RN_b_S);
-					linearInterpolation(this->t_a, this->attRefMsg_a.sigma_RN, this->t_b, sigma_RN_b_S, t, &attMsgBuffer.sigma_RN[0]);
-				}
-                linearInterpolation(this->t_a, this->attRefMsg_a.omega_RN_N, this->t_b, this->attRefMsg_b.omega_RN_N, t, &attMsgBuffer.omega_RN_N[0]);
-                linearInterpolation(this->t_a, this->attRefMsg_a.domega_RN_N, this->t_b, this->attRefMsg_b.domega_RN_N, t, &attMsgBuffer.domega_RN_N[0]);
-			}
-		}
-		/* for CurrentTime > t_b and t_b is the last time step in file, hold final attitude with zero angular rates and accelerations */
-		if (t > this->t_b && this->endOfFile == true) {
-			v3Copy(this->attRefMsg_b.sigma_RN, attMsgBuffer.sigma_RN);
-		}
+        size_t numWaypoints = this->waypoints.size();
+
+        if (numWaypoints > 0) {
+            /* for CurrentTime < t_0 hold initial attitude with zero angular rates and accelerations */
+            if (t < this->waypoints.time(0) || numWaypoints == 1) {
+                this->loadInterval(0);
+                v3Copy(this->attRefMsg_a.sigma_RN, attMsgBuffer.sigma_RN);
+            }
+            /* for CurrentTime > t_N hold final attitude with zero angular rates and accelerations */
+            else if (t > this->waypoints.time(numWaypoints - 1)) {
+                this->loadInterval(numWaypoints - 2);
+                v3Copy(this->attRefMsg_b.sigma_RN, attMsgBuffer.sigma_RN);
+            }
+            else {
+                /* binary search for the waypoint interval such that t_a < CurrentTime <= t_b */
+                size_t index_b = this->waypoints.lowerBound(t);
+                size_t index = (index_b == 0) ? 0 : index_b - 1;
+                this->loadInterval(index);
+
+                if (this->t_b == this->t_a) {
+                    attMsgBuffer = this->attRefMsg_a;
+                }
+                else if (this->interpolationOrder > 1) {
+                    this->splineInterpolation(index, t, &attMsgBuffer);
+                }
+                else {
+                    /* if t_a <= CurrentTime <= t_b interpolate between attRefMsg_a and attRefMsg_b */
+                    /* check the norm of the MRP difference between two consecutive waypoints */
+                    double deltaSigma[3];
+                    v3Subtract(this->attRefMsg_b.sigma_RN, this->attRefMsg_a.sigma_RN, deltaSigma);
+                    double normDeltaSigma = v3Norm(deltaSigma);
+                    /* if norm <= 1 interpolate between waypoints */
+                    if (normDeltaSigma <= 1) {
+                        linearInterpolation(this->t_a, this->attRefMsg_a.sigma_RN, this->t_b, this->attRefMsg_b.sigma_RN, t, &attMsgBuffer.sigma_RN[0]);
+                    }
+                    /* if norm > 1 interpolate between waypoint a and shadow set of waypoint b */
+                    else {
+                        double sigma_RN_b_S[3];
+                        MRPshadow(this->attRefMsg_b.sigma_RN, sigma_RN_b_S);
+                        linearInterpolation(this->t_a, this->attRefMsg_a.sigma_RN, this->t_b, sigma_RN_b_S, t, &attMsgBuffer.sigma_RN[0]);
+                    }
+                    linearInterpolation(this->t_a, this->attRefMsg_a.omega_RN_N, this->t_b, this->attRefMsg_b.omega_RN_N, t, &attMsgBuffer.omega_RN_N[0]);
+                    linearInterpolation(this->t_a, this->attRefMsg_a.domega_RN_N, this->t_b, this->attRefMsg_b.domega_RN_N, t, &attMsgBuffer.domega_RN_N[0]);
+                }
+            }
+        }
 	
 		/* write output attitude reference message */
         this->attRefOutMsg.write(&attMsgBuffer, this->moduleID, CurrentSimNanos);
@@ -148,92 +162,182 @@ void WaypointReference::UpdateState(uint64_t CurrentSimNanos)
     return;
 }
 
+/*! Return the number of waypoints indexed in the data file
+ @return number of waypoints
+ */
+size_t WaypointReference::getNumberOfWaypoints() const
+{
+    return this->waypoints.size();
+}
+
+/*! Make the waypoints index and index+1 the current interpolation interval.  Only the records that are not
+ already cached are parsed from the mapped file.
+ @param index index of the first waypoint of the interval
+ */
+void WaypointReference::loadInterval(size_t index)
+{
+    if (index == this->index_a) {
+        return;
+    }
+    size_t index_b = std::min(index + 1, this->waypoints.size() - 1);
+    if (this->index_a != SIZE_MAX && index == this->index_a + 1) {
+        /* stepping forward by one interval, so the previous waypoint b becomes waypoint a */
+        this->t_a = this->t_b;
+        this->attRefMsg_a = this->attRefMsg_b;
+    }
+    else {
+        pullDataLine(index, &this->t_a, &this->attRefMsg_a);
+    }
+    pullDataLine(index_b, &this->t_b, &this->attRefMsg_b);
+    this->index_a = index;
+}
 
-/*! Pull one line of dataFileName and stores time t and relative attitude in attRefMsg_t */
-void WaypointReference::pullDataLine(uint64_t *t, AttRefMsgPayload *attRefMsg_t)
+/*! Evaluate a BSpline of degree interpolationOrder fitted through a window of splineWindow waypoints that surrounds
+ the current interval.  The fit is cached and only recomputed when the window moves.
+ @param index index of the first waypoint of the current interval
+ @param t [ns] current time
+ @param attRefMsg_t interpolated attitude reference
+ */
+void WaypointReference::splineInterpolation(size_t index, uint64_t t, AttRefMsgPayload *attRefMsg_t)
+{
+    size_t numWaypoints = this->waypoints.size();
+    size_t window = (size_t) std::max(this->splineWindow, this->interpolationOrder + 1);
+    window = std::min(window, numWaypoints);
+    int degree = std::min(this->interpolationOrder, (int) window - 1);
+
+    /* center the window on the current interval */
+    size_t start = (index + 1 > window / 2) ? index + 1 - window / 2 : 0;
+    start = std::min(start, numWaypoints - window);
+
+    if (start != this->splineStart) {
+        Eigen::VectorXd T(window);
+        Eigen::VectorXd S1(window), S2(window), S3(window);
+        Eigen::VectorXd W1(window), W2(window), W3(window);
+        Eigen::VectorXd D1(window), D2(window), D3(window);
+        double sigmaPrev[3];
+        for (size_t k = 0; k < window; k++) {
+            uint64_t t_k;
+            AttRefMsgPayload att_k;
+            pullDataLine(start + k, &t_k, &att_k);
+            if (k == 0) {
+                this->splineT0 = t_k;
+            }
+            /* keep the attitude description continuous across the window by switching to the shadow set when needed */
+            if (k > 0) {
+                double deltaSigma[3];
+                v3Subtract(att_k.sigma_RN, sigmaPrev, deltaSigma);
+                if (v3Norm(deltaSigma) > 1) {
+                    MRPshadow(att_k.sigma_RN, att_k.sigma_RN);
+                }
+            }
+            v3Copy(att_k.sigma_RN, sigmaPrev);
+            T[k] = (t_k - this->splineT0) * NANO2SEC;
+            S1[k] = att_k.sigma_RN[0];  S2[k] = att_k.sigma_RN[1];  S3[k] = att_k.sigma_RN[2];
+            W1[k] = att_k.omega_RN_N[0];  W2[k] = att_k.omega_RN_N[1];  W3[k] = att_k.omega_RN_N[2];
+            D1[k] = att_k.domega_RN_N[0];  D2[k] = att_k.domega_RN_N[1];  D3[k] = att_k.domega_RN_N[2];
+        }
+        InputDataSet sigmaInput(S1, S2, S3);
+        sigmaInput.setT(T);
+        interpolate(sigmaInput, 2, degree, &this->splineSigma);
+        InputDataSet omegaInput(W1, W2, W3);
+        omegaInput.setT(T);
+        interpolate(omegaInput, 2, degree, &this->splineOmega);
+        InputDataSet omegaDotInput(D1, D2, D3);
+        omegaDotInput.setT(T);
+        interpolate(omegaDotInput, 2, degree, &this->splineOmegaDot);
+        this->splineStart = start;
+    }
+
+    double tau = (t - this->splineT0) * NANO2SEC;
+    double xDot[3], xDDot[3];
+    this->splineSigma.getData(tau, attRefMsg_t->sigma_RN, xDot, xDDot);
+    this->splineOmega.getData(tau, attRefMsg_t->omega_RN_N, xDot, xDDot);
+    this->splineOmegaDot.getData(tau, attRefMsg_t->domega_RN_N, xDot, xDDot);
+    /* map the interpolated attitude back to the short rotation set */
+    if (v3Norm(attRefMsg_t->sigma_RN) > 1) {
+        MRPshadow(attRefMsg_t->sigma_RN, attRefMsg_t->sigma_RN);
+    }
+}
+
+
+/*! Parse the waypoint at position index of dataFileName and stores time t and relative attitude in attRefMsg_t */
+void WaypointReference::pullDataLine(size_t index, uint64_t *t, AttRefMsgPayload *attRefMsg_t)
 {   
-    std::string line;
+    std::string line = this->waypoints.record(index);
 	
-	/* read in next line, if line is not empty, stores the information ;
-	   if line is empty, switches this_endOfFile to true */
-	if (getline(*this->fileHandle, line)) {
-		std::istringstream iss(line);
-		
-		*attRefMsg_t = this->attRefOutMsg.zeroMsgPayload;
+	std::istringstream iss(line);
+	
+	*attRefMsg_t = this->attRefOutMsg.zeroMsgPayload;
 
-        /* pull time, this is not used in the BSK msg */
-        *t = (uint64_t) (pullScalar(&iss) * SEC2NANO);
+    /* pull time, this is not used in the BSK msg */
+    *t = (uint64_t) (pullScalar(&iss) * SEC2NANO);
+	
+	/* get inertial attitude of reference frame R with respect to N and store in msg */
+	double attNorm;
+	double att3[3];
+	double att4[4];
+	double att4Norm[4];
+	switch (this->attitudeType) {
+		case 0:
+		    /* 3D attitude coordinate set */
+			/* if MRP norm <= 1 save the MRP set immediately,
+			   if not map to the shadow set and saves the shadow set */
+            pullVector(&iss, att3);
+			attNorm = v3Norm(att3);
+			if (attNorm <= 1) {
+				v3Copy(att3, attRefMsg_t->sigma_RN);
+			}
+			else {
+				MRPshadow(att3, attRefMsg_t->sigma_RN);
+			}
+			break;
+		case 1:
+		    /* 4D attitude coordinate set (q0, q1, q2, q3) */
+            pullVector4(&iss, att4);
+			vNormalize(att4, 4, att4Norm);
+			EP2MRP(att4Norm, attRefMsg_t->sigma_RN);
+			break;
+		case 2:
+		    /* 4D attitude coordinate set (q1, q2, q3, qs) */
+		    double attBuffer[4];
+            pullVector4(&iss, attBuffer);
+			att4[0] = attBuffer[3];
+			att4[1] = attBuffer[0];
+			att4[2] = attBuffer[1];
+			att4[3] = attBuffer[2];
+			vNormalize(att4, 4, att4Norm);
+			EP2MRP(att4Norm, attRefMsg_t->sigma_RN);
+			break;
+		default:
+		    bskLogger.bskLog(BSK_ERROR, "WaypointReference: the attitude type provided is invalid.");
+	}
+
+	if (this->useReferenceFrame == false) {
+		/* get inertial angular rates in inertial frame components and store them in msg */
+	    pullVector(&iss, attRefMsg_t->omega_RN_N);
+		
+		/* get inertial angular accelerations in inertial frame components and store them in msg */
+	    pullVector(&iss, attRefMsg_t->domega_RN_N);
+		
+	}
+	else {
+		/* get inertial angular rates in reference frame components */
+		double omega_RN_R[3];
+	    pullVector(&iss, omega_RN_R);
+		
+		/* get inertial angular accelerations in reference frame components */
+		double omegaDot_RN_R[3];
+	    pullVector(&iss, omegaDot_RN_R);
+		
+		/* compute direction cosine matrix [RN] */
+		double RN[3][3];
+	    MRP2C(attRefMsg_t->sigma_RN, RN);
+		
+		/* change angular rates and accelerations to inertial frame and stores them in msg */
+		v3tMultM33(omega_RN_R, RN, attRefMsg_t->omega_RN_N);
+	    v3tMultM33(omegaDot_RN_R, RN, attRefMsg_t->domega_RN_N);
+	}
 		
-		/* get inertial attitude of reference frame R with respect to N and store in msg */
-		double attNorm;
-		double att3[3];
-		double att4[4];
-		double att4Norm[4];
-		switch (this->attitudeType) {
-			case 0:
-			    /* 3D attitude coordinate set */
-				/* if MRP norm <= 1 save the MRP set immediately,
-				   if not map to the shadow set and saves the shadow set */
-                pullVector(&iss, att3);
-				attNorm = v3Norm(att3);
-				if (attNorm <= 1) {
-					v3Copy(att3, attRefMsg_t->sigma_RN);
-				}
-				else {
-					MRPshadow(att3, attRefMsg_t->sigma_RN);
-				}
-				break;
-			case 1:
-			    /* 4D attitude coordinate set (q0, q1, q2, q3) */
-                pullVector4(&iss, att4);
-				vNormalize(att4, 4, att4Norm);
-				EP2MRP(att4Norm, attRefMsg_t->sigma_RN);
-				break;
-			case 2:
-			    /* 4D attitude coordinate set (q1, q2, q3, qs) */
-			    double attBuffer[4];
-                pullVector4(&iss, attBuffer);
-				att4[0] = attBuffer[3];
-				att4[1] = attBuffer[0];
-				att4[2] = attBuffer[1];
-				att4[3] = attBuffer[2];
-				vNormalize(att4, 4, att4Norm);
-				EP2MRP(att4Norm, attRefMsg_t->sigma_RN);
-				break;
-			default:
-			    bskLogger.bskLog(BSK_ERROR, "WaypointReference: the attitude type provided is invalid.");
-		}
-
-		if (this->useReferenceFrame == false) {
-			/* get inertial angular rates in inertial frame components and store them in msg */
-		    pullVector(&iss, attRefMsg_t->omega_RN_N);
-			
-			/* get inertial angular accelerations in inertial frame components and store them in msg */
-		    pullVector(&iss, attRefMsg_t->domega_RN_N);
-			
-		}
-		else {
-			/* get inertial angular rates in reference frame components */
-			double omega_RN_R[3];
-		    pullVector(&iss, omega_RN_R);
-			
-			/* get inertial angular accelerations in reference frame components */
-			double omegaDot_RN_R[3];
-		    pullVector(&iss, omegaDot_RN_R);
-			
-			/* compute direction cosine matrix [RN] */
-			double RN[3][3];
-		    MRP2C(attRefMsg_t->sigma_RN, RN);
-			
-			/* change angular rates and accelerations to inertial frame and stores them in msg */
-			v3tMultM33(omega_RN_R, RN, attRefMsg_t->omega_RN_N);
-		    v3tMultM33(omegaDot_RN_R, RN, attRefMsg_t->domega_RN_N);
-		}
-			
-    } else {
-        bskLogger.bskLog(BSK_INFORMATION, "WaypointReference: reached end of file.");
-		this->endOfFile = true;
-    }
 }
 
 
@@ -24,8 +24,10 @@
 #include "architecture/msgPayloadDefC/AttRefMsgPayload.h"
 #include "architecture/utilities/bskLogging.h"
 #include "architecture/messaging/messaging.h"
+#include "architecture/utilities/BSpline.h"
+#include "fswAlgorithms/attGuidance/waypointReference/waypointStore.h"
 #include <iostream>
-#include <fstream>
+#include <sstream>
 
 /*! @brief waypoint reference module class */
 class WaypointReference: public SysModel {
@@ -34,6 +36,7 @@ public:
     ~WaypointReference(); 
     void Reset(uint64_t CurrentSimNanos);
     void UpdateState(uint64_t CurrentSimNanos);
+    size_t getNumberOfWaypoints() const;
 
 
 public:
@@ -42,22 +45,31 @@ public:
     int headerLines;                            //!< Number of header lines in the file, defaulted to 0
     int attitudeType;                           //!< 0 - MRP, 1 - EP or quaternions (q0, q1, q2, q3), 2 - EP or quaternions (q1, q2, q3, qs)
 	bool useReferenceFrame;                     //!< if true: angular rates and accelerations in the file are expressed in the reference frame; defaulted to false
+    int interpolationOrder;                     //!< 1 - linear interpolation (default), 3 to 5 - BSpline interpolation of this degree
+    int splineWindow;                           //!< number of waypoints around the current time used by the BSpline interpolation, defaulted to 8
     Message<AttRefMsgPayload> attRefOutMsg;     //!< attitude reference output msg
 
     BSKLogger bskLogger;                        //!< -- BSK Logging
 
 
 private:
-    std::ifstream *fileHandle;                                     //!< pointer to the file that is to be read
-	bool endOfFile;                                                //!< boolean that indicates if the last line of file has been reached
+    WaypointStore waypoints;                                       //!< memory-mapped and time-indexed waypoint file
     double pullScalar(std::istringstream *iss);                    
     void pullVector(std::istringstream *iss, double *);            
     void pullVector4(std::istringstream *iss, double *);   
-	void pullDataLine(uint64_t *t, AttRefMsgPayload *attRefMsg_t);
+	void pullDataLine(size_t index, uint64_t *t, AttRefMsgPayload *attRefMsg_t);
+    void loadInterval(size_t index);
+    void splineInterpolation(size_t index, uint64_t t, AttRefMsgPayload *attRefMsg_t);
+    size_t index_a;                                                //!< index of the waypoint at time t_a
     uint64_t t_a;                                                  //!< [ns] time t_a in the data file
     uint64_t t_b;                                                  //!< [ns] time t_b in the data file
     AttRefMsgPayload attRefMsg_a;                                  //!< attitude at time t_a
     AttRefMsgPayload attRefMsg_b;                                  //!< attitude at time t_b	
+    size_t splineStart;                                            //!< index of the first waypoint of the current BSpline window
+    uint64_t splineT0;                                             //!< [ns] time of the first waypoint of the current BSpline window
+    OutputDataSet splineSigma;                                     //!< BSpline fit of the attitude over the current window
+    OutputDataSet splineOmega;                                     //!< BSpline fit of the angular rate over the current window
+    OutputDataSet splineOmegaDot;                                  //!< BSpline fit of the angular acceleration over the current window
 	void linearInterpolation(uint64_t t_a, double v_a[3], uint64_t t_b, double v_b[3], uint64_t t, double *v);
 
 };
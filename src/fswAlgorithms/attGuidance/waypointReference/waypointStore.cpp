@@ -0,0 +1,228 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "fswAlgorithms/attGuidance/waypointReference/waypointStore.h"
+#include "architecture/utilities/macroDefinitions.h"
+#include <algorithm>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*! The constructor creates an empty, closed store */
+WaypointStore::WaypointStore()
+{
+    this->data = nullptr;
+    this->dataSize = 0;
+#ifdef _WIN32
+    this->fileHandle = nullptr;
+    this->mapHandle = nullptr;
+#else
+    this->fileDescriptor = -1;
+#endif
+}
+
+/*! The destructor releases the file mapping */
+WaypointStore::~WaypointStore()
+{
+    this->close();
+}
+
+/*! Map a waypoint file into memory and index its records
+    @return true if the file could be mapped
+    @param fileName path of the waypoint file
+    @param headerLines number of leading lines that are skipped
+    @param delimiter character that terminates the time tag of each record
+ */
+bool WaypointStore::open(const std::string &fileName, int headerLines, char delimiter)
+{
+    this->close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        CloseHandle(file);
+        return false;
+    }
+    this->fileHandle = file;
+    this->dataSize = (size_t) fileSize.QuadPart;
+    if (this->dataSize > 0) {
+        HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL) {
+            this->close();
+            return false;
+        }
+        this->mapHandle = mapping;
+        this->data = (const char *) MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (this->data == nullptr) {
+            this->close();
+            return false;
+        }
+    }
+#else
+    this->fileDescriptor = ::open(fileName.c_str(), O_RDONLY);
+    if (this->fileDescriptor < 0) {
+        return false;
+    }
+    struct stat fileStat;
+    if (fstat(this->fileDescriptor, &fileStat) != 0) {
+        this->close();
+        return false;
+    }
+    this->dataSize = (size_t) fileStat.st_size;
+    if (this->dataSize > 0) {
+        void *mapped = mmap(nullptr, this->dataSize, PROT_READ, MAP_PRIVATE, this->fileDescriptor, 0);
+        if (mapped == MAP_FAILED) {
+            this->close();
+            return false;
+        }
+        /* the index is built with a single forward pass, later lookups are random */
+        madvise(mapped, this->dataSize, MADV_SEQUENTIAL);
+        this->data = (const char *) mapped;
+    }
+#endif
+
+    this->buildIndex(headerLines, delimiter);
+#ifndef _WIN32
+    if (this->data != nullptr) {
+        madvise((void *) this->data, this->dataSize, MADV_RANDOM);
+    }
+#endif
+    return true;
+}
+
+/*! Release the file mapping and clear the record index */
+void WaypointStore::close()
+{
+#ifdef _WIN32
+    if (this->data != nullptr) {
+        UnmapViewOfFile(this->data);
+    }
+    if (this->mapHandle != nullptr) {
+        CloseHandle((HANDLE) this->mapHandle);
+        this->mapHandle = nullptr;
+    }
+    if (this->fileHandle != nullptr) {
+        CloseHandle((HANDLE) this->fileHandle);
+        this->fileHandle = nullptr;
+    }
+#else
+    if (this->data != nullptr) {
+        munmap((void *) this->data, this->dataSize);
+    }
+    if (this->fileDescriptor >= 0) {
+        ::close(this->fileDescriptor);
+        this->fileDescriptor = -1;
+    }
+#endif
+    this->data = nullptr;
+    this->dataSize = 0;
+    this->recordStart.clear();
+    this->recordLength.clear();
+    this->recordTime.clear();
+}
+
+/*! @return true if a file is currently mapped */
+bool WaypointStore::isOpen() const
+{
+#ifdef _WIN32
+    return this->fileHandle != nullptr;
+#else
+    return this->fileDescriptor >= 0;
+#endif
+}
+
+/*! @return number of indexed records */
+size_t WaypointStore::size() const
+{
+    return this->recordTime.size();
+}
+
+/*! @return [ns] time tag of a record
+    @param index record index
+ */
+uint64_t WaypointStore::time(size_t index) const
+{
+    return this->recordTime[index];
+}
+
+/*! @return text of a record, without the line terminator
+    @param index record index
+ */
+std::string WaypointStore::record(size_t index) const
+{
+    return std::string(this->data + this->recordStart[index], this->recordLength[index]);
+}
+
+/*! @return index of the first record whose time tag is not smaller than t, or size() if there is none
+    @param t [ns] search time
+ */
+size_t WaypointStore::lowerBound(uint64_t t) const
+{
+    return (size_t) (std::lower_bound(this->recordTime.begin(), this->recordTime.end(), t)
+                     - this->recordTime.begin());
+}
+
+/*! Scan the mapped file once, storing the offset, length and time tag of every non-empty record */
+void WaypointStore::buildIndex(int headerLines, char delimiter)
+{
+    size_t pos = 0;
+    int lineCount = 0;
+    char timeBuffer[64];
+
+    while (pos < this->dataSize) {
+        const char *lineBegin = this->data + pos;
+        const char *lineEnd = (const char *) memchr(lineBegin, '\n', this->dataSize - pos);
+        size_t next = (lineEnd == nullptr) ? this->dataSize : (size_t) (lineEnd - this->data) + 1;
+        size_t length = (lineEnd == nullptr) ? this->dataSize - pos : (size_t) (lineEnd - lineBegin);
+        if (length > 0 && lineBegin[length - 1] == '\r') {
+            length -= 1;
+        }
+
+        lineCount += 1;
+        if (lineCount > headerLines && length > 0) {
+            /* the time tag is the first field; copy it so that parsing never runs past the mapping */
+            const char *fieldEnd = (const char *) memchr(lineBegin, delimiter, length);
+            size_t fieldLength = (fieldEnd == nullptr) ? length : (size_t) (fieldEnd - lineBegin);
+            fieldLength = std::min(fieldLength, sizeof(timeBuffer) - 1);
+            memcpy(timeBuffer, lineBegin, fieldLength);
+            timeBuffer[fieldLength] = '\0';
+            char *parseEnd;
+            double timeSec = strtod(timeBuffer, &parseEnd);
+            if (parseEnd != timeBuffer) {
+                this->recordStart.push_back(pos);
+                this->recordLength.push_back(length);
+                this->recordTime.push_back((uint64_t) (timeSec * SEC2NANO));
+            }
+        }
+        pos = next;
+    }
+}
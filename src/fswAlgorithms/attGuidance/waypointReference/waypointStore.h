@@ -0,0 +1,67 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef WAYPOINTSTORE_H
+#define WAYPOINTSTORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+/*! @brief Read-only, memory-mapped store of time-tagged text waypoints.
+
+    The file is mapped once and scanned a single time to build an index of the record offsets and their time tags.
+    The remaining fields of a record are only parsed when the record is requested, so the memory footprint is
+    independent of the record length and arbitrarily large files can be searched by time in logarithmic time.
+ */
+class WaypointStore {
+public:
+    WaypointStore();
+    ~WaypointStore();
+
+    bool open(const std::string &fileName, int headerLines, char delimiter);
+    void close();
+    bool isOpen() const;
+
+    size_t size() const;
+    uint64_t time(size_t index) const;
+    std::string record(size_t index) const;
+    size_t lowerBound(uint64_t t) const;
+
+private:
+    WaypointStore(const WaypointStore &);
+    WaypointStore &operator=(const WaypointStore &);
+
+    void buildIndex(int headerLines, char delimiter);
+
+    const char *data;                       //!< start of the mapped file contents
+    size_t dataSize;                        //!< [bytes] size of the mapped file
+    std::vector<size_t> recordStart;        //!< offset of the first character of each record
+    std::vector<size_t> recordLength;       //!< number of characters of each record, line terminator excluded
+    std::vector<uint64_t> recordTime;       //!< [ns] time tag of each record
+#ifdef _WIN32
+    void *fileHandle;                       //!< Windows file handle
+    void *mapHandle;                        //!< Windows file mapping handle
+#else
+    int fileDescriptor;                     //!< POSIX file descriptor
+#endif
+};
+
+#endif
@@ -0,0 +1,92 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import numpy as np
+import pytest
+from Basilisk.architecture import messaging
+from Basilisk.simulation import boreAngCalc
+from Basilisk.simulation import boreAngCalcArray
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def spacecraftStates():
+    rng = np.random.default_rng(0)
+    states = []
+    for _ in range(6):
+        payload = messaging.SCStatesMsgPayload()
+        payload.r_BN_N = rng.normal(0.0, 7.0e6, 3)
+        payload.v_BN_N = rng.normal(0.0, 7.0e3, 3)
+        payload.sigma_BN = rng.uniform(-0.5, 0.5, 3)
+        states.append((payload, rng.normal(0.0, 1.0, 3)))
+    return states
+
+
+@pytest.mark.parametrize("celestial", [True, False])
+def test_boreAngCalcArray(celestial):
+    """The array module matches one boreAngCalc module per spacecraft"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(1.0)))
+
+    planet = messaging.SpicePlanetStateMsgPayload()
+    planet.PositionVector = [1.0e8, -2.0e8, 3.0e7]
+    planet.VelocityVector = [1.0e3, 2.0e3, -5.0e2]
+    planetMsg = messaging.SpicePlanetStateMsg().write(planet)
+    heading_N = np.array([0.2, -0.5, 0.8]) / np.linalg.norm([0.2, -0.5, 0.8])
+
+    boreArray = boreAngCalcArray.BoreAngCalcArray()
+    boreArray.ModelTag = "boreAngCalcArray"
+    if celestial:
+        boreArray.celBodyInMsg.subscribeTo(planetMsg)
+    else:
+        boreArray.inertialHeadingVec_N = heading_N
+    scSim.AddModelToTask("task", boreArray)
+
+    stateMsgs = []
+    singleLogs = []
+    for payload, boreVec_B in spacecraftStates():
+        stateMsgs.append(messaging.SCStatesMsg().write(payload))
+        boreArray.addSpacecraft(stateMsgs[-1], boreVec_B)
+
+        single = boreAngCalc.BoreAngCalc()
+        single.scStateInMsg.subscribeTo(stateMsgs[-1])
+        single.boreVec_B = boreVec_B / np.linalg.norm(boreVec_B)
+        if celestial:
+            single.celBodyInMsg.subscribeTo(planetMsg)
+        else:
+            single.inertialHeadingVec_N = heading_N
+        scSim.AddModelToTask("task", single)
+        singleLogs.append(single.angOutMsg.recorder())
+        scSim.AddModelToTask("task", singleLogs[-1])
+        stateMsgs.append(single)
+
+    arrayLog = boreArray.angOutMsg.recorder()
+    scSim.AddModelToTask("task", arrayLog)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(1.0))
+    scSim.ExecuteSimulation()
+
+    np.testing.assert_array_equal(arrayLog.numSc, len(singleLogs))
+    for c, log in enumerate(singleLogs):
+        np.testing.assert_allclose(arrayLog.missAngle[:, c], log.missAngle, atol=1e-12)
+        np.testing.assert_allclose(arrayLog.azimuth[:, c], log.azimuth, atol=1e-12)
+
+
+if __name__ == "__main__":
+    test_boreAngCalcArray(True)
@@ -0,0 +1,135 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "simulation/dynamics/DynOutput/boreAngCalcArray/boreAngCalcArray.h"
+#include "architecture/utilities/linearAlgebra.h"
+#include "architecture/utilities/avsEigenMRP.h"
+#include "architecture/utilities/avsEigenSupport.h"
+
+//! The constructor
+BoreAngCalcArray::BoreAngCalcArray()
+{
+    this->inertialHeadingVec_N.setZero();
+    this->localPlanet = this->celBodyInMsg.zeroMsgPayload;
+}
+
+//! The destructor
+BoreAngCalcArray::~BoreAngCalcArray() = default;
+
+/*! This method is used to reset the module.
+ @return void
+ @param CurrentSimNanos The current simulation time in nanoseconds
+ */
+void BoreAngCalcArray::Reset(uint64_t CurrentSimNanos)
+{
+    if (this->scStateInMsgs.size() == 0) {
+        bskLogger.bskLog(BSK_ERROR, "boreAngCalcArray: no spacecraft was added with addSpacecraft().");
+    }
+
+    this->useCelestialHeading = this->celBodyInMsg.isLinked();
+    if (!this->useCelestialHeading && this->inertialHeadingVec_N.norm() <= 1e-8) {
+        bskLogger.bskLog(BSK_ERROR, "Either boreAngCalcArray.celBodyInMsg was not linked or boreAngCalcArray.inertialHeadingVec_N was not set.");
+    }
+}
+
+/*! This method adds a spacecraft and the boresight vector of its structure.  Its angles are stored at the
+ index of the spacecraft in the output message, in the order the spacecraft are added.
+ @return void
+ @param scStateMsg spacecraft state message
+ @param boreVec_B boresight unit vector in the body frame of the spacecraft
+ */
+void BoreAngCalcArray::addSpacecraft(Message<SCStatesMsgPayload> *scStateMsg, Eigen::Vector3d boreVec_B)
+{
+    if (this->scStateInMsgs.size() >= MAX_SC_CNT) {
+        bskLogger.bskLog(BSK_ERROR, "boreAngCalcArray: cannot add more than %d spacecraft.", MAX_SC_CNT);
+        return;
+    }
+    this->scStateInMsgs.push_back(scStateMsg->addSubscriber());
+    this->boreVecs_B.push_back(boreVec_B.normalized());
+}
+
+/*! This method computes the miss and azimuth angles of a boresight relative to the celestial body.  The angles
+ are those of the boresight in the frame pointing from the spacecraft to the body, see boreAngCalc.
+ */
+void BoreAngCalcArray::computeCelestialAngles(const SCStatesMsgPayload &state, const Eigen::Vector3d &boreVec_B,
+                                              double *azimuth, double *missAngle)
+{
+    double eps = 1e-10;
+    Eigen::Vector3d r_PB_N = cArray2EigenVector3d(this->localPlanet.PositionVector)
+                             - cArray2EigenVector3d((double *) state.r_BN_N);
+    Eigen::Vector3d v_PB_N = cArray2EigenVector3d(this->localPlanet.VelocityVector)
+                             - cArray2EigenVector3d((double *) state.v_BN_N);
+    Eigen::Vector3d rHat_PB_N = r_PB_N.normalized();
+    Eigen::Vector3d secHat_N = r_PB_N.cross(v_PB_N).normalized();
+
+    Eigen::Matrix3d dcm_PoN;
+    dcm_PoN.row(0) = rHat_PB_N.transpose();
+    dcm_PoN.row(2) = rHat_PB_N.cross(secHat_N).normalized();
+    dcm_PoN.row(1) = dcm_PoN.row(2).cross(dcm_PoN.row(0));
+
+    Eigen::MRPd sigma_BN = cArray2EigenMRPd((double *) state.sigma_BN);
+    Eigen::Matrix3d dcm_BN = sigma_BN.toRotationMatrix().transpose();
+    Eigen::Vector3d boreVec_Po = dcm_PoN * dcm_BN.transpose() * boreVec_B;
+
+    *missAngle = fabs(safeAcos(boreVec_Po(0)));
+    *azimuth = fabs(boreVec_Po(1)) < eps ? 0.0 : atan2(boreVec_Po(2), boreVec_Po(1));
+}
+
+/*! This method computes the miss angle of a boresight relative to the inertial heading, the azimuth is
+ undefined and set to zero.
+ */
+void BoreAngCalcArray::computeInertialAngles(const SCStatesMsgPayload &state, const Eigen::Vector3d &boreVec_B,
+                                             double *azimuth, double *missAngle)
+{
+    Eigen::MRPd sigma_BN = cArray2EigenMRPd((double *) state.sigma_BN);
+    Eigen::Matrix3d dcm_BN = sigma_BN.toRotationMatrix().transpose();
+    *missAngle = fabs(safeAcos(boreVec_B.dot(dcm_BN * this->inertialHeadingVec_N)));
+    *azimuth = 0.0;
+}
+
+/*! This method computes the boresight angles of all spacecraft whose state was written and writes them into the
+ output message.  The angles of the other spacecraft are zero.
+ @return void
+ @param CurrentSimNanos The current simulation time in nanoseconds
+ */
+void BoreAngCalcArray::UpdateState(uint64_t CurrentSimNanos)
+{
+    BoreAngleArrayMsgPayload angOut = this->angOutMsg.zeroMsgPayload;
+    angOut.numSc = (int) this->scStateInMsgs.size();
+
+    bool targetGood = !this->useCelestialHeading;
+    if (this->useCelestialHeading) {
+        this->localPlanet = this->celBodyInMsg();
+        targetGood = this->celBodyInMsg.isWritten();
+    }
+
+    for (size_t c = 0; c < this->scStateInMsgs.size() && targetGood; c++) {
+        if (!this->scStateInMsgs[c].isWritten()) {
+            continue;
+        }
+        SCStatesMsgPayload state = this->scStateInMsgs[c]();
+        if (this->useCelestialHeading) {
+            this->computeCelestialAngles(state, this->boreVecs_B[c], &angOut.azimuth[c], &angOut.missAngle[c]);
+        } else {
+            this->computeInertialAngles(state, this->boreVecs_B[c], &angOut.azimuth[c], &angOut.missAngle[c]);
+        }
+    }
+
+    this->angOutMsg.write(&angOut, this->moduleID, CurrentSimNanos);
+}
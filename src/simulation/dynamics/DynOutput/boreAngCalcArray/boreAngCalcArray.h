@@ -0,0 +1,65 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef BORE_ANG_CALC_ARRAY_H
+#define BORE_ANG_CALC_ARRAY_H
+
+#include <vector>
+#include <Eigen/Dense>
+
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+#include "architecture/msgPayloadDefC/SCStatesMsgPayload.h"
+#include "architecture/msgPayloadDefC/SpicePlanetStateMsgPayload.h"
+#include "architecture/msgPayloadDefC/BoreAngleArrayMsgPayload.h"
+#include "architecture/messaging/messaging.h"
+#include "architecture/utilities/bskLogging.h"
+
+
+/*! @brief Computes the boresight angles of several spacecraft relative to a common target in one call
+ */
+class BoreAngCalcArray: public SysModel {
+public:
+    BoreAngCalcArray();
+    ~BoreAngCalcArray();
+
+    void Reset(uint64_t CurrentSimNanos);
+    void UpdateState(uint64_t CurrentSimNanos);
+    void addSpacecraft(Message<SCStatesMsgPayload> *scStateMsg, Eigen::Vector3d boreVec_B);
+
+    std::vector<ReadFunctor<SCStatesMsgPayload>> scStateInMsgs; //!< (-) spacecraft state input messages
+    ReadFunctor<SpicePlanetStateMsgPayload> celBodyInMsg;       //!< (-) celestial body state msg at which we pointing at
+    Message<BoreAngleArrayMsgPayload> angOutMsg;                //!< (-) bore sight angles output message
+
+    std::vector<Eigen::Vector3d> boreVecs_B;    //!< (-) boresight vector in the structure of each spacecraft
+    Eigen::Vector3d inertialHeadingVec_N;       //!< (-) inertial heading, used if celBodyInMsg is not linked
+
+    BSKLogger bskLogger;                        //!< -- BSK Logging
+
+private:
+    void computeCelestialAngles(const SCStatesMsgPayload &state, const Eigen::Vector3d &boreVec_B,
+                                double *azimuth, double *missAngle);
+    void computeInertialAngles(const SCStatesMsgPayload &state, const Eigen::Vector3d &boreVec_B,
+                               double *azimuth, double *missAngle);
+
+    SpicePlanetStateMsgPayload localPlanet;     //!< (-) planet that we are pointing at
+    bool useCelestialHeading = false;           //!< (-) Flag indicating that the module should use the celestial body heading
+};
+
+
+#endif
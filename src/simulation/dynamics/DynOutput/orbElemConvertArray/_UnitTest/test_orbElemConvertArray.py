@@ -0,0 +1,97 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import numpy as np
+import pytest
+from Basilisk.architecture import messaging
+from Basilisk.simulation import orbElemConvert
+from Basilisk.simulation import orbElemConvertArray
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+
+mu = 0.3986004415E+15
+elementNames = ["a", "e", "i", "Omega", "omega", "f", "rmag", "alpha", "rPeriap", "rApoap"]
+
+
+def orbitStates():
+    """inclined, equatorial, circular and hyperbolic orbits"""
+    states = []
+    for a, e, i, Omega, omega, f in [(1.0e7, 0.01, 33.3, 48.2, 347.8, 85.3),
+                                     (1.0e7, 0.5, 0.0, 0.0, 347.8, 85.3),
+                                     (7.0e6, 0.0, 45.0, 120.0, 0.0, 10.0),
+                                     (7.0e6, 0.0, 0.0, 0.0, 0.0, 200.0),
+                                     (-1.0e7, 1.5, 60.0, 10.0, 20.0, 30.0)]:
+        oe = orbitalMotion.ClassicElements()
+        oe.a, oe.e = a, e
+        oe.i, oe.Omega, oe.omega, oe.f = np.radians([i, Omega, omega, f])
+        states.append(orbitalMotion.elem2rv(mu, oe))
+    return states
+
+
+@pytest.mark.parametrize("written", [True, False])
+def test_orbElemConvertArray(written):
+    """The batched conversion matches one orbElemConvert module per spacecraft"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(1.0)))
+
+    converter = orbElemConvertArray.OrbElemConvertArray()
+    converter.ModelTag = "orbElemConvertArray"
+    converter.mu = mu
+    scSim.AddModelToTask("task", converter)
+
+    stateMsgs = []
+    singleConverters = []
+    singleLogs = []
+    for r_N, v_N in orbitStates():
+        payload = messaging.SCStatesMsgPayload()
+        payload.r_BN_N = r_N
+        payload.v_BN_N = v_N
+        stateMsgs.append(messaging.SCStatesMsg().write(payload))
+        converter.addSpacecraft(stateMsgs[-1])
+
+        single = orbElemConvert.OrbElemConvert()
+        single.mu = mu
+        single.scStateInMsg.subscribeTo(stateMsgs[-1])
+        scSim.AddModelToTask("task", single)
+        singleConverters.append(single)
+        singleLogs.append(single.elemOutMsg.recorder())
+        scSim.AddModelToTask("task", singleLogs[-1])
+    # a spacecraft whose state message is never written
+    unwrittenMsg = messaging.SCStatesMsg()
+    if not written:
+        converter.addSpacecraft(unwrittenMsg)
+
+    arrayLog = converter.elemOutMsg.recorder()
+    scSim.AddModelToTask("task", arrayLog)
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(1.0))
+    scSim.ExecuteSimulation()
+
+    numSc = len(singleConverters)
+    np.testing.assert_array_equal(arrayLog.numSc, numSc + (0 if written else 1))
+    for name in elementNames:
+        batched = getattr(arrayLog, name)
+        for c, log in enumerate(singleLogs):
+            np.testing.assert_allclose(batched[:, c], getattr(log, name), rtol=1e-14, atol=1e-12, err_msg=name)
+        np.testing.assert_array_equal(batched[:, numSc:], 0.0)
+
+
+if __name__ == "__main__":
+    test_orbElemConvertArray(False)
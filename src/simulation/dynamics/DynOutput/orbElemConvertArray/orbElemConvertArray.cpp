@@ -0,0 +1,109 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "simulation/dynamics/DynOutput/orbElemConvertArray/orbElemConvertArray.h"
+#include "architecture/utilities/linearAlgebra.h"
+
+/*! The constructor */
+OrbElemConvertArray::OrbElemConvertArray()
+{
+    this->mu = 0.0;
+}
+
+/*! The destructor */
+OrbElemConvertArray::~OrbElemConvertArray()
+{
+}
+
+/*! This method checks the module configuration and sizes the conversion buffers.
+ @return void
+ @param CurrentSimNanos The current simulation time in nanoseconds
+ */
+void OrbElemConvertArray::Reset(uint64_t CurrentSimNanos)
+{
+    if (this->scStateInMsgs.size() == 0) {
+        bskLogger.bskLog(BSK_ERROR, "OrbElemConvertArray: no spacecraft was added with addSpacecraft().");
+    }
+    if (this->mu <= 0.0) {
+        bskLogger.bskLog(BSK_ERROR, "OrbElemConvertArray: mu must be set to a positive value.");
+    }
+    this->r_N.resize(3*this->scStateInMsgs.size());
+    this->v_N.resize(3*this->scStateInMsgs.size());
+    this->scIndex.resize(this->scStateInMsgs.size());
+    this->elements.resize(this->scStateInMsgs.size());
+}
+
+/*! This method adds a spacecraft to the converted set.  Its elements are stored at the index of the
+ spacecraft in the output message, in the order the spacecraft are added.
+ @return void
+ @param scStateMsg spacecraft state message
+ */
+void OrbElemConvertArray::addSpacecraft(Message<SCStatesMsgPayload> *scStateMsg)
+{
+    if (this->scStateInMsgs.size() >= MAX_SC_CNT) {
+        bskLogger.bskLog(BSK_ERROR, "OrbElemConvertArray: cannot add more than %d spacecraft.", MAX_SC_CNT);
+        return;
+    }
+    this->scStateInMsgs.push_back(scStateMsg->addSubscriber());
+}
+
+/*! This method gathers the written spacecraft states, converts them to orbit elements in one batched
+ call and writes the output message.  The elements of spacecraft whose state was not written yet are zero.
+ @return void
+ @param CurrentSimNanos The current simulation time in nanoseconds
+ */
+void OrbElemConvertArray::UpdateState(uint64_t CurrentSimNanos)
+{
+    ClassicElementsArrayMsgPayload elemOut = this->elemOutMsg.zeroMsgPayload;
+    int numWritten = 0;
+
+    //! - gather the written states into contiguous buffers
+    for (size_t c = 0; c < this->scStateInMsgs.size(); c++) {
+        if (!this->scStateInMsgs[c].isWritten()) {
+            continue;
+        }
+        SCStatesMsgPayload state = this->scStateInMsgs[c]();
+        v3Copy(state.r_BN_N, &this->r_N[3*numWritten]);
+        v3Copy(state.v_BN_N, &this->v_N[3*numWritten]);
+        this->scIndex[numWritten] = (int) c;
+        numWritten++;
+    }
+
+    //! - convert all states at once
+    rv2elemArray(this->mu, numWritten, (double (*)[3]) this->r_N.data(), (double (*)[3]) this->v_N.data(),
+                 this->elements.data());
+
+    //! - scatter the elements into the output message
+    elemOut.numSc = (int) this->scStateInMsgs.size();
+    for (int k = 0; k < numWritten; k++) {
+        int c = this->scIndex[k];
+        const classicElements &elem = this->elements[k];
+        elemOut.a[c] = elem.a;
+        elemOut.e[c] = elem.e;
+        elemOut.i[c] = elem.i;
+        elemOut.Omega[c] = elem.Omega;
+        elemOut.omega[c] = elem.omega;
+        elemOut.f[c] = elem.f;
+        elemOut.rmag[c] = elem.rmag;
+        elemOut.alpha[c] = elem.alpha;
+        elemOut.rPeriap[c] = elem.rPeriap;
+        elemOut.rApoap[c] = elem.rApoap;
+    }
+    this->elemOutMsg.write(&elemOut, this->moduleID, CurrentSimNanos);
+}
@@ -0,0 +1,58 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef ORB_ELEM_CONVERT_ARRAY_H
+#define ORB_ELEM_CONVERT_ARRAY_H
+
+#include <vector>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+
+#include "architecture/msgPayloadDefC/SCStatesMsgPayload.h"
+#include "architecture/msgPayloadDefC/ClassicElementsArrayMsgPayload.h"
+#include "architecture/messaging/messaging.h"
+
+#include "architecture/utilities/orbitalMotion.h"
+#include "architecture/utilities/bskLogging.h"
+
+
+/*! @brief orbit element converter of several spacecraft writing a single array message */
+class OrbElemConvertArray: public SysModel {
+public:
+    OrbElemConvertArray();
+    ~OrbElemConvertArray();
+
+    void Reset(uint64_t CurrentSimNanos);
+    void UpdateState(uint64_t CurrentSimNanos);
+    void addSpacecraft(Message<SCStatesMsgPayload> *scStateMsg);
+
+public:
+    double mu;                                                  //!< [m^3/s^2] gravitational parameter
+    std::vector<ReadFunctor<SCStatesMsgPayload>> scStateInMsgs; //!< -- sc state input messages
+    Message<ClassicElementsArrayMsgPayload> elemOutMsg;         //!< -- orbit elements output message
+    BSKLogger bskLogger;                                        //!< -- BSK Logging
+
+private:
+    std::vector<double> r_N;                    //!< [m] inertial positions of the written states, 3 per spacecraft
+    std::vector<double> v_N;                    //!< [m/s] inertial velocities of the written states
+    std::vector<int> scIndex;                   //!< -- spacecraft index of each written state
+    std::vector<classicElements> elements;      //!< -- orbit elements of the written states
+};
+
+
+#endif
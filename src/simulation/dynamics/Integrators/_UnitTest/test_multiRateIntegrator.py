@@ -0,0 +1,121 @@
+# ISC License
+#
+# Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+#
+# Basilisk Unit Test
+#
+# Purpose:  Checks the multi-rate RK4 integrator against the single-rate RK4 integrator for a spacecraft
+#           with two stiff hinged panels that are sub-cycled
+#
+
+import numpy as np
+import pytest
+from Basilisk.simulation import hingedRigidBodyStateEffector
+from Basilisk.simulation import spacecraft
+from Basilisk.simulation import svIntegrators
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def runPanelSpacecraft(timeStep, fastSubCycles, multiRate, stopTime=10.0):
+    """Simulate a hub with two stiff undamped hinged panels and return the final hub and panel states"""
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProc = unitTestSim.CreateNewProcess("TestProcess")
+    testProc.addTask(unitTestSim.CreateNewTask("unitTask", macros.sec2nano(timeStep)))
+
+    scObject = spacecraft.Spacecraft()
+    scObject.ModelTag = "spacecraftBody"
+    scObject.hub.mHub = 750.0
+    scObject.hub.r_BcB_B = [[0.0], [0.0], [1.0]]
+    scObject.hub.IHubPntBc_B = [[900.0, 0.0, 0.0], [0.0, 800.0, 0.0], [0.0, 0.0, 600.0]]
+    scObject.hub.r_CN_NInit = [[-4020338.690396649], [7490566.741852513], [5248299.211589362]]
+    scObject.hub.v_CN_NInit = [[-5199.77710904224], [-3436.681645356935], [1041.576797498721]]
+    scObject.hub.sigma_BNInit = [[0.0], [0.0], [0.0]]
+    scObject.hub.omega_BN_BInit = [[0.1], [-0.1], [0.1]]
+
+    panels = []
+    for i, (side, thetaInit) in enumerate([(1.0, 5.0), (-1.0, -3.0)]):
+        panel = hingedRigidBodyStateEffector.HingedRigidBodyStateEffector()
+        panel.ModelTag = "Panel" + str(i + 1)
+        panel.mass = 100.0
+        panel.IPntS_S = [[100.0, 0.0, 0.0], [0.0, 50.0, 0.0], [0.0, 0.0, 50.0]]
+        panel.d = 1.5
+        panel.k = 2.0e5
+        panel.c = 0.0
+        panel.r_HB_B = [[0.5*side], [0.0], [1.0]]
+        panel.dcm_HB = [[side, 0.0, 0.0], [0.0, side, 0.0], [0.0, 0.0, 1.0]]
+        panel.thetaInit = thetaInit*macros.D2R
+        panel.thetaDotInit = 0.0
+        panel.fastSubCycles = fastSubCycles
+        scObject.addStateEffector(panel)
+        unitTestSim.AddModelToTask("unitTask", panel)
+        panels.append(panel)
+
+    if multiRate:
+        integratorObject = svIntegrators.svIntegratorMultiRateRK4(scObject)
+        scObject.setIntegrator(integratorObject)
+
+    unitTestSim.AddModelToTask("unitTask", scObject)
+    scLog = scObject.scStateOutMsg.recorder()
+    unitTestSim.AddModelToTask("unitTask", scLog)
+    panelLogs = [panel.hingedRigidBodyOutMsg.recorder() for panel in panels]
+    for panelLog in panelLogs:
+        unitTestSim.AddModelToTask("unitTask", panelLog)
+    unitTestSim.AddVariableForLogging(scObject.ModelTag + ".totRotEnergy", macros.sec2nano(timeStep), 0, 0, 'double')
+
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(stopTime))
+    unitTestSim.ExecuteSimulation()
+
+    rotEnergy = unitTestSim.GetLogVariableData(scObject.ModelTag + ".totRotEnergy")
+    return {"sigma_BN": scLog.sigma_BN[-1],
+            "omega_BN_B": scLog.omega_BN_B[-1],
+            "r_BN_N": scLog.r_BN_N[-1],
+            "theta": np.array([panelLog.theta[-1] for panelLog in panelLogs]),
+            "thetaDot": np.array([panelLog.thetaDot[-1] for panelLog in panelLogs]),
+            "rotEnergy": rotEnergy[1:, 1]}
+
+
+def test_multiRateSingleRate():
+    """Without sub-cycled effectors the multi-rate integrator must reproduce the RK4 integrator"""
+    timeStep = 0.01
+    truth = runPanelSpacecraft(timeStep, 1, False, stopTime=2.0)
+    result = runPanelSpacecraft(timeStep, 1, True, stopTime=2.0)
+    for key in ["sigma_BN", "omega_BN_B", "r_BN_N", "theta", "thetaDot"]:
+        np.testing.assert_array_equal(result[key], truth[key], err_msg=key)
+
+
+@pytest.mark.parametrize("timeStep, accuracy", [(0.01, 2e-3), (0.005, 5e-4)])
+def test_multiRateSubCycled(timeStep, accuracy):
+    """Sub-cycling the panels 10 times per hub step must match single-rate RK4 run at the fast step size"""
+    fastSubCycles = 10
+    truth = runPanelSpacecraft(timeStep/fastSubCycles, 1, False)
+    result = runPanelSpacecraft(timeStep, fastSubCycles, True)
+
+    np.testing.assert_allclose(result["sigma_BN"], truth["sigma_BN"], atol=accuracy, rtol=0)
+    np.testing.assert_allclose(result["omega_BN_B"], truth["omega_BN_B"], atol=accuracy, rtol=0)
+    np.testing.assert_allclose(result["r_BN_N"], truth["r_BN_N"], atol=10*accuracy, rtol=0)
+    np.testing.assert_allclose(result["theta"], truth["theta"], atol=5*accuracy, rtol=0)
+
+    # the undamped system must conserve rotational energy
+    rotEnergy = result["rotEnergy"]
+    assert np.max(np.abs(rotEnergy - rotEnergy[0]))/rotEnergy[0] < accuracy
+
+
+if __name__ == "__main__":
+    test_multiRateSubCycled(0.01, 2e-3)
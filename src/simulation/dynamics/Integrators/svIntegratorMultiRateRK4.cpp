@@ -0,0 +1,172 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+#include "svIntegratorMultiRateRK4.h"
+#include "../_GeneralModuleFiles/dynamicObject.h"
+#include <algorithm>
+
+svIntegratorMultiRateRK4::svIntegratorMultiRateRK4(DynamicObject* dyn) : svIntegratorRK4(dyn)
+{
+    this->holdSlowStates = false;
+    return;
+}
+
+svIntegratorMultiRateRK4::~svIntegratorMultiRateRK4()
+{
+    return;
+}
+
+/*! This method sorts the states of the dynamic object into the sub-cycled (fast) states and the remaining (slow)
+ states. */
+void svIntegratorMultiRateRK4::splitStates(std::vector<StateData*> &fast, std::vector<StateData*> &slow)
+{
+    std::map<std::string, StateData>::iterator it;
+    for (it = dynPtr->dynManager.stateContainer.stateMap.begin(); it != dynPtr->dynManager.stateContainer.stateMap.end(); it++)
+    {
+        if (std::find(dynPtr->fastStateNames.begin(), dynPtr->fastStateNames.end(), it->first) != dynPtr->fastStateNames.end())
+        {
+            fast.push_back(&(it->second));
+        } else {
+            slow.push_back(&(it->second));
+        }
+    }
+}
+
+/*! This method advances the states by one step. The fast states are integrated first with fastSubCycles RK4
+ sub-steps, during which the slow states are extrapolated (or held) from the start of the step and only the fast
+ equations of motion are evaluated. The slow states are then integrated with a single RK4 step of the full equations
+ of motion, reading the fast states from the sub-step trajectory at the RK4 stage times. If the dynamic object has
+ no fast states this reduces to the regular RK4 integrator. */
+void svIntegratorMultiRateRK4::integrate(double currentTime, double timeStep)
+{
+    uint32_t nSub = dynPtr->fastSubCycles;
+    std::vector<StateData*> fast;
+    std::vector<StateData*> slow;
+    if (nSub > 1)
+    {
+        this->splitStates(fast, slow);
+    }
+    if (fast.empty())
+    {
+        svIntegratorRK4::integrate(currentTime, timeStep);
+        return;
+    }
+
+    size_t i;
+    uint32_t j;
+    double subStep = timeStep / nSub;
+    std::vector<Eigen::MatrixXd> slowInit(slow.size());
+    std::vector<Eigen::MatrixXd> slowK1(slow.size());
+    std::vector<Eigen::MatrixXd> slowOut(slow.size());
+    std::vector<Eigen::MatrixXd> fastInit(fast.size());
+    std::vector<Eigen::MatrixXd> fastOut(fast.size());
+    std::vector<std::vector<Eigen::MatrixXd> > fastHistory(nSub + 1, std::vector<Eigen::MatrixXd>(fast.size()));
+
+    // - First stage of the full system gives the slow rates used to drive the fast sub-steps
+    dynPtr->equationsOfMotion(currentTime, timeStep);
+    for (i = 0; i < slow.size(); i++)
+    {
+        slowInit[i] = slow[i]->getState();
+        slowK1[i] = slow[i]->getStateDeriv();
+    }
+    for (i = 0; i < fast.size(); i++)
+    {
+        fastHistory[0][i] = fast[i]->getState();
+    }
+
+    // - Fast pass: sub-cycle the fast states with the slow states prescribed
+    const double stageFrac[4] = {0.0, 0.5, 0.5, 1.0};
+    const double stageWeight[4] = {1.0/6.0, 2.0/6.0, 2.0/6.0, 1.0/6.0};
+    for (j = 0; j < nSub; j++)
+    {
+        for (i = 0; i < fast.size(); i++)
+        {
+            fastInit[i] = fastHistory[j][i];
+            fastOut[i] = fastInit[i];
+        }
+        for (int stage = 0; stage < 4; stage++)
+        {
+            double tau = j*subStep + stageFrac[stage]*subStep;
+            if (stage > 0)
+            {
+                for (i = 0; i < fast.size(); i++)
+                {
+                    fast[i]->state = fastInit[i] + stageFrac[stage]*subStep*fast[i]->stateDeriv;
+                }
+            }
+            for (i = 0; i < slow.size(); i++)
+            {
+                slow[i]->state = this->holdSlowStates ? slowInit[i] : Eigen::MatrixXd(slowInit[i] + tau*slowK1[i]);
+                slow[i]->stateDeriv = slowK1[i];
+            }
+            dynPtr->fastEquationsOfMotion(currentTime + tau, subStep);
+            for (i = 0; i < fast.size(); i++)
+            {
+                fastOut[i] += stageWeight[stage]*subStep*fast[i]->stateDeriv;
+            }
+        }
+        for (i = 0; i < fast.size(); i++)
+        {
+            fastHistory[j + 1][i] = fastOut[i];
+        }
+    }
+
+    // - Fast states at the RK4 stage times of the slow step
+    std::vector<Eigen::MatrixXd> fastMid(fast.size());
+    for (i = 0; i < fast.size(); i++)
+    {
+        fastMid[i] = 0.5*(fastHistory[nSub/2][i] + fastHistory[(nSub + 1)/2][i]);
+    }
+
+    // - Slow pass: one RK4 step of the full equations of motion
+    for (i = 0; i < slow.size(); i++)
+    {
+        slowOut[i] = slowInit[i] + timeStep/6.0*slowK1[i];
+        slow[i]->state = slowInit[i] + 0.5*timeStep*slowK1[i];
+    }
+    for (i = 0; i < fast.size(); i++)
+    {
+        fast[i]->state = fastMid[i];
+    }
+    dynPtr->equationsOfMotion(currentTime + timeStep * 0.5, timeStep);
+    for (i = 0; i < slow.size(); i++)
+    {
+        slowOut[i] += 2.0*timeStep/6.0*slow[i]->stateDeriv;
+        slow[i]->state = slowInit[i] + 0.5*timeStep*slow[i]->stateDeriv;
+    }
+    dynPtr->equationsOfMotion(currentTime + timeStep * 0.5, timeStep);
+    for (i = 0; i < slow.size(); i++)
+    {
+        slowOut[i] += 2.0*timeStep/6.0*slow[i]->stateDeriv;
+        slow[i]->state = slowInit[i] + timeStep*slow[i]->stateDeriv;
+    }
+    for (i = 0; i < fast.size(); i++)
+    {
+        fast[i]->state = fastHistory[nSub][i];
+    }
+    dynPtr->equationsOfMotion(currentTime + timeStep, timeStep);
+    for (i = 0; i < slow.size(); i++)
+    {
+        slowOut[i] += timeStep/6.0*slow[i]->stateDeriv;
+        slow[i]->state = slowOut[i];
+    }
+
+    return;
+}
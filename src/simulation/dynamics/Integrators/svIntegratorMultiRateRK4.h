@@ -0,0 +1,44 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef svIntegratorMultiRateRK4_h
+#define svIntegratorMultiRateRK4_h
+
+#include "../_GeneralModuleFiles/svIntegratorRK4.h"
+#include "../_GeneralModuleFiles/dynParamManager.h"
+#include <stdint.h>
+#include <vector>
+
+/*! @brief Multi-rate 4th order Runge-Kutta integrator that sub-cycles the fast states of the dynamic object */
+class svIntegratorMultiRateRK4 : public svIntegratorRK4
+{
+public:
+    svIntegratorMultiRateRK4(DynamicObject* dyn); //!< class method
+    virtual ~svIntegratorMultiRateRK4();
+    virtual void integrate(double currentTime, double timeStep); //!< class method
+
+public:
+    bool holdSlowStates;        //!< -- if true the slow states are frozen during the fast sub-steps, otherwise they are extrapolated along their rates
+
+private:
+    void splitStates(std::vector<StateData*> &fast, std::vector<StateData*> &slow);  //!< class method
+};
+
+
+#endif /* svIntegratorMultiRateRK4_h */
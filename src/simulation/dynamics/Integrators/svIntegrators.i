@@ -25,6 +25,7 @@
    #include "svIntegratorRK2.h"
    #include "svIntegratorRKF45.h"
    #include "svIntegratorRKF78.h"
+   #include "svIntegratorMultiRateRK4.h"
    #include "architecture/_GeneralModuleFiles/sys_model.h"
 %}
 
@@ -40,6 +41,7 @@ from Basilisk.architecture.swig_common_model import *
 %include "svIntegratorRK2.h"
 %include "svIntegratorRKF45.h"
 %include "svIntegratorRKF78.h"
+%include "svIntegratorMultiRateRK4.h"
 
 %pythoncode %{
 import sys
@@ -35,6 +35,7 @@ StateData* DynParamManager::registerState(uint32_t nRow, uint32_t nCol,
     std::string stateName)
 {
     std::map<std::string, StateData>::iterator it;
+    this->registeredStateNames.push_back(stateName);
     it = stateContainer.stateMap.find(stateName);
     if(it != stateContainer.stateMap.end())
     {
@@ -43,6 +43,7 @@ class DynParamManager {
 public:
     std::map<std::string, Eigen::MatrixXd> dynProperties; //!< class variable
     StateVector stateContainer;                             //!< class variable
+    std::vector<std::string> registeredStateNames;          //!< -- State names in the order they were registered, cleared by the owner before it registers its states
     BSKLogger bskLogger;                      //!< -- BSK Logging
 public:
     DynParamManager();
@@ -22,6 +22,7 @@
 /*! This is the constructor, just setting the variables to zero */
 DynamicObject::DynamicObject()
 {
+    this->fastSubCycles = 1;
     return;
 }
 
@@ -43,6 +44,14 @@ void DynamicObject::computeEnergyMomentum(double t)
     return;
 }
 
+/*! This method computes the derivatives of the fast states listed in fastStateNames while a multi-rate integrator
+ sub-cycles them. The default evaluates the full equations of motion, which is always correct but saves no work. */
+void DynamicObject::fastEquationsOfMotion(double t, double timeStep)
+{
+    this->equationsOfMotion(t, timeStep);
+    return;
+}
+
 /*! This method changes the integrator in use (Default integrator: RK4) */
 void DynamicObject::setIntegrator(StateVecIntegrator *newIntegrator)
 {
@@ -22,6 +22,7 @@
 
 #include <vector>
 #include <stdint.h>
+#include <string>
 #include "dynParamManager.h"
 #include "stateEffector.h"
 #include "dynamicEffector.h"
@@ -35,6 +36,8 @@ public:
     DynParamManager dynManager;                       //!< -- Dynamics parameter manager for all effectors
     StateVecIntegrator *integrator;                   //!< -- Integrator used to propagate state forward
     BSKLogger bskLogger;                      //!< -- BSK Logging
+    std::vector<std::string> fastStateNames;          //!< -- Names of the states that a multi-rate integrator sub-cycles
+    uint32_t fastSubCycles;                           //!< -- Number of fast sub-steps per integration step (1 = single rate)
 
 public:
     DynamicObject();                                  //!< -- Constructor
@@ -43,6 +46,7 @@ public:
     virtual void computeEnergyMomentum(double t);     //!< -- Method to compute energy and momentum of the system
     virtual void UpdateState(uint64_t callTime) = 0;  //!< -- This hooks the dyn-object into Basilisk architecture
     virtual void equationsOfMotion(double t, double timeStep) = 0;     //!< -- This is computing F = Xdot(X,t)
+    virtual void fastEquationsOfMotion(double t, double timeStep);     //!< -- This is computing Xdot = F(X,t) for the fast states only
     virtual void integrateState(double t) = 0;        //!< -- This method steps the state forward in time
     void setIntegrator(StateVecIntegrator *newIntegrator);  //!< -- Sets a new integrator
 };
@@ -36,6 +36,7 @@ StateEffector::StateEffector()
     this->nameOfSpacecraftAttachedTo = "";
     this->r_BP_P.setZero();
     this->dcm_BP.setIdentity();
+    this->fastSubCycles = 1;
     return;
 }
 
@@ -58,6 +58,7 @@ public:
     Eigen::Vector3d torqueOnBodyPntC_B;    //!< [N] Torque that the state effector applies to the body about point B
     Eigen::Vector3d r_BP_P;                //!< position vector of the spacecraft mody frame origin B relative to the primary spacecraft body frame P.  This is used in the SpacecraftSystem module where multiple spacecraft hubs can be a single spacecraft
     Eigen::Matrix3d dcm_BP;                //!< DCM of the spacecraft body frame B relative to primary spacecraft body frame P
+    uint32_t fastSubCycles;                //!< -- Number of sub-steps per integration step when used with a multi-rate integrator (1 = not sub-cycled)
     BSKLogger bskLogger;                   //!< -- BSK Logging
 
 public:
@@ -17,6 +17,9 @@
 # 
 # 
 
+import time
+
+import numpy as np
 import pytest
 from Basilisk.architecture import messaging
 from Basilisk.simulation import msmForceTorque
@@ -25,8 +28,9 @@ from Basilisk.utilities import macros
 from Basilisk.utilities import unitTestSupport
 
 
+@pytest.mark.parametrize("useIterativeSolver", [False, True])
 @pytest.mark.parametrize("accuracy", [1e-4])
-def test_msmForceTorque(show_plots, accuracy):
+def test_msmForceTorque(show_plots, accuracy, useIterativeSolver):
     r"""
     **Validation Test Description**
 
@@ -40,17 +44,18 @@ def test_msmForceTorque(show_plots, accuracy):
 
     Args:
         accuracy (float): relative accuracy value used in the validation tests
+        useIterativeSolver (bool): flag to solve the charges with the iterative solver instead of the dense solve
 
     **Description of Variables Being Tested**
 
     The module output messages for the inertial force vector and body torque vector are compared to
     hand-calculated truth values using their relative accuracy.
     """
-    [testResults, testMessage] = msmForceTorqueTestFunction(show_plots, accuracy)
+    [testResults, testMessage] = msmForceTorqueTestFunction(show_plots, accuracy, useIterativeSolver)
     assert testResults < 1, testMessage
 
 
-def msmForceTorqueTestFunction(show_plots, accuracy):
+def msmForceTorqueTestFunction(show_plots, accuracy, useIterativeSolver=False):
     """Test method"""
     testFailCount = 0
     testMessages = []
@@ -65,6 +70,7 @@ def msmForceTorqueTestFunction(show_plots, accuracy):
     # setup module to be tested
     module = msmForceTorque.MsmForceTorque()
     module.ModelTag = "msmForceTorqueTag"
+    module.useIterativeSolver = useIterativeSolver
     unitTestSim.AddModelToTask(unitTaskName, module)
 
     # Configure space object state and voltage input messages
@@ -166,7 +172,98 @@ def msmForceTorqueTestFunction(show_plots, accuracy):
     return [testFailCount, "".join(testMessages)]
 
 
+def setupFormation(numSat, numSpheres, spacing, useIterativeSolver, farFieldRatio):
+    """Returns a simulation with a line of numSat spacecraft modeled by a lattice of numSpheres spheres each"""
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProc = unitTestSim.CreateNewProcess("TestProcess")
+    testProc.addTask(unitTestSim.CreateNewTask("unitTask", macros.sec2nano(1.0)))
+
+    module = msmForceTorque.MsmForceTorque()
+    module.ModelTag = "msmForceTorqueTag"
+    module.useIterativeSolver = useIterativeSolver
+    module.farFieldRatio = farFieldRatio
+    unitTestSim.AddModelToTask("unitTask", module)
+
+    rng = np.random.default_rng(0)
+    side = int(np.ceil(numSpheres ** (1. / 3.)))
+    spPosList = [0.5 * np.array([k % side, (k // side) % side, k // side ** 2]) - 0.25 * side
+                 for k in range(numSpheres)]
+    rList = list(0.15 + 0.05 * rng.random(numSpheres))
+    msgs = []
+    for c in range(numSat):
+        scStateInMsgsData = messaging.SCStatesMsgPayload()
+        scStateInMsgsData.r_BN_N = [spacing * c, rng.uniform(-2., 2.), rng.uniform(-2., 2.)]
+        scStateInMsgsData.sigma_BN = list(rng.uniform(-0.3, 0.3, 3))
+        scStateInMsg = messaging.SCStatesMsg().write(scStateInMsgsData)
+        voltInMsgData = messaging.VoltMsgPayload()
+        voltInMsgData.voltage = rng.uniform(-20000., 20000.)
+        voltInMsg = messaging.VoltMsg().write(voltInMsgData)
+        module.addSpacecraftToModel(scStateInMsg
+                                    , messaging.DoubleVector(rList)
+                                    , unitTestSupport.npList2EigenXdVector(spPosList))
+        module.voltInMsgs[c].subscribeTo(voltInMsg)
+        msgs.append((scStateInMsg, voltInMsg))
+
+    unitTestSim.InitializeSimulation()
+    return unitTestSim, module, msgs
+
+
+def formationForces(module, numSat):
+    return np.array([module.eForceOutMsgs[c].read().forceRequestInertial for c in range(numSat)])
+
+
+@pytest.mark.parametrize("farFieldRatio", [0.0, 0.3])
+def test_msmIterativeSolver(farFieldRatio):
+    r"""
+    **Validation Test Description**
+
+    A formation of 4 spacecraft modeled by 27 spheres each is set up.  The forces found with the iterative
+    solver, with and without the far-field multipole approximation, are compared to the forces of the dense solve.
+
+    **Test Parameters**
+
+    Args:
+        farFieldRatio (float): far-field ratio of the iterative solver
+    """
+    numSat = 4
+    denseSim, dense, denseMsgs = setupFormation(numSat, 27, 15., False, 0.0)
+    denseSim.TotalSim.SingleStepProcesses()
+    iterSim, iterative, iterMsgs = setupFormation(numSat, 27, 15., True, farFieldRatio)
+    iterSim.TotalSim.SingleStepProcesses()
+
+    fDense = formationForces(dense, numSat)
+    fIterative = formationForces(iterative, numSat)
+    accuracy = 1e-8 if farFieldRatio == 0.0 else 1e-3
+    np.testing.assert_allclose(fIterative, fDense, rtol=0, atol=accuracy * np.max(np.abs(fDense)))
+    assert 0 < iterative.solverIterations < iterative.maxSolverIterations
+
+
+def msmBenchmark(numSat=10, numSpheres=100, spacing=10., numSteps=10, farFieldRatio=0.3):
+    """Prints the time per update and the force error of the iterative and far-field solves relative to the
+    dense solve, for a formation whose attitudes change every step"""
+    results = {}
+    for name, useIterativeSolver, ratio in [("dense", False, 0.0), ("iterative", True, 0.0),
+                                            ("far field", True, farFieldRatio)]:
+        sim, module, msgs = setupFormation(numSat, numSpheres, spacing, useIterativeSolver, ratio)
+        start = time.perf_counter()
+        for step in range(numSteps):
+            for scStateInMsg, _ in msgs:
+                scStateInMsgsData = scStateInMsg.read()
+                scStateInMsgsData.sigma_BN = list(np.array(scStateInMsgsData.sigma_BN) + 0.001)
+                scStateInMsg.write(scStateInMsgsData)
+            sim.TotalSim.SingleStepProcesses()
+        results[name] = ((time.perf_counter() - start) / numSteps, formationForces(module, numSat),
+                         module.solverIterations)
+    fDense = results["dense"][1]
+    for name, (stepTime, forces, iterations) in results.items():
+        error = np.linalg.norm(forces - fDense) / np.linalg.norm(fDense)
+        print("%d x %d spheres, %-9s: %8.2f ms per update, %2d iterations, relative force error %.1e"
+              % (numSat, numSpheres, name, stepTime * 1e3, iterations, error))
+
+
 if __name__ == "__main__":
-    test_msmForceTorque(False, 1e-4)
+    test_msmForceTorque(False, 1e-4, True)
+    for numSat, numSpheres in [(5, 100), (10, 100), (10, 200), (20, 100)]:
+        msmBenchmark(numSat, numSpheres)
 
 
@@ -21,11 +21,20 @@
 #include "simulation/dynamics/msmForceTorque/msmForceTorque.h"
 #include <iostream>
 #include <cstring>
+#include <cmath>
+
+static const double kc = 8.99e9;        //!< [Nm^2/C^2] Coulomb's constant
 
 /*! This is the constructor for the module class.  It sets default variable
     values and initializes the various parts of the model */
 MsmForceTorque::MsmForceTorque()
 {
+    this->useIterativeSolver = false;
+    this->solverTolerance = 1e-10;
+    this->maxSolverIterations = 100;
+    this->farFieldRatio = 0.0;
+    this->solverIterations = 0;
+    this->chargesInitialized = false;
 }
 
 /*! Module Destructor */
@@ -74,7 +83,62 @@ void MsmForceTorque::Reset(uint64_t CurrentSimNanos)
     if (this->numSpheres == 0) {
         bskLogger.bskLog(BSK_ERROR, "MsmForceTorque does not have any spheres added?");
     }
-    
+
+    /* size the solver storage once */
+    this->sphereStartList.resize(this->numSat);
+    unsigned int start = 0;
+    for (long unsigned int c=0; c < this->numSat; c++) {
+        this->sphereStartList.at(c) = start;
+        start += this->radiiList.at(c).size();
+    }
+    this->r_SN_NList.resize(this->numSpheres);
+    this->V.resize(this->numSpheres);
+    this->q.setZero(this->numSpheres);
+    this->chargesInitialized = false;
+    this->solverIterations = 0;
+    if (!this->useIterativeSolver) {
+        this->S.resize(this->numSpheres, this->numSpheres);
+        return;
+    }
+
+    /* the self-elastance blocks are constant in the body frame, they are set up and factored once */
+    this->selfElastanceList.resize(this->numSat);
+    this->selfElastanceFactors.resize(this->numSat);
+    this->r_CB_BList.resize(this->numSat);
+    this->clusterRadiusList.resize(this->numSat);
+    for (long unsigned int c=0; c < this->numSat; c++) {
+        const std::vector<Eigen::Vector3d> &r_SB_B = this->r_SB_BList.at(c);
+        long unsigned int n = r_SB_B.size();
+        Eigen::MatrixXd &selfS = this->selfElastanceList.at(c);
+        selfS.resize(n, n);
+        Eigen::Vector3d center = Eigen::Vector3d::Zero();
+        for (long unsigned int k=0; k < n; k++) {
+            selfS(k, k) = kc/this->radiiList.at(c).at(k);
+            for (long unsigned int l=k+1; l < n; l++) {
+                selfS(k, l) = kc / (r_SB_B.at(k) - r_SB_B.at(l)).norm();
+                selfS(l, k) = selfS(k, l);
+            }
+            center += r_SB_B.at(k);
+        }
+        this->selfElastanceFactors.at(c).compute(selfS);
+        if (this->selfElastanceFactors.at(c).info() != Eigen::Success) {
+            bskLogger.bskLog(BSK_ERROR, "MsmForceTorque: the self-elastance matrix of spacecraft %lu is not positive definite.", c);
+        }
+        if (n > 0) {
+            center /= (double) n;
+        }
+        this->r_CB_BList.at(c) = center;
+        this->clusterRadiusList.at(c) = 0.0;
+        for (long unsigned int k=0; k < n; k++) {
+            this->clusterRadiusList.at(c) = std::max(this->clusterRadiusList.at(c), (r_SB_B.at(k) - center).norm());
+        }
+    }
+    this->mutualElastanceList.resize(this->numSat * this->numSat);
+    this->r_CN_NList.resize(this->numSat);
+    this->monopoleList.resize(this->numSat);
+    this->dipoleList.resize(this->numSat);
+    this->quadrupoleList.resize(this->numSat);
+
     return;
 }
 
@@ -140,6 +204,207 @@ void MsmForceTorque::readMessages()
 }
 
 
+/*! Compute the inertial sphere locations, and the inertial sphere cluster centers for the iterative solver
+ */
+void MsmForceTorque::computeSpherePositions()
+{
+    Eigen::Matrix3d dcm_NB;                     // [] DCM from body B to inertial frame N
+    Eigen::Vector3d r_BN_N;                     // [m] spacecraft inertial position vector
+
+    for (long unsigned int c=0; c < this->numSat; c++) {
+        dcm_NB = this->sigma_BNList.at(c).toRotationMatrix();
+        r_BN_N = this->r_BN_NList.at(c);
+        unsigned int i0 = this->sphereStartList.at(c);
+        for (long unsigned int k=0; k < this->radiiList.at(c).size(); k++) {
+            this->r_SN_NList.at(i0 + k) = r_BN_N + dcm_NB * this->r_SB_BList.at(c).at(k);
+        }
+        if (this->useIterativeSolver) {
+            this->r_CN_NList.at(c) = r_BN_N + dcm_NB * this->r_CB_BList.at(c);
+        }
+    }
+}
+
+/*! Solve for the sphere charges with a Cholesky factorization of the full elastance matrix
+ */
+void MsmForceTorque::solveChargesDense()
+{
+    /* setup diagonal S matrix and voltage components */
+    long unsigned int counter = 0;
+    for (long unsigned int c=0; c < this->numSat; c++) {
+        for (long unsigned int k=0; k < this->radiiList.at(c).size(); k++) {
+            this->S(counter, counter) = kc/this->radiiList.at(c).at(k);
+            counter++;
+        }
+    }
+    /* setup off-diagonal components, the matrix is symmetric */
+    for (long unsigned int i=0; i < this->numSpheres; i++) {
+        for (long unsigned int j=i+1; j < this->numSpheres; j++) {
+            this->S(i,j) = kc / (this->r_SN_NList.at(i) - this->r_SN_NList.at(j)).norm();
+            this->S(j,i) = this->S(i,j);
+        }
+    }
+
+    /* solve for sphere charges */
+    this->q = this->S.llt().solve(this->V);
+}
+
+/*! Return true if the spacecraft a and b are far enough apart to interact through their multipole expansions
+ */
+bool MsmForceTorque::isFarField(unsigned int a, unsigned int b) const
+{
+    if (this->farFieldRatio <= 0.0) {
+        return false;
+    }
+    double separation = (this->r_CN_NList.at(a) - this->r_CN_NList.at(b)).norm();
+    return this->clusterRadiusList.at(a) + this->clusterRadiusList.at(b) < this->farFieldRatio * separation;
+}
+
+/*! Compute the net charge, dipole and second moment of the sphere charges x of each spacecraft about its inertial
+    sphere cluster center
+ */
+void MsmForceTorque::computeMultipoleMoments(const Eigen::VectorXd &x)
+{
+    for (long unsigned int c=0; c < this->numSat; c++) {
+        unsigned int i0 = this->sphereStartList.at(c);
+        double monopole = 0.0;
+        Eigen::Vector3d dipole = Eigen::Vector3d::Zero();
+        Eigen::Matrix3d quadrupole = Eigen::Matrix3d::Zero();
+        for (long unsigned int k=0; k < this->radiiList.at(c).size(); k++) {
+            Eigen::Vector3d r_SC_N = this->r_SN_NList.at(i0 + k) - this->r_CN_NList.at(c);
+            monopole += x(i0 + k);
+            dipole += x(i0 + k) * r_SC_N;
+            quadrupole += x(i0 + k) * r_SC_N * r_SC_N.transpose();
+        }
+        this->monopoleList.at(c) = monopole;
+        this->dipoleList.at(c) = dipole;
+        this->quadrupoleList.at(c) = quadrupole;
+    }
+}
+
+/*! Compute y = S x with the factored self-elastance blocks, the mutual elastance blocks of the near spacecraft, and
+    a second order expansion of 1/|R + x_i - y_j| about the cluster centers for the far spacecraft.  The expansion is
+    symmetric in the two spacecraft, so the operator stays symmetric for the conjugate gradient solve.
+ */
+void MsmForceTorque::applyElastance(const Eigen::VectorXd &x, Eigen::VectorXd &y)
+{
+    if (this->farFieldRatio > 0.0) {
+        this->computeMultipoleMoments(x);
+    }
+    for (unsigned int a=0; a < this->numSat; a++) {
+        unsigned int ia = this->sphereStartList.at(a);
+        long unsigned int na = this->radiiList.at(a).size();
+        y.segment(ia, na).noalias() = this->selfElastanceList.at(a) * x.segment(ia, na);
+    }
+    for (unsigned int a=0; a < this->numSat; a++) {
+        unsigned int ia = this->sphereStartList.at(a);
+        long unsigned int na = this->radiiList.at(a).size();
+        for (unsigned int b=0; b < this->numSat; b++) {
+            if (b == a) {
+                continue;
+            }
+            unsigned int ib = this->sphereStartList.at(b);
+            long unsigned int nb = this->radiiList.at(b).size();
+            if (!this->isFarField(a, b)) {
+                if (a < b) {
+                    y.segment(ia, na).noalias() += this->mutualElastanceList.at(a*this->numSat + b) * x.segment(ib, nb);
+                } else {
+                    y.segment(ia, na).noalias() += this->mutualElastanceList.at(b*this->numSat + a).transpose() * x.segment(ib, nb);
+                }
+                continue;
+            }
+            /* potential of the multipole expansion of spacecraft b at the spheres of spacecraft a */
+            Eigen::Vector3d R = this->r_CN_NList.at(a) - this->r_CN_NList.at(b);
+            double R2 = R.squaredNorm();
+            double R1 = std::sqrt(R2);
+            double R3 = R1*R2;
+            double R5 = R3*R2;
+            double Q = this->monopoleList.at(b);
+            const Eigen::Vector3d &p = this->dipoleList.at(b);
+            const Eigen::Matrix3d &Qd = this->quadrupoleList.at(b);
+            double Rp = R.dot(p);
+            double RQdR = R.dot(Qd * R);
+            double trQd = Qd.trace();
+            for (long unsigned int k=0; k < na; k++) {
+                Eigen::Vector3d x_i = this->r_SN_NList.at(ia + k) - this->r_CN_NList.at(a);
+                double Rx = R.dot(x_i);
+                double RMR = Q*Rx*Rx - 2.0*Rx*Rp + RQdR;
+                double trM = Q*x_i.squaredNorm() - 2.0*x_i.dot(p) + trQd;
+                y(ia + k) += kc * (Q/R1 - (Q*Rx - Rp)/R3 + (3.0*RMR - R2*trM)/(2.0*R5));
+            }
+        }
+    }
+}
+
+/*! Compute y = D^-1 x with the Cholesky factors of the block diagonal self-elastance matrix D
+ */
+void MsmForceTorque::applyBlockJacobi(const Eigen::VectorXd &x, Eigen::VectorXd &y)
+{
+    for (unsigned int c=0; c < this->numSat; c++) {
+        unsigned int i0 = this->sphereStartList.at(c);
+        long unsigned int n = this->radiiList.at(c).size();
+        y.segment(i0, n) = this->selfElastanceFactors.at(c).solve(x.segment(i0, n));
+    }
+}
+
+/*! Solve for the sphere charges with the block-Jacobi preconditioned conjugate gradient method, starting from the
+    charges of the previous update.  Only the mutual elastance blocks of the near spacecraft are set up.
+ */
+void MsmForceTorque::solveChargesIterative()
+{
+    /* update the mutual elastance blocks of the near spacecraft */
+    for (unsigned int a=0; a < this->numSat; a++) {
+        for (unsigned int b=a+1; b < this->numSat; b++) {
+            if (this->isFarField(a, b)) {
+                continue;
+            }
+            unsigned int ia = this->sphereStartList.at(a);
+            unsigned int ib = this->sphereStartList.at(b);
+            long unsigned int na = this->radiiList.at(a).size();
+            long unsigned int nb = this->radiiList.at(b).size();
+            Eigen::MatrixXd &block = this->mutualElastanceList.at(a*this->numSat + b);
+            block.resize(na, nb);
+            for (long unsigned int k=0; k < na; k++) {
+                for (long unsigned int l=0; l < nb; l++) {
+                    block(k, l) = kc / (this->r_SN_NList.at(ia + k) - this->r_SN_NList.at(ib + l)).norm();
+                }
+            }
+        }
+    }
+
+    /* the first solve starts from the charges of the isolated spacecraft */
+    if (!this->chargesInitialized) {
+        this->applyBlockJacobi(this->V, this->q);
+        this->chargesInitialized = true;
+    }
+
+    Eigen::VectorXd r(this->numSpheres);        // residual
+    Eigen::VectorXd z(this->numSpheres);        // preconditioned residual
+    Eigen::VectorXd p(this->numSpheres);        // search direction
+    Eigen::VectorXd Sp(this->numSpheres);       // elastance times search direction
+    double tolerance = this->solverTolerance * this->V.norm();
+
+    this->applyElastance(this->q, Sp);
+    r = this->V - Sp;
+    this->applyBlockJacobi(r, z);
+    p = z;
+    double rz = r.dot(z);
+    this->solverIterations = 0;
+    while (r.norm() > tolerance && this->solverIterations < this->maxSolverIterations) {
+        this->applyElastance(p, Sp);
+        double alpha = rz / p.dot(Sp);
+        this->q += alpha * p;
+        r -= alpha * Sp;
+        this->applyBlockJacobi(r, z);
+        double rzNew = r.dot(z);
+        p = z + (rzNew / rz) * p;
+        rz = rzNew;
+        this->solverIterations++;
+    }
+    if (r.norm() > tolerance) {
+        bskLogger.bskLog(BSK_WARNING, "MsmForceTorque: the iterative charge solve did not converge in %d iterations.", this->maxSolverIterations);
+    }
+}
+
 /*! This is the main method that gets called every time the module is updated.  Provide an appropriate description.
     @return void
 */
@@ -149,13 +414,6 @@ void MsmForceTorque::UpdateState(uint64_t CurrentSimNanos)
     this->readMessages();
     
     // compute the electrostatic forces and torques
-    Eigen::MatrixXd S;                          //!< [1/m] Elastance matrix divided by kc
-    Eigen::VectorXd V;                          //!< [V] vector of sphere voltages
-    Eigen::VectorXd q;                          //!< [C] vector of sphere charges
-    double kc;                                  //!< [Nm^2/C^2] Coulomb's constant
-    std::vector<Eigen::Vector3d> r_SN_NList;    //!< [m] list of inertial sphere locations
-    Eigen::Matrix3d dcm_NB;                     //!< [] DCM from body B to inertial frame N
-    Eigen::Vector3d r_BN_N;                     //!< [m] spacecraft inertial position vector
     Eigen::Vector3d r_ij_N;                     //!< [m] relative position vector between ith and jth spheres
     double r_ij;                                //!< [m] norm of r_ij_N
     long unsigned int counter;                  //!< [] loop counter
@@ -163,50 +421,30 @@ void MsmForceTorque::UpdateState(uint64_t CurrentSimNanos)
     CmdTorqueBodyMsgPayload torqueMsgBuffer;    //!< [] torque out message buffer
     ChargeMsmMsgPayload chargeMsmMsgBuffer;     //!< [] MSM charge message buffer
 
-    kc = 8.99e9;
-    
-    /* size matrices */
-    S.resize(this->numSpheres, this->numSpheres);
-    V.resize(this->numSpheres);
-    q.resize(this->numSpheres);
-
     /* determine inertial sphere locations */
-    for (long unsigned int c=0; c < this->numSat; c++) {
-        dcm_NB = this->sigma_BNList.at(c).toRotationMatrix();
-        r_BN_N = this->r_BN_NList.at(c);
-        for (long unsigned int k=0; k < this->radiiList.at(c).size(); k++) {
-            r_SN_NList.push_back(r_BN_N + dcm_NB * this->r_SB_BList.at(c).at(k));
-        }
-    }
-    
-    /*
-     setup elastance matrix
-     */
-    /* setup diagonal S matrix and voltage components */
+    this->computeSpherePositions();
+
+    /* setup the voltage components */
     counter = 0;
     for (long unsigned int c=0; c < this->numSat; c++) {
         for (long unsigned int k=0; k < this->radiiList.at(c).size(); k++) {
-            S(counter, counter) = kc/this->radiiList.at(c).at(k);
-            V(counter) = this->volt.at(c);
+            this->V(counter) = this->volt.at(c);
             counter++;
         }
     }
-    /* setup off-diagonal components */
-    for (long unsigned int i=0; i < this->numSpheres; i++) {
-        for (long unsigned int j=0; j < this->numSpheres; j++) {
-            if (i != j) {
-                r_ij_N = r_SN_NList.at(i) - r_SN_NList.at(j);
-                S(i,j) = kc / r_ij_N.norm();
-                S(j,i) = S(i,j);
-            }
+
+    /* solve for sphere charges */
+    if (this->useIterativeSolver) {
+        this->solveChargesIterative();
+        if (this->farFieldRatio > 0.0) {
+            this->computeMultipoleMoments(this->q);
         }
+    } else {
+        this->solveChargesDense();
     }
-    
-    /* solve for sphere charges */
-    q = S.llt().solve(V);
+    const Eigen::VectorXd &q = this->q;
 
     /* find forces and torques acting on each space object */
-    counter = 0;
     long unsigned int i0 = 0;       // counter where the MSM sphere charges start in the q vector
     long unsigned int i1;           // counter where the next spacecraft MSM sphere charges start
     // loop over all satellites
@@ -232,10 +470,34 @@ void MsmForceTorque::UpdateState(uint64_t CurrentSimNanos)
         // loop over current body spheres
         for (long unsigned int j=i0; j<i1; j++) {
             force_N.setZero();
-            // loop over all other spheres
-            for (long unsigned int i=0; i<this->numSpheres; i++) {
-                if (i<i0 || i>=i1) {
-                    r_ij_N = r_SN_NList.at(i) - r_SN_NList.at(j);
+            // loop over all other spacecraft
+            for (unsigned int b=0; b < this->numSat; b++) {
+                if (b == c) {
+                    continue;
+                }
+                if (this->useIterativeSolver && this->isFarField(c, b)) {
+                    // field of the multipole expansion of spacecraft b at sphere j, the gradient of the expansion
+                    // is taken to third order so that the force has the accuracy of the potential
+                    Eigen::Vector3d R = this->r_CN_NList.at(c) - this->r_CN_NList.at(b);
+                    double R2 = R.squaredNorm();
+                    double R3 = std::sqrt(R2)*R2;
+                    double R5 = R3*R2;
+                    double Q = this->monopoleList.at(b);
+                    const Eigen::Vector3d &p = this->dipoleList.at(b);
+                    Eigen::Vector3d x_j = this->r_SN_NList.at(j) - this->r_CN_NList.at(c);
+                    Eigen::Vector3d u = Q*x_j - p;
+                    Eigen::Matrix3d M = Q*x_j*x_j.transpose() - x_j*p.transpose() - p*x_j.transpose()
+                                        + this->quadrupoleList.at(b);
+                    Eigen::Vector3d MR = M*R;
+                    double RMR = R.dot(MR);
+                    force_N -= kc * q(j) * (-Q*R/R3 + (3.0*R.dot(u)*R - R2*u)/R5
+                                            - (15.0*RMR*R - 3.0*R2*(M.trace()*R + 2.0*MR))/(2.0*R5*R2));
+                    continue;
+                }
+                // loop over the spheres of the other spacecraft
+                long unsigned int ib = this->sphereStartList.at(b);
+                for (long unsigned int i=ib; i<ib + this->radiiList.at(b).size(); i++) {
+                    r_ij_N = this->r_SN_NList.at(i) - this->r_SN_NList.at(j);
                     r_ij = r_ij_N.norm();
                     // check if separation is larger then current MSM sphere radius
                     if (r_ij > this->radiiList.at(c).at(j-i0)) {
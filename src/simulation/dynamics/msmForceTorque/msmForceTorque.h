@@ -46,6 +46,13 @@ public:
 
 private:
     void readMessages();
+    void computeSpherePositions();
+    void solveChargesDense();
+    void solveChargesIterative();
+    void applyElastance(const Eigen::VectorXd &x, Eigen::VectorXd &y);
+    void applyBlockJacobi(const Eigen::VectorXd &x, Eigen::VectorXd &y);
+    void computeMultipoleMoments(const Eigen::VectorXd &x);
+    bool isFarField(unsigned int a, unsigned int b) const;
     
 public:
     std::vector<ReadFunctor<SCStatesMsgPayload>> scStateInMsgs; //!< vector of spacecraft state input messages
@@ -55,6 +62,12 @@ public:
     std::vector<Message<CmdForceInertialMsgPayload>*> eForceOutMsgs;    //!< vector of E-forces in inertial frame components
     std::vector<Message<ChargeMsmMsgPayload>*> chargeMsmOutMsgs;        //!< vector of spacecraft MSM charge values
 
+    bool useIterativeSolver;                                    //!< [-] flag to solve the charges with block-Jacobi preconditioned CG instead of the dense Cholesky solve, default false
+    double solverTolerance;                                     //!< [-] relative residual norm at which the iterative solve stops, default 1e-10
+    int maxSolverIterations;                                    //!< [-] maximum number of iterations of the iterative solve, default 100
+    double farFieldRatio;                                       //!< [-] with the iterative solver, spacecraft whose sphere cluster radii sum to less than farFieldRatio times their separation interact through a multipole expansion, default 0 (off)
+    int solverIterations;                                       //!< [-] number of iterations of the last iterative solve
+
     BSKLogger bskLogger;                                        //!< -- BSK Logging
 
 private:
@@ -65,6 +78,22 @@ private:
     std::vector<double> volt;                                   //!< [V] input voltage for each spacecrat object
     std::vector<Eigen::Vector3d> r_BN_NList;                    //!< [m] list of inertial satellite position vectors
     std::vector<Eigen::MRPd> sigma_BNList;                      //!< [m] list of satellite MRP orientations
+    std::vector<unsigned int> sphereStartList;                  //!< [] index of the first sphere of each satellite in the charge vector
+    std::vector<Eigen::Vector3d> r_SN_NList;                    //!< [m] list of inertial sphere locations
+    Eigen::MatrixXd S;                                          //!< [V/C] elastance matrix of the dense solve
+    Eigen::VectorXd V;                                          //!< [V] vector of sphere voltages
+    Eigen::VectorXd q;                                          //!< [C] vector of sphere charges, also the initial guess of the iterative solve
+    bool chargesInitialized;                                    //!< [-] flag if q holds the charges of a previous iterative solve
+
+    std::vector<Eigen::LLT<Eigen::MatrixXd>> selfElastanceFactors;  //!< [] Cholesky factors of the constant self-elastance block of each satellite
+    std::vector<Eigen::MatrixXd> selfElastanceList;             //!< [V/C] self-elastance block of each satellite
+    std::vector<Eigen::MatrixXd> mutualElastanceList;           //!< [V/C] elastance block between the spheres of satellites a < b, at a*numSat + b
+    std::vector<Eigen::Vector3d> r_CB_BList;                    //!< [m] body-fixed center of the MSM spheres of each satellite
+    std::vector<double> clusterRadiusList;                      //!< [m] radius about r_CB_B enclosing the sphere centers of each satellite
+    std::vector<Eigen::Vector3d> r_CN_NList;                    //!< [m] inertial sphere cluster center of each satellite
+    std::vector<double> monopoleList;                           //!< [C] net charge of each satellite in the multipole expansion
+    std::vector<Eigen::Vector3d> dipoleList;                    //!< [Cm] dipole about r_CN_N of each satellite
+    std::vector<Eigen::Matrix3d> quadrupoleList;                //!< [Cm^2] second moment about r_CN_N of each satellite
 };
 
 
@@ -23,6 +23,7 @@
 #include "architecture/utilities/avsEigenSupport.h"
 #include "architecture/utilities/avsEigenMRP.h"
 #include <iostream>
+#include <algorithm>
 
 
 /*! This is the constructor, setting variables to default values */
@@ -237,14 +238,27 @@ void Spacecraft::initializeDynamics()
     // - Register the gravity properties with the dynManager, 'erbody wants g_N!
     this->gravField.registerProperties(this->dynManager);
 
-    // - Register the hub states
+    // - Register the hub states, dropping the names recorded by a previous Reset
+    this->dynManager.registeredStateNames.clear();
     this->hub.registerStates(this->dynManager);
 
-    // - Loop through stateEffectors to register their states
+    // - Loop through stateEffectors to register their states, keeping track of the ones that are sub-cycled
+    this->fastStates.clear();
+    this->fastStateNames.clear();
+    this->fastSubCycles = 1;
     std::vector<StateEffector*>::iterator stateIt;
     for(stateIt = this->states.begin(); stateIt != this->states.end(); stateIt++)
     {
+        size_t firstStateIdx = this->dynManager.registeredStateNames.size();
         (*stateIt)->registerStates(this->dynManager);
+        if ((*stateIt)->fastSubCycles > 1)
+        {
+            this->fastStates.push_back(*stateIt);
+            this->fastStateNames.insert(this->fastStateNames.end(),
+                                        this->dynManager.registeredStateNames.begin() + firstStateIdx,
+                                        this->dynManager.registeredStateNames.end());
+            this->fastSubCycles = std::max(this->fastSubCycles, (*stateIt)->fastSubCycles);
+        }
     }
 
     // - Link in states for the Spacecraft, gravity and the hub
@@ -384,10 +398,14 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
         this->sumTorquePntB_B += (*dynIt)->torqueExternalPntB_B;
     }
 
-    // - Loop through state effectors to get contributions for back-substitution
+    // - Loop through the state effectors that are not sub-cycled to get contributions for back-substitution
     std::vector<StateEffector*>::iterator it;
     for(it = this->states.begin(); it != this->states.end(); it++)
     {
+        if (std::find(this->fastStates.begin(), this->fastStates.end(), *it) != this->fastStates.end())
+        {
+            continue;
+        }
         /* - Set the contribution matrices to zero (just in case a stateEffector += on the matrix or the stateEffector
          doesn't have a contribution for a matrix and doesn't set the matrix to zero */
         this->backSubContributions.matrixA.setZero();
@@ -407,6 +425,56 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
         this->hub.hubBackSubMatrices.vecRot += this->backSubContributions.vecRot;
     }
 
+    // - Keep the contributions of the effectors that are not sub-cycled for the fast equations of motion
+    this->slowBackSubContributions = this->hub.hubBackSubMatrices;
+    this->addFastContributions(integTimeSeconds);
+
+    // - Add the hub, gravity and external force and torque terms and solve for the derivatives
+    this->completeBackSubstitution(integTimeSeconds);
+
+    // - Loop through state effectors for compute derivatives
+    for(it = states.begin(); it != states.end(); it++)
+    {
+        (*it)->computeDerivatives(integTimeSeconds, this->hubV_N->getStateDeriv(), this->hubOmega_BN_B->getStateDeriv(), this->hubSigma->getState());
+    }
+
+    return;
+}
+
+/*! This method adds the back-substitution contributions of the sub-cycled stateEffectors to the hub matrices */
+void Spacecraft::addFastContributions(double integTimeSeconds)
+{
+    std::vector<StateEffector*>::iterator it;
+    for(it = this->fastStates.begin(); it != this->fastStates.end(); it++)
+    {
+        this->backSubContributions.matrixA.setZero();
+        this->backSubContributions.matrixB.setZero();
+        this->backSubContributions.matrixC.setZero();
+        this->backSubContributions.matrixD.setZero();
+        this->backSubContributions.vecTrans.setZero();
+        this->backSubContributions.vecRot.setZero();
+
+        (*it)->updateContributions(integTimeSeconds, this->backSubContributions, this->hubSigma->getState(), this->hubOmega_BN_B->getState(), *this->g_N);
+        this->hub.hubBackSubMatrices.matrixA += this->backSubContributions.matrixA;
+        this->hub.hubBackSubMatrices.matrixB += this->backSubContributions.matrixB;
+        this->hub.hubBackSubMatrices.matrixC += this->backSubContributions.matrixC;
+        this->hub.hubBackSubMatrices.matrixD += this->backSubContributions.matrixD;
+        this->hub.hubBackSubMatrices.vecTrans += this->backSubContributions.vecTrans;
+        this->hub.hubBackSubMatrices.vecRot += this->backSubContributions.vecRot;
+    }
+
+    return;
+}
+
+/*! This method adds the hub, gravity and external force and torque terms to the back-substitution matrices, which
+ already hold the stateEffector contributions, and computes the hub state derivatives */
+void Spacecraft::completeBackSubstitution(double integTimeSeconds)
+{
+    Eigen::MRPd sigmaBNLoc;
+    Eigen::Matrix3d dcm_NB;
+    sigmaBNLoc = (Eigen::Vector3d) this->hubSigma->getState();
+    dcm_NB = sigmaBNLoc.toRotationMatrix();
+
     // - Finish the math that is needed
     Eigen::Vector3d cLocal_B;
     Eigen::Vector3d cPrimeLocal_B;
@@ -448,8 +516,28 @@ void Spacecraft::equationsOfMotion(double integTimeSeconds, double timeStep)
     // - Compute the derivatives of the hub states before looping through stateEffectors
     this->hub.computeDerivatives(integTimeSeconds, this->hubV_N->getStateDeriv(), this->hubOmega_BN_B->getStateDeriv(), this->hubSigma->getState());
 
-    // - Loop through state effectors for compute derivatives
-    for(it = states.begin(); it != states.end(); it++)
+    return;
+}
+
+/*! This method computes the state derivatives of the sub-cycled stateEffectors only. It is called by a multi-rate
+ integrator between the evaluations of the full equations of motion. The hub accelerations are solved for again so that
+ the fast effectors stay coupled to the hub, but gravity, the dynamicEffectors and the stateEffectors that are not
+ sub-cycled keep the contributions found in the last call to equationsOfMotion(). */
+void Spacecraft::fastEquationsOfMotion(double integTimeSeconds, double timeStep)
+{
+    // - Update time to the current time
+    uint64_t integTimeNanos = this->simTimePrevious + (uint64_t) ((integTimeSeconds-this->timePrevious)/NANO2SEC);
+    (*this->sysTime) << (double) integTimeNanos, integTimeSeconds;
+
+    // - Start from the held contributions and add the ones of the sub-cycled effectors
+    this->updateSCMassProps(integTimeSeconds);
+    this->hub.hubBackSubMatrices = this->slowBackSubContributions;
+    this->addFastContributions(integTimeSeconds);
+    this->completeBackSubstitution(integTimeSeconds);
+
+    // - Loop through the sub-cycled state effectors to compute their derivatives
+    std::vector<StateEffector*>::iterator it;
+    for(it = this->fastStates.begin(); it != this->fastStates.end(); it++)
     {
         (*it)->computeDerivatives(integTimeSeconds, this->hubV_N->getStateDeriv(), this->hubOmega_BN_B->getStateDeriv(), this->hubSigma->getState());
     }
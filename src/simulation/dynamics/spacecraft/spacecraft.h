@@ -56,6 +56,7 @@ public:
     double currTimeStep;                 //!< [s] Time after integration, used for dvAccum calculation
     double timePrevious;                 //!< [s] Time before integration, used for dvAccum calculation
     BackSubMatrices backSubContributions;//!< class variable
+    BackSubMatrices slowBackSubContributions;//!< -- Back-sub contributions of the stateEffectors that are not sub-cycled
     Eigen::Vector3d sumForceExternal_N;  //!< [N] Sum of forces given in the inertial frame
     Eigen::Vector3d sumForceExternal_B;  //!< [N] Sum of forces given in the body frame
     Eigen::Vector3d sumTorquePntB_B;     //!< [N-m] Total torque about point B in B frame components
@@ -71,6 +72,7 @@ public:
     GravityEffector gravField;           //!< -- Gravity effector for gravitational field experienced by spacecraft
     std::vector<StateEffector*> states;               //!< -- Vector of state effectors attached to dynObject
     std::vector<DynamicEffector*> dynEffectors;       //!< -- Vector of dynamic effectors attached to dynObject
+    std::vector<StateEffector*> fastStates;           //!< -- State effectors that are sub-cycled by a multi-rate integrator
     BSKLogger bskLogger;                      //!< -- BSK Logging
     Message<SCStatesMsgPayload> scStateOutMsg;      //!< spacecraft state output message
     Message<SCMassPropsMsgPayload> scMassOutMsg;    //!< spacecraft mass properties output message
@@ -87,6 +89,7 @@ public:
     void UpdateState(uint64_t CurrentSimNanos);  //!< -- Runtime hook back into Basilisk arch
     void linkInStates(DynParamManager& statesIn);  //!< Method to get access to the hub's states
     void equationsOfMotion(double integTimeSeconds, double timeStep);    //!< -- This method computes the equations of motion for the whole system
+    void fastEquationsOfMotion(double integTimeSeconds, double timeStep);    //!< -- This method computes the equations of motion of the sub-cycled stateEffectors
     void integrateState(double time);       //!< -- This method steps the state forward one step in time
     void addStateEffector(StateEffector *newSateEffector);  //!< -- Attaches a stateEffector to the system
     void addDynamicEffector(DynamicEffector *newDynamicEffector);  //!< -- Attaches a dynamicEffector
@@ -113,6 +116,8 @@ private:
     Eigen::MatrixXd *sysTime;            //!< [s] System time
 
 private:
+    void addFastContributions(double integTimeSeconds);  //!< -- Adds the back-sub contributions of the sub-cycled stateEffectors
+    void completeBackSubstitution(double integTimeSeconds);  //!< -- Adds the hub terms and computes the hub derivatives
     void readOptionalRefMsg();                  //!< -- Read the optional attitude or translational reference input message and set the reference states
 };
 
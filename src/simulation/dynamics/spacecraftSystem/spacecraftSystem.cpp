@@ -432,6 +432,9 @@ void SpacecraftSystem::initializeDynamics()
     systemTime.setZero();
     this->sysTime = this->dynManager.createProperty(this->sysTimePropertyName, systemTime);
 
+    // - Drop the state names recorded by a previous Reset before the spacecraft register their states
+    this->dynManager.registeredStateNames.clear();
+
     // - Call initializeDynamics for primary spacecraft
     this->primaryCentralSpacecraft.initializeDynamicsSC(this->dynManager);
 
@@ -0,0 +1,192 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import time
+
+import numpy as np
+import pytest
+from Basilisk.architecture import messaging
+from Basilisk.simulation import conjunctionScreening
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+
+mu = orbitalMotion.MU_EARTH * 1e9
+radius = orbitalMotion.REQ_EARTH * 1000. + 600. * 1000
+meanMotion = np.sqrt(mu / radius**3)
+
+
+def crossingState(t, inclination, phase):
+    """Returns the state on a circular orbit that crosses the x axis at the time phase / meanMotion"""
+    u = meanMotion * t - phase
+    r = radius * np.array([np.cos(u), np.sin(u) * np.cos(inclination), np.sin(u) * np.sin(inclination)])
+    v = radius * meanMotion * np.array([-np.sin(u), np.cos(u) * np.cos(inclination), np.cos(u) * np.sin(inclination)])
+    return r, v
+
+
+def closestApproach(inclination, phase):
+    """Returns the time, miss distance and relative speed of the closest approach of an equatorial orbit and an
+    inclined orbit both crossing the x axis, from the relative motion in closed form"""
+    t = np.linspace(-100., 100., 200001)
+    rA = crossingState(t, 0.0, 0.0)[0]
+    rB = crossingState(t, inclination, phase)[0]
+    k = np.argmin(np.linalg.norm(rB - rA, axis=0))
+    tca = t[k - 1:k + 2]
+    dist = np.linalg.norm((rB - rA)[:, k - 1:k + 2], axis=0)
+    # quadratic fit through the three samples around the minimum
+    coeffs = np.polyfit(tca - tca[1], dist**2, 2)
+    tMin = tca[1] - coeffs[1] / (2 * coeffs[0])
+    rA, vA = crossingState(tMin, 0.0, 0.0)
+    rB, vB = crossingState(tMin, inclination, phase)
+    return tMin, np.linalg.norm(rB - rA), np.linalg.norm(vB - vA)
+
+
+def runScreening(phase, catalogObject, screenCatalogPairs=False, timeStep=1., duration=200.):
+    """Runs the screening of an equatorial spacecraft against a polar spacecraft or catalog object that pass the
+    x axis at nearly the same time, with the planet away from the inertial origin"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(timeStep)))
+
+    module = conjunctionScreening.ConjunctionScreening()
+    module.ModelTag = "conjunctionScreening"
+    module.screeningDistance = 5. * 1000
+    module.mu = mu
+    module.screenCatalogPairs = screenCatalogPairs
+    scSim.AddModelToTask("simTask", module)
+
+    planetPos = np.array([orbitalMotion.AU * 1000, 0.0, 0.0])
+    planetVel = np.array([0.0, 30. * 1000, 0.0])
+    planetData = messaging.SpicePlanetStateMsgPayload()
+    planetData.PositionVector = list(planetPos)
+    planetData.VelocityVector = list(planetVel)
+    planetMsg = messaging.SpicePlanetStateMsg().write(planetData)
+    module.planetInMsg.subscribeTo(planetMsg)
+
+    # the crossing of the x axis is 100 seconds into the simulation
+    t0 = -100.
+    scMsgs = []
+    if screenCatalogPairs:
+        module.addCatalogObject(*crossingState(t0, 0.0, 0.0))
+    else:
+        scMsgs.append(messaging.SCStatesMsg())
+        module.addSpacecraftToModel(scMsgs[-1])
+    if catalogObject:
+        module.addCatalogObject(*crossingState(t0, np.pi / 2, phase))
+    else:
+        scMsgs.append(messaging.SCStatesMsg())
+        module.addSpacecraftToModel(scMsgs[-1])
+
+    scSim.InitializeSimulation()
+
+    events = []
+    for step in range(int(duration / timeStep) + 1):
+        t = t0 + step * timeStep
+        for scMsg, (inclination, scPhase) in zip(scMsgs, [(0.0, 0.0), (np.pi / 2, phase)]):
+            r, v = crossingState(t, inclination, scPhase)
+            scData = messaging.SCStatesMsgPayload()
+            scData.r_BN_N = list(planetPos + r)
+            scData.v_BN_N = list(planetVel + v)
+            scMsg.write(scData)
+        scSim.TotalSim.SingleStepProcesses()
+        eventData = module.conjunctionOutMsg.read()
+        for k in range(eventData.numEvents):
+            events.append((eventData.objectA[k], eventData.objectB[k], eventData.timeOfClosestApproach[k],
+                           eventData.missDistance[k], eventData.relativeSpeed[k]))
+    return events
+
+
+@pytest.mark.parametrize("catalogObject", [False, True])
+@pytest.mark.parametrize("missDistance", [500., 3000., 8000.])
+def test_conjunctionScreening(catalogObject, missDistance):
+    """
+    Tests whether conjunctionScreening:
+
+    1. finds the time of closest approach, the miss distance and the relative speed of two spacecraft, or of a
+       spacecraft and a catalog object, from the states at the updates
+    2. reports a close approach once, and only if the miss distance is below the screening distance
+    3. accounts for the planet position and velocity
+
+    :return:
+    """
+    phase = missDistance / radius * np.sqrt(2)
+    tca, miss, speed = closestApproach(np.pi / 2, phase)
+    events = runScreening(phase, catalogObject)
+
+    if miss > 5. * 1000:
+        assert len(events) == 0
+        return
+    assert len(events) == 1
+    objectA, objectB, eventTime, eventMiss, eventSpeed = events[0]
+    assert (objectA, objectB) == (0, 1)
+    np.testing.assert_allclose(eventTime, tca + 100., atol=1e-3)
+    np.testing.assert_allclose(eventMiss, miss, atol=0.1)
+    np.testing.assert_allclose(eventSpeed, speed, rtol=1e-6)
+
+
+@pytest.mark.parametrize("screenCatalogPairs", [False, True])
+def test_conjunctionScreeningCatalogPairs(screenCatalogPairs):
+    """
+    Tests whether conjunctionScreening only screens the catalog objects against each other if
+    ``screenCatalogPairs`` is set
+
+    :return:
+    """
+    phase = 1000. / radius
+    events = runScreening(phase, True, screenCatalogPairs)
+    assert len(events) == (1 if screenCatalogPairs else 0)
+
+
+def screeningBenchmark(numObjects, timeStep=10., numSteps=10, screeningDistance=10. * 1000):
+    """Prints the time per update of the screening of randomly oriented low Earth orbits, given as a catalog"""
+    rng = np.random.default_rng(1)
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(timeStep)))
+    module = conjunctionScreening.ConjunctionScreening()
+    module.screeningDistance = screeningDistance
+    module.mu = mu
+    module.screenCatalogPairs = True
+    scSim.AddModelToTask("simTask", module)
+
+    oe = orbitalMotion.ClassicElements()
+    for k in range(numObjects):
+        oe.a = orbitalMotion.REQ_EARTH * 1000. + rng.uniform(400., 500.) * 1000
+        oe.e = rng.uniform(0., 0.005)
+        oe.i = rng.uniform(0., np.pi)
+        oe.Omega = rng.uniform(0., 2 * np.pi)
+        oe.omega = rng.uniform(0., 2 * np.pi)
+        oe.f = rng.uniform(0., 2 * np.pi)
+        r, v = orbitalMotion.elem2rv(mu, oe)
+        module.addCatalogObject(r, v)
+    scSim.InitializeSimulation()
+
+    numEvents = 0
+    start = time.perf_counter()
+    for step in range(numSteps):
+        scSim.TotalSim.SingleStepProcesses()
+        numEvents += module.conjunctionOutMsg.read().numEvents
+    stepTime = (time.perf_counter() - start) / numSteps
+    print("%6d objects: %7.2f ms per update, %5d refined pairs in the last update, %4d close approaches"
+          % (numObjects, stepTime * 1e3, module.numRefinedPairs, numEvents))
+
+
+if __name__ == "__main__":
+    test_conjunctionScreening(True, 500.)
+    for numObjects in [1000, 3000, 10000]:
+        screeningBenchmark(numObjects)
@@ -0,0 +1,381 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "simulation/environment/conjunctionScreening/conjunctionScreening.h"
+#include "architecture/utilities/macroDefinitions.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*! offset and bit width of the cell coordinates packed into a grid cell key */
+static const int64_t cellOffset = 1 << 20;
+static const int cellBits = 21;
+
+/*! number of intervals in which the closest approaches of a pair are bracketed within a step */
+static const int numBrackets = 8;
+
+/*! pack the grid cell coordinates into a key */
+static int64_t cellKey(int64_t ix, int64_t iy, int64_t iz)
+{
+    return ((ix + cellOffset) << (2*cellBits)) | ((iy + cellOffset) << cellBits) | (iz + cellOffset);
+}
+
+/*! key of the grid cell that contains a position */
+static int64_t cellKey(const Eigen::Vector3d &r, double cellSize)
+{
+    return cellKey((int64_t) std::floor(r[0]/cellSize), (int64_t) std::floor(r[1]/cellSize),
+                   (int64_t) std::floor(r[2]/cellSize));
+}
+
+/*! osculating periapsis and apoapsis radius of a state, the apoapsis radius is infinite for open orbits */
+static void periApoRadius(double mu, const Eigen::Vector3d &r, const Eigen::Vector3d &v, double &rPeri, double &rApo)
+{
+    double rNorm = r.norm();
+    double energy = v.squaredNorm()/2.0 - mu/rNorm;
+    double h2 = r.cross(v).squaredNorm();
+    double p = h2/mu;
+    double e = std::sqrt(std::max(0.0, 1.0 + 2.0*energy*h2/(mu*mu)));
+    rPeri = std::min(p/(1.0 + e), rNorm);
+    rApo = e < 1.0 ? std::max(p/(1.0 - e), rNorm) : std::numeric_limits<double>::infinity();
+}
+
+/*! @brief Creates an instance of the ConjunctionScreening class
+ @return void
+ */
+ConjunctionScreening::ConjunctionScreening()
+{
+    this->screeningDistance = -1.0;
+    this->mu = -1.0;
+    this->screenCatalogPairs = false;
+    this->numRefinedPairs = 0;
+    this->catalogEpoch = 0;
+    this->numObjects = 0;
+    this->hasPreviousStates = false;
+    this->previousTime = 0;
+    this->stepTime = 0.0;
+    this->cellSize = 0.0;
+}
+
+/*! Empty destructor method.
+ @return void
+ */
+ConjunctionScreening::~ConjunctionScreening()
+{
+    return;
+}
+
+/*! Reset the module, check the parameters and compute the orbit elements of the catalog objects
+ @param CurrentSimNanos
+ */
+void ConjunctionScreening::Reset(uint64_t CurrentSimNanos)
+{
+    if (this->scStateInMsgs.size() + this->catalogPosList.size() < 2) {
+        bskLogger.bskLog(BSK_ERROR, "ConjunctionScreening must have 2 or more spacecraft or catalog objects");
+    }
+    if (this->screeningDistance <= 0.0) {
+        bskLogger.bskLog(BSK_ERROR, "ConjunctionScreening screeningDistance must be set to a positive distance");
+    }
+    if (this->catalogPosList.size() > 0 && this->mu <= 0.0) {
+        bskLogger.bskLog(BSK_ERROR, "ConjunctionScreening mu must be set to propagate the catalog objects");
+    }
+
+    /* the catalog objects move on Keplerian orbits from the catalog states at the time of the reset */
+    this->catalogEpoch = CurrentSimNanos;
+    this->catalogElements.resize(this->catalogPosList.size());
+    this->catalogMeanAnomaly.resize(this->catalogPosList.size());
+    for (long unsigned int c = 0; c < this->catalogPosList.size() && this->mu > 0.0; c++) {
+        rv2elem(this->mu, this->catalogPosList.at(c).data(), this->catalogVelList.at(c).data(),
+                &this->catalogElements.at(c));
+        if (this->catalogElements.at(c).e >= 1.0) {
+            bskLogger.bskLog(BSK_ERROR, "ConjunctionScreening catalog object %d is not on an elliptic orbit", (int) c);
+        }
+        this->catalogMeanAnomaly.at(c) = E2M(f2E(this->catalogElements.at(c).f, this->catalogElements.at(c).e),
+                                             this->catalogElements.at(c).e);
+    }
+
+    this->numObjects = (int) (this->scStateInMsgs.size() + this->catalogPosList.size());
+    this->r0List.resize(this->numObjects);
+    this->v0List.resize(this->numObjects);
+    this->r1List.resize(this->numObjects);
+    this->v1List.resize(this->numObjects);
+    this->rPeri0List.resize(this->numObjects);
+    this->rApo0List.resize(this->numObjects);
+    this->rPeri1List.resize(this->numObjects);
+    this->rApo1List.resize(this->numObjects);
+    this->boxMinList.resize(this->numObjects);
+    this->boxMaxList.resize(this->numObjects);
+    this->hasPreviousStates = false;
+    this->numRefinedPairs = 0;
+}
+
+/*! Subscribe to the state message of a spacecraft.  The spacecraft are numbered in the order in which they are added.
+ @param tmpScMsg spacecraft state message
+ */
+void ConjunctionScreening::addSpacecraftToModel(Message<SCStatesMsgPayload> *tmpScMsg)
+{
+    this->scStateInMsgs.push_back(tmpScMsg->addSubscriber());
+}
+
+/*! Add a passive object to the catalog.  The catalog objects are numbered after the spacecraft, in the order in
+    which they are added.
+ @param r_OP_N [m] position of the object relative to the planet at the time the simulation is initialized
+ @param v_OP_N [m/s] velocity of the object relative to the planet at the time the simulation is initialized
+ */
+void ConjunctionScreening::addCatalogObject(Eigen::Vector3d r_OP_N, Eigen::Vector3d v_OP_N)
+{
+    this->catalogPosList.push_back(r_OP_N);
+    this->catalogVelList.push_back(v_OP_N);
+}
+
+/*! Propagate the catalog objects along their Keplerian orbits to the current time
+ @param CurrentSimNanos
+ */
+void ConjunctionScreening::propagateCatalog(uint64_t CurrentSimNanos)
+{
+    double dt = (double) (CurrentSimNanos - this->catalogEpoch) * NANO2SEC;
+    int numSc = (int) this->scStateInMsgs.size();
+    for (int c = 0; c < (int) this->catalogElements.size(); c++) {
+        classicElements elements = this->catalogElements.at(c);
+        double M = std::fmod(this->catalogMeanAnomaly.at(c) + std::sqrt(this->mu/std::pow(elements.a, 3))*dt, 2*M_PI);
+        elements.f = E2f(M2E(M, elements.e), elements.e);
+        elem2rv(this->mu, &elements, this->r1List.at(numSc + c).data(), this->v1List.at(numSc + c).data());
+    }
+}
+
+/*! Read the spacecraft states and propagate the catalog, keeping the states of the previous update
+ @param CurrentSimNanos
+ */
+void ConjunctionScreening::readStates(uint64_t CurrentSimNanos)
+{
+    std::swap(this->r0List, this->r1List);
+    std::swap(this->v0List, this->v1List);
+    std::swap(this->rPeri0List, this->rPeri1List);
+    std::swap(this->rApo0List, this->rApo1List);
+
+    //! - Read in the optional planet message.  if no planet message is set, then a zero planet state is assumed
+    Eigen::Vector3d r_PN_N = Eigen::Vector3d::Zero();
+    Eigen::Vector3d v_PN_N = Eigen::Vector3d::Zero();
+    if (this->planetInMsg.isLinked()) {
+        const SpicePlanetStateMsgPayload &planetState = this->planetInMsg();
+        r_PN_N = Eigen::Map<const Eigen::Vector3d>(planetState.PositionVector);
+        v_PN_N = Eigen::Map<const Eigen::Vector3d>(planetState.VelocityVector);
+    }
+
+    for (long unsigned int c = 0; c < this->scStateInMsgs.size(); c++) {
+        const SCStatesMsgPayload &scState = this->scStateInMsgs.at(c)();
+        this->r1List.at(c) = Eigen::Map<const Eigen::Vector3d>(scState.r_BN_N) - r_PN_N;
+        this->v1List.at(c) = Eigen::Map<const Eigen::Vector3d>(scState.v_BN_N) - v_PN_N;
+    }
+    this->propagateCatalog(CurrentSimNanos);
+
+    for (int k = 0; k < this->numObjects; k++) {
+        if (this->mu > 0.0) {
+            periApoRadius(this->mu, this->r1List[k], this->v1List[k], this->rPeri1List[k], this->rApo1List[k]);
+        } else {
+            this->rPeri1List[k] = 0.0;
+            this->rApo1List[k] = std::numeric_limits<double>::infinity();
+        }
+    }
+}
+
+/*! Sort the objects into a uniform grid of cubic cells.  The path of an object over the step is the cubic Hermite
+    curve through its states at both updates, which lies in the convex hull of its Bezier control points.  The box
+    around these control points, grown by half the screening distance, is added to each cell it overlaps.  The cell
+    size is the largest box size, so each box overlaps at most 8 cells.
+ */
+void ConjunctionScreening::buildGrid()
+{
+    double h3 = this->stepTime/3.0;
+    double maxSize = 0.0;
+    double extent = 0.0;
+    for (int k = 0; k < this->numObjects; k++) {
+        Eigen::Vector3d p1 = this->r0List[k] + h3*this->v0List[k];
+        Eigen::Vector3d p2 = this->r1List[k] - h3*this->v1List[k];
+        Eigen::Vector3d boxMin = this->r0List[k].cwiseMin(this->r1List[k]).cwiseMin(p1).cwiseMin(p2);
+        Eigen::Vector3d boxMax = this->r0List[k].cwiseMax(this->r1List[k]).cwiseMax(p1).cwiseMax(p2);
+        this->boxMinList[k] = boxMin.array() - this->screeningDistance/2.0;
+        this->boxMaxList[k] = boxMax.array() + this->screeningDistance/2.0;
+        maxSize = std::max(maxSize, (this->boxMaxList[k] - this->boxMinList[k]).maxCoeff());
+        extent = std::max(extent, std::max(this->boxMinList[k].cwiseAbs().maxCoeff(), this->boxMaxList[k].cwiseAbs().maxCoeff()));
+    }
+    /* keep the cell coordinates within the bits of the cell keys */
+    this->cellSize = std::max(maxSize, extent / (double) (cellOffset/2));
+
+    this->cellList.clear();
+    for (int k = 0; k < this->numObjects; k++) {
+        Eigen::Vector3d cellMin = this->boxMinList[k] / this->cellSize;
+        Eigen::Vector3d cellMax = this->boxMaxList[k] / this->cellSize;
+        for (int64_t ix = (int64_t) std::floor(cellMin[0]); ix <= (int64_t) std::floor(cellMax[0]); ix++) {
+            for (int64_t iy = (int64_t) std::floor(cellMin[1]); iy <= (int64_t) std::floor(cellMax[1]); iy++) {
+                for (int64_t iz = (int64_t) std::floor(cellMin[2]); iz <= (int64_t) std::floor(cellMax[2]); iz++) {
+                    this->cellList.push_back(std::make_pair(cellKey(ix, iy, iz), k));
+                }
+            }
+        }
+    }
+    std::sort(this->cellList.begin(), this->cellList.end());
+}
+
+/*! Screen the pairs of objects whose boxes overlap.  A pair is screened in the cell that contains the lower
+    corner of the overlap of their boxes, so it is screened once although both boxes can share several cells.
+ */
+void ConjunctionScreening::screenGrid()
+{
+    for (long unsigned int begin = 0; begin < this->cellList.size(); ) {
+        int64_t key = this->cellList[begin].first;
+        long unsigned int end = begin;
+        while (end < this->cellList.size() && this->cellList[end].first == key) {
+            end++;
+        }
+        for (long unsigned int m = begin; m < end; m++) {
+            int a = this->cellList[m].second;
+            for (long unsigned int n = m + 1; n < end; n++) {
+                int b = this->cellList[n].second;
+                if ((this->boxMinList[a].array() > this->boxMaxList[b].array()).any()
+                    || (this->boxMinList[b].array() > this->boxMaxList[a].array()).any()) {
+                    continue;
+                }
+                if (cellKey(this->boxMinList[a].cwiseMax(this->boxMinList[b]), this->cellSize) != key) {
+                    continue;
+                }
+                this->screenPair(a, b);
+            }
+        }
+        begin = end;
+    }
+}
+
+/*! Find the closest approaches of a pair of objects within the step.  The relative position of the pair is a cubic
+    Hermite polynomial of the normalized step time, and the closest approaches are the roots of the quintic
+    polynomial of the relative position times the relative velocity where it changes from negative to positive.
+ @param a index of the first object, lower than b
+ @param b index of the second object
+ */
+void ConjunctionScreening::screenPair(int a, int b)
+{
+    int numSc = (int) this->scStateInMsgs.size();
+    if (a >= numSc && !this->screenCatalogPairs) {
+        return;
+    }
+
+    /* perigee and apogee filter, the radius bands of both objects over the step must be close enough */
+    double rPeriA = std::min(this->rPeri0List[a], this->rPeri1List[a]);
+    double rApoA = std::max(this->rApo0List[a], this->rApo1List[a]);
+    double rPeriB = std::min(this->rPeri0List[b], this->rPeri1List[b]);
+    double rApoB = std::max(this->rApo0List[b], this->rApo1List[b]);
+    if (rPeriB - rApoA > this->screeningDistance || rPeriA - rApoB > this->screeningDistance) {
+        return;
+    }
+
+    /* the relative path lies in the hull of its control points, which must come within the screening distance */
+    double h = this->stepTime;
+    Eigen::Vector3d p0 = this->r0List[b] - this->r0List[a];
+    Eigen::Vector3d m0 = h*(this->v0List[b] - this->v0List[a]);
+    Eigen::Vector3d p1 = this->r1List[b] - this->r1List[a];
+    Eigen::Vector3d m1 = h*(this->v1List[b] - this->v1List[a]);
+    Eigen::Vector3d boxMin = p0.cwiseMin(p1).cwiseMin(p0 + m0/3.0).cwiseMin(p1 - m1/3.0);
+    Eigen::Vector3d boxMax = p0.cwiseMax(p1).cwiseMax(p0 + m0/3.0).cwiseMax(p1 - m1/3.0);
+    Eigen::Vector3d closest = boxMin.cwiseMax(Eigen::Vector3d::Zero()) + boxMax.cwiseMin(Eigen::Vector3d::Zero());
+    if (closest.squaredNorm() > this->screeningDistance*this->screeningDistance) {
+        return;
+    }
+    this->numRefinedPairs++;
+
+    /* relative position d = c3 t^3 + c2 t^2 + c1 t + c0 and the quintic g = d . d' */
+    Eigen::Vector3d c3 = 2.0*p0 + m0 - 2.0*p1 + m1;
+    Eigen::Vector3d c2 = -3.0*p0 - 2.0*m0 + 3.0*p1 - m1;
+    const Eigen::Vector3d &c1 = m0;
+    const Eigen::Vector3d &c0 = p0;
+    double g[6] = {c0.dot(c1), c1.dot(c1) + 2.0*c0.dot(c2), 3.0*(c1.dot(c2) + c0.dot(c3)),
+                   4.0*c1.dot(c3) + 2.0*c2.dot(c2), 5.0*c2.dot(c3), 3.0*c3.dot(c3)};
+    auto quintic = [&g](double t) {
+        return ((((g[5]*t + g[4])*t + g[3])*t + g[2])*t + g[1])*t + g[0];
+    };
+
+    double tLow = 0.0;
+    double gLow = quintic(tLow);
+    for (int k = 1; k <= numBrackets; k++) {
+        double tHigh = (double) k / numBrackets;
+        double gHigh = quintic(tHigh);
+        if (gLow < 0.0 && gHigh >= 0.0) {
+            /* bisect the bracket of the closest approach */
+            double t0 = tLow;
+            double t1 = tHigh;
+            for (int iter = 0; iter < 40; iter++) {
+                double t = 0.5*(t0 + t1);
+                if (quintic(t) < 0.0) {
+                    t0 = t;
+                } else {
+                    t1 = t;
+                }
+            }
+            double t = 0.5*(t0 + t1);
+            Eigen::Vector3d d = ((c3*t + c2)*t + c1)*t + c0;
+            if (d.norm() <= this->screeningDistance) {
+                Eigen::Vector3d dPrime = (3.0*c3*t + 2.0*c2)*t + c1;
+                ConjunctionEvent event;
+                event.time = (double) this->previousTime * NANO2SEC + t*h;
+                event.objectA = a;
+                event.objectB = b;
+                event.missDistance = d.norm();
+                event.relativeSpeed = dPrime.norm()/h;
+                this->eventList.push_back(event);
+            }
+        }
+        tLow = tHigh;
+        gLow = gHigh;
+    }
+}
+
+/*!
+ update module
+ @param CurrentSimNanos
+ */
+void ConjunctionScreening::UpdateState(uint64_t CurrentSimNanos)
+{
+    this->readStates(CurrentSimNanos);
+
+    this->eventList.clear();
+    this->numRefinedPairs = 0;
+    if (this->hasPreviousStates && CurrentSimNanos > this->previousTime) {
+        this->stepTime = (double) (CurrentSimNanos - this->previousTime) * NANO2SEC;
+        this->buildGrid();
+        this->screenGrid();
+    }
+    this->hasPreviousStates = true;
+    this->previousTime = CurrentSimNanos;
+
+    /* report the close approaches in the order of their time */
+    std::sort(this->eventList.begin(), this->eventList.end());
+    this->eventBuffer.numEvents = (int) this->eventList.size();
+    this->eventBuffer.objectA.resize(this->eventList.size());
+    this->eventBuffer.objectB.resize(this->eventList.size());
+    this->eventBuffer.timeOfClosestApproach.resize(this->eventList.size());
+    this->eventBuffer.missDistance.resize(this->eventList.size());
+    this->eventBuffer.relativeSpeed.resize(this->eventList.size());
+    for (long unsigned int k = 0; k < this->eventList.size(); k++) {
+        this->eventBuffer.objectA[k] = this->eventList[k].objectA;
+        this->eventBuffer.objectB[k] = this->eventList[k].objectB;
+        this->eventBuffer.timeOfClosestApproach[k] = this->eventList[k].time;
+        this->eventBuffer.missDistance[k] = this->eventList[k].missDistance;
+        this->eventBuffer.relativeSpeed[k] = this->eventList[k].relativeSpeed;
+    }
+    this->conjunctionOutMsg.write(&this->eventBuffer, this->moduleID, CurrentSimNanos);
+}
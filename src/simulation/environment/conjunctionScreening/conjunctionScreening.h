@@ -0,0 +1,106 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+#ifndef CONJUNCTION_SCREENING_H
+#define CONJUNCTION_SCREENING_H
+
+#include <Eigen/Dense>
+#include <vector>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+
+#include "architecture/msgPayloadDefC/SpicePlanetStateMsgPayload.h"
+#include "architecture/msgPayloadDefC/SCStatesMsgPayload.h"
+#include "architecture/msgPayloadDefCpp/ConjunctionEventsMsgPayload.h"
+#include "architecture/messaging/messaging.h"
+
+#include "architecture/utilities/orbitalMotion.h"
+#include "architecture/utilities/bskLogging.h"
+
+/*! @brief conjunction screening class, which finds the close approaches of a set of spacecraft and an optional
+    catalog of passive objects between consecutive updates */
+class ConjunctionScreening:  public SysModel {
+public:
+    ConjunctionScreening();
+    ~ConjunctionScreening();
+    void UpdateState(uint64_t CurrentSimNanos);
+    void Reset(uint64_t CurrentSimNanos);
+    void addSpacecraftToModel(Message<SCStatesMsgPayload> *tmpScMsg);
+    void addCatalogObject(Eigen::Vector3d r_OP_N, Eigen::Vector3d v_OP_N);
+
+private:
+    /*! close approach found in an update */
+    struct ConjunctionEvent {
+        double time;                //!< [s] simulation time of the closest approach
+        int objectA;                //!< [-] index of the first object
+        int objectB;                //!< [-] index of the second object
+        double missDistance;        //!< [m] distance at the closest approach
+        double relativeSpeed;       //!< [m/s] relative speed at the closest approach
+        bool operator<(const ConjunctionEvent &other) const {
+            return time < other.time || (time == other.time && (objectA < other.objectA
+                   || (objectA == other.objectA && objectB < other.objectB)));
+        }
+    };
+
+    void readStates(uint64_t CurrentSimNanos);
+    void propagateCatalog(uint64_t CurrentSimNanos);
+    void buildGrid();
+    void screenGrid();
+    void screenPair(int a, int b);
+
+public:
+    double screeningDistance;       //!< [m] miss distance below which a close approach is reported
+    double mu;                      //!< [m^3/s^2] gravitational constant of the planet, used by the perigee and apogee filter and to propagate the catalog
+    bool screenCatalogPairs;        //!< [-] flag to also screen the catalog objects against each other, default false
+    int numRefinedPairs;            //!< [-] number of pairs whose closest approach was refined in the last update
+
+    ReadFunctor<SpicePlanetStateMsgPayload> planetInMsg;        //!< (optional) planet state input message
+    std::vector<ReadFunctor<SCStatesMsgPayload>> scStateInMsgs; //!< vector of spacecraft state input messages
+    Message<ConjunctionEventsMsgPayload> conjunctionOutMsg;     //!< close approaches found in the last update
+
+    BSKLogger bskLogger;            //!< -- BSK Logging
+
+private:
+    std::vector<Eigen::Vector3d> catalogPosList;    //!< [m] positions of the catalog objects relative to the planet at the catalog epoch
+    std::vector<Eigen::Vector3d> catalogVelList;    //!< [m/s] velocities of the catalog objects relative to the planet at the catalog epoch
+    std::vector<classicElements> catalogElements;   //!< orbit elements of the catalog objects at the catalog epoch
+    std::vector<double> catalogMeanAnomaly;         //!< [rad] mean anomaly of the catalog objects at the catalog epoch
+    uint64_t catalogEpoch;                          //!< [ns] simulation time of the catalog states, set in Reset()
+    int numObjects;                                 //!< [-] number of spacecraft and catalog objects
+    bool hasPreviousStates;                         //!< [-] flag if the states of a previous update are available
+    uint64_t previousTime;                          //!< [ns] simulation time of the previous update
+    double stepTime;                                //!< [s] time between the previous and the current update
+    std::vector<Eigen::Vector3d> r0List;            //!< [m] object positions relative to the planet at the previous update
+    std::vector<Eigen::Vector3d> v0List;            //!< [m/s] object velocities relative to the planet at the previous update
+    std::vector<Eigen::Vector3d> r1List;            //!< [m] object positions relative to the planet at the current update
+    std::vector<Eigen::Vector3d> v1List;            //!< [m/s] object velocities relative to the planet at the current update
+    std::vector<double> rPeri0List;                 //!< [m] osculating periapsis radius of the objects at the previous update
+    std::vector<double> rApo0List;                  //!< [m] osculating apoapsis radius of the objects at the previous update
+    std::vector<double> rPeri1List;                 //!< [m] osculating periapsis radius of the objects at the current update
+    std::vector<double> rApo1List;                  //!< [m] osculating apoapsis radius of the objects at the current update
+    std::vector<Eigen::Vector3d> boxMinList;        //!< [m] lower corner of the box bounding the path of each object over the step
+    std::vector<Eigen::Vector3d> boxMaxList;        //!< [m] upper corner of the box bounding the path of each object over the step
+    std::vector<std::pair<int64_t, int>> cellList;  //!< [-] grid cell key and index of the objects, sorted by key
+    double cellSize;                                //!< [m] edge length of the grid cells
+    std::vector<ConjunctionEvent> eventList;        //!< close approaches found in this update
+    ConjunctionEventsMsgPayload eventBuffer;        //!< buffer of the output message
+};
+
+
+#endif
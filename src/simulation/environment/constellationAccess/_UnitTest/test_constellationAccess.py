@@ -0,0 +1,177 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import time
+
+import numpy as np
+import pytest
+from Basilisk.architecture import messaging
+from Basilisk.simulation import constellationAccess
+from Basilisk.utilities import RigidBodyKinematics as rbk
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities import orbitalMotion
+
+
+def walkerPositions(numPlanes, numPerPlane, radius, inclination, phasing=1):
+    """Returns the inertial positions of a Walker delta constellation on circular orbits"""
+    positions = []
+    for p in range(numPlanes):
+        raan = 2 * np.pi * p / numPlanes
+        for s in range(numPerPlane):
+            u = 2 * np.pi * (s + phasing * p / numPlanes) / numPerPlane
+            r_P = radius * np.array([np.cos(u), np.sin(u), 0.0])
+            positions.append(np.dot(rbk.euler3(-raan), np.dot(rbk.euler1(-inclination), r_P)))
+    return np.array(positions)
+
+
+def bruteForceGraph(r_SP_P, rEquator, rPolar, maximumRange):
+    """Returns the sorted edges and slant ranges by testing every pair of spacecraft"""
+    s_SP_P = r_SP_P * np.array([1.0, 1.0, rEquator / rPolar])
+    edges = []
+    ranges = []
+    for i in range(len(r_SP_P)):
+        if np.linalg.norm(s_SP_P[i]) <= rEquator:
+            continue
+        for j in range(i + 1, len(r_SP_P)):
+            if np.linalg.norm(s_SP_P[j]) <= rEquator:
+                continue
+            slantRange = np.linalg.norm(r_SP_P[j] - r_SP_P[i])
+            if 0 < maximumRange < slantRange:
+                continue
+            s_ji = s_SP_P[j] - s_SP_P[i]
+            param = np.clip(-np.dot(s_SP_P[i], s_ji) / np.dot(s_ji, s_ji), 0.0, 1.0)
+            if np.linalg.norm(s_SP_P[i] + param * s_ji) > rEquator:
+                edges.append((i, j))
+                ranges.append(slantRange)
+    return edges, ranges
+
+
+def setupConstellation(r_BN_N, maximumRange=-1, planetPos=np.zeros(3), dcm_PN=np.identity(3)):
+    """Creates a simulation with a constellation access module and a state message per spacecraft"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(1.)))
+
+    module = constellationAccess.ConstellationAccess()
+    module.ModelTag = "constellationAccess"
+    module.rEquator = orbitalMotion.REQ_EARTH * 1000.
+    module.rPolar = orbitalMotion.RP_EARTH * 1000.
+    module.maximumRange = maximumRange
+    scSim.AddModelToTask("simTask", module)
+
+    planetData = messaging.SpicePlanetStateMsgPayload()
+    planetData.PositionVector = list(planetPos)
+    planetData.J20002Pfix = dcm_PN.tolist()
+    planetMsg = messaging.SpicePlanetStateMsg().write(planetData)
+    module.planetInMsg.subscribeTo(planetMsg)
+
+    scMsgs = []
+    for r in r_BN_N:
+        scData = messaging.SCStatesMsgPayload()
+        scData.r_BN_N = list(planetPos + r)
+        scMsgs.append(messaging.SCStatesMsg().write(scData))
+        module.addSpacecraftToModel(scMsgs[-1])
+
+    scSim.InitializeSimulation()
+    return scSim, module, [planetMsg] + scMsgs
+
+
+@pytest.mark.parametrize("maximumRange", [-1, 2000. * 1000, 4000. * 1000])
+@pytest.mark.parametrize("altitude", [500. * 1000, 1200. * 1000])
+def test_constellationAccess(maximumRange, altitude):
+    """
+    Tests whether constellationAccess:
+
+    1. finds the same edges and slant ranges as a test of every pair of spacecraft
+    2. accounts for the planet position, orientation and oblateness
+    3. excludes spacecraft inside the planet
+    4. orders the edges by the source and then the target spacecraft
+
+    :return:
+    """
+    r_BN_N = walkerPositions(12, 10, orbitalMotion.REQ_EARTH * 1000. + altitude, 53. * macros.D2R)
+    r_BN_N[7] = np.zeros(3)  # a spacecraft inside of the planet has no access
+    planetPos = np.array([orbitalMotion.AU * 1000, 0.0, 0.0])
+    dcm_PN = np.array(rbk.euler3(np.radians(-90.)))
+
+    scSim, module, msgs = setupConstellation(r_BN_N, maximumRange, planetPos, dcm_PN)
+    scSim.TotalSim.SingleStepProcesses()
+
+    r_SP_P = np.dot(r_BN_N, dcm_PN.T)
+    edges, ranges = bruteForceGraph(r_SP_P, module.rEquator, module.rPolar, maximumRange)
+
+    graph = module.accessGraphOutMsg.read()
+    assert graph.numSpacecraft == len(r_BN_N)
+    assert graph.numEdges == len(edges)
+    assert list(zip(graph.edgeSource, graph.edgeTarget)) == edges
+    np.testing.assert_allclose(list(graph.slantRange), ranges, rtol=1e-12)
+    assert 7 not in graph.edgeSource and 7 not in graph.edgeTarget
+
+
+def test_constellationAccessWriteOnlyOnChange():
+    """
+    Tests whether constellationAccess only writes the access graph when the set of edges changes if
+    ``writeOnlyOnChange`` is set
+
+    :return:
+    """
+    r_BN_N = walkerPositions(6, 8, orbitalMotion.REQ_EARTH * 1000. + 800. * 1000, 60. * macros.D2R)
+    scSim, module, msgs = setupConstellation(r_BN_N, 3000. * 1000)
+    module.writeOnlyOnChange = True
+
+    scSim.TotalSim.SingleStepProcesses()
+    firstWritten = module.accessGraphOutMsg.timeWritten()
+    firstEdges = list(zip(module.accessGraphOutMsg.read().edgeSource, module.accessGraphOutMsg.read().edgeTarget))
+
+    # moving a spacecraft by a few meters keeps the edges
+    scData = msgs[1].read()
+    scData.r_BN_N = list(np.array(scData.r_BN_N) + 1.0)
+    msgs[1].write(scData)
+    scSim.TotalSim.SingleStepProcesses()
+    assert module.accessGraphOutMsg.timeWritten() == firstWritten
+
+    # moving a spacecraft to the other side of the planet changes the edges
+    r_BN_N[0] = -np.array(scData.r_BN_N)
+    scData.r_BN_N = list(r_BN_N[0])
+    msgs[1].write(scData)
+    scSim.TotalSim.SingleStepProcesses()
+    edges, ranges = bruteForceGraph(r_BN_N, module.rEquator, module.rPolar, module.maximumRange)
+    assert edges != firstEdges
+    assert module.accessGraphOutMsg.timeWritten() > firstWritten
+    assert list(zip(module.accessGraphOutMsg.read().edgeSource, module.accessGraphOutMsg.read().edgeTarget)) == edges
+
+
+def constellationAccessBenchmark(numPlanes, numPerPlane, maximumRange, numSteps=10):
+    """Prints the time per update of the module for a Walker constellation"""
+    r_BN_N = walkerPositions(numPlanes, numPerPlane, orbitalMotion.REQ_EARTH * 1000. + 550. * 1000,
+                             53. * macros.D2R)
+    scSim, module, msgs = setupConstellation(r_BN_N, maximumRange)
+    start = time.perf_counter()
+    for step in range(numSteps):
+        scSim.TotalSim.SingleStepProcesses()
+    stepTime = (time.perf_counter() - start) / numSteps
+    print("%5d spacecraft, maximum range %6.0f km: %8.2f ms per update, %7d edges"
+          % (len(r_BN_N), maximumRange / 1000., stepTime * 1e3, module.accessGraphOutMsg.read().numEdges))
+
+
+if __name__ == "__main__":
+    test_constellationAccess(2000. * 1000, 500. * 1000)
+    for numPlanes, numPerPlane, maximumRange in [(72, 22, 1000. * 1000), (100, 50, 1000. * 1000),
+                                                 (100, 50, 3000. * 1000)]:
+        constellationAccessBenchmark(numPlanes, numPerPlane, maximumRange)
@@ -0,0 +1,260 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#include "simulation/environment/constellationAccess/constellationAccess.h"
+#include "architecture/utilities/avsEigenSupport.h"
+
+#include <algorithm>
+#include <cmath>
+
+/*! offset and bit width of the cell coordinates packed into a grid cell key */
+static const int64_t cellOffset = 1 << 20;
+static const int cellBits = 21;
+
+/*! pack the grid cell coordinates into a key */
+static int64_t cellKey(int64_t ix, int64_t iy, int64_t iz)
+{
+    return ((ix + cellOffset) << (2*cellBits)) | ((iy + cellOffset) << cellBits) | (iz + cellOffset);
+}
+
+/*! @brief Creates an instance of the ConstellationAccess class
+ @return void
+ */
+ConstellationAccess::ConstellationAccess()
+{
+    this->rEquator = -1.0;
+    this->rPolar = -1.0;
+    this->maximumRange = -1.0;
+    this->writeOnlyOnChange = false;
+    this->cellSize = 0.0;
+    this->zScale = 1.0;
+    this->graphWritten = false;
+
+    this->planetState = this->planetInMsg.zeroMsgPayload;
+    this->planetState.J20002Pfix[0][0] = 1;
+    this->planetState.J20002Pfix[1][1] = 1;
+    this->planetState.J20002Pfix[2][2] = 1;
+}
+
+/*! Empty destructor method.
+ @return void
+ */
+ConstellationAccess::~ConstellationAccess()
+{
+    return;
+}
+
+/*! Reset the module and check the planet radii
+ @param CurrentSimNanos
+ */
+void ConstellationAccess::Reset(uint64_t CurrentSimNanos)
+{
+    if (this->scStateInMsgs.size() < 2) {
+        bskLogger.bskLog(BSK_ERROR, "ConstellationAccess must have 2 or more spacecraft added through `addSpacecraftToModel`");
+    }
+    if (this->rEquator < 0.0) {
+        bskLogger.bskLog(BSK_ERROR, "ConstellationAccess rEquator must be set to the planet equatorial radius");
+    }
+    /* if the polar radius is not specified, then it is set equal to the equatorial radius */
+    if (this->rEquator > 0.0 && this->rPolar < 0.0) {
+        this->rPolar = this->rEquator;
+    }
+    this->zScale = this->rEquator / this->rPolar;
+
+    long unsigned int numSc = this->scStateInMsgs.size();
+    this->r_SP_PList.resize(numSc);
+    this->s_SP_PList.resize(numSc);
+    this->cellKeyList.resize(numSc);
+    this->graphBuffer = this->accessGraphOutMsg.zeroMsgPayload;
+    this->graphBuffer.numSpacecraft = (int) numSc;
+    this->graphWritten = false;
+}
+
+/*! Subscribe to the state message of a spacecraft of the constellation.  The spacecraft are numbered in the order
+    in which they are added.
+ @param tmpScMsg spacecraft state message
+ */
+void ConstellationAccess::addSpacecraftToModel(Message<SCStatesMsgPayload> *tmpScMsg)
+{
+    this->scStateInMsgs.push_back(tmpScMsg->addSubscriber());
+}
+
+/*! Read the spacecraft states once and express their positions in the planet frame
+ */
+void ConstellationAccess::readMessages()
+{
+    //! - Read in the optional planet message.  if no planet message is set, then a zero planet position, velocity and orientation is assumed
+    if (this->planetInMsg.isLinked()) {
+        this->planetState = this->planetInMsg();
+    }
+    Eigen::Matrix3d dcm_PN = cArray2EigenMatrix3d(*this->planetState.J20002Pfix);
+    Eigen::Vector3d r_PN_N = cArray2EigenVector3d(this->planetState.PositionVector);
+
+    for (long unsigned int c = 0; c < this->scStateInMsgs.size(); c++) {
+        const double *r_BN_N = this->scStateInMsgs.at(c)().r_BN_N;
+        this->r_SP_PList.at(c) = dcm_PN * (Eigen::Vector3d(r_BN_N[0], r_BN_N[1], r_BN_N[2]) - r_PN_N);
+        this->s_SP_PList.at(c) = this->r_SP_PList.at(c);
+        this->s_SP_PList.at(c)[2] *= this->zScale;
+    }
+}
+
+/*! Sort the spacecraft outside of the planet into a uniform grid of cubic cells
+ @param cellSize [m] edge length of the cells
+ */
+void ConstellationAccess::buildGrid(double cellSize)
+{
+    this->cellSize = cellSize;
+    this->sortedIndexList = this->visibleList;
+    for (int i : this->visibleList) {
+        Eigen::Vector3d cell = this->r_SP_PList.at(i) / cellSize;
+        this->cellKeyList.at(i) = cellKey((int64_t) std::floor(cell[0]), (int64_t) std::floor(cell[1]),
+                                          (int64_t) std::floor(cell[2]));
+    }
+    std::sort(this->sortedIndexList.begin(), this->sortedIndexList.end(), [this](int a, int b) {
+        return this->cellKeyList.at(a) < this->cellKeyList.at(b) || (this->cellKeyList.at(a) == this->cellKeyList.at(b) && a < b);
+    });
+    this->cellMap.clear();
+    for (int k = 0; k < (int) this->sortedIndexList.size(); ) {
+        int64_t key = this->cellKeyList.at(this->sortedIndexList.at(k));
+        int end = k;
+        while (end < (int) this->sortedIndexList.size() && this->cellKeyList.at(this->sortedIndexList.at(end)) == key) {
+            end++;
+        }
+        this->cellMap[key] = std::make_pair(k, end);
+        k = end;
+    }
+}
+
+/*! Add the edge between the spacecraft i and j if they are within range and the planet does not block the line of
+    sight.  The planet test finds the point of the line of sight segment closest to the planet center, after the affine
+    scaling that maps the planet ellipsoid to a sphere.
+ @param i index of the first spacecraft
+ @param j index of the second spacecraft
+ */
+void ConstellationAccess::addEdgeIfAccess(int i, int j)
+{
+    double range = (this->r_SP_PList.at(j) - this->r_SP_PList.at(i)).norm();
+    if (this->maximumRange > 0 && range > this->maximumRange) {
+        return;
+    }
+    const Eigen::Vector3d &s_i = this->s_SP_PList.at(i);
+    Eigen::Vector3d s_ji = this->s_SP_PList.at(j) - s_i;
+    double param = - s_i.dot(s_ji)/s_ji.dot(s_ji);
+    param = std::max(std::min(param, 1.0), 0.0);
+    if ((s_i + param * s_ji).norm() > this->rEquator) {
+        this->neighborList.push_back(std::make_pair(j, range));
+    }
+}
+
+/*! Compute the access graph.  A pair of spacecraft with access is at most the sum of their horizon distances apart,
+    and at most maximumRange apart if it is set.  The spacecraft are sorted into a grid whose cell size is the lowest
+    of these bounds, so only the pairs in neighboring cells are tested.
+ */
+void ConstellationAccess::computeAccessGraph()
+{
+    this->edgeList.clear();
+    this->rangeList.clear();
+
+    /* spacecraft inside the planet have no access */
+    double rMax2 = 0.0;
+    this->visibleList.clear();
+    for (int c = 0; c < (int) this->s_SP_PList.size(); c++) {
+        double r2 = this->s_SP_PList.at(c).squaredNorm();
+        if (r2 > this->rEquator*this->rEquator) {
+            this->visibleList.push_back(c);
+            rMax2 = std::max(rMax2, r2);
+        }
+    }
+    if (this->visibleList.size() < 2) {
+        return;
+    }
+
+    /* the scaled distances bound the true distances, so twice the largest scaled horizon distance bounds the range */
+    double bound = 2.0 * std::sqrt(rMax2 - this->rEquator*this->rEquator);
+    if (this->maximumRange > 0) {
+        bound = std::min(bound, this->maximumRange);
+    }
+    /* keep the cell coordinates within the bits of the cell keys */
+    double extent = 0.0;
+    for (int i : this->visibleList) {
+        extent = std::max(extent, this->r_SP_PList.at(i).cwiseAbs().maxCoeff());
+    }
+    bound = std::max(bound, extent / (double) (cellOffset/2));
+    this->buildGrid(bound);
+
+    /* the edges of each spacecraft are found in the order of the spacecraft, and sorted by the other spacecraft */
+    for (int i : this->visibleList) {
+        this->neighborList.clear();
+        Eigen::Vector3d cell = this->r_SP_PList.at(i) / this->cellSize;
+        int64_t ix = (int64_t) std::floor(cell[0]);
+        int64_t iy = (int64_t) std::floor(cell[1]);
+        int64_t iz = (int64_t) std::floor(cell[2]);
+        for (int64_t dx = -1; dx <= 1; dx++) {
+            for (int64_t dy = -1; dy <= 1; dy++) {
+                for (int64_t dz = -1; dz <= 1; dz++) {
+                    auto cellIt = this->cellMap.find(cellKey(ix + dx, iy + dy, iz + dz));
+                    if (cellIt == this->cellMap.end()) {
+                        continue;
+                    }
+                    for (int k = cellIt->second.first; k < cellIt->second.second; k++) {
+                        int j = this->sortedIndexList.at(k);
+                        if (j > i) {
+                            this->addEdgeIfAccess(i, j);
+                        }
+                    }
+                }
+            }
+        }
+        std::sort(this->neighborList.begin(), this->neighborList.end());
+        for (const std::pair<int, double> &neighbor : this->neighborList) {
+            this->edgeList.push_back(std::make_pair(i, neighbor.first));
+            this->rangeList.push_back(neighbor.second);
+        }
+    }
+}
+
+/*!
+ update module
+ @param CurrentSimNanos
+ */
+void ConstellationAccess::UpdateState(uint64_t CurrentSimNanos)
+{
+    this->readMessages();
+    this->computeAccessGraph();
+
+    bool changed = !this->graphWritten || (int) this->edgeList.size() != this->graphBuffer.numEdges;
+    for (int k = 0; !changed && k < (int) this->edgeList.size(); k++) {
+        changed = this->edgeList[k].first != this->graphBuffer.edgeSource[k]
+                  || this->edgeList[k].second != this->graphBuffer.edgeTarget[k];
+    }
+
+    this->graphBuffer.numEdges = (int) this->edgeList.size();
+    this->graphBuffer.edgeSource.resize(this->edgeList.size());
+    this->graphBuffer.edgeTarget.resize(this->edgeList.size());
+    for (int k = 0; k < (int) this->edgeList.size(); k++) {
+        this->graphBuffer.edgeSource[k] = this->edgeList[k].first;
+        this->graphBuffer.edgeTarget[k] = this->edgeList[k].second;
+    }
+    this->graphBuffer.slantRange = this->rangeList;
+
+    if (changed || !this->writeOnlyOnChange) {
+        this->accessGraphOutMsg.write(&this->graphBuffer, this->moduleID, CurrentSimNanos);
+        this->graphWritten = true;
+    }
+}
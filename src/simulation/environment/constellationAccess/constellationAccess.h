@@ -0,0 +1,82 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+#ifndef CONSTELLATION_ACCESS_H
+#define CONSTELLATION_ACCESS_H
+
+#include <Eigen/Dense>
+#include <vector>
+#include <unordered_map>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+
+#include "architecture/msgPayloadDefC/SpicePlanetStateMsgPayload.h"
+#include "architecture/msgPayloadDefC/SCStatesMsgPayload.h"
+#include "architecture/msgPayloadDefCpp/AccessGraphMsgPayload.h"
+#include "architecture/messaging/messaging.h"
+
+#include "architecture/utilities/bskLogging.h"
+
+/*! @brief constellation access class, which evaluates the line-of-sight access between all pairs of a set of
+    spacecraft and publishes the access graph as a list of edges */
+class ConstellationAccess:  public SysModel {
+public:
+    ConstellationAccess();
+    ~ConstellationAccess();
+    void UpdateState(uint64_t CurrentSimNanos);
+    void Reset(uint64_t CurrentSimNanos);
+    void addSpacecraftToModel(Message<SCStatesMsgPayload> *tmpScMsg);
+
+private:
+    void readMessages();
+    void computeAccessGraph();
+    void buildGrid(double cellSize);
+    void addEdgeIfAccess(int i, int j);
+
+public:
+    double rEquator;            //!< [m] equatorial planet radius
+    double rPolar;              //!< [m] polar planet radius, defaults to rEquator
+    double maximumRange;        //!< [m] maximum slant range of an access; defaults to -1, which represents no maximum range
+    bool writeOnlyOnChange;     //!< [-] flag to only write the output message when the set of edges changes, default false
+
+    ReadFunctor<SpicePlanetStateMsgPayload> planetInMsg;        //!< (optional) planet state input message
+    std::vector<ReadFunctor<SCStatesMsgPayload>> scStateInMsgs; //!< vector of spacecraft state input messages
+    Message<AccessGraphMsgPayload> accessGraphOutMsg;           //!< access graph output message
+
+    BSKLogger bskLogger;         //!< -- BSK Logging
+
+private:
+    SpicePlanetStateMsgPayload planetState;                     //!< buffer of planet data
+    std::vector<Eigen::Vector3d> r_SP_PList;                    //!< [m] spacecraft positions relative to the planet, in planet frame components
+    std::vector<Eigen::Vector3d> s_SP_PList;                    //!< [m] spacecraft positions with the polar axis scaled to map the ellipsoid to a sphere
+    std::vector<int> visibleList;                               //!< [-] indices of the spacecraft outside of the planet
+    std::vector<int64_t> cellKeyList;                           //!< [-] grid cell key of each spacecraft
+    std::vector<int> sortedIndexList;                           //!< [-] indices of the visible spacecraft sorted by grid cell
+    std::unordered_map<int64_t, std::pair<int, int>> cellMap;   //!< [-] range of sortedIndexList of each occupied grid cell
+    double cellSize;                                            //!< [m] edge length of the grid cells
+    AccessGraphMsgPayload graphBuffer;                          //!< buffer of the access graph
+    std::vector<std::pair<int, double>> neighborList;           //!< [-] other spacecraft and slant range of the edges of one spacecraft
+    std::vector<std::pair<int, int>> edgeList;                  //!< [-] edges found in this update, ordered by source and target
+    std::vector<double> rangeList;                              //!< [m] slant range of the edges found in this update
+    bool graphWritten;                                          //!< [-] flag if the output message was written since Reset()
+    double zScale;                                              //!< ratio of rEquator over rPolar, used for affine scaling to turn ellipsoid to sphere
+};
+
+
+#endif
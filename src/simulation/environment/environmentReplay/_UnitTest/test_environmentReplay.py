@@ -0,0 +1,110 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import numpy as np
+import pytest
+from Basilisk.architecture import messaging
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.simulation import environmentReplay
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities.MonteCarlo.EnvironmentCache import EnvironmentCache
+
+
+def createSim():
+    """The upstream module plays the environment, the downstream module the flight software"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("envTask", macros.sec2nano(2.0)), 20)
+    proc.addTask(scSim.CreateNewTask("fswTask", macros.sec2nano(1.0)), 10)
+
+    scSim.envModule = cppModuleTemplate.CppModuleTemplate()
+    scSim.envModule.ModelTag = "environment"
+    scSim.AddModelToTask("envTask", scSim.envModule)
+
+    scSim.fswModule = cppModuleTemplate.CppModuleTemplate()
+    scSim.fswModule.ModelTag = "fsw"
+    scSim.fswModule.dataInMsg.subscribeTo(scSim.envModule.dataOutMsg)
+    scSim.AddModelToTask("fswTask", scSim.fswModule)
+
+    scSim.fswLog = scSim.fswModule.dataOutMsg.recorder()
+    scSim.AddModelToTask("fswTask", scSim.fswLog)
+    return scSim
+
+
+def environmentModules(scSim):
+    return [scSim.envModule]
+
+
+def executeSim(scSim):
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(10.0))
+    scSim.ExecuteSimulation()
+
+
+def test_environmentReplay(tmp_path):
+    """Replaying the recorded environment reproduces the flight software outputs without running the environment"""
+    nominal = createSim()
+    executeSim(nominal)
+
+    cache = EnvironmentCache(environmentModules)
+    recorded = createSim()
+    cache.record(recorded, executeSim)
+    times, payloads = cache.tables["0.dataOutMsg"]
+    np.testing.assert_array_equal(times, macros.sec2nano(2.0) * np.arange(6))
+    assert payloads.shape == (6, 24)
+    np.testing.assert_array_equal(payloads.view(np.float64)[:, 0], np.arange(1.0, 7.0))
+
+    cache.save(tmp_path / "environment.npz")
+    loaded = EnvironmentCache(environmentModules)
+    loaded.load(tmp_path / "environment.npz")
+
+    replayed = createSim()
+    loaded.replay(replayed)
+    executeSim(replayed)
+
+    np.testing.assert_array_equal(replayed.fswLog.dataVector, nominal.fswLog.dataVector)
+    np.testing.assert_array_equal(replayed.fswLog.times(), nominal.fswLog.times())
+    assert replayed.envModule.dataOutMsg.read().dataVector[0] == 6.0
+    assert replayed.envModule.CallCounts == 0  # the environment module was not executed
+
+
+def test_replayChannel():
+    """A replay channel writes the last record at or before the current time"""
+    msg = messaging.CModuleTemplateMsg()
+    reader = msg.addSubscriber()
+    replay = environmentReplay.EnvironmentReplay()
+    payloadAddress, headerAddress, dtype = msg.payloadPointers()
+    channel = replay.addReplayChannel(payloadAddress, headerAddress, dtype.itemsize)
+    times = np.array([10, 20, 30], dtype=np.uint64)
+    payloads = np.zeros(3, dtype=dtype)
+    payloads["dataVector"][:, 0] = [1.0, 2.0, 3.0]
+    replay.importChannel(channel, times.ctypes.data, payloads.ctypes.data, len(times))
+
+    replay.Reset(0)
+    assert not reader.isWritten()
+    for currentTime, expected in [(10, 1.0), (15, 1.0), (20, 2.0), (35, 3.0)]:
+        replay.UpdateState(currentTime)
+        assert reader().dataVector[0] == expected
+        assert reader.timeWritten() == currentTime
+    replay.Reset(25)
+    assert reader().dataVector[0] == 2.0
+
+
+if __name__ == "__main__":
+    test_replayChannel()
@@ -0,0 +1,194 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+#include "environmentReplay.h"
+#include <cstring>
+
+/*! The constructor */
+EnvironmentReplay::EnvironmentReplay()
+{
+}
+
+/*! The destructor */
+EnvironmentReplay::~EnvironmentReplay()
+{
+}
+
+/*! Rewinds the replayed channels and clears the recorded ones.  The replayed channels already write the
+ payload valid at the reset time, as the replaced module would have.
+ @return void
+ @param CurrentSimNanos [ns] time of the reset
+ */
+void EnvironmentReplay::Reset(uint64_t CurrentSimNanos)
+{
+    for (auto &channel : this->channels) {
+        if (channel.recording) {
+            channel.times.clear();
+            channel.payloads.clear();
+        } else {
+            channel.cursor = 0;
+            this->replayChannel(channel, CurrentSimNanos);
+        }
+    }
+}
+
+/*! Records the messages written since the last call, or writes the recorded payloads valid at the current time
+ @return void
+ @param CurrentSimNanos [ns] current simulation time
+ */
+void EnvironmentReplay::UpdateState(uint64_t CurrentSimNanos)
+{
+    for (auto &channel : this->channels) {
+        if (channel.recording) {
+            this->recordChannel(channel);
+        } else {
+            this->replayChannel(channel, CurrentSimNanos);
+        }
+    }
+}
+
+/*! Adds a channel recording a message each time its header shows a new write time
+ @return int index of the channel
+ @param payloadAddress address of the message payload
+ @param headerAddress address of the message header
+ @param payloadSize [bytes] size of the message payload
+ */
+int EnvironmentReplay::addRecordChannel(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize)
+{
+    return this->addChannel(payloadAddress, headerAddress, payloadSize, true);
+}
+
+/*! Adds a channel writing recorded payloads into a message.  The records are loaded with importChannel().
+ @return int index of the channel
+ @param payloadAddress address of the message payload
+ @param headerAddress address of the message header
+ @param payloadSize [bytes] size of the message payload
+ */
+int EnvironmentReplay::addReplayChannel(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize)
+{
+    return this->addChannel(payloadAddress, headerAddress, payloadSize, false);
+}
+
+/*! Returns the number of records of a channel
+ @return uint64_t number of records
+ @param channel index of the channel
+ */
+uint64_t EnvironmentReplay::getRecordCount(int channel)
+{
+    if (!this->validChannel(channel)) {
+        return 0;
+    }
+    return this->channels[channel].times.size();
+}
+
+/*! Copies the records of a channel into caller provided arrays of getRecordCount() times and payloads
+ @return void
+ @param channel index of the channel
+ @param timesAddress address of a uint64 array receiving the record times
+ @param payloadsAddress address of a byte array receiving the payloads, stored back to back
+ */
+void EnvironmentReplay::exportChannel(int channel, uint64_t timesAddress, uint64_t payloadsAddress)
+{
+    if (!this->validChannel(channel)) {
+        return;
+    }
+    ReplayChannel &source = this->channels[channel];
+    if (source.times.size() == 0) {
+        return;
+    }
+    memcpy(reinterpret_cast<void *>(timesAddress), source.times.data(), source.times.size()*sizeof(uint64_t));
+    memcpy(reinterpret_cast<void *>(payloadsAddress), source.payloads.data(), source.payloads.size());
+}
+
+/*! Loads the records of a channel from arrays of times, in increasing order, and payloads
+ @return void
+ @param channel index of the channel
+ @param timesAddress address of a uint64 array of the record times
+ @param payloadsAddress address of a byte array of the payloads, stored back to back
+ @param recordCount number of records
+ */
+void EnvironmentReplay::importChannel(int channel, uint64_t timesAddress, uint64_t payloadsAddress,
+                                      uint64_t recordCount)
+{
+    if (!this->validChannel(channel)) {
+        return;
+    }
+    ReplayChannel &target = this->channels[channel];
+    const uint64_t *times = reinterpret_cast<const uint64_t *>(timesAddress);
+    const uint8_t *payloads = reinterpret_cast<const uint8_t *>(payloadsAddress);
+    target.times.assign(times, times + recordCount);
+    target.payloads.assign(payloads, payloads + recordCount*target.payloadSize);
+    target.cursor = 0;
+}
+
+int EnvironmentReplay::addChannel(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize,
+                                  bool recording)
+{
+    if (payloadAddress == 0 || headerAddress == 0 || payloadSize == 0) {
+        bskLogger.bskLog(BSK_ERROR, "EnvironmentReplay: the message payload and header addresses must be set.");
+        return -1;
+    }
+    ReplayChannel channel;
+    channel.payload = reinterpret_cast<uint8_t *>(payloadAddress);
+    channel.header = reinterpret_cast<MsgHeader *>(headerAddress);
+    channel.payloadSize = payloadSize;
+    channel.recording = recording;
+    channel.cursor = 0;
+    this->channels.push_back(channel);
+    return (int) this->channels.size() - 1;
+}
+
+bool EnvironmentReplay::validChannel(int channel)
+{
+    if (channel < 0 || channel >= (int) this->channels.size()) {
+        bskLogger.bskLog(BSK_ERROR, "EnvironmentReplay: channel %d does not exist.", channel);
+        return false;
+    }
+    return true;
+}
+
+/*! Appends the message payload if the message was written since the last record */
+void EnvironmentReplay::recordChannel(ReplayChannel &channel)
+{
+    if (!channel.header->isWritten) {
+        return;
+    }
+    if (channel.times.size() > 0 && channel.times.back() == channel.header->timeWritten) {
+        return;
+    }
+    channel.times.push_back(channel.header->timeWritten);
+    channel.payloads.insert(channel.payloads.end(), channel.payload, channel.payload + channel.payloadSize);
+}
+
+/*! Writes the last record at or before the current time, the records are visited once in time order */
+void EnvironmentReplay::replayChannel(ReplayChannel &channel, uint64_t CurrentSimNanos)
+{
+    uint64_t recordCount = channel.times.size();
+    if (recordCount == 0 || channel.times[0] > CurrentSimNanos) {
+        return;
+    }
+    while (channel.cursor + 1 < recordCount && channel.times[channel.cursor + 1] <= CurrentSimNanos) {
+        channel.cursor++;
+    }
+    memcpy(channel.payload, &channel.payloads[channel.cursor*channel.payloadSize], channel.payloadSize);
+    channel.header->isWritten = 1;
+    channel.header->timeWritten = CurrentSimNanos;
+    channel.header->moduleID = this->moduleID;
+}
@@ -0,0 +1,70 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+
+#ifndef ENVIRONMENT_REPLAY_H
+#define ENVIRONMENT_REPLAY_H
+
+#include <stdint.h>
+#include <vector>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+#include "architecture/messaging/msgHeader.h"
+#include "architecture/utilities/bskLogging.h"
+
+/*! @brief time-indexed table of the payloads written to one message */
+typedef struct {
+    uint8_t *payload;               //!< address of the message payload
+    MsgHeader *header;              //!< address of the message header
+    uint64_t payloadSize;           //!< [bytes] size of the message payload
+    bool recording;                 //!< flag if the channel records the message instead of replaying it
+    std::vector<uint64_t> times;    //!< [ns] times the recorded payloads were written
+    std::vector<uint8_t> payloads;  //!< recorded payloads, stored back to back
+    uint64_t cursor;                //!< index of the next record to replay
+}ReplayChannel;
+
+/*! @brief records the output messages of environment modules and replays them in place of the modules */
+class EnvironmentReplay: public SysModel {
+public:
+    EnvironmentReplay();
+    ~EnvironmentReplay();
+
+    void Reset(uint64_t CurrentSimNanos);
+    void UpdateState(uint64_t CurrentSimNanos);
+
+    int addRecordChannel(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize);
+    int addReplayChannel(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize);
+    uint64_t getRecordCount(int channel);
+    void exportChannel(int channel, uint64_t timesAddress, uint64_t payloadsAddress);
+    void importChannel(int channel, uint64_t timesAddress, uint64_t payloadsAddress, uint64_t recordCount);
+
+public:
+    BSKLogger bskLogger;                        //!< -- BSK Logging
+
+private:
+    int addChannel(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize, bool recording);
+    bool validChannel(int channel);
+    void recordChannel(ReplayChannel &channel);
+    void replayChannel(ReplayChannel &channel, uint64_t CurrentSimNanos);
+
+private:
+    std::vector<ReplayChannel> channels;        //!< recorded or replayed messages
+};
+
+
+#endif
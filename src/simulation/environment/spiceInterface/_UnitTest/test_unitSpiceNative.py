@@ -0,0 +1,188 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+#
+#   Unit Test Script
+#   Module Name:        spiceInterface
+#   Purpose:            Compares the native kernel reader of the Spice interface to CSPICE, for SPK segments of
+#                       type 2 and 3, for text and binary PCK frames and for the Julian date.
+#
+
+import struct
+import tempfile
+import time
+
+import numpy as np
+import pytest
+from Basilisk import __path__
+from Basilisk.simulation import spiceInterface
+from Basilisk.utilities import RigidBodyKinematics as rbk
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+bskPath = __path__[0]
+dataPath = bskPath + '/supportData/EphemerisData/'
+
+
+def writeBinaryPck(fileName, classId, frameId, startTime, intervalLength, numRecords, angles):
+    """Writes a little endian binary PCK file with one type 2 segment of degree 2 Chebyshev polynomials of the
+    Euler angles returned by angles(t)"""
+    degree = 2
+    nodes = np.cos(np.pi * (np.arange(degree + 1) + 0.5) / (degree + 1))
+    data = []
+    for k in range(numRecords):
+        mid = startTime + (k + 0.5) * intervalLength
+        radius = intervalLength / 2
+        values = np.array([angles(mid + radius * s) for s in nodes])
+        coeffs = np.polynomial.chebyshev.chebfit(nodes, values, degree)
+        data += [mid, radius] + list(coeffs.T.flatten())
+    data += [startTime, intervalLength, 2 + 3 * (degree + 1), numRecords]
+    begin = 3 * 128 + 1
+    end = begin + len(data) - 1
+
+    # file record, one summary record and one name record followed by the segment data
+    fileRecord = bytearray(1024)
+    fileRecord[0:8] = b"DAF/PCK "
+    fileRecord[8:16] = struct.pack("<ii", 2, 5)
+    fileRecord[16:76] = b"BASILISK TEST PCK".ljust(60)
+    fileRecord[76:88] = struct.pack("<iii", 2, 2, end + 1)
+    fileRecord[88:96] = b"LTL-IEEE"
+    fileRecord[699:727] = b"FTPSTR:\r:\n:\r\n:\r\x00:\x81:\x10\xce:ENDFTP"
+    summaryRecord = bytearray(1024)
+    summaryRecord[0:24] = struct.pack("<ddd", 0.0, 0.0, 1.0)
+    summaryRecord[24:64] = struct.pack("<ddiiiii", startTime, startTime + numRecords * intervalLength,
+                                       classId, frameId, 2, begin, end) + bytes(4)
+    nameRecord = bytearray(b" " * 1024)
+    segmentData = struct.pack("<%dd" % len(data), *data)
+    segmentData += bytes(-len(segmentData) % 1024)
+    with open(fileName, "wb") as f:
+        f.write(fileRecord + summaryRecord + nameRecord + segmentData)
+
+
+def earthAngles(t):
+    """3-1-3 Euler angles of a slowly precessing Earth fixed frame"""
+    return np.array([np.pi / 2 + 1e-10 * t, 0.02 + 1e-11 * t, 1.2 + 7.292115e-5 * t])
+
+
+def runSpice(useNativeEphemeris, planetNames, scNames, planetFrames, zeroBase, dateSpice, numSteps=24):
+    """Runs a Spice interface and returns the planet and spacecraft states, the planet frames and the Julian date
+    of each step"""
+    scSim = SimulationBaseClass.SimBaseClass()
+    dynProcess = scSim.CreateNewProcess("simProcess")
+    dynProcess.addTask(scSim.CreateNewTask("simTask", macros.sec2nano(3600.)))
+
+    module = spiceInterface.SpiceInterface()
+    module.ModelTag = "spiceInterface"
+    module.SPICEDataPath = dataPath
+    module.addPlanetNames(spiceInterface.StringVector(planetNames))
+    module.addSpacecraftNames(spiceInterface.StringVector(scNames))
+    module.planetFrames = spiceInterface.StringVector(planetFrames)
+    module.zeroBase = zeroBase
+    module.UTCCalInit = dateSpice
+    module.useNativeEphemeris = useNativeEphemeris
+    scSim.AddModelToTask("simTask", module)
+
+    scSim.InitializeSimulation()
+    positions, velocities, dcms, dcmRates, julianDates = [], [], [], [], []
+    for step in range(numSteps):
+        scSim.ConfigureStopTime(macros.sec2nano(3600. * step))
+        scSim.ExecuteSimulation()
+        for msg in module.planetStateOutMsgs:
+            payload = msg.read()
+            positions.append(payload.PositionVector)
+            velocities.append(payload.VelocityVector)
+            dcms.append(payload.J20002Pfix)
+            dcmRates.append(payload.J20002Pfix_dot)
+        for msg in module.scStateOutMsgs:
+            payload = msg.read()
+            positions.append(payload.r_BN_N)
+            velocities.append(payload.v_BN_N)
+        julianDates.append(module.spiceTimeOutMsg.read().JulianDateCurrent)
+    return (np.array(positions), np.array(velocities), np.array(dcms), np.array(dcmRates), np.array(julianDates))
+
+
+@pytest.mark.parametrize("kernel, planetNames, scNames, planetFrames, zeroBase, dateSpice", [
+    # type 2 segments and IAU frames of the text PCK
+    ("", ["earth", "moon", "sun", "mars barycenter", "jupiter barycenter", "venus"], [], [], "SSB",
+     "2015 February 10, 00:00:00.0 TDB"),
+    # type 3 segments of a big endian kernel, chained to the planetary ephemeris
+    ("MAR033_2000-2025.bsp", ["mars", "phobos", "deimos"], [], [], "earth", "2015 February 10, 00:00:00.0 TDB"),
+    # binary PCK frame
+    ("test_ITRF93.bpc", ["earth", "moon"], [], ["ITRF93"], "SSB", "2000 March 1, 00:00:00.0 TDB"),
+    # type 10 spacecraft segments are evaluated with CSPICE
+    ("hst_edited.bsp", [], ["HUBBLE SPACE TELESCOPE"], [], "earth", "2015 February 10, 00:00:00.0 TDB"),
+])
+def test_spiceNativeEphemeris(tmp_path, kernel, planetNames, scNames, planetFrames, zeroBase, dateSpice):
+    r"""
+    **Validation Test Description**
+
+    The same bodies and frames are computed by a Spice interface with ``useNativeEphemeris`` set and by one using
+    CSPICE, over one day in steps of an hour.  Bodies and frames that the native reader does not support are
+    computed with CSPICE, such that the results agree in every case.
+
+    **Description of Variables Being Tested**
+
+    The positions and velocities agree to 1e-6 m and 1e-9 m/s, the frames to 1e-10 and their rates to 1e-13 1/s.
+    The Julian date of CSPICE is rounded to 1e-7 days, which is the tolerance of the Julian date.
+    """
+    kernelPath = dataPath
+    if kernel == "test_ITRF93.bpc":
+        kernelPath = str(tmp_path) + '/'
+        # ITRF93 is the built-in PCK frame of class id 3000
+        writeBinaryPck(kernelPath + kernel, 3000, 1, 0.0, 86400., 400, earthAngles)
+
+    loader = spiceInterface.SpiceInterface()
+    if kernel:
+        loader.loadSpiceKernel(kernel, kernelPath)
+    try:
+        native = runSpice(True, planetNames, scNames, planetFrames, zeroBase, dateSpice)
+        cspice = runSpice(False, planetNames, scNames, planetFrames, zeroBase, dateSpice)
+    finally:
+        if kernel:
+            loader.unloadSpiceKernel(kernel, kernelPath)
+
+    np.testing.assert_allclose(native[0], cspice[0], rtol=0, atol=1e-6)
+    np.testing.assert_allclose(native[1], cspice[1], rtol=0, atol=1e-9)
+    np.testing.assert_allclose(native[2], cspice[2], rtol=0, atol=1e-10)
+    np.testing.assert_allclose(native[3], cspice[3], rtol=0, atol=1e-13)
+    np.testing.assert_allclose(native[4], cspice[4], rtol=0, atol=1e-7)
+    if kernel == "test_ITRF93.bpc":
+        # the Earth frame follows the Euler angles of the binary PCK, the first step is 59.5 days past J2000 TDB
+        et = 59.5 * 86400.
+        np.testing.assert_allclose(native[2][0], rbk.euler3132C(earthAngles(et)), rtol=0, atol=1e-10)
+
+
+def benchmarkSpice(numSteps=100000):
+    """Times the update of a Spice interface with planets and the Moon with the native reader and with CSPICE"""
+    planetNames = ["earth", "moon", "sun", "mars barycenter", "jupiter barycenter", "venus"]
+    for useNativeEphemeris in [True, False]:
+        module = spiceInterface.SpiceInterface()
+        module.SPICEDataPath = dataPath
+        module.addPlanetNames(spiceInterface.StringVector(planetNames))
+        module.useNativeEphemeris = useNativeEphemeris
+        module.Reset(0)
+        start = time.perf_counter()
+        for step in range(numSteps):
+            module.UpdateState(macros.sec2nano(step))
+        elapsed = time.perf_counter() - start
+        print("%s: %.2f us per update" % ("native" if useNativeEphemeris else "CSPICE", elapsed / numSteps * 1e6))
+
+
+if __name__ == "__main__":
+    test_spiceNativeEphemeris(tempfile.mkdtemp(), "test_ITRF93.bpc", ["earth", "moon"], [], ["ITRF93"], "SSB",
+                              "2000 March 1, 00:00:00.0 TDB")
+    benchmarkSpice()
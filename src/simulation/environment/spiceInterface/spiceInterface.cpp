@@ -21,6 +21,7 @@
 #include <sstream>
 #include "../libs/cspice/include/SpiceUsr.h"
 #include <string.h>
+#include <math.h>
 #include "architecture/utilities/simDefinitions.h"
 #include "architecture/utilities/macroDefinitions.h"
 #include "architecture/utilities/rigidBodyKinematics.h"
@@ -45,6 +46,14 @@ SpiceInterface::SpiceInterface()
     timeDataInit = false;
     JDGPSEpoch = 0.0;
     GPSEpochTime = "1980 January 6, 00:00:00.0";
+    useNativeEphemeris = false;
+    nativeEphemeris = false;
+    zeroBaseId = 0;
+    deltaTA = 0.0;
+    deltetK = 0.0;
+    deltetEB = 0.0;
+    deltetM[0] = 0.0;
+    deltetM[1] = 0.0;
 
     referenceBase = "j2000";
     zeroBase = "SSB";
@@ -149,6 +158,12 @@ void SpiceInterface::Reset(uint64_t CurrenSimNanos)
     }
     delete [] name;
 
+    //! - Set up the native kernel reader if requested
+    this->nativeEphemeris = false;
+    if (this->useNativeEphemeris) {
+        this->initNativeEphemeris();
+    }
+
     // - Call Update state so that the spice bodies are inputted into the messaging system on reset
     this->UpdateState(CurrenSimNanos);
 }
@@ -266,7 +281,17 @@ void SpiceInterface::UpdateState(uint64_t CurrentSimNanos)
 {
     //! - Increment the J2000 elapsed time based on init value and Current sim
     this->J2000Current = this->J2000ETInit + CurrentSimNanos*NANO2SEC;
-    
+
+    //! - With the native kernel reader, evaluate the time, states and frames without calling CSPICE
+    if (this->nativeEphemeris) {
+        this->computeNativeJulianDate();
+        this->computeGPSData();
+        this->pullNativeData(&this->planetData, this->nativePlanets);
+        this->pullNativeData(&this->scData, this->nativeSc);
+        this->writeOutputMessages(CurrentSimNanos);
+        return;
+    }
+
     //! - Compute the current Julian Date string and cast it over to the double
     et2utc_c(this->J2000Current, "J", 14, this->charBufferSize - 1, reinterpret_cast<SpiceChar*>
              (this->spiceBuffer));
@@ -290,6 +315,7 @@ void SpiceInterface::addPlanetNames(std::vector<std::string> planetNames) {
     }
     this->planetStateOutMsgs.clear();
     this->planetData.clear();
+    this->nativeEphemeris = false;
 
     for (it = planetNames.begin(); it != planetNames.end(); it++) {
         Message<SpicePlanetStateMsgPayload> *spiceOutMsg;
@@ -333,6 +359,7 @@ void SpiceInterface::addSpacecraftNames(std::vector<std::string> spacecraftNames
     this->attRefStateOutMsgs.clear();
     this->transRefStateOutMsgs.clear();
     this->scData.clear();
+    this->nativeEphemeris = false;
 
     for (it = spacecraftNames.begin(); it != spacecraftNames.end(); it++) {
         /* append to spacecraft related output messages */
@@ -388,7 +415,7 @@ void SpiceInterface::pullSpiceData(std::vector<SpicePlanetStateMsgPayload> *spic
     {
         double lighttime;
         double localState[6];
-        std::string planetFrame = "";
+        std::string planetFrame = this->getPlanetFrame(*planit, c);
         
         spkezr_c(planit->PlanetName, this->J2000Current, this->referenceBase.c_str(),
             "NONE", this->zeroBase.c_str(), localState, &lighttime);
@@ -397,19 +424,6 @@ void SpiceInterface::pullSpiceData(std::vector<SpicePlanetStateMsgPayload> *spic
         v3Scale(1000., planit->PositionVector, planit->PositionVector);
         v3Scale(1000., planit->VelocityVector, planit->VelocityVector);
         planit->J2000Current = this->J2000Current;
-        /* use default IAU planet frame name */
-        planetFrame = "IAU_";
-        planetFrame += planit->PlanetName;
-
-        /* use specific planet frame if specified */
-        if (this->planetFrames.size() > 0) {
-            if (c < this->planetFrames.size()) {
-                if (this->planetFrames[c].length() > 0){
-                    /* use custom planet frame name */
-                    planetFrame = this->planetFrames[c];
-                }
-            }
-        }
 
         if(planit->computeOrient)
         {
@@ -428,6 +442,266 @@ void SpiceInterface::pullSpiceData(std::vector<SpicePlanetStateMsgPayload> *spic
     }
 }
 
+/*! This method returns the name of the frame of a planet or spacecraft.  The default is the IAU frame of the
+ body, a name given in planetFrames is used instead.
+ @return std::string Frame name
+ @param body Planet or spacecraft state message payload
+ @param c Index of the body in its vector
+ */
+std::string SpiceInterface::getPlanetFrame(const SpicePlanetStateMsgPayload &body, int c)
+{
+    /* use default IAU planet frame name */
+    std::string planetFrame = "IAU_";
+    planetFrame += body.PlanetName;
+
+    /* use specific planet frame if specified */
+    if (c < (int) this->planetFrames.size() && this->planetFrames[c].length() > 0) {
+        /* use custom planet frame name */
+        planetFrame = this->planetFrames[c];
+    }
+    return planetFrame;
+}
+
+/*! Read the numeric values of a kernel pool variable.
+ @return bool True if the variable was found
+ @param name Name of the kernel pool variable
+ @param values Values of the variable
+ */
+static bool getPoolValues(const std::string &name, std::vector<double> &values)
+{
+    SpiceBoolean found;
+    SpiceInt count;
+    SpiceChar type[2];
+    values.clear();
+    dtpool_c(name.c_str(), &found, &count, type);
+    if (!found || type[0] != 'N') {
+        return false;
+    }
+    values.resize(count);
+    gdpool_c(name.c_str(), 0, count, &count, values.data(), &found);
+    return found;
+}
+
+/*! Read the IAU rotation model of a body from the text PCK variables in the kernel pool.  Models with constants
+ given relative to another frame than J2000, at another epoch than J2000, or with nutation precession angles of
+ higher than linear degree are not supported.
+ @return bool True if the model is found and supported
+ @param body NAIF id of the body
+ @param model Rotation model of the body
+ */
+static bool getRotationModel(int body, PckRotationModel &model)
+{
+    std::vector<double> values;
+    std::string bodyName = "BODY" + std::to_string(body);
+    std::string baryName = "BODY" + std::to_string((body > 100 && body < 1000) ? body/100 : body);
+
+    for (const std::string &name : {bodyName, baryName}) {
+        if (getPoolValues(name + "_CONSTANTS_REF_FRAME", values) && values[0] != 1.0) {
+            return false;
+        }
+        if (getPoolValues(name + "_CONSTANTS_JED_EPOCH", values) && values[0] != 2451545.0) {
+            return false;
+        }
+    }
+    if (getPoolValues(baryName + "_MAX_PHASE_DEGREE", values) && values[0] != 1.0) {
+        return false;
+    }
+
+    double *polynomials[3] = {model.poleRa, model.poleDec, model.pm};
+    const char *polynomialNames[3] = {"_POLE_RA", "_POLE_DEC", "_PM"};
+    for (int i = 0; i < 3; i++) {
+        if (!getPoolValues(bodyName + polynomialNames[i], values)) {
+            return false;
+        }
+        for (size_t k = 0; k < 3; k++) {
+            polynomials[i][k] = k < values.size() ? values[k] : 0.0;
+        }
+    }
+    getPoolValues(bodyName + "_NUT_PREC_RA", model.nutPrecRa);
+    getPoolValues(bodyName + "_NUT_PREC_DEC", model.nutPrecDec);
+    getPoolValues(bodyName + "_NUT_PREC_PM", model.nutPrecPm);
+    getPoolValues(baryName + "_NUT_PREC_ANGLES", model.nutPrecAngles);
+    return true;
+}
+
+/*! This method sets up the native kernel reader.  The SPK and binary PCK kernels loaded in CSPICE are mapped in
+ the same order, the NAIF ids of the bodies, frames and the zero base are looked up, and the leap second and text
+ PCK constants are read from the kernel pool.  Bodies and frames that the reader can not evaluate are computed
+ with CSPICE.
+ @return void
+ */
+void SpiceInterface::initNativeEphemeris()
+{
+    SpiceInt code;
+    SpiceBoolean found;
+
+    //! - The reader evaluates states and frames relative to J2000
+    namfrm_c(this->referenceBase.c_str(), &code);
+    if (code != 1) {
+        bskLogger.bskLog(BSK_WARNING, "spiceInterface: the native ephemeris requires the J2000 reference base, "
+                         "not %s.  Using CSPICE.", this->referenceBase.c_str());
+        return;
+    }
+    bodn2c_c(this->zeroBase.c_str(), &code, &found);
+    if (!found) {
+        bskLogger.bskLog(BSK_WARNING, "spiceInterface: unknown zero base %s.  Using CSPICE.", this->zeroBase.c_str());
+        return;
+    }
+    this->zeroBaseId = code;
+
+    //! - Read the constants of the TDB to UTC conversion
+    std::vector<double> deltaTAValue, kValue, ebValue, meanAnomaly;
+    if (!getPoolValues("DELTET/DELTA_T_A", deltaTAValue) || !getPoolValues("DELTET/K", kValue)
+        || !getPoolValues("DELTET/EB", ebValue) || !getPoolValues("DELTET/M", meanAnomaly) || meanAnomaly.size() < 2
+        || !getPoolValues("DELTET/DELTA_AT", this->deltaAT) || this->deltaAT.size() < 2) {
+        bskLogger.bskLog(BSK_WARNING, "spiceInterface: no leap second kernel is loaded.  Using CSPICE.");
+        return;
+    }
+    this->deltaTA = deltaTAValue[0];
+    this->deltetK = kValue[0];
+    this->deltetEB = ebValue[0];
+    this->deltetM[0] = meanAnomaly[0];
+    this->deltetM[1] = meanAnomaly[1];
+
+    //! - Map the SPK and PCK kernels in the CSPICE load order, text PCK kernels are skipped
+    SpiceChar file[FILENAME_MAX];
+    SpiceChar type[32];
+    SpiceChar source[FILENAME_MAX];
+    SpiceInt handle;
+    this->kernelReader.clear();
+    for (const char *kind : {"SPK", "PCK"}) {
+        SpiceInt count;
+        ktotal_c(kind, &count);
+        for (SpiceInt i = 0; i < count; i++) {
+            kdata_c(i, kind, FILENAME_MAX, sizeof(type), FILENAME_MAX, file, type, source, &handle, &found);
+            if (found && !this->kernelReader.loadKernel(file) && strcmp(kind, "SPK") == 0) {
+                bskLogger.bskLog(BSK_WARNING, "spiceInterface: unable to map the SPK kernel %s.", file);
+            }
+        }
+    }
+
+    //! - Look up the NAIF ids of the planets and spacecraft
+    this->nativePlanets.clear();
+    for (size_t c = 0; c < this->planetData.size(); c++) {
+        this->nativePlanets.push_back(this->initNativeBody(this->planetData[c],
+                                                           this->getPlanetFrame(this->planetData[c], (int) c)));
+    }
+    this->nativeSc.clear();
+    for (size_t c = 0; c < this->scData.size(); c++) {
+        this->nativeSc.push_back(this->initNativeBody(this->scData[c], this->getPlanetFrame(this->scData[c], (int) c)));
+    }
+    this->nativeEphemeris = true;
+}
+
+/*! This method looks up the NAIF ids of a planet or spacecraft and of its frame for the native kernel reader.
+ The state needs to be given by SPK segments of type 2 or 3 at the initial time.  Frames need to be PCK frames,
+ whose rotation is given by a binary PCK kernel or by the IAU model of a text PCK kernel.
+ @return NativeBody NAIF ids of the body
+ @param body Planet or spacecraft state message payload
+ @param frameName Name of the frame of the body
+ */
+SpiceInterface::NativeBody SpiceInterface::initNativeBody(const SpicePlanetStateMsgPayload &body,
+                                                          const std::string &frameName)
+{
+    NativeBody nativeBody = {false, false, 0, 0};
+    SpiceInt code;
+    SpiceBoolean found;
+
+    double state[6];
+    bodn2c_c(body.PlanetName, &code, &found);
+    if (found && this->kernelReader.getState(code, this->zeroBaseId, this->J2000Current, state)) {
+        nativeBody.nativeState = true;
+        nativeBody.bodyId = code;
+    } else {
+        bskLogger.bskLog(BSK_WARNING, "spiceInterface: the state of %s can not be evaluated natively, only SPK "
+                         "types 2 and 3 are supported.  Using CSPICE.", body.PlanetName);
+    }
+
+    if (!body.computeOrient) {
+        return nativeBody;
+    }
+    SpiceInt center;
+    SpiceInt frameClass;
+    SpiceInt classId;
+    namfrm_c(frameName.c_str(), &code);
+    found = SPICEFALSE;
+    if (code != 0) {
+        frinfo_c(code, &center, &frameClass, &classId, &found);
+    }
+    if (found && frameClass == 2) {
+        /* the text PCK model is used outside of the binary PCK coverage, as in CSPICE */
+        PckRotationModel model = {};
+        if (getRotationModel(classId, model)) {
+            this->kernelReader.setRotationModel(classId, model);
+        }
+        if (this->kernelReader.hasRotation(classId)) {
+            nativeBody.nativeOrient = true;
+            nativeBody.frameClassId = classId;
+        }
+    }
+    if (!nativeBody.nativeOrient) {
+        bskLogger.bskLog(BSK_WARNING, "spiceInterface: the frame %s of %s can not be evaluated natively.  Using CSPICE.",
+                         frameName.c_str(), body.PlanetName);
+    }
+    return nativeBody;
+}
+
+/*! This method computes the Julian date in UTC of the current time with the leap second constants of the kernel
+ pool, following the TDB to UTC conversion of CSPICE.
+ @return void
+ */
+void SpiceInterface::computeNativeJulianDate()
+{
+    double meanAnomaly = this->deltetM[0] + this->deltetM[1]*this->J2000Current;
+    double periodic = this->deltetK*sin(meanAnomaly + this->deltetEB*sin(meanAnomaly));
+    double tai = this->J2000Current - this->deltaTA - periodic;
+
+    //! - Find the TAI-UTC offset, CSPICE uses one second less than the first entry before the first leap second
+    double leapSeconds = this->deltaAT[0] - 1.0;
+    for (size_t k = this->deltaAT.size()/2; k > 0; k--) {
+        if (tai >= this->deltaAT[2*k - 1] + this->deltaAT[2*k - 2]) {
+            leapSeconds = this->deltaAT[2*k - 2];
+            break;
+        }
+    }
+    this->julianDateCurrent = 2451545.0 + (tai - leapSeconds)/86400.0;
+}
+
+/*! This method gets the state and frame of each planet or spacecraft with the native kernel reader.  Bodies that
+ the reader can not evaluate are computed with CSPICE.
+ @return void
+ @param spiceData Planet or spacecraft state message payloads
+ @param nativeBodies NAIF ids of the bodies
+ */
+void SpiceInterface::pullNativeData(std::vector<SpicePlanetStateMsgPayload> *spiceData,
+                                    const std::vector<NativeBody> &nativeBodies)
+{
+    for (size_t c = 0; c < spiceData->size(); c++) {
+        SpicePlanetStateMsgPayload &body = (*spiceData)[c];
+        const NativeBody &nativeBody = nativeBodies[c];
+        double localState[6];
+
+        if (!nativeBody.nativeState
+            || !this->kernelReader.getState(nativeBody.bodyId, this->zeroBaseId, this->J2000Current, localState)) {
+            double lighttime;
+            spkezr_c(body.PlanetName, this->J2000Current, this->referenceBase.c_str(),
+                     "NONE", this->zeroBase.c_str(), localState, &lighttime);
+        }
+        v3Scale(1000., &localState[0], body.PositionVector);
+        v3Scale(1000., &localState[3], body.VelocityVector);
+        body.J2000Current = this->J2000Current;
+
+        if (body.computeOrient
+            && (!nativeBody.nativeOrient || !this->kernelReader.getRotation(nativeBody.frameClassId, this->J2000Current,
+                                                                            body.J20002Pfix, body.J20002Pfix_dot))) {
+            double aux[6][6];
+            sxform_c(this->referenceBase.c_str(), this->getPlanetFrame(body, (int) c).c_str(), this->J2000Current, aux);
+            m66Get33Matrix(0, 0, aux, body.J20002Pfix);
+            m66Get33Matrix(1, 0, aux, body.J20002Pfix_dot);
+        }
+    }
+}
+
 /*! This method loads a requested SPICE kernel into the system memory.  It is
  its own method because we have to load several SPICE kernels in for our
  application.  Note that they are stored in the SPICE library and are not
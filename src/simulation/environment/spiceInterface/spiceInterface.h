@@ -26,6 +26,7 @@
 #include "architecture/utilities/linearAlgebra.h"
 #include "architecture/utilities/bskLogging.h"
 #include "architecture/utilities/avsEigenSupport.h"
+#include "architecture/utilities/spiceKernelReader.h"
 
 #include "architecture/msgPayloadDefC/SpicePlanetStateMsgPayload.h"
 #include "architecture/msgPayloadDefC/SpiceTimeMsgPayload.h"
@@ -72,6 +73,7 @@ public:
     std::string UTCCalInit;     //!< -- UTC time string for init time
 
     std::vector<std::string>planetFrames; //!< -- Optional vector of planet frame names.  Default values are IAU_ + planet name
+    bool useNativeEphemeris;    //!< -- Flag to evaluate the states and frames with the native kernel reader instead of CSPICE, default false
     
     bool timeDataInit;          //!< -- Flag indicating whether time has been init
     double J2000ETInit;         //!< s Seconds elapsed since J2000 at init
@@ -84,12 +86,37 @@ public:
     BSKLogger bskLogger;                      //!< -- BSK Logging
 
 private:
+    /*! NAIF ids used to evaluate a body with the native kernel reader */
+    typedef struct {
+        bool nativeState;           //!< -- flag if the state is evaluated natively, otherwise CSPICE is used
+        bool nativeOrient;          //!< -- flag if the frame is evaluated natively, otherwise CSPICE is used
+        int bodyId;                 //!< -- NAIF id of the body
+        int frameClassId;           //!< -- frame class id of the body frame
+    } NativeBody;
+
+    std::string getPlanetFrame(const SpicePlanetStateMsgPayload &body, int c);
+    void initNativeEphemeris();
+    NativeBody initNativeBody(const SpicePlanetStateMsgPayload &body, const std::string &frameName);
+    void computeNativeJulianDate();
+    void pullNativeData(std::vector<SpicePlanetStateMsgPayload> *spiceData, const std::vector<NativeBody> &nativeBodies);
+
     std::string GPSEpochTime;   //!< -- String for the GPS epoch
     double JDGPSEpoch;          //!< s Epoch for GPS time.  Saved for efficiency
 
     std::vector<SpicePlanetStateMsgPayload> planetData;
     std::vector<SpicePlanetStateMsgPayload> scData;
 
+    bool nativeEphemeris;                   //!< -- flag if the native kernel reader is used in the current run
+    SpiceKernelReader kernelReader;         //!< -- native reader of the loaded SPK and binary PCK kernels
+    int zeroBaseId;                         //!< -- NAIF id of the zero base
+    std::vector<NativeBody> nativePlanets;  //!< -- NAIF ids of the planets
+    std::vector<NativeBody> nativeSc;       //!< -- NAIF ids of the spacecraft
+    double deltaTA;                         //!< s difference between TDT and TAI
+    double deltetK;                         //!< s amplitude of the periodic TDB-TDT difference
+    double deltetEB;                        //!< -- eccentricity of the heliocentric orbit of the Earth-Moon barycenter
+    double deltetM[2];                      //!< rad, rad/s mean anomaly of the Earth-Moon barycenter at J2000 and its rate
+    std::vector<double> deltaAT;            //!< s, s pairs of the TAI-UTC offset and the UTC epoch it applies from
+
 };
 
 
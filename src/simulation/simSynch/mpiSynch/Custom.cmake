@@ -0,0 +1,2 @@
+find_package(MPI REQUIRED COMPONENTS CXX)
+target_link_libraries(${TARGET_NAME} PRIVATE MPI::MPI_CXX)
@@ -0,0 +1,136 @@
+# ISC License
+#
+# Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+
+#
+# Basilisk Unit Test
+#
+# Purpose:  Checks the message exchange and the global stop of the MPI synch module on two ranks
+#
+
+import os
+import shutil
+import subprocess
+import sys
+
+import numpy as np
+import pytest
+from Basilisk.architecture import bskLogging
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+importErr = False
+reasonErr = ""
+try:
+    from Basilisk.simulation import mpiSynch
+except ImportError:
+    importErr = True
+    reasonErr = "mpiSynch not built---check the mpi option"
+if shutil.which("mpirun") is None:
+    importErr = True
+    reasonErr += "\nmpirun not found"
+
+
+def runChain(distributed):
+    """
+    Run two template modules, where the second one reads the output of the first, until a stop condition on the
+    output of the first module is met.  In the distributed run each module is executed on its own rank.
+    """
+    scSim = SimulationBaseClass.SimBaseClass()
+    dt = macros.sec2nano(1.0)
+    # the reading vehicle runs first, so it reads the output of the previous step in both runs
+    readerProc = scSim.CreateNewProcess("reader", 20)
+    readerProc.addTask(scSim.CreateNewTask("readerTask", dt))
+    writerProc = scSim.CreateNewProcess("writer", 10)
+    writerProc.addTask(scSim.CreateNewTask("writerTask", dt))
+
+    writer = cppModuleTemplate.CppModuleTemplate()
+    writer.ModelTag = "writer"
+    scSim.AddModelToTask("writerTask", writer)
+    reader = cppModuleTemplate.CppModuleTemplate()
+    reader.ModelTag = "reader"
+    reader.dataInMsg.subscribeTo(writer.dataOutMsg)
+    scSim.AddModelToTask("readerTask", reader)
+    readerLog = reader.dataOutMsg.recorder()
+    scSim.AddModelToTask("readerTask", readerLog)
+
+    scSim.addMessageStopCondition("writerDone", writer.dataOutMsg, "dataVector", ">=", 5.0, index=0)
+
+    exchange = None
+    if distributed:
+        exchangeProc = scSim.CreateNewProcess("exchange", 0)
+        exchangeProc.addTask(scSim.CreateNewTask("exchangeTask", dt))
+        exchange = mpiSynch.MpiSynch()
+        exchange.ModelTag = "mpiSynch"
+        exchange.addProcess(writerProc, 0)
+        exchange.addProcess(readerProc, 1)
+        exchange.addMessage(writer.dataOutMsg, 0)
+        exchange.attachStopConditions(scSim)
+        scSim.AddModelToTask("exchangeTask", exchange)
+
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(20.0))
+    scSim.ExecuteSimulation()
+
+    return exchange, readerLog, scSim.getStopCondition()
+
+
+def runRanks():
+    """entry point of each rank when the file is run through mpirun, exits with a non-zero code on failure"""
+    bskLogging.setDefaultLogLevel(bskLogging.BSK_WARNING)
+    serial = runChain(False)
+    exchange, readerLog, stopInfo = runChain(True)
+    rank = exchange.getRank()
+
+    assert exchange.getNumRanks() == 2
+    assert exchange.getLinkCount() == 1
+    # every rank stops after the same exchange, with the name of the condition met on the writing rank
+    assert stopInfo == serial[2], "rank " + str(rank) + " stopped at " + str(stopInfo)
+    assert exchange.globalStop.stopRank == 0
+    assert exchange.exchangeCount == 5
+    if rank == 1:
+        np.testing.assert_array_equal(readerLog.times(), serial[1].times())
+        np.testing.assert_allclose(readerLog.dataVector, serial[1].dataVector, atol=1e-12)
+    else:
+        assert len(readerLog.times()) == 0, "the reader process must only run on rank 1"
+    assert exchange.allRanks(True) and not exchange.anyRank(False)
+
+
+@pytest.mark.skipif(importErr, reason=reasonErr)
+def test_mpiSynch():
+    """
+    Runs this file on two ranks through mpirun.  The module writing a message runs on rank 0 and the module reading
+    it on rank 1, and the reader output must match the serial simulation.  A stop condition met on rank 0 must stop
+    both ranks at the same time.
+    """
+    env = dict(os.environ)
+    # let Open MPI run in containers and on machines with a single core, other MPI libraries ignore these
+    env.setdefault("OMPI_ALLOW_RUN_AS_ROOT", "1")
+    env.setdefault("OMPI_ALLOW_RUN_AS_ROOT_CONFIRM", "1")
+    env.setdefault("OMPI_MCA_rmaps_base_oversubscribe", "1")
+    result = subprocess.run(["mpirun", "-n", "2", sys.executable, os.path.abspath(__file__), "--ranks"],
+                            env=env, capture_output=True, text=True, timeout=300)
+    assert result.returncode == 0, result.stdout + result.stderr
+
+
+if __name__ == "__main__":
+    if "--ranks" in sys.argv:
+        runRanks()
+    else:
+        test_mpiSynch()
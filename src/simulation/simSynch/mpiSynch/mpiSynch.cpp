@@ -0,0 +1,281 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+#include "simulation/simSynch/mpiSynch/mpiSynch.h"
+#include <mpi.h>
+#include <cstdlib>
+#include <cstring>
+
+/*! This function finalizes MPI at process exit if this module initialized it. */
+static void finalizeMpi()
+{
+    int finalized = 0;
+    MPI_Finalized(&finalized);
+    if (!finalized) {
+        MPI_Finalize();
+    }
+}
+
+/*! This function returns the size of a message in the exchange buffers.  Payloads are padded to 8 bytes so that
+    every header in the buffers is aligned.
+    @param payloadSize [bytes] size of the message payload
+    @return uint64_t [bytes] size of the serialized message
+*/
+static uint64_t serializedSize(uint64_t payloadSize)
+{
+    return sizeof(MsgHeader) + ((payloadSize + 7) & ~((uint64_t) 7));
+}
+
+/*! The constructor clears the condition state. */
+MpiStopCondition::MpiStopCondition()
+{
+    this->name = "mpiSynch";
+    this->reset();
+}
+
+/*! This method clears the condition state at the start of a run.
+    @return void
+*/
+void MpiStopCondition::reset()
+{
+    this->globalStopMet = false;
+    this->stopRank = -1;
+}
+
+/*! This method returns true once the exchange has found a rank that met one of its stop conditions.
+    @param CurrentSimNanos [ns] current simulation time
+    @return bool
+*/
+bool MpiStopCondition::isMet(uint64_t CurrentSimNanos)
+{
+    return this->globalStopMet;
+}
+
+/*! This is the constructor for the MPI synch model.  MPI is initialized here if it is not initialized yet, with
+    the thread support needed to call it from the scheduler threads. */
+MpiSynch::MpiSynch()
+{
+    int initialized = 0;
+    MPI_Initialized(&initialized);
+    if (!initialized) {
+        int provided = 0;
+        MPI_Init_thread(NULL, NULL, MPI_THREAD_SERIALIZED, &provided);
+        if (provided < MPI_THREAD_SERIALIZED) {
+            bskLogger.bskLog(BSK_WARNING, "MpiSynch: the MPI library does not support calls from the scheduler "
+                                          "threads, the exchange may fail.");
+        }
+        std::atexit(finalizeMpi);
+    }
+    MPI_Comm_rank(MPI_COMM_WORLD, &this->rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &this->numRanks);
+    this->exchangeCount = 0;
+    this->exchangeBytes = 0;
+    return;
+}
+
+/*! Destructor.  MPI stays initialized until the process exits. */
+MpiSynch::~MpiSynch()
+{
+    return;
+}
+
+/*! This method adds a message that is written on one rank and read on others.  Every rank must add the same
+    messages in the same order, with the local copy of the message on the ranks that do not write it.
+    @param payloadAddress address of the message payload on this rank
+    @param headerAddress address of the message header on this rank
+    @param payloadSize [bytes] size of the message payload
+    @param ownerRank rank that executes the module writing the message
+    @return void
+*/
+void MpiSynch::addMessageLink(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize, int ownerRank)
+{
+    if (ownerRank < 0 || ownerRank >= this->numRanks) {
+        bskLogger.bskLog(BSK_ERROR, "MpiSynch: owner rank %d is out of range for %d ranks.", ownerRank, this->numRanks);
+        return;
+    }
+    MpiMessageLink newLink;
+    newLink.payload = reinterpret_cast<char *> (payloadAddress);
+    newLink.header = reinterpret_cast<MsgHeader *> (headerAddress);
+    newLink.payloadSize = payloadSize;
+    newLink.ownerRank = ownerRank;
+    this->links.push_back(newLink);
+}
+
+/*! This method adds a stop condition that is evaluated on this rank at each exchange.  Once a condition is met on
+    any rank, globalStop is met on every rank after the same exchange.  Every rank must add the same conditions
+    in the same order.
+    @param condition the stop condition, the caller keeps ownership
+    @return void
+*/
+void MpiSynch::addStopCondition(StopCondition *condition)
+{
+    this->stopConditions.push_back(condition);
+}
+
+/*! This method checks that all of the ranks added the same message links, which is required for the blocks of
+    the exchange to line up.
+    @return bool
+*/
+bool MpiSynch::linksConsistent()
+{
+    //! - Hash the link count, sizes and owners in registration order
+    uint64_t signature[2] = {this->links.size(), 1469598103934665603ULL};
+    for (size_t i = 0; i < this->links.size(); i++) {
+        signature[1] = (signature[1] ^ this->links[i].payloadSize) * 1099511628211ULL;
+        signature[1] = (signature[1] ^ (uint64_t) this->links[i].ownerRank) * 1099511628211ULL;
+    }
+    uint64_t minSignature[2];
+    uint64_t maxSignature[2];
+    MPI_Allreduce(signature, minSignature, 2, MPI_UINT64_T, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(signature, maxSignature, 2, MPI_UINT64_T, MPI_MAX, MPI_COMM_WORLD);
+    return minSignature[0] == maxSignature[0] && minSignature[1] == maxSignature[1];
+}
+
+/*! Reset the module.  The exchange buffers are sized here so that the exchanges do not allocate memory.
+    @param currentSimNanos
+    @return void
+*/
+void MpiSynch::Reset(uint64_t currentSimNanos)
+{
+    this->exchangeCount = 0;
+    this->globalStop.reset();
+    std::vector<StopCondition*>::iterator it;
+    for (it = this->stopConditions.begin(); it != this->stopConditions.end(); it++) {
+        (*it)->reset();
+    }
+    if (!this->linksConsistent()) {
+        bskLogger.bskLog(BSK_ERROR, "MpiSynch: the ranks added different message links.");
+    }
+
+    //! - Each rank sends the index of its met stop condition followed by the messages it writes
+    this->recvCounts.assign(this->numRanks, sizeof(int64_t));
+    for (size_t i = 0; i < this->links.size(); i++) {
+        this->recvCounts[this->links[i].ownerRank] += (int) serializedSize(this->links[i].payloadSize);
+    }
+    this->recvDispls.assign(this->numRanks, 0);
+    for (int r = 1; r < this->numRanks; r++) {
+        this->recvDispls[r] = this->recvDispls[r-1] + this->recvCounts[r-1];
+    }
+    this->sendBuffer.assign(this->recvCounts[this->rank], 0);
+    this->recvBuffer.assign(this->recvDispls[this->numRanks-1] + this->recvCounts[this->numRanks-1], 0);
+    this->rankCursor.assign(this->numRanks, 0);
+    this->exchangeBytes = this->recvBuffer.size() - this->sendBuffer.size();
+}
+
+/*! This method serializes the messages written on this rank, gathers the blocks of all of the ranks and copies the
+    messages written on the other ranks into their local copies.  The link flag of the local headers is kept.
+    @return void
+*/
+void MpiSynch::exchangeMessages()
+{
+    char *sendPtr = this->sendBuffer.data() + sizeof(int64_t);
+    for (size_t i = 0; i < this->links.size(); i++) {
+        const MpiMessageLink &link = this->links[i];
+        if (link.ownerRank == this->rank) {
+            memcpy(sendPtr, link.header, sizeof(MsgHeader));
+            memcpy(sendPtr + sizeof(MsgHeader), link.payload, link.payloadSize);
+            sendPtr += serializedSize(link.payloadSize);
+        }
+    }
+
+    MPI_Allgatherv(this->sendBuffer.data(), (int) this->sendBuffer.size(), MPI_BYTE,
+                   this->recvBuffer.data(), this->recvCounts.data(), this->recvDispls.data(), MPI_BYTE,
+                   MPI_COMM_WORLD);
+
+    //! - The stop flag of the lowest rank that met a stop condition is used on every rank
+    for (int r = 0; r < this->numRanks; r++) {
+        int64_t stopIndex;
+        memcpy(&stopIndex, this->recvBuffer.data() + this->recvDispls[r], sizeof(int64_t));
+        this->rankCursor[r] = this->recvDispls[r] + sizeof(int64_t);
+        if (stopIndex > 0 && !this->globalStop.globalStopMet) {
+            this->globalStop.globalStopMet = true;
+            this->globalStop.stopRank = r;
+            if ((size_t) stopIndex <= this->stopConditions.size()) {
+                this->globalStop.name = this->stopConditions[stopIndex-1]->name;
+                this->globalStop.isFailure = this->stopConditions[stopIndex-1]->isFailure;
+            }
+        }
+    }
+
+    //! - The blocks hold the messages of each rank in registration order, which is the same on every rank
+    for (size_t i = 0; i < this->links.size(); i++) {
+        const MpiMessageLink &link = this->links[i];
+        const char *recvPtr = this->recvBuffer.data() + this->rankCursor[link.ownerRank];
+        this->rankCursor[link.ownerRank] += serializedSize(link.payloadSize);
+        if (link.ownerRank == this->rank) {
+            continue;
+        }
+        MsgHeader remoteHeader;
+        memcpy(&remoteHeader, recvPtr, sizeof(MsgHeader));
+        link.header->isWritten = remoteHeader.isWritten;
+        link.header->timeWritten = remoteHeader.timeWritten;
+        link.header->moduleID = remoteHeader.moduleID;
+        memcpy(link.payload, recvPtr + sizeof(MsgHeader), link.payloadSize);
+    }
+}
+
+/*! This method evaluates the stop conditions of this rank and exchanges the messages between the ranks.
+    @param currentSimNanos The clock time associated with the model call
+    @return void
+*/
+void MpiSynch::UpdateState(uint64_t currentSimNanos)
+{
+    int64_t stopIndex = 0;
+    for (size_t i = 0; i < this->stopConditions.size(); i++) {
+        if (this->stopConditions[i]->isMet(currentSimNanos)) {
+            stopIndex = (int64_t) i + 1;
+            break;
+        }
+    }
+    memcpy(this->sendBuffer.data(), &stopIndex, sizeof(int64_t));
+    this->exchangeMessages();
+    this->exchangeCount++;
+}
+
+/*! This method returns true on every rank if the flag is set on any rank.  It is a collective call that must be
+    made by all of the ranks, for instance to agree on the outcome of a python event.
+    @param flag the flag of this rank
+    @return bool
+*/
+bool MpiSynch::anyRank(bool flag)
+{
+    int localFlag = flag ? 1 : 0;
+    int globalFlag = 0;
+    MPI_Allreduce(&localFlag, &globalFlag, 1, MPI_INT, MPI_LOR, MPI_COMM_WORLD);
+    return globalFlag != 0;
+}
+
+/*! This method returns true on every rank if the flag is set on all of the ranks.  It is a collective call.
+    @param flag the flag of this rank
+    @return bool
+*/
+bool MpiSynch::allRanks(bool flag)
+{
+    int localFlag = flag ? 1 : 0;
+    int globalFlag = 0;
+    MPI_Allreduce(&localFlag, &globalFlag, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+    return globalFlag != 0;
+}
+
+/*! This method holds the calling rank until all of the ranks have called it.
+    @return void
+*/
+void MpiSynch::barrier()
+{
+    MPI_Barrier(MPI_COMM_WORLD);
+}
@@ -0,0 +1,92 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef MPI_SYNCH_H
+#define MPI_SYNCH_H
+
+#include <stdint.h>
+#include <vector>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+#include "architecture/system_model/stop_condition.h"
+#include "architecture/messaging/msgHeader.h"
+
+#include "architecture/utilities/bskLogging.h"
+
+/*! @brief stop condition that is met on every rank once a stop condition of any rank is met */
+class MpiStopCondition: public StopCondition {
+public:
+    MpiStopCondition();
+    ~MpiStopCondition() {};
+    void reset();
+    bool isMet(uint64_t CurrentSimNanos);
+
+public:
+    bool globalStopMet;                 //!< [-] Flag set by the exchange once a rank has met one of its stop conditions
+    int stopRank;                       //!< [-] Lowest rank that met a stop condition, -1 if none
+};
+
+/*! @brief message buffer of a message that is exchanged between the ranks */
+typedef struct {
+    char *payload;                      //!< [-] Address of the message payload on this rank
+    MsgHeader *header;                  //!< [-] Address of the message header on this rank
+    uint64_t payloadSize;               //!< [bytes] Size of the message payload
+    int ownerRank;                      //!< [-] Rank that executes the module writing the message
+}MpiMessageLink;
+
+/*! @brief MPI exchange module that runs a simulation distributed over several processes */
+class MpiSynch: public SysModel {
+public:
+    MpiSynch();
+    ~MpiSynch();
+
+    void Reset(uint64_t currentSimNanos);
+    void UpdateState(uint64_t currentSimNanos);
+    void addMessageLink(uint64_t payloadAddress, uint64_t headerAddress, uint64_t payloadSize, int ownerRank);
+    void addStopCondition(StopCondition *condition);
+    int getRank() {return this->rank;}          //!< returns the rank of this process
+    int getNumRanks() {return this->numRanks;}  //!< returns the number of ranks
+    uint64_t getLinkCount() {return this->links.size();}  //!< returns the number of exchanged messages
+    bool anyRank(bool flag);
+    bool allRanks(bool flag);
+    void barrier();
+
+public:
+    MpiStopCondition globalStop;        //!< [-] Condition to add to the simulation on every rank
+    uint64_t exchangeCount;             //!< [-] Number of exchanges since the last reset
+    uint64_t exchangeBytes;             //!< [bytes] Number of bytes received by this rank in each exchange
+    BSKLogger bskLogger;                //!< -- BSK Logging
+
+private:
+    void exchangeMessages();
+    bool linksConsistent();
+
+private:
+    int rank;                           //!< [-] Rank of this process in MPI_COMM_WORLD
+    int numRanks;                       //!< [-] Number of processes in MPI_COMM_WORLD
+    std::vector<MpiMessageLink> links;  //!< [-] Exchanged messages, in the same order on every rank
+    std::vector<StopCondition*> stopConditions;  //!< [-] Conditions evaluated on this rank at each exchange
+    std::vector<char> sendBuffer;       //!< [-] Serialized messages written on this rank
+    std::vector<char> recvBuffer;       //!< [-] Serialized messages of all of the ranks
+    std::vector<int> recvCounts;        //!< [bytes] Size of the block of each rank
+    std::vector<int> recvDispls;        //!< [bytes] Offset of the block of each rank in the receive buffer
+    std::vector<uint64_t> rankCursor;   //!< [bytes] Read position in the block of each rank while unpacking
+};
+
+
+#endif
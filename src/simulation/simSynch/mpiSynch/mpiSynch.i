@@ -0,0 +1,68 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+%module mpiSynch
+%{
+   #include "mpiSynch.h"
+%}
+
+%pythoncode %{
+from Basilisk.architecture.swig_common_model import *
+%}
+
+%include "std_string.i"
+%include "std_vector.i"
+%include "stdint.i"
+%include "swig_conly_data.i"
+%include "sys_model.h"
+%include "architecture/system_model/stop_condition.h"
+%include "mpiSynch.h"
+
+%extend MpiSynch {
+    %pythoncode %{
+        def addMessage(self, msg, ownerRank):
+            """add a message that is written on ``ownerRank`` and read on other ranks.  Every rank must add the
+            same messages in the same order.  On the other ranks the message is the local copy that the readers
+            subscribe to, which must be kept alive by the caller.  Only plain C payloads can be exchanged."""
+            payloadAddress, headerAddress, dtype = msg.payloadPointers()
+            self.addMessageLink(payloadAddress, headerAddress, dtype.itemsize, ownerRank)
+
+        def addProcess(self, proc, rank):
+            """run a process only on ``rank``.  The process is disabled on the other ranks."""
+            procData = getattr(proc, "processData", proc)
+            if rank == self.getRank():
+                procData.enableProcess()
+            else:
+                procData.disableProcess()
+
+        def attachStopConditions(self, scSim):
+            """make the stop conditions added to ``scSim`` global.  They are evaluated by this module at each
+            exchange, and every rank stops after the exchange in which a condition is met on any rank.  Call it
+            once, after adding the stop conditions and before initializing the simulation."""
+            scSim.TotalSim.clearStopConditions()
+            for condition in scSim.stopConditions:
+                if hasattr(condition, "isMet"):
+                    self.addStopCondition(condition)
+            scSim.addStopCondition(self.globalStop)
+    %}
+}
+
+%pythoncode %{
+import sys
+protectAllClasses(sys.modules[__name__])
+%}
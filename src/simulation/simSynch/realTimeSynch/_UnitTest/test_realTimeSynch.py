@@ -0,0 +1,84 @@
+# ISC License
+#
+# Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+# Permission to use, copy, modify, and/or distribute this software for any
+# purpose with or without fee is hereby granted, provided that the above
+# copyright notice and this permission notice appear in all copies.
+#
+# THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+# WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+# MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+# ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+# WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+# ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+# OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+#
+# Basilisk Unit Test
+#
+# Purpose:  Checks the frame pacing, statistics and allocation tracking of the real-time synch module
+#
+
+import time
+
+import numpy as np
+import pytest
+from Basilisk.simulation import realTimeSynch
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+
+
+def runRealTime(accelFactor, withRecorder):
+    """Run 1 s of simulation with 10 ms frames and return the module and the elapsed wall time"""
+    unitTestSim = SimulationBaseClass.SimBaseClass()
+    testProc = unitTestSim.CreateNewProcess("TestProcess")
+    testProc.addTask(unitTestSim.CreateNewTask("unitTask", macros.sec2nano(0.01)))
+
+    rtSynch = realTimeSynch.RealTimeSynch()
+    rtSynch.ModelTag = "realTimeSynch"
+    rtSynch.accelFactor = accelFactor
+    rtSynch.lockMemory = False      # avoid requiring memlock privileges on the test machines
+    unitTestSim.AddModelToTask("unitTask", rtSynch)
+    if withRecorder:
+        # the recorder grows its data buffers while the simulation runs
+        statsLog = rtSynch.rtStatsOutMsg.recorder()
+        unitTestSim.AddModelToTask("unitTask", statsLog)
+
+    unitTestSim.InitializeSimulation()
+    unitTestSim.ConfigureStopTime(macros.sec2nano(1.0))
+    start = time.monotonic()
+    unitTestSim.ExecuteSimulation()
+    return rtSynch, time.monotonic() - start
+
+
+def test_realTimePacing():
+    """The frames must be paced to the wall clock and all frame latencies must be in the histogram"""
+    accelFactor = 5.0
+    rtSynch, wallTime = runRealTime(accelFactor, False)
+    stats = rtSynch.statsBuffer
+
+    assert wallTime >= 1.0/accelFactor
+    assert stats.frameCount == 101
+    assert np.sum(stats.latencyHistogram) == stats.frameCount
+    assert stats.maxLatency >= stats.lastLatency >= 0
+    assert stats.deadlineMissCount <= stats.frameCount
+    assert 0.0 <= stats.frameLoad
+
+
+@pytest.mark.skipif(not realTimeSynch.RealTimeSynch().canTrackAllocations(),
+                    reason="allocations are only tracked on Linux in a build with the allocationGuard option")
+@pytest.mark.parametrize("withRecorder", [False, True])
+def test_realTimeAllocations(withRecorder):
+    """Only the module is allocation free, the recorder allocates while it runs"""
+    rtSynch, _ = runRealTime(100.0, withRecorder)
+    if withRecorder:
+        assert rtSynch.statsBuffer.allocationCount > 0
+    else:
+        assert rtSynch.statsBuffer.allocationCount == 0
+
+
+if __name__ == "__main__":
+    test_realTimePacing()
@@ -0,0 +1,266 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+#include "simulation/simSynch/realTimeSynch/realTimeSynch.h"
+#include "architecture/utilities/macroDefinitions.h"
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <alloca.h>
+#include <malloc.h>
+#include <sys/mman.h>
+#endif
+
+/*! This function reads the monotonic clock.
+    @return int64_t [ns] clock time
+*/
+static int64_t monotonicNanos()
+{
+#ifdef __linux__
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t) now.tv_sec*1000000000LL + (int64_t) now.tv_nsec;
+#else
+    return (int64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/*! This function sleeps until an absolute time of the monotonic clock.  Using an absolute deadline keeps the sleep
+    error from accumulating over the frames.
+    @param deadlineNanos [ns] clock time to wake up at
+*/
+static void sleepUntil(int64_t deadlineNanos)
+{
+#ifdef __linux__
+    struct timespec deadline;
+    deadline.tv_sec = (time_t) (deadlineNanos / 1000000000LL);
+    deadline.tv_nsec = (long) (deadlineNanos % 1000000000LL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) == EINTR) {}
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::time_point(std::chrono::nanoseconds(deadlineNanos)));
+#endif
+}
+
+#ifdef __linux__
+/*! This function touches the requested amount of stack so that the pages are resident before the frames start.
+    @param bytes [bytes] amount of stack to touch
+*/
+static void __attribute__((noinline)) prefaultStack(uint64_t bytes)
+{
+    volatile char *stack = (volatile char *) alloca(bytes);
+    for (uint64_t i = 0; i < bytes; i += 4096) {
+        stack[i] = 0;
+    }
+}
+#endif
+
+/*! This is the constructor for the real-time synch model.  It sets default variable
+    values and initializes the various parts of the model */
+RealTimeSynch::RealTimeSynch()
+{
+    this->accelFactor = 1.0;
+    this->deadlineToleranceNanos = 100000;
+    this->fifoPriority = 0;
+    this->lockMemory = true;
+    this->prefaultStackBytes = 256*1024;
+    this->checkAllocations = true;
+    this->assertNoAllocation = false;
+    this->timeInitialized = false;
+    this->startClockNanos = 0;
+    this->startSimTimeNano = 0;
+    this->lastReleaseNanos = 0;
+    this->lastDeadlineNanos = 0;
+    this->latencySum = 0.0;
+    memset(&this->statsBuffer, 0x0, sizeof(RealTimeStatsMsgPayload));
+    return;
+}
+
+/*! Destructor.  Nothing here. */
+RealTimeSynch::~RealTimeSynch()
+{
+    return;
+}
+
+
+/*! Reset the module variables.  The clocks are started again on the next call.
+    @param currentSimNanos
+    @return void
+*/
+void RealTimeSynch::Reset(uint64_t currentSimNanos)
+{
+    if (this->accelFactor <= 0.0) {
+        bskLogger.bskLog(BSK_ERROR, "RealTimeSynch: accelFactor must be positive.");
+    }
+    this->timeInitialized = false;
+    this->latencySum = 0.0;
+    memset(&this->statsBuffer, 0x0, sizeof(RealTimeStatsMsgPayload));
+    //! - The thread goes through initialization again, so drop any allocation guard from a previous run
+    AllocationGuard::disarm();
+}
+
+
+/*! This method configures the calling thread, which is the scheduler thread running the task of this module, and
+    the process for real-time execution.  Failures are reported as warnings so that a simulation can still be run
+    without the required privileges.
+    @param currentSimNanos The clock time associated with the model call
+*/
+void RealTimeSynch::startRealTime(uint64_t currentSimNanos)
+{
+#ifdef __linux__
+    //! - Pin the scheduler thread to the requested CPUs
+    if (!this->cpuList.empty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for (size_t i = 0; i < this->cpuList.size(); i++) {
+            if (this->cpuList[i] < 0 || this->cpuList[i] >= CPU_SETSIZE) {
+                bskLogger.bskLog(BSK_ERROR, "RealTimeSynch: CPU %d is out of range.", this->cpuList[i]);
+                continue;
+            }
+            CPU_SET(this->cpuList[i], &cpuSet);
+        }
+        int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+        if (rc != 0) {
+            bskLogger.bskLog(BSK_WARNING, "RealTimeSynch: could not pin the scheduler thread: %s", strerror(rc));
+        }
+    }
+
+    //! - Switch the scheduler thread to the SCHED_FIFO policy
+    this->statsBuffer.fifoScheduling = 0;
+    if (this->fifoPriority > 0) {
+        struct sched_param param;
+        memset(&param, 0x0, sizeof(param));
+        param.sched_priority = std::min(this->fifoPriority, sched_get_priority_max(SCHED_FIFO));
+        int rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (rc != 0) {
+            bskLogger.bskLog(BSK_WARNING, "RealTimeSynch: could not set SCHED_FIFO priority %d: %s",
+                             param.sched_priority, strerror(rc));
+        } else {
+            this->statsBuffer.fifoScheduling = 1;
+        }
+    }
+
+    //! - Lock current and future pages and keep freed heap memory in the process so it does not fault again
+    this->statsBuffer.memoryLocked = 0;
+    if (this->lockMemory) {
+        mallopt(M_TRIM_THRESHOLD, -1);
+        mallopt(M_MMAP_MAX, 0);
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            bskLogger.bskLog(BSK_WARNING, "RealTimeSynch: could not lock the process memory: %s", strerror(errno));
+        } else {
+            this->statsBuffer.memoryLocked = 1;
+        }
+    }
+    if (this->prefaultStackBytes > 0) {
+        prefaultStack(this->prefaultStackBytes);
+    }
+#else
+    if (!this->cpuList.empty() || this->fifoPriority > 0) {
+        bskLogger.bskLog(BSK_WARNING, "RealTimeSynch: CPU pinning and SCHED_FIFO are only supported on Linux.");
+    }
+#endif
+
+    if (this->assertNoAllocation && !AllocationGuard::isActive()) {
+        bskLogger.bskLog(BSK_WARNING, "RealTimeSynch: heap allocations are only tracked on Linux in a build with the "
+                                      "allocationGuard option.");
+    }
+
+    this->startClockNanos = monotonicNanos();
+    this->startSimTimeNano = currentSimNanos;
+    this->lastReleaseNanos = this->startClockNanos;
+    this->lastDeadlineNanos = this->startClockNanos;
+    this->timeInitialized = true;
+}
+
+
+/*! This method adds the latency of a frame start to the statistics.
+    @param latencyNanos [ns] latency of the frame start with respect to its deadline
+*/
+void RealTimeSynch::updateStatistics(int64_t latencyNanos)
+{
+    this->statsBuffer.frameCount++;
+    if (latencyNanos > this->deadlineToleranceNanos) {
+        this->statsBuffer.deadlineMissCount++;
+    }
+    this->statsBuffer.lastLatency = latencyNanos;
+    this->statsBuffer.maxLatency = std::max(this->statsBuffer.maxLatency, latencyNanos);
+    this->latencySum += (double) latencyNanos;
+    this->statsBuffer.meanLatency = this->latencySum / this->statsBuffer.frameCount;
+
+    //! - Bin 0 holds latencies below 1 us, bin k holds [2^(k-1), 2^k) us
+    int bin = 0;
+    int64_t latencyMicros = latencyNanos / 1000;
+    if (latencyMicros >= 1) {
+        bin = 1;
+        while (latencyMicros >= 2 && bin < MAX_RT_LATENCY_BINS - 1) {
+            latencyMicros >>= 1;
+            bin++;
+        }
+    }
+    this->statsBuffer.latencyHistogram[bin]++;
+}
+
+
+/*! This method paces the simulation to the wall clock.  Each frame has an absolute deadline found from the
+    simulation time, and the scheduler thread sleeps until that deadline.  A frame whose deadline has already
+    passed by more than the tolerance when the module is called counts as a deadline miss.
+    @return void
+    @param currentSimNanos The clock time associated with the model call
+*/
+void RealTimeSynch::UpdateState(uint64_t currentSimNanos)
+{
+    //! - Configure the thread and start the clocks on the first frame
+    if (!this->timeInitialized) {
+        this->startRealTime(currentSimNanos);
+    }
+
+    int64_t arrivalNanos = monotonicNanos();
+    int64_t deadlineNanos = this->startClockNanos
+                            + (int64_t) ((currentSimNanos - this->startSimTimeNano)/this->accelFactor);
+
+    //! - Fraction of the previous frame used by the simulation
+    if (deadlineNanos > this->lastDeadlineNanos) {
+        this->statsBuffer.frameLoad = (double) (arrivalNanos - this->lastReleaseNanos)
+                                      / (double) (deadlineNanos - this->lastDeadlineNanos);
+    }
+
+    //! - Sleep until the deadline if it is in the future
+    int64_t releaseNanos = arrivalNanos;
+    if (arrivalNanos < deadlineNanos) {
+        sleepUntil(deadlineNanos);
+        releaseNanos = monotonicNanos();
+    }
+    this->updateStatistics(releaseNanos - deadlineNanos);
+    this->lastReleaseNanos = releaseNanos;
+    this->lastDeadlineNanos = deadlineNanos;
+
+    //! - Write the frame statistics
+    this->statsBuffer.allocationCount = this->checkAllocations ? AllocationGuard::count() : 0;
+    this->rtStatsOutMsg.write(&this->statsBuffer, this->moduleID, currentSimNanos);
+
+    //! - Initialization ends with the first frame, from then on the scheduler thread must not allocate
+    if (this->checkAllocations && !AllocationGuard::isArmed()) {
+        AllocationGuard::arm(this->assertNoAllocation);
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ ISC License
+
+ Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+
+ Permission to use, copy, modify, and/or distribute this software for any
+ purpose with or without fee is hereby granted, provided that the above
+ copyright notice and this permission notice appear in all copies.
+
+ THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+ */
+
+#ifndef REAL_TIME_SYNCH_H
+#define REAL_TIME_SYNCH_H
+
+#include <stdint.h>
+#include <vector>
+#include "architecture/_GeneralModuleFiles/sys_model.h"
+
+#include "architecture/msgPayloadDefC/RealTimeStatsMsgPayload.h"
+#include "architecture/messaging/messaging.h"
+
+#include "architecture/utilities/bskLogging.h"
+#include "architecture/utilities/moduleIdGenerator/allocationGuard.h"
+
+/*! @brief hard real-time clock synchronization module for hardware-in-the-loop simulations */
+class RealTimeSynch: public SysModel {
+public:
+    RealTimeSynch();
+    ~RealTimeSynch();
+
+    void Reset(uint64_t currentSimNanos);
+    void UpdateState(uint64_t currentSimNanos);
+    bool canTrackAllocations() {return AllocationGuard::isActive();} //!< returns true if the build counts heap allocations
+
+public:
+    double accelFactor;                 //!< [-] Factor used to accelerate sim-time relative to clock, default 1
+    int64_t deadlineToleranceNanos;     //!< [ns] Lateness allowed before a frame counts as a deadline miss, default 100 us
+    std::vector<int> cpuList;           //!< [-] CPUs the scheduler thread is pinned to, empty keeps the current affinity
+    int fifoPriority;                   //!< [-] SCHED_FIFO priority of the scheduler thread, 0 keeps the default policy
+    bool lockMemory;                    //!< [-] Flag to lock the process memory with mlockall at start, default on
+    uint64_t prefaultStackBytes;        //!< [bytes] Amount of stack touched at start so that it is resident, default 256 kB
+    bool checkAllocations;              //!< [-] Flag to count the heap allocations of the scheduler thread after the first frame, default on
+    bool assertNoAllocation;            //!< [-] Flag to abort the process on the first heap allocation of the scheduler thread after the first frame
+    RealTimeStatsMsgPayload statsBuffer; //!< [-] Copy of the last frame statistics
+    Message<RealTimeStatsMsgPayload> rtStatsOutMsg; //!< [-] frame statistics output message
+    BSKLogger bskLogger;                //!< -- BSK Logging
+
+private:
+    void startRealTime(uint64_t currentSimNanos);
+    void updateStatistics(int64_t latencyNanos);
+
+private:
+    bool timeInitialized;               //!< [-] Flag that the clocks have been started
+    int64_t startClockNanos;            //!< [ns] Monotonic clock time of the first frame
+    uint64_t startSimTimeNano;          //!< [ns] Simulation time of the first frame
+    int64_t lastReleaseNanos;           //!< [ns] Monotonic clock time at which the last frame was released
+    int64_t lastDeadlineNanos;          //!< [ns] Deadline of the last frame
+    double latencySum;                  //!< [ns] Sum of the frame start latencies
+};
+
+
+#endif
@@ -0,0 +1,124 @@
+ # ISC License
+ #
+ # Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+ #
+ # Permission to use, copy, modify, and/or distribute this software for any
+ # purpose with or without fee is hereby granted, provided that the above
+ # copyright notice and this permission notice appear in all copies.
+ #
+ # THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ # WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ # MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ # ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ # WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ # ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ # OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#
+# Adaptive importance sampling of MonteCarlo campaigns.
+#
+# Purpose:  Spends more runs near the boundary between failed and successful runs.  The runs are drawn in
+#           the unit hypercube of the table dispersions and carry importance weights, so the weighted
+#           campaign statistics remain estimates under the nominal dispersions.
+#
+
+import math
+
+import numpy as np
+
+
+class BoundarySampler(object):
+    """
+    Importance sampler that proposes runs near the failure boundary.  After ``explorationRuns`` runs drawn
+    from the nominal dispersions, each failed run is paired with its nearest successful run in the unit
+    hypercube and the midpoints of the pairs become the centers of the proposal.  New runs are drawn from the
+    mixture of the nominal (uniform) density, with probability ``1 - boundaryFraction``, and of truncated
+    normal densities of width ``scale`` around the centers.  Each run is weighted by the inverse of the
+    mixture density, which is bounded by ``1 / (1 - boundaryFraction)``.
+    """
+
+    def __init__(self, explorationRuns=100, boundaryFraction=0.5, scale=0.05, maxCenters=200,
+                 failureMetric="failed"):
+        """
+        Args:
+            explorationRuns (int): number of runs drawn from the nominal dispersions before adapting
+            boundaryFraction (float): probability of drawing a run near the boundary, in [0, 1)
+            scale (float): standard deviation of the boundary densities in the unit hypercube
+            maxCenters (int): largest number of boundary centers, the closest pairs are kept
+            failureMetric (str): run metric flagging failed runs with a value above 0.5
+        """
+        if not 0.0 <= boundaryFraction < 1.0:
+            raise ValueError("boundaryFraction must be in [0, 1)")
+        self.explorationRuns = explorationRuns
+        self.boundaryFraction = boundaryFraction
+        self.scale = scale
+        self.maxCenters = maxCenters
+        self.failureMetric = failureMetric
+
+    def boundaryCenters(self, unitSamples, failed):
+        """
+        Returns the midpoints between failed runs and their nearest successful runs
+
+        :param unitSamples: (numRuns, numColumns) unit hypercube samples of the finished runs
+        :param failed: (numRuns,) boolean failure flags of the finished runs
+        :return: (numCenters, numColumns) array, empty if the runs have not both failed and succeeded
+        """
+        failedSamples = unitSamples[failed]
+        successSamples = unitSamples[~failed]
+        if len(failedSamples) == 0 or len(successSamples) == 0:
+            return np.empty((0, unitSamples.shape[1]))
+        centers = np.empty(failedSamples.shape)
+        distances = np.empty(len(failedSamples))
+        chunk = max(1, 2 ** 22 // max(1, successSamples.size))  # bound the memory of the distance matrix
+        for start in range(0, len(failedSamples), chunk):
+            block = failedSamples[start:start + chunk]
+            dist2 = np.sum((block[:, None, :] - successSamples[None, :, :]) ** 2, axis=2)
+            nearest = np.argmin(dist2, axis=1)
+            centers[start:start + chunk] = 0.5 * (block + successSamples[nearest])
+            distances[start:start + chunk] = dist2[np.arange(len(block)), nearest]
+        return centers[np.argsort(distances)[:self.maxCenters]]
+
+    def _truncationMass(self, centers):
+        """Mass of the normal densities around the centers that falls inside the unit hypercube"""
+        erf = np.vectorize(math.erf)
+        upper = 0.5 * (1.0 + erf((1.0 - centers) / (self.scale * math.sqrt(2.0))))
+        lower = 0.5 * (1.0 + erf(-centers / (self.scale * math.sqrt(2.0))))
+        return np.prod(upper - lower, axis=1)
+
+    def density(self, samples, centers):
+        """Returns the proposal density of unit hypercube samples, relative to the nominal (uniform) density"""
+        if len(centers) == 0:
+            return np.ones(len(samples))
+        dist2 = np.sum((samples[:, None, :] - centers[None, :, :]) ** 2, axis=2)
+        numDims = samples.shape[1]
+        normal = np.exp(-0.5 * dist2 / self.scale ** 2) / (math.sqrt(2.0 * math.pi) * self.scale) ** numDims
+        boundary = np.mean(normal / self._truncationMass(centers)[None, :], axis=1)
+        return (1.0 - self.boundaryFraction) + self.boundaryFraction * boundary
+
+    def propose(self, numRuns, unitSamples, failed, rng):
+        """
+        Proposes new runs from the finished ones
+
+        :param numRuns: number of runs to propose
+        :param unitSamples: (numFinished, numColumns) unit hypercube samples of the finished runs
+        :param failed: (numFinished,) boolean failure flags of the finished runs
+        :param rng: ``numpy.random.Generator``
+        :return: (numRuns, numColumns) unit hypercube samples and (numRuns,) importance weights
+        """
+        numDims = unitSamples.shape[1]
+        centers = self.boundaryCenters(unitSamples, np.asarray(failed, dtype=bool))
+        samples = rng.random((numRuns, numDims))
+        if len(centers) == 0 or self.boundaryFraction == 0.0:
+            return samples, np.ones(numRuns)
+
+        nearBoundary = rng.random(numRuns) < self.boundaryFraction
+        chosen = centers[rng.integers(len(centers), size=np.count_nonzero(nearBoundary))]
+        candidates = chosen + self.scale * rng.standard_normal(chosen.shape)
+        # the truncated density is a product over the dimensions, so each element is redrawn until it is inside
+        outside = (candidates <= 0.0) | (candidates >= 1.0)
+        while np.any(outside):
+            candidates[outside] = chosen[outside] + self.scale * rng.standard_normal(np.count_nonzero(outside))
+            outside = (candidates <= 0.0) | (candidates >= 1.0)
+        samples[nearBoundary] = candidates
+        return samples, 1.0 / self.density(samples, centers)
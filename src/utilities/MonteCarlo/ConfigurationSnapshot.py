@@ -0,0 +1,154 @@
+ # ISC License
+ #
+ # Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+ #
+ # Permission to use, copy, modify, and/or distribute this software for any
+ # purpose with or without fee is hereby granted, provided that the above
+ # copyright notice and this permission notice appear in all copies.
+ #
+ # THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ # WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ # MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ # ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ # WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ # ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ # OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+
+#
+# Configuration snapshot of MonteCarlo campaigns.
+#
+# Purpose:  Captures the configuration of a built simulation and restores it between the runs of a campaign,
+#           so the simulation is built once per worker and only reset for each run.
+#
+
+import copy
+
+_plainTypes = (bool, int, float, str)
+
+
+def isPlainValue(value):
+    """Returns True for numbers, strings and (nested) lists or tuples of them, which can be copied and assigned back"""
+    if isinstance(value, _plainTypes):
+        return True
+    if isinstance(value, (list, tuple)):
+        return all(isPlainValue(item) for item in value)
+    return False
+
+
+def isSwigObject(value):
+    """Returns True for the python proxy of a C/C++ object"""
+    return hasattr(value, "this") and hasattr(value, "thisown") and not isinstance(value, type)
+
+
+def isMessageObject(value):
+    """Returns True for messages, message readers and recorders, whose payloads are not configuration"""
+    return any(hasattr(value, name) for name in ("addSubscriber", "subscribeTo", "payloadPointers", "times"))
+
+
+class ConfigurationSnapshot(object):
+    """
+    Snapshot of the configuration of a simulation after it was built, used to run several cases on one
+    simulation instance.  ``capture()`` records
+
+    - the variables of the modules added to the tasks, including the configuration structures of C modules and
+      the members of nested C++ objects such as the hub of a spacecraft, that hold numbers, strings or lists
+      of them
+    - the plain attributes of the python modules
+    - the activity of the tasks and processes, the state of the events and the stop time of the simulation
+
+    ``restore()`` assigns back the values that changed since the capture.  The module states are not part of
+    the snapshot: they are initialized again by the ``Reset()`` methods in ``InitializeSimulation()``.
+    Variables that are only used while the simulation is built, such as scenario parameters read by the creation
+    function, are not restored and must not be dispersed when the simulation is reused.
+    """
+
+    def __init__(self, simInstance, maxDepth=3):
+        """
+        Args:
+            simInstance: SimulationBaseClass
+                The built simulation
+            maxDepth: int
+                Number of levels of nested C++ objects that are searched for variables below each module
+        """
+        self.simInstance = simInstance
+        self.maxDepth = maxDepth
+        self.entries = []
+
+    def captureObject(self, obj, depth, visited):
+        """Records the variables of a C/C++ object and of the objects nested in it"""
+        key = (type(obj).__name__, int(obj.this))
+        if key in visited:
+            return
+        visited.add(key)
+        objType = type(obj)
+        for name in dir(objType):
+            if name.startswith("_") or name.startswith("this"):
+                continue
+            attribute = getattr(objType, name, None)
+            if not isinstance(attribute, property) or attribute.fset is None:
+                continue
+            try:
+                value = getattr(obj, name)
+            except Exception:
+                continue
+            if isPlainValue(value):
+                self.entries.append((obj, name, copy.deepcopy(value)))
+            elif depth < self.maxDepth and isSwigObject(value) and not isMessageObject(value):
+                self.captureObject(value, depth + 1, visited)
+
+    def capturePythonModel(self, model):
+        """Records the plain attributes of a python module"""
+        for name, value in vars(model).items():
+            if not name.startswith("_") and isPlainValue(value):
+                self.entries.append((model, name, copy.deepcopy(value)))
+
+    def capture(self):
+        """
+        Records the configuration of the simulation
+
+        :return: number of recorded values
+        """
+        sim = self.simInstance
+        self.entries = []
+        visited = set()
+        for task in sim.TaskList:
+            for model in task.TaskModels:
+                if isSwigObject(model):
+                    self.captureObject(model, 0, visited)
+            self.entries.append((task.TaskData, "taskActive", task.TaskData.taskActive))
+        for pyProc in sim.pyProcList:
+            for pyTask in pyProc.taskList:
+                self.entries.append((pyTask, "taskActive", pyTask.taskActive))
+                for model in pyTask.modelList:
+                    self.capturePythonModel(model)
+        for event in sim.eventMap.values():
+            for name in ("eventActive", "occurCounter", "prevTime"):
+                self.entries.append((event, name, getattr(event, name)))
+        for name in ("StopTime", "terminate"):
+            self.entries.append((sim, name, getattr(sim, name)))
+        self.processStates = [(proc.processData, proc.processData.processEnabled())
+                              for proc in sim.procList + sim.pyProcList]
+        return len(self.entries)
+
+    def restore(self):
+        """
+        Assigns back the recorded values that changed since the capture
+
+        :return: number of restored values
+        """
+        restored = 0
+        for obj, name, value in self.entries:
+            if getattr(obj, name) != value:
+                setattr(obj, name, copy.deepcopy(value))
+                restored += 1
+        for processData, enabled in self.processStates:
+            if processData.processEnabled() != enabled:
+                if enabled:
+                    processData.enableProcess()
+                else:
+                    processData.disableProcess()
+                restored += 1
+        return restored
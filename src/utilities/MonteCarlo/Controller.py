@@ -24,6 +24,7 @@
 # Creation Date:  July. 20, 2017
 #
 
+import ast
 import os
 import random
 import shutil
@@ -41,8 +42,12 @@ import time
 import numpy as np
 import multiprocessing as mp
 import pickle as pickle
+from Basilisk.utilities.MonteCarlo.ConfigurationSnapshot import ConfigurationSnapshot
 from Basilisk.utilities.MonteCarlo.DataWriter import DataWriter
+from Basilisk.utilities.MonteCarlo.DispersionTable import DispersionTable, TableDispersion, compileSetter
+from Basilisk.utilities.MonteCarlo.EnvironmentCache import EnvironmentCache
 from Basilisk.utilities.MonteCarlo.RetentionPolicy import RetentionPolicy
+from Basilisk.utilities.MonteCarlo.Statistics import StreamingStatistic
 from Basilisk.utilities.simulationProgessBar import SimulationProgressBar
 
 
@@ -60,6 +65,15 @@ class Controller:
         self.archiveDir = None
         self.varCast = None
         self.numProcess = mp.cpu_count()
+        self.tableDispersions = []
+        self.samplingMethod = "lhs"
+        self.samplingSeed = None
+        self.dispersionTable = None
+        self.convergenceCriteria = []
+        self.adaptiveSampler = None
+        self.caseMetrics = {}
+        self.campaignStatistics = {}
+        self.environmentCache = None
 
         self.simParams = SimulationParameters(
             creationFunction=None,
@@ -158,13 +172,114 @@ class Controller:
 
     def addDispersion(self, disp):
         """
-        Add a dispersion to the simulation.
+        Add a dispersion to the simulation.  Table dispersions (see ``DispersionTable.py``) are generated for
+        all runs at once when the simulations are executed, the other dispersions are generated in each run.
 
         Args:
             disp: Dispersion
                 The dispersion to add to the simulation.
         """
-        self.simParams.dispersions.append(disp)
+        if isinstance(disp, TableDispersion):
+            self.tableDispersions.append(disp)
+        else:
+            self.simParams.dispersions.append(disp)
+
+    def setSamplingMethod(self, method, seed=None):
+        """
+        Set how the unit samples of the table dispersions are drawn
+
+        Args:
+            method: string
+                'random' for independent samples, 'lhs' for a Latin hypercube (default) or 'sobol' for
+                a scrambled Sobol sequence
+            seed: int
+                Seed of the campaign. The same seed reproduces the same dispersion table. None for a random seed.
+        """
+        if method not in DispersionTable.samplingMethods:
+            raise ValueError("Unknown sampling method '" + str(method) + "', use one of "
+                             + str(DispersionTable.samplingMethods))
+        self.samplingMethod = method
+        self.samplingSeed = seed
+
+    def addMetric(self, name, metricFunction):
+        """
+        Add a scalar metric evaluated at the end of each run.  The metrics of the finished runs are accumulated
+        in streaming statistics, see ``getCampaignStatistics()``.  Runs with native stop conditions also report
+        the metrics "failed", 1 if a failure stop condition ended the run, and "stopTime" in nanoseconds.
+
+        Args:
+            name: string
+                The name of the metric
+            metricFunction: (sim: SimulationBaseClass) => float
+                A function evaluating the metric on the simulation after the execution function returned.
+        """
+        self.simParams.metricFunctions[name] = metricFunction
+
+    def addConvergenceCriterion(self, criterion):
+        """
+        Add a criterion on the confidence interval of a run metric.  Once all criteria are met, no further runs
+        are started and the campaign ends before ``executionCount`` runs.
+
+        Args:
+            criterion: ConvergenceCriterion
+                The convergence criterion, see ``Statistics.py``
+        """
+        self.convergenceCriteria.append(criterion)
+
+    def setAdaptiveSampler(self, sampler):
+        """
+        Set an importance sampler proposing the table dispersions of the runs that follow the exploration runs.
+        The runs carry importance weights that are used by the campaign statistics.
+
+        Args:
+            sampler: BoundarySampler
+                The adaptive sampler, see ``AdaptiveSampling.py``
+        """
+        self.adaptiveSampler = sampler
+
+    def setEnvironmentReplay(self, environmentFunction):
+        """
+        Compute the outputs of the environment modules once, in a nominal run without dispersions, and replay
+        them in every run of the campaign in place of the environment modules.  This suits campaigns dispersing
+        flight software parameters only, see ``EnvironmentCache.py``.
+
+        Args:
+            environmentFunction: (sim: SimulationBaseClass) => list
+                A function returning the environment modules of a simulation, such as the spice, atmosphere,
+                magnetic field and eclipse modules.  Pass None to execute the environment modules in every run.
+        """
+        self.environmentCache = None if environmentFunction is None else EnvironmentCache(environmentFunction)
+
+    def setWarmReuse(self, warmReuse):
+        """
+        Build the simulation once in each worker process and reuse it for the following runs of the worker.
+        After the first build the configuration of the modules is captured; before each following run it is
+        restored, the dispersions of the run are applied and the simulation is initialized again, which resets
+        the modules without constructing them or loading their data files again.  The dispersions must set
+        module variables, not parameters that are only read by the creation function.  See
+        ``ConfigurationSnapshot.py`` for the captured configuration.
+
+        Args:
+            warmReuse: bool
+                Whether to reuse the simulation of the previous run of the worker
+        """
+        self.simParams.warmReuse = warmReuse
+
+    def getCampaignStatistics(self):
+        """
+        Get the streaming statistics of the run metrics
+
+        :return: dictionary of StreamingStatistic, keyed by metric name
+        """
+        return self.campaignStatistics
+
+    def getDispersionTable(self):
+        """
+        Get the table holding the values of the table dispersions of all runs
+
+        :return: DispersionTable, or None if no table dispersions were executed
+        """
+        return self.dispersionTable
 
     def addRetentionPolicy(self, policy):
         """
@@ -341,7 +456,7 @@ class Controller:
 
             # execute simulation with dispersion
             executor = SimulationExecutor()
-            success = executor([simParams, self.dataOutQueue])
+            success = executor([simParams, self.dataOutQueue])[0]
 
             if not success:
                 print("Error re-executing run", caseNumber)
@@ -431,6 +546,8 @@ class Controller:
             if self.numProcess > numSims:
                 print("Fewer MCs spawned than processes assigned (%d < %d). Changing processes count to %d." % (numSims, self.numProcess, numSims))
                 self.numProcess = numSims
+            # with the warm reuse the worker processes, and the simulations they keep, live for the whole campaign
+            warmPool = mp.Pool(self.numProcess) if self.simParams.warmReuse else None
             for i in range(numSims//self.numProcess):
                 # If number of sims doesn't factor evenly into the number of processes:
                 if numSims % self.numProcess != 0 and i == len(list(range(numSims//self.numProcess)))-1:
@@ -439,7 +556,7 @@ class Controller:
                     offset = 0
 
                 simGenerator = self.generateICSims(caseList[self.numProcess*i:self.numProcess*(i+1)+offset])
-                pool = mp.Pool(self.numProcess)
+                pool = warmPool if warmPool is not None else mp.Pool(self.numProcess)
                 try:
                     # yields results *as* the workers finish jobs
                     for result in pool.imap_unordered(simulationExecutor, [(x, self.dataOutQueue) for x in simGenerator]):
@@ -449,19 +566,26 @@ class Controller:
 
                         jobsFinished += 1
                         progressBar.update(jobsFinished)
-                    pool.close()
+                    if warmPool is None:
+                        pool.close()
                 except KeyboardInterrupt as e:
                     print("Ctrl-C was hit, closing pool")
                     # failed.extend(range(jobsFinished, numSims))  # fail all potentially running jobs...
                     pool.terminate()
+                    pool.join()
                     raise e
                 except Exception as e:
                     print("Unknown exception while running simulations:", e)
                     # failed.extend(range(jobsFinished, numSims))  # fail all potentially running jobs...
                     traceback.print_exc()
                     pool.terminate()
+                    warmPool = None
                 finally:
-                    pool.join()
+                    if warmPool is None:
+                        pool.join()
+            if warmPool is not None:
+                warmPool.close()
+                warmPool.join()
 
         progressBar.markComplete()
         progressBar.close()
@@ -542,12 +666,66 @@ class Controller:
         # changing each clone's index and filename to make a list of
         # simulations to execute
         for i in simNumList:
-            simClone = copy.deepcopy(self.simParams)
+            # the environment tables are shared by all runs instead of being copied
+            simClone = copy.deepcopy(self.simParams, {id(self.environmentCache): self.environmentCache})
             simClone.index = i
             simClone.filename += "run" + str(i)
+            if self.dispersionTable is not None:
+                simClone.tableRow = self.dispersionTable.row(i)
 
             yield simClone
 
+    def extendDispersionTable(self, numRuns):
+        """
+        Make sure the dispersion table holds at least ``numRuns`` runs.  With an adaptive sampler the missing
+        runs are proposed from the runs that finished so far.
+
+        Args:
+            numRuns: int
+                The number of runs the table must hold
+        """
+        table = self.dispersionTable
+        if self.adaptiveSampler is None or table is None or len(table) >= numRuns:
+            return
+        finished = sorted(self.caseMetrics.keys())
+        failureMetric = self.adaptiveSampler.failureMetric
+        failedFlags = np.array([self.caseMetrics[idx].get(failureMetric, 0.0) > 0.5 for idx in finished], dtype=bool)
+        unitSamples, weights = self.adaptiveSampler.propose(numRuns - len(table),
+                                                            table.unitSamples[finished],
+                                                            failedFlags, self.samplingRng)
+        caseSeeds = self.samplingRng.integers(0, 1 << 32, size=len(unitSamples), dtype=np.uint32)
+        table.append(DispersionTable.fromUnitSamples(self.tableDispersions, unitSamples, caseSeeds, weights))
+
+    def recordCaseMetrics(self, index, metrics):
+        """
+        Add the metrics of a finished run to the campaign statistics
+
+        Args:
+            index: int
+                The index of the run
+            metrics: dict
+                The metric values of the run, keyed by metric name
+        """
+        self.caseMetrics[index] = metrics
+        weight = 1.0
+        if self.dispersionTable is not None and index < len(self.dispersionTable):
+            weight = float(self.dispersionTable.weights[index])
+        for name, value in metrics.items():
+            if name not in self.campaignStatistics:
+                self.campaignStatistics[name] = StreamingStatistic(name)
+            self.campaignStatistics[name].add(value, weight)
+
+    def campaignConverged(self):
+        """
+        Check the convergence criteria of the campaign
+
+        :return: True if there are convergence criteria and all of them are met
+        """
+        if len(self.convergenceCriteria) == 0:
+            return False
+        return all(criterion.isConverged(self.campaignStatistics.get(criterion.metricName))
+                   for criterion in self.convergenceCriteria)
+
     def executeCallbacks(self, rng=None, retentionPolicies=[]):
         """
         Execute retention policy callbacks after running a monteCarlo sim.
@@ -579,6 +757,31 @@ class Controller:
         if self.simParams.verbose:
             print("Beginning simulation with {0} runs on {1} threads".format(self.executionCount, self.numProcess))
 
+        # generate the table dispersions of all runs at once, so the table is archived with the controller.
+        # With an adaptive sampler only the exploration runs are generated up front.
+        self.caseMetrics = {}
+        self.campaignStatistics = {}
+        self.samplingRng = np.random.default_rng(self.samplingSeed)
+        if self.adaptiveSampler is not None and len(self.tableDispersions) == 0:
+            raise ValueError("Adaptive sampling requires table dispersions")
+        if len(self.tableDispersions) > 0:
+            numTableRuns = self.executionCount
+            if self.adaptiveSampler is not None:
+                numTableRuns = min(self.adaptiveSampler.explorationRuns, self.executionCount)
+            self.dispersionTable = DispersionTable.generate(self.tableDispersions, numTableRuns,
+                                                            self.samplingMethod, self.samplingSeed)
+
+        # record the environment of a nominal run, which is replayed in all runs
+        self.simParams.environmentCache = self.environmentCache
+        if self.environmentCache is not None:
+            if self.simParams.verbose:
+                print("Recording the environment of a nominal run")
+            nominalSim = self.simParams.creationFunction()
+            if self.simParams.configureFunction is not None:
+                self.simParams.configureFunction(nominalSim)
+            self.environmentCache.record(nominalSim, SimulationExecutor.executionFunction(self.simParams))
+            del nominalSim
+
         if self.simParams.shouldArchiveParameters:
             if os.path.exists(self.archiveDir):
                 shutil.rmtree(self.archiveDir, ignore_errors=True)
@@ -627,52 +830,76 @@ class Controller:
                 print("Executing sequentially...")
             i = 0
             for i in range(numSims):
+                self.extendDispersionTable(i + 1)
                 simGenerator = self.generateSims(list(range(i,i+1)))
                 for sim in simGenerator:
                     try:
-                        run_ok = simulationExecutor([sim, self.dataOutQueue])[0]
+                        run_ok, _, metrics = simulationExecutor([sim, self.dataOutQueue])
                     except:
                         failed.append(i)
                     else:
                         if not run_ok:
                             failed.append(i)
+                        else:
+                            self.recordCaseMetrics(i, metrics)
                     i += 1
                     progressBar.update(i)
+                if self.campaignConverged():
+                    break
+            # the sequential runs share this process, drop the warm simulation so later campaigns rebuild
+            _warmSimulations.clear()
         else:
             if self.numProcess > numSims:
                 print("Fewer MCs spawned than processes assigned (%d < %d). Changing processes count to %d." % (numSims, self.numProcess, numSims))
                 self.numProcess = numSims
+            # with the warm reuse the worker processes, and the simulations they keep, live for the whole campaign
+            warmPool = mp.Pool(self.numProcess) if self.simParams.warmReuse else None
             for i in range(numSims//self.numProcess):
                 # If number of sims doesn't factor evenly into the number of processes:
                 if numSims % self.numProcess != 0 and i == len(list(range(numSims//self.numProcess)))-1:
                     offset = numSims % self.numProcess
                 else:
                     offset = 0
+                self.extendDispersionTable(self.numProcess*(i+1)+offset)
                 simGenerator = self.generateSims(list(range(self.numProcess*i, self.numProcess*(i+1)+offset)))
-                pool = mp.Pool(self.numProcess)
+                pool = warmPool if warmPool is not None else mp.Pool(self.numProcess)
                 try:
                     # yields results *as* the workers finish jobs
                     for result in pool.imap_unordered(simulationExecutor, [(x, self.dataOutQueue) for x in simGenerator]):
                         if result[0] is not True:  # workers return True on success
                             failed.append(result[1])  # add failed jobs to the list of failures
                             print("Job", result[1], "failed...")
+                        else:
+                            self.recordCaseMetrics(result[1], result[2])
 
                         jobsFinished += 1
                         progressBar.update(jobsFinished)
-                    pool.close()
+                    if warmPool is None:
+                        pool.close()
                 except KeyboardInterrupt as e:
                     print("Ctrl-C was hit, closing pool")
                     failed.extend(list(range(jobsFinished, numSims)))  # fail all potentially running jobs...
                     pool.terminate()
+                    pool.join()
                     raise e
                 except Exception as e:
                     print("Unknown exception while running simulations:", e)
                     failed.extend(list(range(jobsFinished, numSims)))  # fail all potentially running jobs...
                     traceback.print_exc()
                     pool.terminate()
+                    warmPool = None
                 finally:
                     # Wait until all data is logged from the spawned runs before proceeding with the next set.
-                    pool.join()
+                    if warmPool is None:
+                        pool.join()
+                if self.campaignConverged():
+                    break
+            if warmPool is not None:
+                warmPool.close()
+                warmPool.join()
+
+        if self.simParams.verbose and self.campaignConverged():
+            print("Campaign converged after {0} of {1} runs".format(len(self.caseMetrics), numSims))
 
         progressBar.markComplete()
         progressBar.close()
@@ -697,6 +924,10 @@ class Controller:
         return failed
 
 
+# simulations kept by each worker process for the warm reuse, keyed by creation function
+_warmSimulations = {}
+
+
 class SimulationParameters():
     """
     This class represents the run parameters for a simulation, with information including
@@ -707,12 +938,15 @@ class SimulationParameters():
      - parameters describing the data to be retained for a simulation
      - whether randomized seeds should be applied to the simulation
      - whether data should be archived
+     - the row of the dispersion table holding the values of the table dispersions of this run
+     - the functions evaluating the metrics of the run
+     - the cache of the environment messages replayed in the run
     """
 
     def __init__(self, creationFunction, executionFunction, configureFunction,
                  retentionPolicies, dispersions, shouldDisperseSeeds,
                  shouldArchiveParameters, filename, icfilename, index=None, verbose=False, modifications={},
-                 showProgressBar=False):
+                 showProgressBar=False, tableRow=None):
         self.index = index
         self.creationFunction = creationFunction
         self.executionFunction = executionFunction
@@ -728,6 +962,10 @@ class SimulationParameters():
         self.dispersionMag = {}
         self.saveDispMag = False
         self.showProgressBar = showProgressBar
+        self.tableRow = tableRow
+        self.metricFunctions = {}
+        self.environmentCache = None
+        self.warmReuse = False
 
 
 
@@ -755,8 +993,9 @@ class SimulationExecutor:
                 for the data writer.
         Returns:
             success: bool
-                (True, simParams.index) if simulation run was successful
-                (False, simParams.index) if simulation run was unsuccessful
+                (True, simParams.index, metrics) if simulation run was successful
+                (False, simParams.index, {}) if simulation run was unsuccessful
+                where metrics is a dictionary of the run metrics
         """
         simParams = params[0]
         dataOutQueue = params[1]
@@ -768,8 +1007,15 @@ class SimulationExecutor:
             np.random.seed(simParams.index * 10)
             random.seed(simParams.index * 10)
 
-            # create the users sim by calling their supplied creationFunction
-            simInstance = simParams.creationFunction()
+            # create the users sim by calling their supplied creationFunction, or restore the configuration
+            # of the simulation of the previous run of this worker
+            warmSim = cls.warmSimulation(simParams)
+            if warmSim is not None:
+                simInstance = warmSim[0]
+                if simParams.verbose:
+                    print("Reusing the simulation of the previous run")
+            else:
+                simInstance = simParams.creationFunction()
 
             # build a list of the parameter and random seed modifications to make
             modifications = simParams.modifications
@@ -779,7 +1025,7 @@ class SimulationExecutor:
             if simParams.shouldDisperseSeeds:
                 # generate the random seeds for the model (but don't apply them yet)
                 # Note: This sets the RNGSeeds before all other modifications
-                randomSeedDispersions = cls.disperseSeeds(simInstance)
+                randomSeedDispersions = cls.disperseSeeds(simInstance, simParams.tableRow)
                 for name, value in randomSeedDispersions.items():
                     modifications[name] = value
 
@@ -805,6 +1051,13 @@ class SimulationExecutor:
                             if simParams.saveDispMag:
                                 magnitudes[name] = disp.generateMagString()
 
+            # the table dispersions of this run were generated with all other runs before the run started
+            tableValues = {}
+            if simParams.tableRow is not None:
+                for name, value in simParams.tableRow.items():
+                    if name not in modifications:  # could be using a saved parameter.
+                        tableValues[name] = value
+
             # if archiving, this run's parameters and random seeds are saved in its own json file
             if simParams.shouldArchiveParameters:
                 # save the dispersions and random seeds for this run
@@ -812,27 +1065,43 @@ class SimulationExecutor:
                     with open(simParams.icfilename + ".json", 'w') as outfile:
                         json.dump(modifications, outfile)
                 else:
+                    archivedModifications = dict(modifications)
+                    for name, value in tableValues.items():
+                        archivedModifications[name] = str(value)
                     with open(simParams.filename + ".json", 'w') as outfile:
-                        json.dump(modifications, outfile)
+                        json.dump(archivedModifications, outfile)
                     if simParams.saveDispMag:
                         with open(simParams.filename + "mag.txt", 'w') as outfileMag:
                             for k in sorted(magnitudes.keys()):
                                 outfileMag.write("'%s':'%s', \n" % (k, magnitudes[k]))
 
-            if simParams.configureFunction is not None:
+            if simParams.configureFunction is not None and warmSim is None:
                 if simParams.verbose:
                     print("Configuring sim")
                 simParams.configureFunction(simInstance)
 
+            # the nominal configuration is captured before the dispersions of the first run are applied
+            if getattr(simParams, "warmReuse", False) and warmSim is None:
+                snapshot = ConfigurationSnapshot(simInstance)
+                snapshot.capture()
+                _warmSimulations[simParams.creationFunction] = (simInstance, snapshot)
+
             # apply the dispersions and the random seeds
             for variable, value in list(modifications.items()):
-                disperseStatement = "simInstance." + variable + "=" + value
                 if simParams.verbose:
-                    print("Executing parameter modification -> ", disperseStatement)
-                exec(disperseStatement)
+                    print("Executing parameter modification -> ", variable + "=" + str(value))
+                cls.applyModification(simInstance, variable, value)
+            for variable, value in tableValues.items():
+                compileSetter(variable)(simInstance, value)
+
+            # replace the environment modules by the replay of the nominal environment
+            if simParams.environmentCache is not None and warmSim is None:
+                if simParams.verbose:
+                    print("Replaying the recorded environment")
+                simParams.environmentCache.replay(simInstance)
 
             # setup data logging
-            if len(simParams.retentionPolicies) > 0:
+            if len(simParams.retentionPolicies) > 0 and warmSim is None:
                 if simParams.verbose:
                     print("Adding retained data")
                 RetentionPolicy.addRetentionPoliciesToSim(simInstance, simParams.retentionPolicies)
@@ -840,10 +1109,9 @@ class SimulationExecutor:
             if simParams.verbose:
                 print("Executing simulation")
             # execute the simulation, with the user-supplied executionFunction
-            try:
-                simParams.executionFunction(simInstance)
-            except TypeError:
-                simParams.executionFunction(simInstance, simParams.filename)
+            cls.executionFunction(simParams)(simInstance)
+
+            metrics = cls.evaluateMetrics(simInstance, simParams.metricFunctions)
 
             if len(simParams.retentionPolicies) > 0:
                 if simParams.icfilename != "":
@@ -868,17 +1136,98 @@ class SimulationExecutor:
             if simParams.verbose:
                 print("Thread", os.getpid(), "Job", simParams.index, "finished successfully")
 
-            return (True, simParams.index)  # this function returns true only if the simulation was successful
+            return (True, simParams.index, metrics)  # this function returns true only if the simulation was successful
 
         except Exception as e:
             print("Error in worker thread", e)
             traceback.print_exc()
-            return (False, simParams.index)  # there was an error
+            # a failed run may leave the simulation in any state, so the next run builds a new one
+            _warmSimulations.pop(simParams.creationFunction, None)
+            return (False, simParams.index, {})  # there was an error
+
+    @staticmethod
+    def warmSimulation(simParams):
+        """
+        Returns the simulation built by a previous run of this worker process with its configuration restored,
+        or None if the simulation must be built
+
+        Args:
+            simParams: SimulationParameters
+                The parameters of the run
+        Returns:
+            (simInstance, ConfigurationSnapshot) or None
+        """
+        if not getattr(simParams, "warmReuse", False):
+            return None
+        warmSim = _warmSimulations.get(simParams.creationFunction)
+        if warmSim is not None:
+            warmSim[1].restore()
+        return warmSim
 
     @staticmethod
-    def disperseSeeds(simInstance):
+    def executionFunction(simParams):
+        """
+        Returns the user-supplied execution function as a function of the simulation only.  Execution
+        functions may take the run file name as a second argument.
+        """
+        def execute(simInstance):
+            try:
+                simParams.executionFunction(simInstance)
+            except TypeError:
+                simParams.executionFunction(simInstance, simParams.filename)
+        return execute
+
+    @staticmethod
+    def evaluateMetrics(simInstance, metricFunctions):
+        """
+        Evaluates the metrics of a finished run
+
+        Args:
+            simInstance: SimulationBaseClass
+                The simulation of the run
+            metricFunctions: dict
+                The functions evaluating the user metrics, keyed by metric name
+        Returns:
+            metrics: dict
+                The metric values, including the stop condition metrics if the simulation supports them
+        """
+        metrics = {}
+        if hasattr(simInstance, "getStopCondition"):
+            stopCondition = simInstance.getStopCondition()
+            metrics["failed"] = 1.0 if stopCondition is not None and stopCondition[2] else 0.0
+            metrics["stopTime"] = float(stopCondition[1] if stopCondition is not None
+                                        else simInstance.TotalSim.CurrentNanos)
+        for name, metricFunction in metricFunctions.items():
+            metrics[name] = float(metricFunction(simInstance))
+        return metrics
+
+    @staticmethod
+    def applyModification(simInstance, variable, value):
+        """
+        Applies a saved parameter modification to the simulation.  Literal values are assigned through a
+        compiled setter; other expressions fall back to executing the assignment statement.
+
+        Args:
+            simInstance: SimulationBaseClass
+                A basilisk simulation to modify
+            variable: string
+                The attribute path of the variable relative to the simulation
+            value:
+                The value, or the string representation of the value, to assign
+        """
+        if isinstance(value, str):
+            try:
+                value = ast.literal_eval(value)
+            except (ValueError, SyntaxError, TypeError):
+                exec("simInstance." + variable + "=" + value)
+                return
+        compileSetter(variable)(simInstance, value)
+
+    @staticmethod
+    def disperseSeeds(simInstance, tableRow=None):
         """
         Disperses the RNG seeds of all the tasks in the sim, and returns a statement that contains the seeds.
+        If a row of the dispersion table is given, the seeds are drawn from the case seed of that row.
         Example return dictionary::
 
              {
@@ -890,20 +1239,26 @@ class SimulationExecutor:
 
         :param simInstance: A basilisk simulation to set random seeds on
         :type simInstance: SimulationBaseClass
+        :param tableRow: optional ``TableRow`` of this run
         :return: A dictionary with the random seeds that should be applied to the sim
                         """
 
-        randomSeeds = {}
+        seedModels = []
         for i, task in enumerate(simInstance.TaskList):
             for j, model in enumerate(task.TaskModels):
                 taskVar = 'TaskList[' + str(i) + '].TaskModels' + '[' + str(j) + '].RNGSeed'
-                rand = str(random.randint(0, 1 << 32 - 1))
-                try:
-                    execStatement = "simInstance." + taskVar + "=" + str(rand)
-                    exec(execStatement)  # if this fails don't add to the list of modification
-                    randomSeeds[taskVar] = rand
-                except:
-                    pass
+                seedModels.append((taskVar, model))
+
+        if tableRow is not None:
+            seeds = tableRow.seeds(len(seedModels))
+        else:
+            seeds = [random.randint(0, 1 << 32 - 1) for _ in seedModels]
+
+        randomSeeds = {}
+        for (taskVar, model), rand in zip(seedModels, seeds):
+            if hasattr(model, "RNGSeed"):  # models without a RNG are not added to the list of modification
+                model.RNGSeed = rand
+                randomSeeds[taskVar] = str(rand)
         return randomSeeds
 
     @staticmethod
@@ -919,6 +1274,5 @@ class SimulationExecutor:
         """
         for variable, value in modifications.items():
             if ".RNGSeed" in variable:
-                rngStatement = "simInstance." + variable + "=" + value
-                exec(rngStatement)
+                compileSetter(variable)(simInstance, int(value))
 
@@ -0,0 +1,440 @@
+ # ISC License
+ #
+ # Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+ #
+ # Permission to use, copy, modify, and/or distribute this software for any
+ # purpose with or without fee is hereby granted, provided that the above
+ # copyright notice and this permission notice appear in all copies.
+ #
+ # THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ # WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ # MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ # ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ # WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ # ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ # OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+#
+# Vectorized MonteCarlo dispersions.
+#
+# Purpose:  Generates the dispersed parameters of all the runs of a MonteCarlo campaign at once and stores
+#           them in a compact table.  Each run applies its row of the table to the simulation through
+#           attribute setters that are compiled once per variable name, instead of executing strings.
+#
+
+import abc
+import ast
+import functools
+import sys
+
+import numpy as np
+
+
+def latinHypercube(numSamples, numDims, rng):
+    """
+    Latin hypercube samples on the unit hypercube.  Each column places exactly one sample in each of the
+    ``numSamples`` equally sized strata of [0, 1).
+
+    :param numSamples: number of samples (rows)
+    :param numDims: number of dimensions (columns)
+    :param rng: ``numpy.random.Generator``
+    :return: (numSamples, numDims) array of samples in (0, 1)
+    """
+    strata = np.argsort(rng.random((numSamples, numDims)), axis=0)
+    return (strata + rng.random((numSamples, numDims))) / numSamples
+
+
+# Initial direction numbers m_1 ... m_s of the Sobol sequence for dimensions 2 to 21 (Joe and Kuo, 2008)
+_sobolInitialNumbers = [
+    [1], [1, 3], [1, 3, 1], [1, 1, 1], [1, 1, 3, 3], [1, 3, 5, 13], [1, 1, 5, 5, 17], [1, 1, 5, 5, 5],
+    [1, 1, 7, 11, 19], [1, 1, 5, 1, 1], [1, 1, 1, 3, 11], [1, 3, 5, 5, 31], [1, 3, 3, 9, 7, 49],
+    [1, 1, 1, 15, 21, 21], [1, 3, 1, 13, 27, 49], [1, 1, 1, 15, 7, 5], [1, 3, 1, 15, 13, 25],
+    [1, 1, 5, 5, 19, 61], [1, 3, 7, 11, 23, 15, 103], [1, 3, 7, 13, 13, 15, 69]
+]
+
+_sobolBits = 32
+
+
+def _isPrimitive(poly, degree):
+    """Checks if the GF(2) polynomial whose coefficient bits are ``poly`` is primitive"""
+    period = (1 << degree) - 1
+    value = 1
+    for k in range(1, period + 1):
+        value <<= 1
+        if value >> degree:
+            value ^= poly
+        if value == 1:
+            return k == period
+    return False
+
+
+def _primitivePolynomials(count):
+    """
+    Returns the first ``count`` primitive polynomials as ``(degree, a)`` pairs sorted
+    by degree and then by the interior coefficients ``a``, which is the ordering of the Joe and Kuo tables.
+    """
+    polys = []
+    degree = 1
+    while len(polys) < count:
+        for a in range(1 << (degree - 1)):
+            if _isPrimitive((1 << degree) | (a << 1) | 1, degree):
+                polys.append((degree, a))
+                if len(polys) == count:
+                    break
+        degree += 1
+    return polys
+
+
+@functools.lru_cache(maxsize=None)
+def _sobolDirections(numDims):
+    """Direction numbers V[dim, bit] of the first ``numDims`` Sobol dimensions, scaled to ``_sobolBits`` bits"""
+    directions = np.zeros((numDims, _sobolBits), dtype=np.uint64)
+    directions[0] = [1 << (_sobolBits - 1 - k) for k in range(_sobolBits)]
+    polys = _primitivePolynomials(numDims - 1)
+    for dim in range(1, numDims):
+        degree, a = polys[dim - 1]
+        if dim - 1 < len(_sobolInitialNumbers):
+            m = list(_sobolInitialNumbers[dim - 1])
+        else:
+            # beyond the tabulated dimensions use reproducible odd initial numbers with m_k < 2^k
+            initRng = np.random.default_rng(dim)
+            m = [2 * int(initRng.integers(0, 1 << k)) + 1 for k in range(degree)]
+        for k in range(degree, _sobolBits):
+            newM = m[k - degree] ^ (m[k - degree] << degree)
+            for i in range(1, degree):
+                if (a >> (degree - 1 - i)) & 1:
+                    newM ^= m[k - i] << i
+            m.append(newM)
+        directions[dim] = [m[k] << (_sobolBits - 1 - k) for k in range(_sobolBits)]
+    return directions
+
+
+def sobol(numSamples, numDims, rng=None):
+    """
+    Sobol low discrepancy samples on the unit hypercube.  The first ``2^m`` samples of each dimension
+    place exactly one sample in each interval of size ``2^-m``.  If ``rng`` is given the sequence is
+    randomized with a digital shift, which preserves this property.
+
+    :param numSamples: number of samples (rows)
+    :param numDims: number of dimensions (columns)
+    :param rng: optional ``numpy.random.Generator`` used to scramble the sequence
+    :return: (numSamples, numDims) array of samples in (0, 1)
+    """
+    if numSamples >= 1 << _sobolBits:
+        raise ValueError("The Sobol sequence supports at most 2^%d samples" % _sobolBits)
+    directions = _sobolDirections(numDims)
+    index = np.arange(numSamples, dtype=np.uint64)
+    points = np.zeros((numSamples, numDims), dtype=np.uint64)
+    for bit in range(max(int(numSamples - 1).bit_length(), 1)):
+        mask = ((index >> np.uint64(bit)) & np.uint64(1)).astype(bool)
+        points[mask] ^= directions[:, bit]
+    if rng is not None:
+        points ^= rng.integers(0, 1 << _sobolBits, size=numDims, dtype=np.uint64)
+    return (points.astype(np.float64) + 0.5) / float(1 << _sobolBits)
+
+
+def normalQuantile(p):
+    """
+    Inverse of the standard normal cumulative distribution function, evaluated element-wise with the
+    rational approximation of P. J. Acklam (relative error below 1.2e-9).
+
+    :param p: array of probabilities in (0, 1)
+    :return: array of standard normal quantiles
+    """
+    a = [-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+         1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00]
+    b = [-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+         6.680131188771972e+01, -1.328068155288572e+01]
+    c = [-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+         -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00]
+    d = [7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00, 3.754408661907416e+00]
+    pLow = 0.02425
+
+    p = np.asarray(p, dtype=np.float64)
+    x = np.empty_like(p)
+
+    tail = np.minimum(p, 1.0 - p)
+    central = tail >= pLow
+    q = p[central] - 0.5
+    r = q * q
+    x[central] = (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5]) * q / \
+                 (((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1.0)
+
+    outer = ~central
+    q = np.sqrt(-2.0 * np.log(tail[outer]))
+    xTail = (((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5]) / \
+            ((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1.0)
+    x[outer] = np.where(p[outer] < 0.5, xTail, -xTail)
+    return x
+
+
+class TableDispersion(abc.ABC):
+    """
+    Base class of the dispersions that are generated for all the runs at once.  A table dispersion maps
+    ``numColumns`` columns of unit hypercube samples onto the values of the dispersed variable.
+    """
+
+    def __init__(self, varName, shape=()):
+        """
+        Args:
+            varName (str): A string representation of the variable to be dispersed, e.g. 'scObject.hub.mHub'.
+            shape (tuple): shape of the dispersed value, () for a scalar.
+        """
+        self.varName = varName
+        self.shape = tuple(shape)
+        self.numColumns = int(np.prod(self.shape, dtype=int))
+
+    def getName(self):
+        return self.varName
+
+    @abc.abstractmethod
+    def sample(self, unitSamples):
+        """
+        Maps unit hypercube samples onto dispersed values.
+
+        :param unitSamples: (numRuns, numColumns) array of samples in (0, 1)
+        :return: (numRuns, numColumns) array of dispersed values
+        """
+        pass
+
+
+class UniformTableDispersion(TableDispersion):
+    def __init__(self, varName, bounds=None, shape=()):
+        """
+        Args:
+            varName (str): A string representation of the variable to be dispersed.
+            bounds (Array[float, float]): lower and upper bounds of the uniform distribution.
+            shape (tuple): shape of the dispersed value, () for a scalar.
+        """
+        super(UniformTableDispersion, self).__init__(varName, shape)
+        self.bounds = bounds if bounds is not None else [-1.0, 1.0]
+
+    def sample(self, unitSamples):
+        return self.bounds[0] + (self.bounds[1] - self.bounds[0]) * unitSamples
+
+
+class NormalTableDispersion(TableDispersion):
+    def __init__(self, varName, mean=0.0, stdDeviation=0.5, bounds=None, shape=()):
+        """
+        Args:
+            varName (str): A string representation of the variable to be dispersed.
+            mean (float or array): mean of the normal distribution, broadcast against ``shape``.
+            stdDeviation (float or array): standard deviation, broadcast against ``shape``.
+            bounds (Array[float, float]): optional lower and upper cut offs of the generated values.
+            shape (tuple): shape of the dispersed value, () for a scalar.
+        """
+        super(NormalTableDispersion, self).__init__(varName, shape)
+        self.mean = mean
+        self.stdDeviation = stdDeviation
+        self.bounds = bounds
+
+    def sample(self, unitSamples):
+        mean = np.broadcast_to(self.mean, self.shape).reshape(-1)
+        std = np.broadcast_to(self.stdDeviation, self.shape).reshape(-1)
+        values = mean + std * normalQuantile(unitSamples)
+        if self.bounds is not None:
+            values = np.clip(values, self.bounds[0], self.bounds[1])
+        return values
+
+
+class UniformEulerAngleMRPTableDispersion(TableDispersion):
+    def __init__(self, varName, bounds=None):
+        """
+        Table analog of ``UniformEulerAngleMRPDispersion``: uniform (3-2-3) Euler angles mapped onto MRPs.
+
+        Args:
+            varName (str): A string representation of the variable to be dispersed
+                e.g. 'scObject.hub.sigma_BNInit'.
+            bounds (Array[float, float]): lower and upper bounds of the Euler angles in radians.
+        """
+        super(UniformEulerAngleMRPTableDispersion, self).__init__(varName, (3,))
+        self.bounds = bounds if bounds is not None else [0, 2 * np.pi]
+
+    def sample(self, unitSamples):
+        halfAngles = 0.5 * (self.bounds[0] + (self.bounds[1] - self.bounds[0]) * unitSamples)
+        e1, e2, e3 = halfAngles[:, 0], halfAngles[:, 1], halfAngles[:, 2]
+        q0 = np.cos(e2) * np.cos(e1 + e3)
+        q = np.column_stack([np.sin(e2) * np.sin(-e1 + e3),
+                             np.sin(e2) * np.cos(-e1 + e3),
+                             np.cos(e2) * np.sin(e1 + e3)])
+        # pick the short rotation, as EP2MRP does
+        sign = np.where(q0 < 0, -1.0, 1.0)
+        return sign[:, None] * q / (1.0 + np.abs(q0))[:, None]
+
+
+@functools.lru_cache(maxsize=None)
+def compileSetter(varName):
+    """
+    Compiles an attribute path such as ``'TaskList[0].TaskModels[1].RNGSeed'`` into a function
+    ``setter(root, value)`` that assigns ``value`` through the same chain of attribute and item accesses.
+    The path is parsed once per variable name, so applying the dispersions of a run does not go through
+    ``exec``.
+
+    :param varName: attribute path relative to the simulation object
+    :return: setter function
+    """
+    try:
+        node = ast.parse(varName.strip(), mode='eval').body
+    except SyntaxError:
+        raise ValueError("Cannot compile a setter for '" + varName + "'")
+    steps = []
+    while not isinstance(node, ast.Name):
+        if isinstance(node, ast.Attribute):
+            steps.append((True, node.attr))
+            node = node.value
+        elif isinstance(node, ast.Subscript):
+            # python versions before 3.9 wrap the subscript expression in an index node
+            index = node.slice if sys.version_info >= (3, 9) else node.slice.value
+            steps.append((False, ast.literal_eval(index)))
+            node = node.value
+        else:
+            raise ValueError("Cannot compile a setter for '" + varName + "'")
+    steps.append((True, node.id))
+    steps.reverse()
+
+    path, (lastIsAttr, lastKey) = steps[:-1], steps[-1]
+
+    def setter(root, value):
+        obj = root
+        for isAttr, key in path:
+            obj = getattr(obj, key) if isAttr else obj[key]
+        if lastIsAttr:
+            setattr(obj, lastKey, value)
+        else:
+            obj[lastKey] = value
+
+    return setter
+
+
+class DispersionTable(object):
+    """
+    Compact table holding the dispersed values of every run of a MonteCarlo campaign.  Row ``i`` holds the
+    flattened values of all table dispersions for run ``i``, and ``caseSeeds[i]`` holds the seed from which
+    the RNG seeds of the simulation modules of run ``i`` are drawn.  The unit hypercube samples the values
+    were mapped from are kept with the importance weight of each run, which is 1 unless the run was
+    proposed by an adaptive sampler.
+    """
+
+    samplingMethods = ("random", "lhs", "sobol")
+
+    def __init__(self, names, shapes, values, caseSeeds, unitSamples=None, weights=None):
+        self.names = list(names)
+        self.shapes = [tuple(shape) for shape in shapes]
+        self.values = np.ascontiguousarray(values, dtype=np.float64)
+        self.caseSeeds = np.ascontiguousarray(caseSeeds, dtype=np.uint32)
+        self.unitSamples = None if unitSamples is None else np.ascontiguousarray(unitSamples, dtype=np.float64)
+        self.weights = np.ones(len(self.values)) if weights is None else np.asarray(weights, dtype=np.float64)
+        self.offsets = np.concatenate(([0], np.cumsum([int(np.prod(s, dtype=int)) for s in self.shapes])))
+
+    @classmethod
+    def generate(cls, dispersions, numRuns, method="lhs", seed=None):
+        """
+        Generates the values of all the runs at once.
+
+        :param dispersions: list of ``TableDispersion``
+        :param numRuns: number of runs of the campaign
+        :param method: ``'random'``, ``'lhs'`` (Latin hypercube) or ``'sobol'``
+        :param seed: seed of the campaign, None for a random campaign
+        :return: DispersionTable
+        """
+        if method not in cls.samplingMethods:
+            raise ValueError("Unknown sampling method '" + str(method) + "', use one of " + str(cls.samplingMethods))
+        rng = np.random.default_rng(seed)
+        numColumns = sum(disp.numColumns for disp in dispersions)
+        if method == "lhs":
+            unitSamples = latinHypercube(numRuns, numColumns, rng)
+        elif method == "sobol":
+            unitSamples = sobol(numRuns, numColumns, rng)
+        else:
+            unitSamples = rng.random((numRuns, numColumns))
+        return cls.fromUnitSamples(dispersions, unitSamples, rng.integers(0, 1 << 32, size=numRuns, dtype=np.uint32))
+
+    @classmethod
+    def fromUnitSamples(cls, dispersions, unitSamples, caseSeeds, weights=None):
+        """
+        Maps unit hypercube samples onto the values of the dispersions.
+
+        :param dispersions: list of ``TableDispersion``
+        :param unitSamples: (numRuns, numColumns) array of samples in (0, 1)
+        :param caseSeeds: (numRuns,) array of case seeds
+        :param weights: optional (numRuns,) array of importance weights
+        :return: DispersionTable
+        """
+        values = np.empty(unitSamples.shape)
+        col = 0
+        for disp in dispersions:
+            values[:, col:col + disp.numColumns] = disp.sample(unitSamples[:, col:col + disp.numColumns])
+            col += disp.numColumns
+        return cls([disp.getName() for disp in dispersions], [disp.shape for disp in dispersions],
+                   values, caseSeeds, unitSamples, weights)
+
+    def append(self, other):
+        """Appends the runs of another table generated from the same dispersions"""
+        if other.names != self.names:
+            raise ValueError("Only tables of the same dispersions can be appended")
+        self.values = np.concatenate((self.values, other.values))
+        self.caseSeeds = np.concatenate((self.caseSeeds, other.caseSeeds))
+        if self.unitSamples is not None and other.unitSamples is not None:
+            self.unitSamples = np.concatenate((self.unitSamples, other.unitSamples))
+        else:
+            self.unitSamples = None
+        self.weights = np.concatenate((self.weights, other.weights))
+
+    def __len__(self):
+        return self.values.shape[0]
+
+    def column(self, name):
+        """Returns the values of the variable ``name`` for all runs, with shape (numRuns,) + shape"""
+        i = self.names.index(name)
+        return self.values[:, self.offsets[i]:self.offsets[i + 1]].reshape((len(self),) + self.shapes[i])
+
+    def row(self, index):
+        """Returns the row of run ``index`` as a ``TableRow``"""
+        return TableRow(self.names, self.shapes, self.values[index].copy(), int(self.caseSeeds[index]))
+
+    def save(self, fileName):
+        """Saves the table into a ``.npz`` file"""
+        data = dict(names=np.array(self.names), shapes=np.array(self.shapes, dtype=object),
+                    values=self.values, caseSeeds=self.caseSeeds, weights=self.weights)
+        if self.unitSamples is not None:
+            data["unitSamples"] = self.unitSamples
+        np.savez_compressed(fileName, **data)
+
+    @classmethod
+    def load(cls, fileName):
+        """Loads a table saved with ``save()``"""
+        with np.load(fileName, allow_pickle=True) as data:
+            unitSamples = data["unitSamples"] if "unitSamples" in data else None
+            return cls(data["names"].tolist(), data["shapes"].tolist(), data["values"], data["caseSeeds"],
+                       unitSamples, data["weights"])
+
+
+class TableRow(object):
+    """The dispersed values of a single run, as sent to the worker executing the run"""
+
+    def __init__(self, names, shapes, values, caseSeed):
+        self.names = names
+        self.shapes = shapes
+        self.values = values
+        self.caseSeed = caseSeed
+
+    def items(self):
+        """Yields ``(name, value)`` pairs, with scalar values as floats and array values as nested lists"""
+        offset = 0
+        for name, shape in zip(self.names, self.shapes):
+            size = int(np.prod(shape, dtype=int))
+            if shape == ():
+                yield name, float(self.values[offset])
+            else:
+                yield name, self.values[offset:offset + size].reshape(shape).tolist()
+            offset += size
+
+    def apply(self, simInstance):
+        """Applies the values of this run to the simulation through compiled setters"""
+        for name, value in self.items():
+            compileSetter(name)(simInstance, value)
+
+    def seeds(self, count):
+        """Draws ``count`` module RNG seeds for this run from its case seed"""
+        return np.random.default_rng(self.caseSeed).integers(0, 1 << 31, size=count).tolist()
@@ -0,0 +1,170 @@
+ # ISC License
+ #
+ # Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+ #
+ # Permission to use, copy, modify, and/or distribute this software for any
+ # purpose with or without fee is hereby granted, provided that the above
+ # copyright notice and this permission notice appear in all copies.
+ #
+ # THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ # WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ # MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ # ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ # WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ # ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ # OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+
+#
+# Environment cache of MonteCarlo campaigns.
+#
+# Purpose:  Records the output messages of the environment modules in a nominal run, and replays them in
+#           the runs of a campaign in place of the environment modules.
+#
+
+import numpy as np
+from Basilisk.simulation import environmentReplay
+
+
+class EnvironmentCache(object):
+    """
+    Time-indexed tables of the output messages of environment modules, such as :ref:`spiceInterface`,
+    atmosphere, magnetic field or :ref:`eclipse` modules.  ``record()`` runs a nominal simulation and stores
+    every write of the module output messages.  ``replay()`` swaps the modules of another simulation for
+    :ref:`environmentReplay` modules writing the stored payloads into the same messages, so the modules
+    subscribed to them are unchanged and the environment modules are never executed.
+
+    The replay is exact for outputs that only depend on time, such as ephemerides.  Outputs evaluated at the
+    spacecraft position, such as the atmosphere density or the eclipse factor, are those of the nominal
+    trajectory, which is a good approximation when only flight software parameters are dispersed.
+    """
+
+    def __init__(self, environmentFunction):
+        """
+        Args:
+            environmentFunction: (sim: SimulationBaseClass) => list
+                Returns the environment modules of a simulation, in the same order for every simulation
+                built by the creation function.  The modules must be C++ modules added with
+                ``AddModelToTask()``.
+        """
+        self.environmentFunction = environmentFunction
+        self.tables = {}
+
+    @staticmethod
+    def outputMessages(module):
+        """
+        Returns the output messages of a module, found through the ``OutMsg`` and ``OutMsgs`` naming
+        convention of the module variables
+
+        :param module: Basilisk module
+        :return: list of (name, message) tuples
+        """
+        messages = []
+        for name in sorted(dir(module)):
+            if name.startswith("_"):
+                continue
+            if name.endswith("OutMsg"):
+                messages.append((name, getattr(module, name)))
+            elif name.endswith("OutMsgs"):
+                for i, msg in enumerate(getattr(module, name)):
+                    messages.append((name + "[" + str(i) + "]", msg))
+        return messages
+
+    @staticmethod
+    def findTask(simInstance, module):
+        """Returns the python task holding a module"""
+        for task in simInstance.TaskList:
+            if any(model is module for model in task.TaskModels):
+                return task
+        raise ValueError("The environment module " + str(getattr(module, "ModelTag", module)) +
+                         " was not added to a task with AddModelToTask()")
+
+    def channels(self, simInstance):
+        """Returns the (key, module, message) tuples of the output messages of the environment modules"""
+        channels = []
+        for i, module in enumerate(self.environmentFunction(simInstance)):
+            for name, msg in self.outputMessages(module):
+                channels.append((str(i) + "." + name, module, msg))
+        return channels
+
+    def record(self, simInstance, executionFunction):
+        """
+        Runs a nominal simulation and records the output messages of its environment modules
+
+        :param simInstance: SimulationBaseClass, not initialized yet
+        :param executionFunction: (sim: SimulationBaseClass) => None, initializes and executes the simulation
+        """
+        recorders = {}
+        channels = []
+        for key, module, msg in self.channels(simInstance):
+            if id(module) not in recorders:
+                recorder = environmentReplay.EnvironmentReplay()
+                recorder.ModelTag = str(module.ModelTag) + "Recorder"
+                simInstance.AddModelToTask(self.findTask(simInstance, module).Name, recorder)
+                recorders[id(module)] = recorder
+            recorder = recorders[id(module)]
+            payloadAddress, headerAddress, dtype = msg.payloadPointers()
+            channels.append((key, recorder, recorder.addRecordChannel(payloadAddress, headerAddress, dtype.itemsize),
+                             dtype.itemsize))
+
+        executionFunction(simInstance)
+
+        self.tables = {}
+        for key, recorder, channel, payloadSize in channels:
+            count = recorder.getRecordCount(channel)
+            times = np.empty(count, dtype=np.uint64)
+            payloads = np.empty((count, payloadSize), dtype=np.uint8)
+            recorder.exportChannel(channel, times.ctypes.data, payloads.ctypes.data)
+            self.tables[key] = (times, payloads)
+
+    def replay(self, simInstance):
+        """
+        Replaces the environment modules of a simulation by modules replaying the recorded messages.  This
+        must be called before the simulation is initialized.
+
+        :param simInstance: SimulationBaseClass
+        :return: list of the environmentReplay modules, which are also kept in ``simInstance.environmentReplays``
+        """
+        replays = {}
+        for key, module, msg in self.channels(simInstance):
+            if key not in self.tables:
+                raise ValueError("The environment message " + key + " was not recorded")
+            if id(module) not in replays:
+                replay = environmentReplay.EnvironmentReplay()
+                replay.ModelTag = str(module.ModelTag) + "Replay"
+                if not self.findTask(simInstance, module).TaskData.replaceObject(module, replay):
+                    raise ValueError("The environment module " + str(module.ModelTag) + " is not a C++ module")
+                replays[id(module)] = replay
+            replay = replays[id(module)]
+            times, payloads = self.tables[key]
+            payloadAddress, headerAddress, dtype = msg.payloadPointers()
+            if dtype.itemsize != payloads.shape[1]:
+                raise ValueError("The payload size of the environment message " + key + " changed")
+            channel = replay.addReplayChannel(payloadAddress, headerAddress, dtype.itemsize)
+            times = np.ascontiguousarray(times)
+            payloads = np.ascontiguousarray(payloads)
+            replay.importChannel(channel, times.ctypes.data, payloads.ctypes.data, len(times))
+
+        # the replaced modules stay referenced by the python tasks, which keeps their messages alive
+        simInstance.environmentReplays = list(replays.values())
+        return simInstance.environmentReplays
+
+    def save(self, fileName):
+        """Saves the recorded tables into a ``.npz`` file"""
+        data = {}
+        for i, (key, (times, payloads)) in enumerate(sorted(self.tables.items())):
+            data["key" + str(i)] = np.array(key)
+            data["times" + str(i)] = times
+            data["payloads" + str(i)] = payloads
+        np.savez(fileName, **data)
+
+    def load(self, fileName):
+        """Loads the tables saved with ``save()``"""
+        self.tables = {}
+        with np.load(fileName) as data:
+            i = 0
+            while "key" + str(i) in data:
+                self.tables[str(data["key" + str(i)])] = (data["times" + str(i)], data["payloads" + str(i)])
+                i += 1
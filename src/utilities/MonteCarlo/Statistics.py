@@ -0,0 +1,123 @@
+ # ISC License
+ #
+ # Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+ #
+ # Permission to use, copy, modify, and/or distribute this software for any
+ # purpose with or without fee is hereby granted, provided that the above
+ # copyright notice and this permission notice appear in all copies.
+ #
+ # THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ # WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ # MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ # ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ # WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ # ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ # OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
+
+
+#
+# Streaming statistics of MonteCarlo campaigns.
+#
+# Purpose:  Accumulates the metrics of the runs as they finish, with confidence intervals, so a campaign
+#           can stop once the metrics of interest have converged.
+#
+
+import numpy as np
+from Basilisk.utilities.MonteCarlo.DispersionTable import normalQuantile
+
+
+class StreamingStatistic(object):
+    """
+    Weighted running mean and confidence interval of a run metric.  The weights are the importance weights
+    of the runs, which are 1 for runs sampled from the nominal distributions.  Metrics that only take the
+    values 0 and 1, such as failure indicators, use the Wilson score interval.
+    """
+
+    def __init__(self, name):
+        self.name = name
+        self.count = 0
+        self.sumWeights = 0.0
+        self.sumWeights2 = 0.0
+        self.sumWeights2Values = 0.0
+        self.sumWeights2Values2 = 0.0
+        self.mean = 0.0
+        self.binary = True
+
+    def add(self, value, weight=1.0):
+        """Adds the metric value of a run with its importance weight"""
+        value = float(value)
+        self.count += 1
+        self.sumWeights += weight
+        self.sumWeights2 += weight * weight
+        self.sumWeights2Values += weight * weight * value
+        self.sumWeights2Values2 += weight * weight * value * value
+        self.mean += weight / self.sumWeights * (value - self.mean)
+        self.binary = self.binary and value in (0.0, 1.0)
+
+    def effectiveCount(self):
+        """Returns the effective number of runs given the spread of the importance weights"""
+        if self.sumWeights2 == 0.0:
+            return 0.0
+        return self.sumWeights * self.sumWeights / self.sumWeights2
+
+    def standardError(self):
+        """Returns the standard error of the self-normalized weighted mean"""
+        if self.count < 2:
+            return np.inf
+        spread = self.sumWeights2Values2 - 2.0 * self.mean * self.sumWeights2Values \
+            + self.mean * self.mean * self.sumWeights2
+        return np.sqrt(max(spread, 0.0)) / self.sumWeights
+
+    def confidenceInterval(self, confidence=0.95):
+        """
+        Returns the confidence interval of the mean
+
+        :param confidence: confidence level of the interval
+        :return: (lower bound, upper bound)
+        """
+        if self.count == 0:
+            return -np.inf, np.inf
+        z = float(normalQuantile(0.5 + 0.5 * confidence))
+        if self.binary:
+            n = self.effectiveCount()
+            p = min(max(self.mean, 0.0), 1.0)
+            center = (p + z * z / (2.0 * n)) / (1.0 + z * z / n)
+            halfWidth = z * np.sqrt(p * (1.0 - p) / n + z * z / (4.0 * n * n)) / (1.0 + z * z / n)
+            return center - halfWidth, center + halfWidth
+        halfWidth = z * self.standardError()
+        return self.mean - halfWidth, self.mean + halfWidth
+
+    def halfWidth(self, confidence=0.95):
+        """Returns the half width of the confidence interval of the mean"""
+        lower, upper = self.confidenceInterval(confidence)
+        return 0.5 * (upper - lower)
+
+
+class ConvergenceCriterion(object):
+    """
+    Stops a campaign once the confidence interval of the mean of a run metric is narrow enough.
+    """
+
+    def __init__(self, metricName, tolerance, confidence=0.95, relative=False, minRuns=30):
+        """
+        Args:
+            metricName (str): name of the run metric, see ``Controller.addMetric()``.  The metric "failed"
+                is the failure indicator of the native stop conditions of the runs.
+            tolerance (float): largest accepted half width of the confidence interval
+            confidence (float): confidence level of the interval
+            relative (bool): if True the tolerance is relative to the magnitude of the mean
+            minRuns (int): smallest number of runs before the criterion can be met
+        """
+        self.metricName = metricName
+        self.tolerance = tolerance
+        self.confidence = confidence
+        self.relative = relative
+        self.minRuns = minRuns
+
+    def isConverged(self, statistic):
+        """Returns True if the statistic of the metric meets the criterion"""
+        if statistic is None or statistic.count < self.minRuns:
+            return False
+        tolerance = self.tolerance * abs(statistic.mean) if self.relative else self.tolerance
+        return statistic.halfWidth(self.confidence) <= tolerance
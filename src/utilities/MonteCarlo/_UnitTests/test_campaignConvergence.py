@@ -0,0 +1,157 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import numpy as np
+import pytest
+from Basilisk.utilities.MonteCarlo import DispersionTable as dt
+from Basilisk.utilities.MonteCarlo.AdaptiveSampling import BoundarySampler
+from Basilisk.utilities.MonteCarlo.Controller import Controller, SimulationExecutor, SimulationParameters
+from Basilisk.utilities.MonteCarlo.Statistics import ConvergenceCriterion, StreamingStatistic
+
+
+class TotalSim:
+    def __init__(self):
+        self.CurrentNanos = 0
+
+
+class StoppingSim:
+    """python stand-in for a simulation that ends on a native stop condition"""
+    def __init__(self):
+        self.TotalSim = TotalSim()
+        self.TaskList = []
+        self.gain = 0.0
+        self.stopCondition = None
+
+    def getStopCondition(self):
+        return self.stopCondition
+
+
+def executeStoppingSim(sim):
+    # the run fails once the gain is above 0.7, at a time proportional to the gain
+    sim.TotalSim.CurrentNanos = 10 ** 9
+    if sim.gain > 0.7:
+        sim.stopCondition = ("gainTooLarge", int(sim.gain * 10 ** 9), True)
+
+
+def gainMetric(sim):
+    return 2.0 * sim.gain
+
+
+def test_streamingStatistic():
+    """Weighted streaming mean and intervals match the batch estimates"""
+    rng = np.random.default_rng(1)
+    values = rng.normal(3.0, 2.0, 2000)
+    weights = rng.uniform(0.5, 2.0, 2000)
+    stat = StreamingStatistic("x")
+    for value, weight in zip(values, weights):
+        stat.add(value, weight)
+    mean = np.sum(weights * values) / np.sum(weights)
+    assert stat.mean == pytest.approx(mean)
+    assert stat.effectiveCount() == pytest.approx(np.sum(weights) ** 2 / np.sum(weights ** 2))
+    stdErr = np.sqrt(np.sum(weights ** 2 * (values - mean) ** 2)) / np.sum(weights)
+    assert stat.standardError() == pytest.approx(stdErr)
+    lower, upper = stat.confidenceInterval(0.95)
+    assert upper - mean == pytest.approx(1.959964 * stdErr, rel=1e-5)
+    assert lower < 3.0 < upper
+
+    failures = StreamingStatistic("failed")
+    for value in [0.0] * 95 + [1.0] * 5:
+        failures.add(value)
+    assert failures.binary
+    lower, upper = failures.confidenceInterval(0.95)
+    assert 0.0 < lower < 0.05 < upper < 0.15
+
+
+def test_convergenceCriterion():
+    """A criterion is met once enough runs narrowed the interval below the tolerance"""
+    criterion = ConvergenceCriterion("x", tolerance=0.1, minRuns=10)
+    assert not criterion.isConverged(None)
+    stat = StreamingStatistic("x")
+    for value in [1.0, 1.05] * 4:
+        stat.add(value)
+    assert not criterion.isConverged(stat)  # too few runs
+    for value in [1.0, 1.05] * 4:
+        stat.add(value)
+    assert criterion.isConverged(stat)
+    assert not ConvergenceCriterion("x", tolerance=1e-3, relative=True, minRuns=10).isConverged(stat)
+
+
+def test_boundarySampler():
+    """The boundary proposal concentrates runs near the failure boundary and its weights are unbiased"""
+    rng = np.random.default_rng(2)
+    sampler = BoundarySampler(boundaryFraction=0.6, scale=0.05)
+    explored = rng.random((200, 2))
+    failed = explored[:, 0] > 0.8
+    centers = sampler.boundaryCenters(explored, failed)
+    assert len(centers) == np.count_nonzero(failed)
+    assert np.all(np.abs(centers[:, 0] - 0.8) < 0.1)
+
+    samples, weights = sampler.propose(20000, explored, failed, rng)
+    assert np.all((samples > 0.0) & (samples < 1.0))
+    assert np.all(weights <= 1.0 / (1.0 - sampler.boundaryFraction) + 1e-12)
+    nearBoundary = np.abs(samples[:, 0] - 0.8) < 0.05
+    assert np.mean(nearBoundary) > 0.3  # the nominal density puts 10 % of the runs there
+    # importance weights recover the nominal expectations
+    assert np.mean(weights) == pytest.approx(1.0, abs=0.03)
+    assert np.mean(weights * (samples[:, 0] > 0.8)) == pytest.approx(0.2, abs=0.02)
+
+
+def test_executorMetrics():
+    """The executor evaluates the user metrics and reports the stop condition of the run"""
+    for gain, failed, stopTime in [(0.5, 0.0, 1e9), (0.9, 1.0, 0.9e9)]:
+        simParams = SimulationParameters(creationFunction=StoppingSim, executionFunction=executeStoppingSim,
+                                         configureFunction=None, retentionPolicies=[], dispersions=[],
+                                         shouldDisperseSeeds=False, shouldArchiveParameters=False, filename="",
+                                         icfilename="", index=3, modifications={"gain": str(gain)})
+        simParams.metricFunctions["gain2"] = gainMetric
+        success, index, metrics = SimulationExecutor()([simParams, None])
+        assert success and index == 3
+        assert metrics == {"failed": failed, "stopTime": pytest.approx(stopTime), "gain2": 2.0 * gain}
+
+
+def test_campaignStatistics():
+    """The controller weights the run metrics, stops once converged and extends the table adaptively"""
+    mc = Controller()
+    mc.addDispersion(dt.UniformTableDispersion("gain", [0.0, 1.0]))
+    mc.setAdaptiveSampler(BoundarySampler(explorationRuns=40))
+    mc.addConvergenceCriterion(ConvergenceCriterion("failed", tolerance=0.5, minRuns=40))
+    mc.dispersionTable = dt.DispersionTable.generate(mc.tableDispersions, 40, "lhs", seed=3)
+    mc.samplingRng = np.random.default_rng(3)
+
+    for index in range(40):
+        gain = mc.dispersionTable.column("gain")[index]
+        mc.recordCaseMetrics(index, {"failed": float(gain > 0.7)})
+    assert mc.getCampaignStatistics()["failed"].mean == pytest.approx(0.3)
+    assert mc.campaignConverged()
+
+    mc.extendDispersionTable(240)
+    assert len(mc.dispersionTable) == 240
+    newGains = mc.dispersionTable.column("gain")[40:]
+    newWeights = mc.dispersionTable.weights[40:]
+    assert np.all(mc.dispersionTable.weights[:40] == 1.0)
+    assert np.any(newWeights != 1.0)
+    assert np.mean(np.abs(newGains - 0.7) < 0.05) > 0.2
+    assert mc.dispersionTable.row(239).caseSeed == mc.dispersionTable.caseSeeds[239]
+
+
+if __name__ == "__main__":
+    test_streamingStatistic()
+    test_convergenceCriterion()
+    test_boundarySampler()
+    test_executorMetrics()
+    test_campaignStatistics()
@@ -0,0 +1,163 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+import statistics
+
+import numpy as np
+import pytest
+from Basilisk.utilities import RigidBodyKinematics as rbk
+from Basilisk.utilities.MonteCarlo import DispersionTable as dt
+from Basilisk.utilities.MonteCarlo.Controller import SimulationExecutor, SimulationParameters
+
+
+class Hub:
+    def __init__(self):
+        self.mHub = 0.0
+        self.sigma_BNInit = [[0.0], [0.0], [0.0]]
+
+
+class Model:
+    def __init__(self):
+        self.RNGSeed = 0
+        self.hub = Hub()
+
+
+class Task:
+    def __init__(self, models):
+        self.TaskModels = models
+
+
+class DummySim:
+    """python stand-in for a simulation exposing the attributes the executor touches"""
+    def __init__(self):
+        self.scObject = Model()
+        self.gains = [1.0, 2.0, 3.0]
+        self.TaskList = [Task([self.scObject, Model()])]
+
+
+@pytest.mark.parametrize("method", ["lhs", "sobol"])
+def test_stratification(method):
+    """Latin hypercube and Sobol samples place exactly one sample in each stratum of every dimension"""
+    numSamples = 256
+    if method == "lhs":
+        samples = dt.latinHypercube(numSamples, 30, np.random.default_rng(0))
+    else:
+        samples = dt.sobol(numSamples, 30, np.random.default_rng(0))
+    assert samples.min() > 0.0 and samples.max() < 1.0
+    for col in samples.T:
+        np.testing.assert_array_equal(np.bincount((col * numSamples).astype(int), minlength=numSamples), 1)
+
+
+def test_sobolSequence():
+    """The unscrambled sequence matches the reference Sobol points"""
+    expected = [[0.0, 0.0, 0.0], [0.5, 0.5, 0.5], [0.25, 0.75, 0.75], [0.75, 0.25, 0.25],
+                [0.125, 0.625, 0.375], [0.625, 0.125, 0.875], [0.375, 0.375, 0.625], [0.875, 0.875, 0.125]]
+    np.testing.assert_allclose(dt.sobol(8, 3), expected, atol=1e-9)
+
+
+def test_normalQuantile():
+    p = np.linspace(1e-6, 1.0 - 1e-6, 2001)
+    expected = [statistics.NormalDist().inv_cdf(x) for x in p]
+    np.testing.assert_allclose(dt.normalQuantile(p), expected, atol=1e-8)
+
+
+def test_tableDispersions():
+    """Table dispersions follow their distributions and match the per-run dispersion conversions"""
+    numRuns = 20000
+    disps = [dt.NormalTableDispersion("scObject.hub.mHub", 750.0, 5.0),
+             dt.UniformTableDispersion("gains", [-1.0, 1.0], shape=(3,)),
+             dt.UniformEulerAngleMRPTableDispersion("scObject.hub.sigma_BNInit")]
+    table = dt.DispersionTable.generate(disps, numRuns, "lhs", seed=1)
+    assert table.values.shape == (numRuns, 7)
+
+    mass = table.column("scObject.hub.mHub")
+    assert abs(np.mean(mass) - 750.0) < 0.1
+    assert abs(np.std(mass) - 5.0) < 0.1
+    gains = table.column("gains")
+    assert gains.shape == (numRuns, 3)
+    assert gains.min() >= -1.0 and gains.max() <= 1.0
+
+    # the vectorized Euler angle to MRP conversion matches the scalar one
+    angles = np.random.default_rng(2).random((10, 3))
+    mrps = disps[2].sample(angles)
+    for angle, mrp in zip(angles, mrps):
+        np.testing.assert_allclose(mrp, rbk.euler3232MRP(2 * np.pi * angle), atol=1e-12)
+
+    # the same seed reproduces the same table
+    table2 = dt.DispersionTable.generate(disps, numRuns, "lhs", seed=1)
+    np.testing.assert_array_equal(table.values, table2.values)
+    np.testing.assert_array_equal(table.caseSeeds, table2.caseSeeds)
+
+
+def test_tableSaveLoad(tmp_path):
+    disps = [dt.UniformTableDispersion("a", [0.0, 1.0]), dt.NormalTableDispersion("b", np.eye(3), 0.1, shape=(3, 3))]
+    table = dt.DispersionTable.generate(disps, 10, "sobol", seed=3)
+    table.save(str(tmp_path / "table.npz"))
+    loaded = dt.DispersionTable.load(str(tmp_path / "table.npz"))
+    assert loaded.names == table.names
+    assert loaded.shapes == table.shapes
+    np.testing.assert_array_equal(loaded.values, table.values)
+    assert dict(loaded.row(4).items()) == dict(table.row(4).items())
+
+
+def test_compileSetter():
+    sim = DummySim()
+    dt.compileSetter("scObject.hub.mHub")(sim, 10.0)
+    dt.compileSetter("gains[1]")(sim, 5.0)
+    dt.compileSetter("TaskList[0].TaskModels[1].RNGSeed")(sim, 42)
+    assert sim.scObject.hub.mHub == 10.0
+    assert sim.gains == [1.0, 5.0, 3.0]
+    assert sim.TaskList[0].TaskModels[1].RNGSeed == 42
+    with pytest.raises(ValueError):
+        dt.compileSetter("scObject.setMass(1)")
+
+
+def test_tableDispersionIsAbstract():
+    with pytest.raises(TypeError):
+        dt.TableDispersion("scObject.hub.mHub")
+
+
+def test_executorAppliesTableRow():
+    """The simulation executor applies the table row and draws the module seeds from its case seed"""
+    disps = [dt.UniformTableDispersion("scObject.hub.mHub", [100.0, 200.0]),
+             dt.UniformTableDispersion("gains", [0.0, 1.0], shape=(3,))]
+    table = dt.DispersionTable.generate(disps, 4, "lhs", seed=5)
+    executed = []
+
+    def execute(sim):
+        executed.append(sim)
+
+    for index in range(len(table)):
+        simParams = SimulationParameters(creationFunction=DummySim, executionFunction=execute,
+                                         configureFunction=None, retentionPolicies=[], dispersions=[],
+                                         shouldDisperseSeeds=True, shouldArchiveParameters=False, filename="",
+                                         icfilename="", index=index, modifications={},
+                                         tableRow=table.row(index))
+        assert SimulationExecutor()([simParams, None]) == (True, index, {})
+
+        sim = executed[-1]
+        row = dict(table.row(index).items())
+        assert sim.scObject.hub.mHub == row["scObject.hub.mHub"]
+        assert sim.gains == row["gains"]
+        assert [model.RNGSeed for model in sim.TaskList[0].TaskModels] == table.row(index).seeds(2)
+
+
+if __name__ == "__main__":
+    test_stratification("sobol")
+    test_tableDispersions()
+    test_executorAppliesTableRow()
@@ -0,0 +1,122 @@
+#
+#  ISC License
+#
+#  Copyright (c) 2023, Autonomous Vehicle Systems Lab, University of Colorado at Boulder
+#
+#  Permission to use, copy, modify, and/or distribute this software for any
+#  purpose with or without fee is hereby granted, provided that the above
+#  copyright notice and this permission notice appear in all copies.
+#
+#  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+#  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+#  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+#  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+#  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+#  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+#  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+#
+
+
+import numpy as np
+from Basilisk.moduleTemplates import cppModuleTemplate
+from Basilisk.utilities import SimulationBaseClass
+from Basilisk.utilities import macros
+from Basilisk.utilities.MonteCarlo import Controller
+from Basilisk.utilities.MonteCarlo.ConfigurationSnapshot import ConfigurationSnapshot
+from Basilisk.utilities.MonteCarlo.Controller import SimulationExecutor, SimulationParameters
+
+builds = []
+outputs = []
+
+
+def createSim():
+    scSim = SimulationBaseClass.SimBaseClass()
+    proc = scSim.CreateNewProcess("process")
+    proc.addTask(scSim.CreateNewTask("task", macros.sec2nano(1.0)))
+
+    scSim.module = cppModuleTemplate.CppModuleTemplate()
+    scSim.module.ModelTag = "module"
+    scSim.module.dummy = 1.0
+    scSim.module.dumVector = [1.0, 2.0, 3.0]
+    scSim.AddModelToTask("task", scSim.module)
+
+    scSim.moduleLog = scSim.module.dataOutMsg.recorder()
+    scSim.AddModelToTask("task", scSim.moduleLog)
+    scSim.createNewEvent("stopEvent", macros.sec2nano(1.0), True,
+                         ["self.TotalSim.CurrentNanos >= int(3E9)"], ["self.disableTask('task')"])
+    builds.append(scSim)
+    return scSim
+
+
+def executeSim(scSim):
+    scSim.InitializeSimulation()
+    scSim.ConfigureStopTime(macros.sec2nano(5.0))
+    scSim.ExecuteSimulation()
+    outputs.append(np.array(scSim.moduleLog.dataVector))
+
+
+def runCase(index, modifications, warmReuse):
+    simParams = SimulationParameters(creationFunction=createSim, executionFunction=executeSim,
+                                     configureFunction=None, retentionPolicies=[], dispersions=[],
+                                     shouldDisperseSeeds=False, shouldArchiveParameters=False, filename="",
+                                     icfilename="", index=index, modifications=dict(modifications))
+    simParams.warmReuse = warmReuse
+    return SimulationExecutor()([simParams, None])
+
+
+def test_snapshotRestore():
+    """The snapshot restores the module variables and the task and event state changed by a run"""
+    scSim = createSim()
+    snapshot = ConfigurationSnapshot(scSim)
+    assert snapshot.capture() > 0
+    executeSim(scSim)
+    assert not scSim.TaskList[0].TaskData.taskActive
+    assert not scSim.eventMap["stopEvent"].eventActive
+
+    scSim.module.dummy = 4.0
+    scSim.module.dumVector = [0.0, 0.0, 0.0]
+    assert snapshot.restore() > 0
+    assert scSim.module.dummy == 1.0
+    assert list(scSim.module.dumVector) == [1.0, 2.0, 3.0]
+    assert scSim.TaskList[0].TaskData.taskActive
+    assert scSim.eventMap["stopEvent"].eventActive
+    assert snapshot.restore() == 0
+
+
+def test_warmReuse():
+    """Warm runs build the simulation once and reproduce the outputs of cold runs"""
+    cases = [{"module.dummy": "2.0"}, {}, {"module.dumVector": "[0.5, 0.5, 0.5]"}]
+    del builds[:], outputs[:]
+    for index, modifications in enumerate(cases):
+        assert runCase(index, modifications, False)[0]
+    coldOutputs = list(outputs)
+    assert len(builds) == len(cases)
+
+    del builds[:], outputs[:]
+    try:
+        for index, modifications in enumerate(cases):
+            assert runCase(index, modifications, True)[0]
+    finally:
+        Controller._warmSimulations.clear()
+    assert len(builds) == 1
+    for warm, cold in zip(outputs, coldOutputs):
+        np.testing.assert_array_equal(warm, cold)
+
+
+def test_warmReuseController():
+    """A warm campaign runs through the controller on several worker processes"""
+    monteCarlo = Controller.Controller()
+    monteCarlo.setSimulationFunction(createSim)
+    monteCarlo.setExecutionFunction(executeSim)
+    monteCarlo.setExecutionCount(4)
+    monteCarlo.setThreadCount(2)
+    monteCarlo.setVerbose(False)
+    monteCarlo.setShouldDisperseSeeds(False)
+    monteCarlo.setWarmReuse(True)
+    assert monteCarlo.executeSimulations() == []
+
+
+if __name__ == "__main__":
+    test_snapshotRestore()
+    test_warmReuse()
+    test_warmReuseController()
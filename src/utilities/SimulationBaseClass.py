@@ -199,6 +199,10 @@ class SimBaseClass:
         self.bskLogger = bskLogging.BSKLogger()
         self.showProgressBar = False
         self.allModules = set()
+        self.stopConditions = []
+        self.pythonErrorCondition = None
+        self.threadChannelMessages = []
+        self.scenarioLoaders = []
 
     def SetProgressBar(self, value):
         """
@@ -211,7 +215,10 @@ class SimBaseClass:
         Shows in what order the Basilisk processes, task lists and modules are executed
         """
 
+        pyProcNames = [pyProc.Name for pyProc in self.pyProcList]
         for processData in self. TotalSim.processList:
+            if processData.processName in pyProcNames:
+                continue
             print(f"{processColor}Process Name: {endColor}" + processData.processName +
                   " , " + processColor + "priority: " + endColor + str(processData.processPriority))
             for task in processData.processTasks:
@@ -240,7 +247,10 @@ class SimBaseClass:
         Shows in what order the Basilisk processes, task lists and modules are executed
         """
         processList = OrderedDict()
+        pyProcNames = [pyProc.Name for pyProc in self.pyProcList]
         for processData in self. TotalSim.processList:
+            if processData.processName in pyProcNames:
+                continue
             taskList = OrderedDict()
             for task in processData.processTasks:
                 moduleList = []
@@ -368,13 +378,25 @@ class SimBaseClass:
 
     def CreateNewPythonProcess(self, procName, priority = -1):
         """
-        Creates the python analog of a sim-level process, that exists only on the python level in self.pyProcList
+        Creates the python analog of a sim-level process.  The python tasks of this process are executed by the
+        native scheduler through ``SysModel`` trampolines, interleaved with the other processes in priority order.
+        An exception raised by a python module triggers the error condition of the simulation, so that the
+        simulation stops at the failing step and ``ExecuteSimulation()`` raises the exception.  Unlike the stop
+        conditions, the error condition does not make the threads of a multi-threaded simulation step together.
 
         :param procName (str): Name of process
         :param priority (int): Priority that determines when the model gets updated. (Higher number = Higher priority)
         :return: simulationArchTypes.PythonProcessClass object
         """
         proc = simulationArchTypes.PythonProcessClass(procName, priority)
+        if self.pythonErrorCondition is None:
+            self.pythonErrorCondition = sim_model.FlagCondition()
+            self.pythonErrorCondition.name = "pythonTaskError"
+            self.pythonErrorCondition.isFailure = True
+            # the error condition is checked by each thread, it does not make the threads step together
+            self.TotalSim.setErrorCondition(self.pythonErrorCondition)
+        proc.errorCondition = self.pythonErrorCondition
+        self.TotalSim.addNewProcess(proc.processData)
         i=0;
         for procLoc in self.pyProcList:
             if priority > procLoc.pyProcPriority:
@@ -384,6 +406,174 @@ class SimBaseClass:
         self.pyProcList.append(proc)
         return proc
 
+    def raisePythonTaskErrors(self):
+        """
+        Re-raises an exception that a python module raised while being executed by the native scheduler
+        """
+        for pyProc in self.pyProcList:
+            pyProc.raisePendingError()
+
+    def addStopCondition(self, condition):
+        """
+        Adds a native stop condition that ends the run once it is met.  Stop conditions are evaluated by the
+        C++ scheduler after each simulation step.  Once a condition is met, ``ExecuteSimulation()`` returns and
+        later calls do not advance the simulation until it is initialized again.  In a simulation with several
+        threads, the threads take each step together while stop conditions are set, so that they all stop at the
+        step where the condition is met.
+
+        :param condition: sim_model.StopCondition object
+        :return: the stop condition
+        """
+        self.stopConditions.append(condition)
+        self.TotalSim.addStopCondition(condition)
+        return condition
+
+    def addMessageStopCondition(self, name, msg, fieldName, relation, threshold, index=None, holdCount=1,
+                                isFailure=False):
+        """
+        Adds a native stop condition on a numeric field of a message payload.
+
+        :param name (str): name reported by ``getStopCondition()`` when the condition ends the run
+        :param msg: output message, input message or C-wrapped message holding the field
+        :param fieldName (str): name of the payload field
+        :param relation (str): one of "<", "<=", ">", ">=" or "settled".  "settled" holds when the value changes
+            by less than ``threshold`` between two consecutive writes of the message.
+        :param threshold (float): threshold of the relation
+        :param index (int): flat index of the array element to compare.  If None, array fields are compared
+            through the Euclidean norm of all their elements.
+        :param holdCount (int): number of consecutive evaluations the relation must hold
+        :param isFailure (bool): flag marking the condition as a failure, such as a constraint violation
+        :return: sim_model.MessageFieldCondition object
+        """
+        payloadAddress, headerAddress, dtype = msg.payloadPointers()
+        if fieldName not in dtype.names:
+            raise ValueError("The payload has no numeric field named " + fieldName)
+        fieldType, offset = dtype.fields[fieldName][:2]
+        elementType = fieldType.base
+        elementCount = int(np.prod(fieldType.shape, dtype=int))
+        if index is not None:
+            if not 0 <= index < elementCount:
+                raise IndexError("Index " + str(index) + " is out of range for field " + fieldName)
+            offset += index * elementType.itemsize
+            elementCount = 1
+
+        condition = sim_model.MessageFieldCondition()
+        condition.name = name
+        condition.isFailure = isFailure
+        condition.configure(payloadAddress, headerAddress, offset, elementType.kind + str(elementType.itemsize),
+                            elementCount)
+        condition.setRelation(relation, threshold, holdCount)
+        self.addStopCondition(condition)
+        self.stopConditions.append(msg)  # the message must outlive the condition reading its payload
+        return condition
+
+    def addThreadChannel(self, inMsg, sourceThread, targetThread, lookaheadNanos):
+        """
+        Declares the message link of a module input message as a channel between two threads.  The input message
+        is subscribed instead to a copy of the message it reads.  Before each of its steps the target thread
+        updates the copy with the value the message had one lookahead earlier, so the threads never access the
+        same message memory.  In the conservative mode, see ``TotalSim.setConservativeSync()``, the target thread
+        then reads the same values in every run.  The channel lookahead between the threads is lowered to the
+        lookahead of the message.
+
+        :param inMsg: C++ input message of a module on the target thread, subscribed to the message to read
+        :param sourceThread (int): index of the thread executing the module writing the message
+        :param targetThread (int): index of the thread executing the module reading the message
+        :param lookaheadNanos (int): [ns] age of the values read through the channel, positive
+        :return: the copy of the message read by ``inMsg``
+        """
+        from Basilisk.architecture import messaging
+        readerName = type(inMsg).__name__
+        if not readerName.endswith("Reader"):
+            raise TypeError("Only C++ input messages can read messages across threads")
+        if not inMsg.isLinked():
+            raise ValueError("The input message must be subscribed to the message it reads across threads")
+        msgCopy = getattr(messaging, readerName[:-len("Reader")])()
+        if not msgCopy.isPayloadTriviallyCopyable():
+            raise TypeError("The payload of " + readerName[:-len("Reader")] + " owns memory and can not be copied "
+                            "across threads")
+        messageCount = self.TotalSim.getChannelMessageCount()
+        self.TotalSim.addChannelMessage(sourceThread, targetThread, inMsg.headerAddress(), inMsg.payloadAddress(),
+                                        msgCopy.headerAddress(), msgCopy.payloadAddress(), msgCopy.getPayloadSize(),
+                                        lookaheadNanos)
+        if self.TotalSim.getChannelMessageCount() == messageCount:
+            raise ValueError("The channel needs two different threads of the simulation and a positive lookahead")
+        inMsg.subscribeTo(msgCopy)
+        self.threadChannelMessages.append(msgCopy)  # the copy must outlive the channel writing to it
+        return msgCopy
+
+    def getStopCondition(self):
+        """
+        Returns the stop condition that ended the run
+
+        :return: tuple (name, time in nanoseconds, failure flag), or None if no stop condition was met
+        """
+        if not self.TotalSim.stopConditionMet():
+            return None
+        return (self.TotalSim.getStopConditionName(), self.TotalSim.stopConditionNanos,
+                self.TotalSim.stopConditionFailed())
+
+    def LoadScenario(self, description, models={}):
+        """
+        Builds the processes, tasks, modules and message links of a scenario description natively, without setting
+        the module variables and subscribing the messages from python.  The description lists the processes, their
+        tasks with the period in nanoseconds, the modules of each task with their type and variables, and the links
+        of input messages to output messages::
+
+            {"processes": [{"name": "dynProcess", "priority": 10, "tasks": [
+                {"name": "dynTask", "period": 100000000, "modules": [
+                    {"name": "env", "type": "cppModuleTemplate.CppModuleTemplate", "priority": 10,
+                     "parameters": {"dumVector": [1.0, 2.0, 3.0]}}]}]}],
+             "links": {"fsw.dataInMsg": "env.dataOutMsg"}}
+
+        Module types are named by their library and class, as in python.  The libraries are imported here, which
+        registers their module types with the native loader.  The created modules are only reachable through the
+        returned loader; modules that python needs a handle on can be created in python and passed in ``models``,
+        the description can then link their messages.
+
+        :param description: path of a JSON or YAML file, JSON text, or a dictionary
+        :param models (dict): C++ modules created in python, by their name in the description
+        :return: scenarioLoader.ScenarioLoader owning the created modules, kept alive by the simulation
+        """
+        import importlib
+        import json
+        from Basilisk.architecture import scenarioLoader
+
+        if isinstance(description, dict):
+            document = json.dumps(description)
+        elif os.path.isfile(description):
+            with open(description, 'r') as fid:
+                document = fid.read()
+            if os.path.splitext(description)[1] in ('.yaml', '.yml'):
+                import yaml
+                document = json.dumps(yaml.safe_load(document))
+        else:
+            document = description
+        parsed = json.loads(document)
+
+        # importing a module library registers its module types
+        libraries = set(model.get("type", "").split(".")[0] for proc in parsed.get("processes", [])
+                        for task in proc.get("tasks", []) for model in task.get("modules", []))
+        libraries.discard("")
+        for library in sorted(libraries):
+            for package in ("simulation", "fswAlgorithms", "moduleTemplates", "ExternalModules"):
+                try:
+                    importlib.import_module("Basilisk." + package + "." + library)
+                    break
+                except ImportError:
+                    continue
+
+        loader = scenarioLoader.ScenarioLoader()
+        loader.bskLogger = self.bskLogger
+        for name, model in models.items():
+            typeName = type(model).__module__.split(".")[-1] + "." + type(model).__name__
+            if not loader.addModel(name, typeName, model):
+                raise ValueError(loader.getErrorMessage())
+        if not loader.loadString(document) or not loader.build(self.TotalSim):
+            raise ValueError(loader.getErrorMessage())
+        self.scenarioLoaders.append(loader)
+        return loader
+
     def CreateNewTask(self, TaskName, TaskRate, InputDelay=0, FirstStart=0):
         """
         Creates a simulation task on the C-level with a specific update-frequency (TaskRate), an optional delay, and
@@ -479,11 +669,9 @@ class SimBaseClass:
         self.TotalSim.assignRemainingProcs()
         self.TotalSim.ResetSimulation()
         self.TotalSim.selfInitSimulation()
-        for proc in self.pyProcList:
-            proc.selfInitProcess()
+        self.raisePythonTaskErrors()
         self.TotalSim.resetInitSimulation()
-        for proc in self.pyProcList:
-            proc.resetProcess(0)
+        self.raisePythonTaskErrors()
         for LogItem, LogValue in self.VarLogList.items():
             LogValue.clearItem()
         self.simulationInitialized = True
@@ -529,11 +717,6 @@ class SimBaseClass:
 
         nextStopTime = self.TotalSim.NextTaskTime
         nextPriority = -1
-        pyProcPresent = False
-        if len(self.pyProcList) > 0:
-            nextPriority = self.pyProcList[0].pyProcPriority
-            pyProcPresent = True
-            nextStopTime = self.pyProcList[0].nextCallTime()
         progressBar = SimulationProgressBar(self.StopTime, self.showProgressBar)
         while self.TotalSim.NextTaskTime <= self.StopTime and not self.terminate:
             if self.TotalSim.CurrentNanos >= self.nextEventTime >= 0:
@@ -543,21 +726,13 @@ class SimBaseClass:
                 nextStopTime = self.nextEventTime
                 nextPriority = -1
             self.TotalSim.StepUntilStop(nextStopTime, nextPriority)
+            self.raisePythonTaskErrors()
+            if self.TotalSim.stopConditionMet():
+                self.terminate = True
             progressBar.update(self.TotalSim.NextTaskTime)
             nextPriority = -1
             nextStopTime = self.StopTime
             nextLogTime = self.RecordLogVars()
-            procStopTimes = []
-            for pyProc in self.pyProcList:
-                nextCallTime = pyProc.nextCallTime()
-                if nextCallTime <= self.TotalSim.CurrentNanos:
-                    pyProc.executeTaskList(self.TotalSim.CurrentNanos)
-                nextCallTime = pyProc.nextCallTime()
-                procStopTimes.append(nextCallTime)
-
-            if pyProcPresent and nextStopTime >= min(procStopTimes):
-                nextStopTime = min(procStopTimes)
-                nextPriority = self.pyProcList[procStopTimes.index(nextStopTime)].pyProcPriority
             if 0 <= nextLogTime < nextStopTime:
                 nextStopTime = nextLogTime
                 nextPriority = -1
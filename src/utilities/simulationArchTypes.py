@@ -18,6 +18,9 @@
 
 
 
+import threading
+from contextlib import contextmanager
+
 from Basilisk.architecture import sim_model
 from Basilisk.architecture import sys_model_task
 
@@ -50,6 +53,17 @@ class ProcessBaseClass(object):
     def updateTaskPeriod(self, TaskName, newPeriod):
         self.processData.changeTaskPeriod(TaskName, newPeriod)
 
+    @contextmanager
+    def placeMessages(self):
+        """place the C++ messages created inside the ``with`` block contiguously in the message arena of the process.
+        The arena is moved to the NUMA node of the thread executing the process when the simulation is initialized.
+        The process must outlive the modules created in the block."""
+        self.processData.openMessageArena()
+        try:
+            yield self
+        finally:
+            self.processData.closeMessageArena()
+
 
 class TaskBaseClass(object):
     def __init__(self, TaskName, TaskRate, InputDelay=0, FirstStart=0):
@@ -71,6 +85,7 @@ class TaskBaseClass(object):
 
 class PythonModelClass(object):
     idCounter = 1
+    idLock = threading.Lock()
     def __init__(self, modelName, modelActive=True, modelPriority=-1):
         # The modelName is a unique identifier (unique to simulation) passed
         # in to a class.
@@ -80,8 +95,9 @@ class PythonModelClass(object):
         # The moduleID is a numeric identifier used to track message usage in
         # a given simulation.
         # Note: python modules get negative ID numbers
-        self.moduleID = -PythonModelClass.idCounter
-        PythonModelClass.idCounter = PythonModelClass.idCounter + 1
+        with PythonModelClass.idLock:
+            self.moduleID = -PythonModelClass.idCounter
+            PythonModelClass.idCounter = PythonModelClass.idCounter + 1
         # The modelPriority variable is the setting for which models get run
         # first.  Higher priority indicates that a model will get run sooner.
         self.modelPriority = modelPriority
@@ -105,6 +121,41 @@ class PythonModelClass(object):
         return
 
 
+class PythonTaskModel(sim_model.SysModel):
+    """
+    Native ``SysModel`` trampoline that lets the C++ scheduler execute a python task directly.
+    Python exceptions are not allowed to unwind through the native scheduler.  They are stored
+    instead, the python task is disabled and the error condition of the simulation is triggered,
+    so that the scheduler stops at the end of the failing step.  The exception is re-raised by the
+    simulation once the native call returns.
+    """
+    def __init__(self, pyTask):
+        super(PythonTaskModel, self).__init__()
+        self.pyTask = pyTask
+        self.ModelTag = pyTask.name
+        self.pendingError = None
+        self.errorCondition = None
+
+    def callPython(self, method, *args):
+        try:
+            method(*args)
+        except BaseException as err:
+            self.pyTask.taskActive = False
+            if self.pendingError is None:
+                self.pendingError = err
+            if self.errorCondition is not None:
+                self.errorCondition.trigger(args[0] if args else 0)
+
+    def SelfInit(self):
+        self.callPython(self.pyTask.selfInitTask)
+
+    def Reset(self, CurrentSimNanos):
+        self.callPython(self.pyTask.resetTask, CurrentSimNanos)
+
+    def UpdateState(self, CurrentSimNanos):
+        self.callPython(self.pyTask.executeModelList, CurrentSimNanos)
+
+
 class PythonTaskClass(object):
     def __init__(self, taskName, taskRate, taskActive=True, taskPriority=-1, parentProc=None):
         self.name = taskName
@@ -114,6 +165,11 @@ class PythonTaskClass(object):
         self.nextTaskTime = 0
         self.taskActive = taskActive
         self.parentProc = parentProc
+        # native task holding the trampoline that runs this python task from the C++ scheduler
+        self.TaskData = sys_model_task.SysModelTask(taskRate)
+        self.TaskData.TaskName = taskName
+        self.taskModel = PythonTaskModel(self)
+        self.TaskData.AddNewObject(self.taskModel)
 
     def updateParentProc(self, newParentProc):
         self.parentProc = newParentProc
@@ -144,34 +200,33 @@ class PythonTaskClass(object):
         for model in self.modelList:
             model.updateState(currentTime)
 
+    def raisePendingError(self):
+        err = self.taskModel.pendingError
+        if err is not None:
+            self.taskModel.pendingError = None
+            raise err
+
 
 class PythonProcessClass(ProcessBaseClass):
+    """
+    Process holding python tasks.  Each python task is added as a native task to the ``processData``
+    process, so the C++ scheduler interleaves the python tasks with the regular processes in priority order.
+    """
     def __init__(self, procName, priority=-1):
-        super(PythonProcessClass, self).__init__(procName)
+        super(PythonProcessClass, self).__init__(procName, priority)
         self.taskList = []
-        self.executionOrder = []
-        self.nextTaskTime = 0
         self.pyProcPriority = priority
         self.intRefs = []
-
-    def nextCallTime(self):
-        return self.nextTaskTime
-
-    def scheduleTask(self, newTask):
-        for i in range(len(self.executionOrder)):
-            tmpTask = self.executionOrder[i]
-            if (newTask.nextTaskTime < tmpTask.nextTaskTime or
-                    newTask.nextTaskTime == tmpTask.nextTaskTime and
-                    newTask.priority > tmpTask.priority):
-                self.executionOrder.insert(i, newTask)
-                return
-        self.executionOrder.append(newTask)
+        # stop condition triggered by the tasks of this process when a python module raises an exception
+        self.errorCondition = None
 
     def createPythonTask(self, newTaskName, taskRate, taskActive=True, taskPriority=-1):
-        self.taskList.append(PythonTaskClass(newTaskName, taskRate, taskActive, taskPriority, self.processData))
+        self.addPythonTask(PythonTaskClass(newTaskName, taskRate, taskActive, taskPriority, self.processData))
 
     def addPythonTask(self, newPyTask):
+        newPyTask.taskModel.errorCondition = self.errorCondition
         self.taskList.append(newPyTask)
+        self.processData.addNewTask(newPyTask.TaskData, newPyTask.priority)
 
     def addModelToTask(self, taskName, newModel, priority=None):
         for task in self.taskList:
@@ -181,34 +236,9 @@ class PythonProcessClass(ProcessBaseClass):
         print("Attempted to add model: " + newModel.modelName)
         print("to non-existent task: " + taskName)
 
-    def selfInitProcess(self):
-
-        if not self.taskList:
-            return
-
-        for task in self.taskList:
-            task.selfInitTask()
-        self.nextTaskTime = 0
-        self.scheduleTask(self.taskList[-1])
-
-    def resetProcess(self, currentTime):
-        self.executionOrder = []
+    def raisePendingError(self):
         for task in self.taskList:
-            task.resetTask(currentTime)
-            self.scheduleTask(task)
-
-    def executeTaskList(self, currentTime):
-        if len(self.executionOrder) == 0:
-            return
-        taskNext = self.executionOrder[0]
-        for intCurr in self.intRefs:
-            intCurr.routeInputs(self.processData.messageBuffer)
-        while taskNext.nextTaskTime <= currentTime:
-            taskNext.executeModelList(currentTime)
-            self.executionOrder.pop(0)
-            self.scheduleTask(taskNext)
-            taskNext = self.executionOrder[0]
-        self.nextTaskTime = taskNext.nextTaskTime
+            task.raisePendingError()
 
     def addInterfaceRef(self, newInt):
         self.intRefs.append(newInt)